@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "AllocationCounter.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Each thread has its own count so that counting doesn't add contention to the multithreaded benchmarks
+    thread_local size_t allocation_count = 0;
+
+    void* allocate(std::size_t size)
+    {
+        ++allocation_count;
+        if (size == 0)
+        {
+            size = 1;
+        }
+        void* memory = std::malloc(size);
+        while (!memory)
+        {
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+            memory = std::malloc(size);
+        }
+        return memory;
+    }
+
+    void* allocate(std::size_t size, const std::nothrow_t&) noexcept
+    {
+        try
+        {
+            return allocate(size);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+}
+
+size_t AllocationCounter::Count() noexcept
+{
+    return allocation_count;
+}
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return allocate(size, tag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return allocate(size, tag);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+// The sized forms are what a C++14 compiler calls when the size is known, they must match the unsized ones
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    std::free(memory);
+}
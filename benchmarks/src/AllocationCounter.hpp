@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_ALLOCATIONCOUNTER_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_ALLOCATIONCOUNTER_HPP
+
+#include <cstddef>
+
+// Counts the heap allocations made by the calling thread. The benchmarks replace the global operator new to do the
+// counting so every allocation made through it is included, whether it comes from the containers of this library or
+// from the standard library.
+class AllocationCounter
+{
+public:
+    // The number of allocations made by the calling thread since it started
+    static size_t Count() noexcept;
+};
+
+#endif
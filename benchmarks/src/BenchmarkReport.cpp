@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BenchmarkReport.hpp"
+#include "AllocationCounter.hpp"
+#include <cstdio>
+
+namespace
+{
+    double perOperation(double total, size_t operations)
+    {
+        return ((operations == 0) ? 0 : (total / operations));
+    }
+
+    void writeJSONString(const char* str, std::ostream& output)
+    {
+        output << '"';
+        for (const char* c = str; *c; ++c)
+        {
+            if ((*c == '"') || (*c == '\\'))
+            {
+                output << '\\' << *c;
+            }
+            else if (static_cast<unsigned char>(*c) < 0x20)
+            {
+                char escaped[7];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(*c));
+                output << escaped;
+            }
+            else
+            {
+                output << *c;
+            }
+        }
+        output << '"';
+    }
+}
+
+BenchmarkReport::BenchmarkReport(std::ostream& output, Format format)
+    : m_output(output), m_format(format), m_result_count(0)
+{
+    if (m_format == Format::json)
+    {
+        m_output << "[";
+    }
+}
+
+BenchmarkReport::Measurement BenchmarkReport::start() const noexcept
+{
+    // The clock is read last so that reading the counters isn't part of the time
+    Measurement measurement;
+    m_counters.read(measurement.m_start_events);
+    measurement.m_start_allocations = AllocationCounter::Count();
+    measurement.m_start_time = std::chrono::steady_clock::now();
+    return measurement;
+}
+
+void BenchmarkReport::stop(const Measurement& measurement, const char* name, const char* operation, size_t size,
+    size_t operations, size_t checksum)
+{
+    std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+    size_t allocations = AllocationCounter::Count() - measurement.m_start_allocations;
+    uint64_t events[PerformanceCounters::event_count];
+    m_counters.read(events);
+
+    for (size_t i = 0; i < PerformanceCounters::event_count; ++i)
+    {
+        events[i] -= measurement.m_start_events[i];
+    }
+    double nanoseconds = std::chrono::duration<double, std::nano>(end_time - measurement.m_start_time).count();
+
+    switch (m_format)
+    {
+    case Format::text:
+        writeText(name, operation, size, operations, checksum, nanoseconds, allocations, events);
+        break;
+
+    case Format::json:
+        writeJSON(name, operation, size, operations, checksum, nanoseconds, allocations, events);
+        break;
+    }
+    ++m_result_count;
+}
+
+void BenchmarkReport::finish()
+{
+    if (m_format == Format::json)
+    {
+        m_output << "\n]" << std::endl;
+    }
+}
+
+void BenchmarkReport::writeText(const char* name, const char* operation, size_t size, size_t operations,
+    size_t checksum, double nanoseconds, size_t allocations,
+    const uint64_t (&events)[PerformanceCounters::event_count])
+{
+    m_output << name << " " << operation << " (size " << size << "): " << operations << " operations in "
+        << (nanoseconds / 1000000) << " ms (" << perOperation(nanoseconds, operations) << " ns/operation, "
+        << perOperation(static_cast<double>(allocations), operations) << " allocations/operation";
+    for (size_t i = 0; i < PerformanceCounters::event_count; ++i)
+    {
+        if (m_counters.isAvailable(i))
+        {
+            m_output << ", " << perOperation(static_cast<double>(events[i]), operations) << " "
+                << PerformanceCounters::EventName(i) << "/operation";
+        }
+    }
+    m_output << ", checksum " << checksum << ")" << std::endl;
+}
+
+void BenchmarkReport::writeJSON(const char* name, const char* operation, size_t size, size_t operations,
+    size_t checksum, double nanoseconds, size_t allocations,
+    const uint64_t (&events)[PerformanceCounters::event_count])
+{
+    if (m_result_count != 0)
+    {
+        m_output << ",";
+    }
+    m_output << "\n  {\"name\": ";
+    writeJSONString(name, m_output);
+    m_output << ", \"operation\": ";
+    writeJSONString(operation, m_output);
+    m_output << ", \"size\": " << size << ", \"operations\": " << operations << ", \"total_ms\": "
+        << (nanoseconds / 1000000) << ", \"ns_per_operation\": " << perOperation(nanoseconds, operations)
+        << ", \"allocations_per_operation\": " << perOperation(static_cast<double>(allocations), operations);
+    for (size_t i = 0; i < PerformanceCounters::event_count; ++i)
+    {
+        if (m_counters.isAvailable(i))
+        {
+            m_output << ", \"" << PerformanceCounters::EventName(i) << "_per_operation\": "
+                << perOperation(static_cast<double>(events[i]), operations);
+        }
+    }
+    m_output << ", \"checksum\": " << checksum << "}";
+    // Results are flushed as they come so that a long run can be followed
+    m_output.flush();
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_BENCHMARKREPORT_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_BENCHMARKREPORT_HPP
+
+#include "PerformanceCounters.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Measures the benchmarks and writes the results to an output stream, either as one line of text per result or as a
+// JSON array with one object per result. Each result has the time, the number of heap allocations and the hardware
+// events per operation. The allocations and the hardware events are those of the thread that created the report.
+class BenchmarkReport
+{
+public:
+    enum class Format
+    {
+        text,
+        json
+    };
+
+    // The state of the clock and of the counters when a measurement started
+    class Measurement
+    {
+    private:
+        friend class BenchmarkReport;
+
+        std::chrono::steady_clock::time_point m_start_time;
+        size_t m_start_allocations;
+        uint64_t m_start_events[PerformanceCounters::event_count];
+    };
+
+    BenchmarkReport(std::ostream& output, Format format);
+    BenchmarkReport(const BenchmarkReport& other) = delete;
+    BenchmarkReport& operator=(const BenchmarkReport& other) = delete;
+
+    Measurement start() const noexcept;
+    // Ends the measurement and writes its result. The per operation figures are the totals divided by operations.
+    // The checksum is computed from the results of the operations, if they have any. It keeps the compiler from
+    // discarding them and it should be the same for all the containers that ran the same workload.
+    void stop(const Measurement& measurement, const char* name, const char* operation, size_t size,
+        size_t operations, size_t checksum);
+    // Terminates the output, no results can be written after this is called
+    void finish();
+
+private:
+    void writeText(const char* name, const char* operation, size_t size, size_t operations, size_t checksum,
+        double nanoseconds, size_t allocations, const uint64_t (&events)[PerformanceCounters::event_count]);
+    void writeJSON(const char* name, const char* operation, size_t size, size_t operations, size_t checksum,
+        double nanoseconds, size_t allocations, const uint64_t (&events)[PerformanceCounters::event_count]);
+
+    std::ostream& m_output;
+    Format m_format;
+    PerformanceCounters m_counters;
+    size_t m_result_count;
+};
+
+#endif
@@ -0,0 +1,241 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BinaryTreeBenchmarks.hpp"
+#include "Ishiko/DataStructures/BinaryTree.hpp"
+#include "Ishiko/DataStructures/FrozenBinaryTree.hpp"
+#include "Ishiko/DataStructures/WorkStealingPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    // The recursive traversal can't be trusted beyond this depth with the default stack sizes
+    const size_t max_recursion_depth = 10000;
+
+    // Fills the subtree rooted at node so that the tree is complete, with the values in inorder
+    void buildCompleteTree(BinaryTree<int>& tree, BinaryTree<int>::Node* node, int first, int last)
+    {
+        int middle = first + ((last - first) / 2);
+        if (first < middle)
+        {
+            int left_middle = first + ((middle - first) / 2);
+            buildCompleteTree(tree, tree.insertLeft(left_middle, node), first, middle);
+        }
+        if ((middle + 1) < last)
+        {
+            int right_middle = (middle + 1) + ((last - middle - 1) / 2);
+            buildCompleteTree(tree, tree.insertRight(right_middle, node), middle + 1, last);
+        }
+    }
+
+    void buildDegenerateTree(BinaryTree<int>& tree, size_t size)
+    {
+        tree.setRoot(0);
+        BinaryTree<int>::Node* node = tree.root();
+        for (size_t i = 1; i < size; ++i)
+        {
+            node = tree.insertRight(static_cast<int>(i), node);
+        }
+    }
+
+    // Stands for the scoring of a payload: enough work for the parallel traversals to be worth it
+    size_t score(int value) noexcept
+    {
+        uint64_t hash = static_cast<uint32_t>(value);
+        for (int i = 0; i < 200; ++i)
+        {
+            hash = ((hash ^ (hash >> 29)) * 0xBF58476D1CE4E5B9ull);
+        }
+        return static_cast<size_t>(hash & 0xFF);
+    }
+
+    // Visits the keys of a tree of the given size in a random order. Multiplying by an odd constant is a bijection on
+    // the integers modulo a power of 2 so the keys are distinct, the ones out of range are skipped.
+    std::vector<int> makeLookupKeys(size_t size)
+    {
+        size_t range = 1;
+        while (range < size)
+        {
+            range *= 2;
+        }
+        std::vector<int> keys;
+        keys.reserve(size);
+        for (size_t i = 0; i < range; ++i)
+        {
+            size_t key = ((i * 2654435761u) & (range - 1));
+            if (key < size)
+            {
+                keys.push_back(static_cast<int>(key));
+            }
+        }
+        return keys;
+    }
+
+    // BinaryTree has no search since it doesn't know how its nodes are ordered
+    template<typename Node>
+    const Node* find(const Node* node, int value)
+    {
+        while (node && (node->data() != value))
+        {
+            node = ((value < node->data()) ? node->leftChildNode() : node->rightChildNode());
+        }
+        return node;
+    }
+
+    // The traversal BinaryTree used before it followed the parent links
+    template<typename Node, typename Callable>
+    void recursiveInorderTraversal(const Node* node, Callable& callable)
+    {
+        if (node->leftChildNode())
+        {
+            recursiveInorderTraversal(node->leftChildNode(), callable);
+        }
+        callable(node->data());
+        if (node->rightChildNode())
+        {
+            recursiveInorderTraversal(node->rightChildNode(), callable);
+        }
+    }
+}
+
+void BinaryTreeBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    for (size_t n = 1000; n <= size; n *= 10)
+    {
+        // The recursion in buildCompleteTree only goes as deep as the height of the tree
+        BinaryTree<int> complete_tree;
+        complete_tree.setRoot(static_cast<int>(n / 2));
+        buildCompleteTree(complete_tree, complete_tree.root(), 0, static_cast<int>(n));
+        Traversals("BinaryTree (complete)", complete_tree, n, true, report);
+        ParallelTraversals("BinaryTree (complete, scoring)", complete_tree, n, report);
+        Lookups("BinaryTree (complete)", complete_tree, n, report);
+
+        BinaryTree<int> degenerate_tree;
+        buildDegenerateTree(degenerate_tree, n);
+        Traversals("BinaryTree (degenerate)", degenerate_tree, n, (n <= max_recursion_depth), report);
+    }
+}
+
+template<typename Tree>
+void BinaryTreeBenchmarks::Traversals(const char* name, Tree& tree, size_t size, bool recursive,
+    BenchmarkReport& report)
+{
+    size_t sum = 0;
+    auto add = [&sum](int value) { sum += static_cast<size_t>(value); };
+
+    if (recursive)
+    {
+        BenchmarkReport::Measurement measurement = report.start();
+        recursiveInorderTraversal(tree.root(), add);
+        report.stop(measurement, name, "recursive inorder", size, size, sum);
+    }
+
+    sum = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    tree.doInorderTraversal(add);
+    report.stop(measurement, name, "inorder", size, size, sum);
+
+    sum = 0;
+    measurement = report.start();
+    for (int value : tree)
+    {
+        add(value);
+    }
+    report.stop(measurement, name, "inorder iterator", size, size, sum);
+
+    sum = 0;
+    measurement = report.start();
+    tree.doPreorderTraversal(add);
+    report.stop(measurement, name, "preorder", size, size, sum);
+
+    sum = 0;
+    measurement = report.start();
+    tree.doPostorderTraversal(add);
+    report.stop(measurement, name, "postorder", size, size, sum);
+
+    sum = 0;
+    measurement = report.start();
+    tree.doLevelOrderTraversal(add);
+    report.stop(measurement, name, "level order", size, size, sum);
+}
+
+template<typename Tree>
+void BinaryTreeBenchmarks::ParallelTraversals(const char* name, const Tree& tree, size_t size,
+    BenchmarkReport& report)
+{
+    size_t sum = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    tree.doInorderTraversal([&sum](int value) { sum += score(value); });
+    report.stop(measurement, name, "inorder", size, size, sum);
+
+    // The scaling with the number of threads, up to the number of hardware threads but at least 2 so that stealing
+    // is always measured. The small grain size shows the overhead of the pool itself.
+    size_t max_thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+    for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        WorkStealingPool pool(thread_count - 1);
+        std::string parallel_name = (std::string(name) + " " + std::to_string(thread_count) + " threads");
+
+        std::atomic<size_t> atomic_sum{0};
+        measurement = report.start();
+        tree.parallelTraversal(pool, [&atomic_sum](int value) { atomic_sum += score(value); });
+        report.stop(measurement, parallel_name.c_str(), "parallelTraversal", size, size, atomic_sum.load());
+
+        atomic_sum = 0;
+        measurement = report.start();
+        tree.parallelTraversal(pool, [&atomic_sum](int value) { atomic_sum += score(value); }, 16);
+        report.stop(measurement, parallel_name.c_str(), "parallelTraversal grain 16", size, size, atomic_sum.load());
+
+        measurement = report.start();
+        sum = tree.parallelReduce(pool, size_t(0), [](int value) { return score(value); },
+            [](size_t x, size_t y) { return (x + y); });
+        report.stop(measurement, parallel_name.c_str(), "parallelReduce", size, size, sum);
+    }
+}
+
+template<typename Tree>
+void BinaryTreeBenchmarks::Lookups(const char* name, Tree& tree, size_t size, BenchmarkReport& report)
+{
+    std::vector<int> keys = makeLookupKeys(size);
+
+    // The nodes of the tree were allocated one after the other in preorder, which is already kinder to the cache
+    // than a tree built by random insertions
+    size_t hits = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    for (int key : keys)
+    {
+        if (find(tree.root(), key))
+        {
+            ++hits;
+        }
+    }
+    report.stop(measurement, name, "lookup", size, keys.size(), hits);
+
+    measurement = report.start();
+    FrozenBinaryTree<int> frozen_tree = tree.freeze();
+    report.stop(measurement, name, "freeze", size, size, frozen_tree.size());
+
+    std::string frozen_name = (std::string(name) + " frozen");
+    hits = 0;
+    measurement = report.start();
+    for (int key : keys)
+    {
+        if (frozen_tree.contains(key))
+        {
+            ++hits;
+        }
+    }
+    report.stop(measurement, frozen_name.c_str(), "lookup", size, keys.size(), hits);
+
+    size_t sum = 0;
+    measurement = report.start();
+    frozen_tree.doInorderTraversal([&sum](int value) { sum += static_cast<size_t>(value); });
+    report.stop(measurement, frozen_name.c_str(), "inorder", size, size, sum);
+}
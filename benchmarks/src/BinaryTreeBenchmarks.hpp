@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_BINARYTREEBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_BINARYTREEBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+
+// Compares the BinaryTree traversals, which follow the parent links, with a recursive inorder traversal on a
+// complete tree and on a degenerate tree, and the parallel traversals with the sequential one for an expensive
+// callable. The lookups in the complete tree, which is a binary search tree, are compared with the lookups in its
+// FrozenBinaryTree copy. The benchmarks run for every power of 10 from 1000 up to the given number of elements. The
+// recursive traversal is skipped on the degenerate trees it would overflow the stack on.
+class BinaryTreeBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    template<typename Tree>
+    static void Traversals(const char* name, Tree& tree, size_t size, bool recursive, BenchmarkReport& report);
+    template<typename Tree>
+    static void ParallelTraversals(const char* name, const Tree& tree, size_t size, BenchmarkReport& report);
+    template<typename Tree>
+    static void Lookups(const char* name, Tree& tree, size_t size, BenchmarkReport& report);
+};
+
+#endif
@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ConcurrencyBenchmarks.hpp"
+#include "Ishiko/DataStructures/ConcurrentQueue.hpp"
+#include "Ishiko/DataStructures/ConcurrentSkipList.hpp"
+#include "Ishiko/DataStructures/ConcurrentStack.hpp"
+#include "Ishiko/DataStructures/DoublyLinkedList.hpp"
+#include "Ishiko/DataStructures/IntrusiveSinglyLinkedList.hpp"
+#include "Ishiko/DataStructures/SkipList.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    const size_t max_thread_count = 64;
+
+    // One insert for every update_ratio - 1 lookups
+    const size_t update_ratio = 10;
+
+    // The number of objects shared by the threads of the recycling workload
+    const size_t recycled_object_count = 64;
+
+    class RecycledObject : public ConcurrentStackHook<RecycledObject>, public SinglyLinkedListHook<RecycledObject>
+    {
+    };
+
+    // xorshift64 with a per thread state so the generators don't contend with each other or with the workload
+    uint64_t nextRandom(uint64_t& state)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    size_t randomLevel()
+    {
+        thread_local uint64_t state = 0x9E3779B97F4A7C15ull
+            ^ static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        size_t levels = 1;
+        uint64_t bits = nextRandom(state);
+        while ((levels < 32) && (bits & 1))
+        {
+            ++levels;
+            bits >>= 1;
+        }
+        return levels;
+    }
+
+    // Runs thread_count threads that together perform size operations on keys in [0, 2 * size) and returns the
+    // number of operations actually performed. The number of successful lookups is returned in hits, which also
+    // keeps the compiler from discarding the lookups.
+    template<typename Lookup, typename Insert>
+    size_t runWorkload(size_t size, size_t thread_count, Lookup lookup, Insert insert, size_t& hits)
+    {
+        size_t operations_per_thread = size / thread_count;
+        std::atomic<size_t> total_hits(0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back(
+                [=, &total_hits]()
+                {
+                    size_t thread_hits = 0;
+                    uint64_t state = 0x2545F4914F6CDD1Dull * (t + 1);
+                    for (size_t i = 0; i < operations_per_thread; ++i)
+                    {
+                        int key = static_cast<int>(nextRandom(state) % (2 * size));
+                        if ((i % update_ratio) == 0)
+                        {
+                            insert(key);
+                        }
+                        else if (lookup(key))
+                        {
+                            ++thread_hits;
+                        }
+                    }
+                    total_hits += thread_hits;
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        hits = total_hits;
+        return (operations_per_thread * thread_count);
+    }
+
+    // Runs thread_count threads that each act as both a producer and a consumer: they push a value and then try to
+    // pop one, until the threads together have performed size operations. Returns the number of operations actually
+    // performed. The number of successful pops is returned in hits.
+    template<typename Push, typename TryPop>
+    size_t runQueueWorkload(size_t size, size_t thread_count, Push push, TryPop try_pop, size_t& hits)
+    {
+        size_t pairs_per_thread = size / (2 * thread_count);
+        std::atomic<size_t> total_hits(0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back(
+                [=, &total_hits]()
+                {
+                    size_t thread_hits = 0;
+                    for (size_t i = 0; i < pairs_per_thread; ++i)
+                    {
+                        push(static_cast<int>(i));
+                        int value;
+                        if (try_pop(value))
+                        {
+                            ++thread_hits;
+                        }
+                    }
+                    total_hits += thread_hits;
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        hits = total_hits;
+        return (2 * pairs_per_thread * thread_count);
+    }
+
+    // Runs thread_count threads that repeatedly take an object from a recycler and give it back, until the threads
+    // together have performed size operations. Returns the number of operations actually performed. The number of
+    // times a thread got an object is returned in hits.
+    template<typename Get, typename Put>
+    size_t runRecyclingWorkload(size_t size, size_t thread_count, Get get, Put put, size_t& hits)
+    {
+        size_t pairs_per_thread = size / (2 * thread_count);
+        std::atomic<size_t> total_hits(0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back(
+                [=, &total_hits]()
+                {
+                    size_t thread_hits = 0;
+                    for (size_t i = 0; i < pairs_per_thread; ++i)
+                    {
+                        RecycledObject* object = get();
+                        if (object)
+                        {
+                            ++thread_hits;
+                            put(object);
+                        }
+                    }
+                    total_hits += thread_hits;
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        hits = total_hits;
+        return (2 * pairs_per_thread * thread_count);
+    }
+
+    std::string workloadName(size_t thread_count)
+    {
+        return ("mixed (" + std::to_string(thread_count) + " threads)");
+    }
+
+    std::string queueWorkloadName(size_t thread_count)
+    {
+        return ("push/pop (" + std::to_string(thread_count) + " threads)");
+    }
+
+    std::string recyclingWorkloadName(size_t thread_count)
+    {
+        return ("recycle (" + std::to_string(thread_count) + " threads)");
+    }
+}
+
+void ConcurrencyBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        ConcurrentSkipListThroughput(size, thread_count, report);
+        LockedSkipListThroughput(size, thread_count, report);
+    }
+    for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        ConcurrentQueueThroughput(size, thread_count, report);
+        LockedQueueThroughput(size, thread_count, report);
+    }
+    for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        ConcurrentStackThroughput(size, thread_count, report);
+        EliminationStackThroughput(size, thread_count, report);
+        LockedStackThroughput(size, thread_count, report);
+    }
+}
+
+void ConcurrencyBenchmarks::ConcurrentSkipListThroughput(size_t size, size_t thread_count, BenchmarkReport& report)
+{
+    // Prefill with every other key so that lookups hit half of the time
+    ConcurrentSkipList<int> list(randomLevel);
+    for (size_t i = 0; i < size; ++i)
+    {
+        list.insert(static_cast<int>(2 * i));
+    }
+
+    std::string operation = workloadName(thread_count);
+    size_t hits = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    size_t operations = runWorkload(size, thread_count,
+        [&list](int key) { return list.contains(key); },
+        [&list](int key) { list.insert(key); },
+        hits);
+    report.stop(measurement, "ConcurrentSkipList", operation.c_str(), size, operations, hits);
+}
+
+void ConcurrencyBenchmarks::LockedSkipListThroughput(size_t size, size_t thread_count, BenchmarkReport& report)
+{
+    SkipList<int> list;
+    for (size_t i = 0; i < size; ++i)
+    {
+        list.insert(static_cast<int>(2 * i));
+    }
+
+    std::mutex mutex;
+    std::string operation = workloadName(thread_count);
+    size_t hits = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    size_t operations = runWorkload(size, thread_count,
+        [&list, &mutex](int key)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return list.contains(key);
+        },
+        [&list, &mutex](int key)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            list.insert(key);
+        },
+        hits);
+    report.stop(measurement, "SkipList with mutex", operation.c_str(), size, operations, hits);
+}
+
+void ConcurrencyBenchmarks::ConcurrentQueueThroughput(size_t size, size_t thread_count, BenchmarkReport& report)
+{
+    ConcurrentQueue<int> queue;
+    std::string operation = queueWorkloadName(thread_count);
+    size_t hits = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    size_t operations = runQueueWorkload(size, thread_count,
+        [&queue](int value) { queue.push(value); },
+        [&queue](int& value) { return queue.tryPop(value); },
+        hits);
+    report.stop(measurement, "ConcurrentQueue", operation.c_str(), size, operations, hits);
+}
+
+void ConcurrencyBenchmarks::LockedQueueThroughput(size_t size, size_t thread_count, BenchmarkReport& report)
+{
+    DoublyLinkedList<int> list;
+    std::mutex mutex;
+    std::string operation = queueWorkloadName(thread_count);
+    size_t hits = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    size_t operations = runQueueWorkload(size, thread_count,
+        [&list, &mutex](int value)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            list.pushBack(value);
+        },
+        [&list, &mutex](int& value)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (list.isEmpty())
+            {
+                return false;
+            }
+            value = list.head()->data();
+            list.popFront();
+            return true;
+        },
+        hits);
+    report.stop(measurement, "DoublyLinkedList with mutex", operation.c_str(), size, operations, hits);
+}
+
+void ConcurrencyBenchmarks::ConcurrentStackThroughput(size_t size, size_t thread_count, BenchmarkReport& report)
+{
+    std::vector<RecycledObject> objects(recycled_object_count);
+    ConcurrentStack<RecycledObject> stack;
+    for (RecycledObject& object : objects)
+    {
+        stack.push(&object);
+    }
+
+    std::string operation = recyclingWorkloadName(thread_count);
+    size_t hits = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    size_t operations = runRecyclingWorkload(size, thread_count,
+        [&stack]() { return stack.pop(); },
+        [&stack](RecycledObject* object) { stack.push(object); },
+        hits);
+    report.stop(measurement, "ConcurrentStack", operation.c_str(), size, operations, hits);
+}
+
+void ConcurrencyBenchmarks::EliminationStackThroughput(size_t size, size_t thread_count, BenchmarkReport& report)
+{
+    std::vector<RecycledObject> objects(recycled_object_count);
+    ConcurrentStack<RecycledObject, void, 8> stack;
+    for (RecycledObject& object : objects)
+    {
+        stack.push(&object);
+    }
+
+    std::string operation = recyclingWorkloadName(thread_count);
+    size_t hits = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    size_t operations = runRecyclingWorkload(size, thread_count,
+        [&stack]() { return stack.pop(); },
+        [&stack](RecycledObject* object) { stack.push(object); },
+        hits);
+    report.stop(measurement, "ConcurrentStack with elimination", operation.c_str(), size, operations, hits);
+}
+
+void ConcurrencyBenchmarks::LockedStackThroughput(size_t size, size_t thread_count, BenchmarkReport& report)
+{
+    std::vector<RecycledObject> objects(recycled_object_count);
+    IntrusiveSinglyLinkedList<RecycledObject> list;
+    for (RecycledObject& object : objects)
+    {
+        list.pushFront(&object);
+    }
+
+    std::mutex mutex;
+    std::string operation = recyclingWorkloadName(thread_count);
+    size_t hits = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    size_t operations = runRecyclingWorkload(size, thread_count,
+        [&list, &mutex]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return list.popFront();
+        },
+        [&list, &mutex](RecycledObject* object)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            list.pushFront(object);
+        },
+        hits);
+    report.stop(measurement, "IntrusiveSinglyLinkedList with mutex", operation.c_str(), size, operations, hits);
+}
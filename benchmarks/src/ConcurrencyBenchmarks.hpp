@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_CONCURRENCYBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_CONCURRENCYBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+
+// Measures the throughput of a mixed lookup and update workload, of a producer-consumer queue workload and of an
+// object recycling workload run by a growing number of threads.
+class ConcurrencyBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    static void ConcurrentSkipListThroughput(size_t size, size_t thread_count, BenchmarkReport& report);
+    static void LockedSkipListThroughput(size_t size, size_t thread_count, BenchmarkReport& report);
+    static void ConcurrentQueueThroughput(size_t size, size_t thread_count, BenchmarkReport& report);
+    static void LockedQueueThroughput(size_t size, size_t thread_count, BenchmarkReport& report);
+    static void ConcurrentStackThroughput(size_t size, size_t thread_count, BenchmarkReport& report);
+    static void EliminationStackThroughput(size_t size, size_t thread_count, BenchmarkReport& report);
+    static void LockedStackThroughput(size_t size, size_t thread_count, BenchmarkReport& report);
+};
+
+#endif
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ConstructionBenchmarks.hpp"
+#include "Ishiko/DataStructures/ArenaAllocator.hpp"
+#include "Ishiko/DataStructures/BPlusTree.hpp"
+#include "Ishiko/DataStructures/PoolAllocator.hpp"
+#include "Ishiko/DataStructures/SkipList.hpp"
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    std::vector<int> sortedValues(size_t size)
+    {
+        std::vector<int> values;
+        values.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            values.push_back(static_cast<int>(i));
+        }
+        return values;
+    }
+
+    // Strings too long for the small string optimization so that copying one allocates
+    std::vector<std::string> sortedStrings(size_t size)
+    {
+        std::vector<std::string> values;
+        values.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            std::string digits = std::to_string(i);
+            values.push_back(std::string(40 - digits.size(), '0') + digits);
+        }
+        return values;
+    }
+}
+
+void ConstructionBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    SkipListRepeatedInsert(size, report);
+    SkipListBulkLoad(size, report);
+    SkipListAllocatorConstruction<ArenaAllocator>("SkipList<int, ArenaAllocator>", size, report);
+    SkipListAllocatorConstruction<PoolAllocator>("SkipList<int, PoolAllocator>", size, report);
+    SkipListStringInsert(size, report);
+    BPlusTreeRepeatedInsert(size, report);
+    BPlusTreeBulkLoad(size, report);
+}
+
+void ConstructionBenchmarks::SkipListRepeatedInsert(size_t size, BenchmarkReport& report)
+{
+    std::vector<int> values = sortedValues(size);
+
+    BenchmarkReport::Measurement measurement = report.start();
+    SkipList<int> list;
+    for (int value : values)
+    {
+        list.insert(value);
+    }
+    report.stop(measurement, "SkipList", "insert", size, size, 0);
+}
+
+void ConstructionBenchmarks::SkipListBulkLoad(size_t size, BenchmarkReport& report)
+{
+    std::vector<int> values = sortedValues(size);
+
+    BenchmarkReport::Measurement measurement = report.start();
+    {
+        SkipList<int> list(values.begin(), values.end());
+        report.stop(measurement, "SkipList", "bulk load (sampled heights)", size, size, 0);
+    }
+
+    measurement = report.start();
+    {
+        SkipList<int> list(values.begin(), values.end(), SkipList<int>::BulkLoadHeights::deterministic);
+        report.stop(measurement, "SkipList", "bulk load (deterministic heights)", size, size, 0);
+    }
+}
+
+template<typename Allocator>
+void ConstructionBenchmarks::SkipListAllocatorConstruction(const char* name, size_t size, BenchmarkReport& report)
+{
+    typedef SkipList<int, std::less<int>, GeometricLevelGenerator<>, Allocator> List;
+
+    std::vector<int> values = sortedValues(size);
+
+    BenchmarkReport::Measurement measurement = report.start();
+    {
+        List list;
+        for (int value : values)
+        {
+            list.insert(value);
+        }
+        report.stop(measurement, name, "insert", size, size, 0);
+    }
+
+    measurement = report.start();
+    {
+        List list(values.begin(), values.end());
+        report.stop(measurement, name, "bulk load (sampled heights)", size, size, 0);
+    }
+
+    measurement = report.start();
+    {
+        List list(values.begin(), values.end(), List::BulkLoadHeights::deterministic);
+        report.stop(measurement, name, "bulk load (deterministic heights)", size, size, 0);
+    }
+}
+
+void ConstructionBenchmarks::SkipListStringInsert(size_t size, BenchmarkReport& report)
+{
+    // Each string holds its own heap buffer so the size is capped to keep the memory use reasonable
+    size = std::min(size, static_cast<size_t>(1000000));
+    std::vector<std::string> values = sortedStrings(size);
+
+    BenchmarkReport::Measurement measurement = report.start();
+    {
+        SkipList<std::string> list;
+        for (const std::string& value : values)
+        {
+            list.insert(value);
+        }
+        report.stop(measurement, "SkipList<std::string>", "insert (copy)", size, size, 0);
+    }
+
+    measurement = report.start();
+    {
+        SkipList<std::string> list;
+        for (std::string& value : values)
+        {
+            list.insert(std::move(value));
+        }
+        report.stop(measurement, "SkipList<std::string>", "insert (move)", size, size, 0);
+    }
+}
+
+void ConstructionBenchmarks::BPlusTreeRepeatedInsert(size_t size, BenchmarkReport& report)
+{
+    std::vector<int> values = sortedValues(size);
+
+    BenchmarkReport::Measurement measurement = report.start();
+    BPlusTree<int> tree;
+    for (int value : values)
+    {
+        tree.insert(value);
+    }
+    report.stop(measurement, "BPlusTree", "insert", size, size, 0);
+}
+
+void ConstructionBenchmarks::BPlusTreeBulkLoad(size_t size, BenchmarkReport& report)
+{
+    std::vector<int> values = sortedValues(size);
+
+    BenchmarkReport::Measurement measurement = report.start();
+    BPlusTree<int> tree(values.begin(), values.end());
+    report.stop(measurement, "BPlusTree", "bulk load", size, size, 0);
+}
@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_CONSTRUCTIONBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_CONSTRUCTIONBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+
+// Measures how long it takes to build containers from sorted input of a given number of elements.
+class ConstructionBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    static void SkipListRepeatedInsert(size_t size, BenchmarkReport& report);
+    static void SkipListBulkLoad(size_t size, BenchmarkReport& report);
+    // Repeated insert and bulk load with a node allocator that supports reserve
+    template<typename Allocator>
+    static void SkipListAllocatorConstruction(const char* name, size_t size, BenchmarkReport& report);
+    static void SkipListStringInsert(size_t size, BenchmarkReport& report);
+    static void BPlusTreeRepeatedInsert(size_t size, BenchmarkReport& report);
+    static void BPlusTreeBulkLoad(size_t size, BenchmarkReport& report);
+};
+
+#endif
@@ -0,0 +1,397 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ContainerBenchmarks.hpp"
+#include "Ishiko/DataStructures/BPlusTree.hpp"
+#include "Ishiko/DataStructures/CompactDoublyLinkedList.hpp"
+#include "Ishiko/DataStructures/DoublyLinkedList.hpp"
+#include "Ishiko/DataStructures/DynamicArray.hpp"
+#include "Ishiko/DataStructures/RedBlackTree.hpp"
+#include "Ishiko/DataStructures/SinglyLinkedList.hpp"
+#include "Ishiko/DataStructures/SkipList.hpp"
+#include "Ishiko/DataStructures/UnrolledSinglyLinkedList.hpp"
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+
+using namespace Ishiko;
+
+namespace
+{
+    // One update for every update_ratio - 1 lookups in the mixed workload
+    const size_t update_ratio = 10;
+    // Each string holds its own heap buffer so the std::string workloads are capped to keep the memory use reasonable
+    const size_t max_string_count = 1000000;
+
+    // A key/value pair ordered by key only. The sets store these to be compared with std::map<int, int>.
+    struct Entry
+    {
+        int key;
+        int value;
+    };
+
+    bool operator<(const Entry& entry1, const Entry& entry2)
+    {
+        return (entry1.key < entry2.key);
+    }
+
+    // Multiplying by an odd constant is a bijection on 32 bit integers so the keys are distinct but spread randomly
+    std::vector<int> makeKeys(size_t size)
+    {
+        std::vector<int> keys;
+        keys.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            keys.push_back(static_cast<int>(static_cast<uint32_t>(i) * 2654435761u));
+        }
+        return keys;
+    }
+
+    // Strings too long for the small string optimization so that copying one allocates
+    std::vector<std::string> makeStrings(const std::vector<int>& keys)
+    {
+        std::vector<std::string> strings;
+        strings.reserve(keys.size());
+        for (int key : keys)
+        {
+            std::string digits = std::to_string(static_cast<uint32_t>(key));
+            strings.push_back(std::string(40 - digits.size(), '0') + digits);
+        }
+        return strings;
+    }
+
+    std::vector<Entry> makeEntries(const std::vector<int>& keys)
+    {
+        std::vector<Entry> entries;
+        entries.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            Entry entry = { keys[i], static_cast<int>(i) };
+            entries.push_back(entry);
+        }
+        return entries;
+    }
+
+    // The lookups visit the values in a different order than the inserts. The sizes are powers of 10 so stepping
+    // through the indices by a number coprime with 10 visits each of them once.
+    template<typename Value>
+    std::vector<Value> permute(const std::vector<Value>& values)
+    {
+        std::vector<Value> permuted_values;
+        permuted_values.reserve(values.size());
+        for (uint64_t i = 0; i < values.size(); ++i)
+        {
+            permuted_values.push_back(values[(i * 40503) % values.size()]);
+        }
+        return permuted_values;
+    }
+
+    // Gives the containers the same interface so the workloads can be written once
+    template<typename DataType>
+    void append(SinglyLinkedList<DataType>& list, const std::vector<DataType>& values)
+    {
+        typename SinglyLinkedList<DataType>::Node* last_node = nullptr;
+        for (const DataType& value : values)
+        {
+            if (last_node)
+            {
+                last_node = list.insert(value, last_node);
+            }
+            else
+            {
+                list.setHead(value);
+                last_node = list.head();
+            }
+        }
+    }
+
+    template<typename DataType>
+    void append(UnrolledSinglyLinkedList<DataType>& list, const std::vector<DataType>& values)
+    {
+        typename UnrolledSinglyLinkedList<DataType>::Iterator last_value = list.end();
+        for (const DataType& value : values)
+        {
+            if (last_value != list.end())
+            {
+                last_value = list.insert(value, last_value);
+            }
+            else
+            {
+                list.setHead(value);
+                last_value = list.begin();
+            }
+        }
+    }
+
+    template<typename DataType>
+    void append(DoublyLinkedList<DataType>& list, const std::vector<DataType>& values)
+    {
+        for (const DataType& value : values)
+        {
+            list.pushBack(value);
+        }
+    }
+
+    template<typename DataType>
+    void append(CompactDoublyLinkedList<DataType>& list, const std::vector<DataType>& values)
+    {
+        for (const DataType& value : values)
+        {
+            list.pushBack(value);
+        }
+    }
+
+    template<typename DataType>
+    void append(DynamicArray<DataType>& array, const std::vector<DataType>& values)
+    {
+        for (const DataType& value : values)
+        {
+            array.pushBack(value);
+        }
+    }
+
+    template<typename Container, typename DataType>
+    void append(Container& container, const std::vector<DataType>& values)
+    {
+        for (const DataType& value : values)
+        {
+            container.push_back(value);
+        }
+    }
+
+    template<typename Container, typename DataType>
+    void insert(Container& container, const DataType& value)
+    {
+        container.insert(value);
+    }
+
+    void insert(std::map<int, int>& map, const Entry& entry)
+    {
+        map.insert(std::make_pair(entry.key, entry.value));
+    }
+
+    template<typename Container, typename DataType>
+    bool contains(const Container& container, const DataType& value)
+    {
+        return container.contains(value);
+    }
+
+    template<typename DataType>
+    bool contains(const std::set<DataType>& set, const DataType& value)
+    {
+        return (set.find(value) != set.end());
+    }
+
+    bool contains(const std::map<int, int>& map, const Entry& entry)
+    {
+        return (map.find(entry.key) != map.end());
+    }
+
+    template<typename Container, typename DataType>
+    bool erase(Container& container, const DataType& value)
+    {
+        return container.erase(value);
+    }
+
+    template<typename DataType>
+    bool erase(std::set<DataType>& set, const DataType& value)
+    {
+        return (set.erase(value) != 0);
+    }
+
+    bool erase(std::map<int, int>& map, const Entry& entry)
+    {
+        return (map.erase(entry.key) != 0);
+    }
+
+    size_t checksum(int value)
+    {
+        return static_cast<size_t>(value);
+    }
+
+    size_t checksum(const std::string& value)
+    {
+        return (value.size() + static_cast<unsigned char>(value.back()));
+    }
+
+    size_t checksum(const Entry& entry)
+    {
+        return static_cast<size_t>(entry.value);
+    }
+
+    size_t checksum(const std::pair<const int, int>& entry)
+    {
+        return static_cast<size_t>(entry.second);
+    }
+
+    template<typename Container>
+    size_t sumValues(const Container& container)
+    {
+        size_t sum = 0;
+        for (const auto& value : container)
+        {
+            sum += checksum(value);
+        }
+        return sum;
+    }
+
+    template<typename DataType>
+    size_t sumValues(const SinglyLinkedList<DataType>& list)
+    {
+        size_t sum = 0;
+        list.traverse([&sum](const DataType& value) { sum += checksum(value); });
+        return sum;
+    }
+
+    template<typename DataType>
+    size_t sumValues(const UnrolledSinglyLinkedList<DataType>& list)
+    {
+        size_t sum = 0;
+        list.traverse([&sum](const DataType& value) { sum += checksum(value); });
+        return sum;
+    }
+
+    template<typename DataType>
+    size_t sumValues(const DoublyLinkedList<DataType>& list)
+    {
+        size_t sum = 0;
+        list.traverse([&sum](const DataType& value) { sum += checksum(value); });
+        return sum;
+    }
+
+    template<typename DataType>
+    size_t sumValues(const CompactDoublyLinkedList<DataType>& list)
+    {
+        size_t sum = 0;
+        list.traverse([&sum](const DataType& value) { sum += checksum(value); });
+        return sum;
+    }
+}
+
+void ContainerBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    for (size_t n = 1000; n <= size; n *= 10)
+    {
+        // The containers are filled with the first half of the keys, the mixed workload inserts the second half
+        std::vector<int> keys = makeKeys(2 * n);
+        std::vector<int> values(keys.begin(), keys.begin() + n);
+        std::vector<int> new_values(keys.begin() + n, keys.end());
+
+        SequenceWorkloads<SinglyLinkedList<int>>("SinglyLinkedList<int>", values, report);
+        SequenceWorkloads<UnrolledSinglyLinkedList<int>>("UnrolledSinglyLinkedList<int>", values, report);
+        SequenceWorkloads<DoublyLinkedList<int>>("DoublyLinkedList<int>", values, report);
+        SequenceWorkloads<CompactDoublyLinkedList<int>>("CompactDoublyLinkedList<int>", values, report);
+        SequenceWorkloads<std::list<int>>("std::list<int>", values, report);
+        SequenceWorkloads<DynamicArray<int>>("DynamicArray<int>", values, report);
+        SequenceWorkloads<std::vector<int>>("std::vector<int>", values, report);
+
+        OrderedWorkloads<SkipList<int>>("SkipList<int>", values, new_values, report);
+        OrderedWorkloads<RedBlackTree<int>>("RedBlackTree<int>", values, new_values, report);
+        OrderedWorkloads<BPlusTree<int>>("BPlusTree<int>", values, new_values, report);
+        OrderedWorkloads<std::set<int>>("std::set<int>", values, new_values, report);
+
+        std::vector<Entry> entries = makeEntries(values);
+        std::vector<Entry> new_entries = makeEntries(new_values);
+        OrderedWorkloads<SkipList<Entry>>("SkipList<Entry>", entries, new_entries, report);
+        OrderedWorkloads<RedBlackTree<Entry>>("RedBlackTree<Entry>", entries, new_entries, report);
+        OrderedWorkloads<BPlusTree<Entry>>("BPlusTree<Entry>", entries, new_entries, report);
+        OrderedWorkloads<std::map<int, int>>("std::map<int, int>", entries, new_entries, report);
+
+        if (n <= max_string_count)
+        {
+            std::vector<std::string> strings = makeStrings(values);
+            std::vector<std::string> new_strings = makeStrings(new_values);
+
+            SequenceWorkloads<SinglyLinkedList<std::string>>("SinglyLinkedList<std::string>", strings, report);
+            SequenceWorkloads<UnrolledSinglyLinkedList<std::string>>("UnrolledSinglyLinkedList<std::string>",
+                strings, report);
+            SequenceWorkloads<DoublyLinkedList<std::string>>("DoublyLinkedList<std::string>", strings, report);
+            SequenceWorkloads<std::list<std::string>>("std::list<std::string>", strings, report);
+            SequenceWorkloads<DynamicArray<std::string>>("DynamicArray<std::string>", strings, report);
+            SequenceWorkloads<std::vector<std::string>>("std::vector<std::string>", strings, report);
+
+            OrderedWorkloads<SkipList<std::string>>("SkipList<std::string>", strings, new_strings, report);
+            OrderedWorkloads<RedBlackTree<std::string>>("RedBlackTree<std::string>", strings, new_strings, report);
+            OrderedWorkloads<BPlusTree<std::string>>("BPlusTree<std::string>", strings, new_strings, report);
+            OrderedWorkloads<std::set<std::string>>("std::set<std::string>", strings, new_strings, report);
+        }
+    }
+}
+
+template<typename Container, typename Value>
+void ContainerBenchmarks::SequenceWorkloads(const char* name, const std::vector<Value>& values,
+    BenchmarkReport& report)
+{
+    std::unique_ptr<Container> container(new Container());
+
+    BenchmarkReport::Measurement measurement = report.start();
+    append(*container, values);
+    report.stop(measurement, name, "append", values.size(), values.size(), 0);
+
+    measurement = report.start();
+    size_t sum = sumValues(*container);
+    report.stop(measurement, name, "traversal", values.size(), values.size(), sum);
+
+    // The container is destroyed rather than cleared so that the memory std::vector::clear keeps is included
+    measurement = report.start();
+    container.reset();
+    report.stop(measurement, name, "teardown", values.size(), values.size(), 0);
+}
+
+template<typename Container, typename Value>
+void ContainerBenchmarks::OrderedWorkloads(const char* name, const std::vector<Value>& values,
+    const std::vector<Value>& new_values, BenchmarkReport& report)
+{
+    std::vector<Value> lookup_values = permute(values);
+    std::unique_ptr<Container> container(new Container());
+
+    BenchmarkReport::Measurement measurement = report.start();
+    for (const Value& value : values)
+    {
+        insert(*container, value);
+    }
+    report.stop(measurement, name, "insert", values.size(), values.size(), 0);
+
+    size_t hits = 0;
+    measurement = report.start();
+    for (const Value& value : lookup_values)
+    {
+        if (contains(*container, value))
+        {
+            ++hits;
+        }
+    }
+    report.stop(measurement, name, "lookup", values.size(), lookup_values.size(), hits);
+
+    measurement = report.start();
+    size_t sum = sumValues(*container);
+    report.stop(measurement, name, "traversal", values.size(), values.size(), sum);
+
+    // An update replaces an element with a new one so the size of the container doesn't change
+    hits = 0;
+    measurement = report.start();
+    for (size_t i = 0; i < lookup_values.size(); ++i)
+    {
+        if ((i % update_ratio) == 0)
+        {
+            if (erase(*container, lookup_values[i]))
+            {
+                ++hits;
+            }
+            insert(*container, new_values[i]);
+        }
+        else if (contains(*container, lookup_values[i]))
+        {
+            ++hits;
+        }
+    }
+    report.stop(measurement, name, "mixed", values.size(), lookup_values.size(), hits);
+
+    measurement = report.start();
+    container.reset();
+    report.stop(measurement, name, "teardown", values.size(), values.size(), 0);
+}
@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_CONTAINERBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_CONTAINERBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+#include <vector>
+
+// Compares the containers with their standard library counterparts. The linked lists and DynamicArray are compared
+// with std::list and std::vector on appends, traversals and teardown. SkipList, RedBlackTree and BPlusTree are
+// compared with std::set, and with std::map for key/value entries, on inserts, lookups, traversals, a mix of lookups
+// and updates, and teardown. The workloads run with int and std::string values for every power of 10 from 1000 up to
+// the given number of elements.
+class ContainerBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    template<typename Container, typename Value>
+    static void SequenceWorkloads(const char* name, const std::vector<Value>& values, BenchmarkReport& report);
+    template<typename Container, typename Value>
+    static void OrderedWorkloads(const char* name, const std::vector<Value>& values,
+        const std::vector<Value>& new_values, BenchmarkReport& report);
+};
+
+#endif
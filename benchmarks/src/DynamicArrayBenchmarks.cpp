@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "DynamicArrayBenchmarks.hpp"
+#include "Ishiko/DataStructures/DynamicArray.hpp"
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    // The number of values erased from the middle of the array, each erase moves half of the array
+    const size_t erase_count = 1000;
+    // The number of values in each of the short arrays
+    const size_t short_array_size = 4;
+
+    // Gives the containers the same interface so the benchmarks can be written once
+    template<typename DataType>
+    void pushBack(DynamicArray<DataType>& array, const DataType& value)
+    {
+        array.pushBack(value);
+    }
+
+    template<typename DataType>
+    void pushBack(std::vector<DataType>& vector, const DataType& value)
+    {
+        vector.push_back(value);
+    }
+
+    template<typename DataType>
+    void erase(DynamicArray<DataType>& array, size_t index)
+    {
+        array.erase(index);
+    }
+
+    template<typename DataType>
+    void erase(std::vector<DataType>& vector, size_t index)
+    {
+        vector.erase(vector.begin() + index);
+    }
+}
+
+void DynamicArrayBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    PushBack<DynamicArray<int>>("DynamicArray", size, report);
+    PushBack<std::vector<int>>("std::vector", size, report);
+    ReservePushBack<DynamicArray<int>>("DynamicArray", size, report);
+    ReservePushBack<std::vector<int>>("std::vector", size, report);
+    StringPushBack<DynamicArray<std::string>>("DynamicArray", size / 10, report);
+    StringPushBack<std::vector<std::string>>("std::vector", size / 10, report);
+    Erase<DynamicArray<int>>("DynamicArray", size, report);
+    Erase<std::vector<int>>("std::vector", size, report);
+    ShortArrays<DynamicArray<int>>("DynamicArray", size / short_array_size, report);
+    ShortArrays<std::vector<int>>("std::vector", size / short_array_size, report);
+}
+
+template<typename Container>
+void DynamicArrayBenchmarks::PushBack(const char* name, size_t size, BenchmarkReport& report)
+{
+    BenchmarkReport::Measurement measurement = report.start();
+    Container container;
+    for (size_t i = 0; i < size; ++i)
+    {
+        pushBack(container, static_cast<int>(i));
+    }
+    report.stop(measurement, name, "push back", size, size, container.size());
+}
+
+template<typename Container>
+void DynamicArrayBenchmarks::ReservePushBack(const char* name, size_t size, BenchmarkReport& report)
+{
+    BenchmarkReport::Measurement measurement = report.start();
+    Container container;
+    container.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        pushBack(container, static_cast<int>(i));
+    }
+    report.stop(measurement, name, "reserve and push back", size, size, container.size());
+}
+
+template<typename Container>
+void DynamicArrayBenchmarks::StringPushBack(const char* name, size_t size, BenchmarkReport& report)
+{
+    const std::string value(32, 'x');
+
+    BenchmarkReport::Measurement measurement = report.start();
+    Container container;
+    for (size_t i = 0; i < size; ++i)
+    {
+        pushBack(container, value);
+    }
+    report.stop(measurement, name, "string push back", size, size, container.size());
+}
+
+template<typename Container>
+void DynamicArrayBenchmarks::Erase(const char* name, size_t size, BenchmarkReport& report)
+{
+    Container container;
+    for (size_t i = 0; i < size; ++i)
+    {
+        pushBack(container, static_cast<int>(i));
+    }
+
+    size_t erases = ((size < erase_count) ? size : erase_count);
+    BenchmarkReport::Measurement measurement = report.start();
+    for (size_t i = 0; i < erases; ++i)
+    {
+        erase(container, container.size() / 2);
+    }
+    report.stop(measurement, name, "erase", size, erases, container[container.size() / 2]);
+}
+
+template<typename Container>
+void DynamicArrayBenchmarks::ShortArrays(const char* name, size_t size, BenchmarkReport& report)
+{
+    size_t checksum = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    for (size_t i = 0; i < size; ++i)
+    {
+        Container container;
+        for (size_t j = 0; j < short_array_size; ++j)
+        {
+            pushBack(container, static_cast<int>(i + j));
+        }
+        checksum += container[short_array_size - 1];
+    }
+    report.stop(measurement, name, "short arrays", short_array_size, size, checksum);
+}
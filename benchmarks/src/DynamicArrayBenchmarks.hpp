@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_DYNAMICARRAYBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_DYNAMICARRAYBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+
+// Compares DynamicArray with std::vector on appends with and without reserving the capacity first, erases and the
+// creation of many short arrays that fit in the inline storage.
+class DynamicArrayBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    template<typename Container>
+    static void PushBack(const char* name, size_t size, BenchmarkReport& report);
+    template<typename Container>
+    static void ReservePushBack(const char* name, size_t size, BenchmarkReport& report);
+    template<typename Container>
+    static void StringPushBack(const char* name, size_t size, BenchmarkReport& report);
+    template<typename Container>
+    static void Erase(const char* name, size_t size, BenchmarkReport& report);
+    template<typename Container>
+    static void ShortArrays(const char* name, size_t size, BenchmarkReport& report);
+};
+
+#endif
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ListTraversalBenchmarks.hpp"
+#include "Ishiko/DataStructures/SinglyLinkedList.hpp"
+#include "Ishiko/DataStructures/UnrolledSinglyLinkedList.hpp"
+
+using namespace Ishiko;
+
+namespace
+{
+    // Gives both lists the same interface to walk the values and insert after one of them. A position is a node for
+    // SinglyLinkedList and an iterator for UnrolledSinglyLinkedList.
+    SinglyLinkedList<int>::Node* first(SinglyLinkedList<int>& list)
+    {
+        return list.head();
+    }
+
+    SinglyLinkedList<int>::Node* next(SinglyLinkedList<int>&, SinglyLinkedList<int>::Node* node)
+    {
+        return node->nextNode();
+    }
+
+    bool isEnd(SinglyLinkedList<int>&, SinglyLinkedList<int>::Node* node)
+    {
+        return (node == nullptr);
+    }
+
+    UnrolledSinglyLinkedList<int>::Iterator first(UnrolledSinglyLinkedList<int>& list)
+    {
+        return list.begin();
+    }
+
+    UnrolledSinglyLinkedList<int>::Iterator next(UnrolledSinglyLinkedList<int>&,
+        UnrolledSinglyLinkedList<int>::Iterator it)
+    {
+        return ++it;
+    }
+
+    bool isEnd(UnrolledSinglyLinkedList<int>& list, UnrolledSinglyLinkedList<int>::Iterator it)
+    {
+        return (it == list.end());
+    }
+
+    template<typename List>
+    void buildByAppending(List& list, size_t size)
+    {
+        list.setHead(0);
+        auto position = first(list);
+        for (size_t i = 1; i < size; ++i)
+        {
+            position = list.insert(static_cast<int>(i), position);
+        }
+    }
+
+    // Each pass doubles the size of the list so the values inserted by a pass end up between values inserted by all
+    // the passes before it
+    template<typename List>
+    void buildByInterleaving(List& list, size_t size)
+    {
+        list.setHead(0);
+        size_t count = 1;
+        while (count < size)
+        {
+            auto position = first(list);
+            while (!isEnd(list, position) && (count < size))
+            {
+                position = list.insert(static_cast<int>(count), position);
+                position = next(list, position);
+                ++count;
+            }
+        }
+    }
+
+    template<typename List>
+    size_t sumValues(const List& list)
+    {
+        size_t sum = 0;
+        list.traverse([&sum](int value) { sum += static_cast<size_t>(value); });
+        return sum;
+    }
+}
+
+void ListTraversalBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    for (size_t n = 1000; n <= size; n *= 10)
+    {
+        Traversal<SinglyLinkedList<int>>("SinglyLinkedList<int>", n, report);
+        Traversal<UnrolledSinglyLinkedList<int>>("UnrolledSinglyLinkedList<int>", n, report);
+    }
+}
+
+template<typename List>
+void ListTraversalBenchmarks::Traversal(const char* name, size_t size, BenchmarkReport& report)
+{
+    {
+        List list;
+        buildByAppending(list, size);
+
+        BenchmarkReport::Measurement measurement = report.start();
+        size_t sum = sumValues(list);
+        report.stop(measurement, name, "traversal (appended)", size, size, sum);
+    }
+
+    {
+        List list;
+        buildByInterleaving(list, size);
+
+        BenchmarkReport::Measurement measurement = report.start();
+        size_t sum = sumValues(list);
+        report.stop(measurement, name, "traversal (interleaved)", size, size, sum);
+    }
+}
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_LISTTRAVERSALBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_LISTTRAVERSALBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+
+// Compares the traversal of SinglyLinkedList, which follows one link per value, with UnrolledSinglyLinkedList, which
+// follows one link per chunk of values. Each list is traversed twice: once built by appending, which allocates the
+// nodes in order so that consecutive values usually end up next to each other in memory, and once built by passes
+// that insert a new value after every value already in the list, which leaves consecutive values in nodes allocated
+// far apart like in a list that has been edited for a while.
+class ListTraversalBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    template<typename List>
+    static void Traversal(const char* name, size_t size, BenchmarkReport& report);
+};
+
+#endif
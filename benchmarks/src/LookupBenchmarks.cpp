@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "LookupBenchmarks.hpp"
+#include "Ishiko/DataStructures/SkipList.hpp"
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    // The keys looked up are this many elements apart
+    const size_t key_gap = 4;
+
+    void fill(SkipList<int>& list, size_t size)
+    {
+        std::vector<int> values;
+        values.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            values.push_back(static_cast<int>(i));
+        }
+        for (int value : values)
+        {
+            list.insert(value);
+        }
+    }
+}
+
+void LookupBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    SkipListSequentialLookup(size, report);
+    SkipListSequentialFingerLookup(size, report);
+}
+
+void LookupBenchmarks::SkipListSequentialLookup(size_t size, BenchmarkReport& report)
+{
+    SkipList<int> list;
+    fill(list, size);
+
+    size_t lookups = 0;
+    size_t hits = 0;
+    BenchmarkReport::Measurement measurement = report.start();
+    for (size_t key = 0; key < size; key += key_gap)
+    {
+        SkipList<int>::Node* node = list.lowerBound(static_cast<int>(key));
+        if (node && (node->data() == static_cast<int>(key)))
+        {
+            ++hits;
+        }
+        ++lookups;
+    }
+    report.stop(measurement, "SkipList", "lowerBound", size, lookups, hits);
+}
+
+void LookupBenchmarks::SkipListSequentialFingerLookup(size_t size, BenchmarkReport& report)
+{
+    SkipList<int> list;
+    fill(list, size);
+
+    size_t lookups = 0;
+    size_t hits = 0;
+    SkipList<int>::Node* finger = nullptr;
+    BenchmarkReport::Measurement measurement = report.start();
+    for (size_t key = 0; key < size; key += key_gap)
+    {
+        SkipList<int>::Node* node = list.lowerBound(static_cast<int>(key), finger);
+        if (node)
+        {
+            if (node->data() == static_cast<int>(key))
+            {
+                ++hits;
+            }
+            finger = node;
+        }
+        ++lookups;
+    }
+    report.stop(measurement, "SkipList", "lowerBound with finger", size, lookups, hits);
+}
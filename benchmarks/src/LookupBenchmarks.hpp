@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_LOOKUPBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_LOOKUPBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+
+// Measures lookups of increasing keys close to each other in containers of a given number of elements.
+class LookupBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    static void SkipListSequentialLookup(size_t size, BenchmarkReport& report);
+    static void SkipListSequentialFingerLookup(size_t size, BenchmarkReport& report);
+};
+
+#endif
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "OrderedSetImageBenchmarks.hpp"
+#include "Ishiko/DataStructures/OrderedSetImage.hpp"
+#include "Ishiko/DataStructures/SkipList.hpp"
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    // Visits every key in [0, size) once in a scattered order, 2654435761 being coprime with any size that is not a
+    // multiple of one of its prime factors
+    int scatteredKey(size_t i, size_t size)
+    {
+        return static_cast<int>((static_cast<uint64_t>(i) * 2654435761ull) % size);
+    }
+}
+
+void OrderedSetImageBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    for (size_t n = 1000; n <= size; n *= 10)
+    {
+        SkipListVersusImage(n, report);
+    }
+}
+
+void OrderedSetImageBenchmarks::SkipListVersusImage(size_t size, BenchmarkReport& report)
+{
+    SkipList<int> list;
+    {
+        BenchmarkReport::Measurement measurement = report.start();
+        for (size_t i = 0; i < size; ++i)
+        {
+            list.insert(scatteredKey(i, size));
+        }
+        report.stop(measurement, "SkipList<int>", "load (insert)", size, size, list.isEmpty() ? 0 : 1);
+    }
+
+    std::string bytes;
+    {
+        std::ostringstream output;
+        BenchmarkReport::Measurement measurement = report.start();
+        OrderedSetImageWriter<int> writer(output);
+        writer.add(list.begin(), list.end());
+        writer.finish();
+        bytes = output.str();
+        report.stop(measurement, "OrderedSetImage<int>", "save", size, size, bytes.size());
+    }
+
+    // Stands in for the file mapped in memory
+    std::vector<uint64_t> mapped_image((bytes.size() + 7) / 8);
+    memcpy(mapped_image.data(), bytes.data(), bytes.size());
+
+    OrderedSetImage<int> image;
+    {
+        BenchmarkReport::Measurement measurement = report.start();
+        image = OrderedSetImage<int>(mapped_image.data(), bytes.size());
+        report.stop(measurement, "OrderedSetImage<int>", "load (open)", size, 1, image.size());
+    }
+
+    {
+        size_t hits = 0;
+        BenchmarkReport::Measurement measurement = report.start();
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (list.contains(scatteredKey(i, 2 * size)))
+            {
+                ++hits;
+            }
+        }
+        report.stop(measurement, "SkipList<int>", "random lookup", size, size, hits);
+    }
+
+    {
+        size_t hits = 0;
+        BenchmarkReport::Measurement measurement = report.start();
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (image.contains(scatteredKey(i, 2 * size)))
+            {
+                ++hits;
+            }
+        }
+        report.stop(measurement, "OrderedSetImage<int>", "random lookup", size, size, hits);
+    }
+}
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_ORDEREDSETIMAGEBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_ORDEREDSETIMAGEBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+
+// Compares getting a SkipList back by inserting all its elements again with writing it once to an OrderedSetImage
+// and opening the image, and compares the lookups in both.
+class OrderedSetImageBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    static void SkipListVersusImage(size_t size, BenchmarkReport& report);
+};
+
+#endif
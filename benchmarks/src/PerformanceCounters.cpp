@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PerformanceCounters.hpp"
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+const size_t PerformanceCounters::event_count;
+
+namespace
+{
+    const char* event_names[PerformanceCounters::event_count] =
+        { "cycles", "instructions", "cache_misses", "branch_misses" };
+
+#if defined(__linux__)
+    const uint64_t event_configs[PerformanceCounters::event_count] = { PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+    int openEvent(uint64_t config) noexcept
+    {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = config;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        // When there are more events than hardware counters the kernel multiplexes them, the times let us scale the
+        // counts back up
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // pid 0 and cpu -1 count the calling thread on whichever CPU it runs
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+
+    uint64_t readEvent(int descriptor) noexcept
+    {
+        uint64_t data[3];
+        if (::read(descriptor, data, sizeof(data)) != sizeof(data))
+        {
+            return 0;
+        }
+
+        uint64_t count = data[0];
+        uint64_t time_enabled = data[1];
+        uint64_t time_running = data[2];
+        if ((time_running != 0) && (time_running < time_enabled))
+        {
+            count = static_cast<uint64_t>(static_cast<double>(count) * time_enabled / time_running);
+        }
+        return count;
+    }
+#endif
+}
+
+PerformanceCounters::PerformanceCounters() noexcept
+{
+    for (size_t i = 0; i < event_count; ++i)
+    {
+#if defined(__linux__)
+        m_descriptors[i] = openEvent(event_configs[i]);
+#else
+        m_descriptors[i] = -1;
+#endif
+    }
+}
+
+PerformanceCounters::~PerformanceCounters()
+{
+#if defined(__linux__)
+    for (int descriptor : m_descriptors)
+    {
+        if (descriptor != -1)
+        {
+            close(descriptor);
+        }
+    }
+#endif
+}
+
+const char* PerformanceCounters::EventName(size_t event) noexcept
+{
+    return event_names[event];
+}
+
+bool PerformanceCounters::isAvailable(size_t event) const noexcept
+{
+    return (m_descriptors[event] != -1);
+}
+
+void PerformanceCounters::read(uint64_t (&values)[event_count]) const noexcept
+{
+    for (size_t i = 0; i < event_count; ++i)
+    {
+        values[i] = 0;
+#if defined(__linux__)
+        if (m_descriptors[i] != -1)
+        {
+            values[i] = readEvent(m_descriptors[i]);
+        }
+#endif
+    }
+}
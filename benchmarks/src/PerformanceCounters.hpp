@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_PERFORMANCECOUNTERS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_PERFORMANCECOUNTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Hardware event counters of the thread that created the object, read with perf_event_open on Linux. Only user space
+// events are counted so that the default perf_event_paranoid setting allows them. An event is unavailable on other
+// platforms, or when the kernel or the CPU doesn't support it, and then it always reads as 0.
+class PerformanceCounters
+{
+public:
+    enum Event
+    {
+        cycles,
+        instructions,
+        cache_misses,
+        branch_misses
+    };
+    static const size_t event_count = 4;
+
+    PerformanceCounters() noexcept;
+    PerformanceCounters(const PerformanceCounters& other) = delete;
+    PerformanceCounters& operator=(const PerformanceCounters& other) = delete;
+    ~PerformanceCounters();
+
+    static const char* EventName(size_t event) noexcept;
+
+    bool isAvailable(size_t event) const noexcept;
+    // The number of events counted since this object was created
+    void read(uint64_t (&values)[event_count]) const noexcept;
+
+private:
+    int m_descriptors[event_count];
+};
+
+#endif
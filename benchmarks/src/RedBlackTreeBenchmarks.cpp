@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "RedBlackTreeBenchmarks.hpp"
+#include "Ishiko/DataStructures/RedBlackTree.hpp"
+#include <cstdint>
+#include <set>
+
+using namespace Ishiko;
+
+namespace
+{
+    // Multiplying by an odd constant is a bijection on 32 bit integers so the keys are distinct but spread randomly
+    std::vector<int> makeKeys(size_t size)
+    {
+        std::vector<int> keys;
+        keys.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            keys.push_back(static_cast<int>(static_cast<uint32_t>(i) * 2654435761u));
+        }
+        return keys;
+    }
+
+    // The lookups and erases visit the keys in a different order than the inserts. The sizes are powers of 10 so
+    // stepping through the indices by a number coprime with 10 visits each of them once.
+    std::vector<int> permuteKeys(const std::vector<int>& keys)
+    {
+        std::vector<int> permuted_keys;
+        permuted_keys.reserve(keys.size());
+        for (uint64_t i = 0; i < keys.size(); ++i)
+        {
+            permuted_keys.push_back(keys[(i * 40503) % keys.size()]);
+        }
+        return permuted_keys;
+    }
+}
+
+void RedBlackTreeBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    for (size_t n = 1000; n <= size; n *= 10)
+    {
+        std::vector<int> keys = makeKeys(n);
+        RedBlackTreeOperations(keys, report);
+        SetOperations(keys, report);
+    }
+}
+
+void RedBlackTreeBenchmarks::RedBlackTreeOperations(const std::vector<int>& keys, BenchmarkReport& report)
+{
+    std::vector<int> lookup_keys = permuteKeys(keys);
+
+    RedBlackTree<int> tree;
+
+    BenchmarkReport::Measurement measurement = report.start();
+    for (int key : keys)
+    {
+        tree.insert(key);
+    }
+    report.stop(measurement, "RedBlackTree", "insert", keys.size(), keys.size(), tree.size());
+
+    size_t hits = 0;
+    measurement = report.start();
+    for (int key : lookup_keys)
+    {
+        if (tree.contains(key))
+        {
+            ++hits;
+        }
+    }
+    report.stop(measurement, "RedBlackTree", "lookup", keys.size(), lookup_keys.size(), hits);
+
+    hits = 0;
+    measurement = report.start();
+    for (int key : lookup_keys)
+    {
+        if (tree.erase(key))
+        {
+            ++hits;
+        }
+    }
+    report.stop(measurement, "RedBlackTree", "erase", keys.size(), lookup_keys.size(), hits);
+}
+
+void RedBlackTreeBenchmarks::SetOperations(const std::vector<int>& keys, BenchmarkReport& report)
+{
+    std::vector<int> lookup_keys = permuteKeys(keys);
+
+    std::set<int> set;
+
+    BenchmarkReport::Measurement measurement = report.start();
+    for (int key : keys)
+    {
+        set.insert(key);
+    }
+    report.stop(measurement, "std::set", "insert", keys.size(), keys.size(), set.size());
+
+    size_t hits = 0;
+    measurement = report.start();
+    for (int key : lookup_keys)
+    {
+        if (set.find(key) != set.end())
+        {
+            ++hits;
+        }
+    }
+    report.stop(measurement, "std::set", "lookup", keys.size(), lookup_keys.size(), hits);
+
+    hits = 0;
+    measurement = report.start();
+    for (int key : lookup_keys)
+    {
+        hits += set.erase(key);
+    }
+    report.stop(measurement, "std::set", "erase", keys.size(), lookup_keys.size(), hits);
+}
@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_REDBLACKTREEBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_REDBLACKTREEBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+#include <vector>
+
+// Compares RedBlackTree with std::set on inserts, lookups and erases of random keys. The benchmarks run for every
+// power of 10 from 1000 up to the given number of elements.
+class RedBlackTreeBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    static void RedBlackTreeOperations(const std::vector<int>& keys, BenchmarkReport& report);
+    static void SetOperations(const std::vector<int>& keys, BenchmarkReport& report);
+};
+
+#endif
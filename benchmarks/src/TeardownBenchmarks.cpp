@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "TeardownBenchmarks.hpp"
+#include "Ishiko/DataStructures/BinaryTree.hpp"
+#include "Ishiko/DataStructures/DoublyLinkedList.hpp"
+#include "Ishiko/DataStructures/SinglyLinkedList.hpp"
+#include "Ishiko/DataStructures/SkipList.hpp"
+#include "Ishiko/DataStructures/WorkStealingPool.hpp"
+#include <algorithm>
+#include <string>
+#include <thread>
+
+using namespace Ishiko;
+
+namespace
+{
+    std::string makeString(size_t i)
+    {
+        return ("a string long enough to be allocated on the heap " + std::to_string(i));
+    }
+
+    void fillList(SinglyLinkedList<std::string>& list, size_t size)
+    {
+        list.setHead(makeString(0));
+        SinglyLinkedList<std::string>::Node* last_node = list.head();
+        for (size_t i = 1; i < size; ++i)
+        {
+            last_node = list.insert(makeString(i), last_node);
+        }
+    }
+
+    // Adds a balanced subtree of count nodes below parent_node so that the parallel clear has subtrees to hand over
+    void fillSubtree(BinaryTree<std::string>& tree, BinaryTree<std::string>::Node* parent_node, size_t count)
+    {
+        size_t left_count = ((count - 1) / 2);
+        size_t right_count = (count - 1 - left_count);
+        if (left_count > 0)
+        {
+            fillSubtree(tree, tree.insertLeft(makeString(left_count), parent_node), left_count);
+        }
+        if (right_count > 0)
+        {
+            fillSubtree(tree, tree.insertRight(makeString(right_count), parent_node), right_count);
+        }
+    }
+
+    void fillTree(BinaryTree<std::string>& tree, size_t size)
+    {
+        tree.setRoot(makeString(0));
+        fillSubtree(tree, tree.root(), size);
+    }
+}
+
+void TeardownBenchmarks::Run(size_t size, BenchmarkReport& report)
+{
+    SinglyLinkedListTeardown(size, report);
+    DoublyLinkedListTeardown(size, report);
+    SkipListTeardown(size, report);
+    BinaryTreeTeardown(size, report);
+    // The strings make the elements a lot bigger
+    size_t string_size = std::max<size_t>((size / 10), 1);
+    SinglyLinkedListStringTeardown(string_size, report);
+    BinaryTreeStringTeardown(string_size, report);
+}
+
+void TeardownBenchmarks::SinglyLinkedListTeardown(size_t size, BenchmarkReport& report)
+{
+    SinglyLinkedList<int> list;
+    list.setHead(0);
+    SinglyLinkedList<int>::Node* last_node = list.head();
+    for (size_t i = 1; i < size; ++i)
+    {
+        last_node = list.insert(static_cast<int>(i), last_node);
+    }
+
+    BenchmarkReport::Measurement measurement = report.start();
+    list.clear();
+    report.stop(measurement, "SinglyLinkedList", "teardown", size, size, 0);
+}
+
+void TeardownBenchmarks::DoublyLinkedListTeardown(size_t size, BenchmarkReport& report)
+{
+    DoublyLinkedList<int> list;
+    list.setHead(0);
+    DoublyLinkedList<int>::Node* last_node = list.head();
+    for (size_t i = 1; i < size; ++i)
+    {
+        last_node = list.insertAfter(static_cast<int>(i), last_node);
+    }
+
+    BenchmarkReport::Measurement measurement = report.start();
+    list.clear();
+    report.stop(measurement, "DoublyLinkedList", "teardown", size, size, 0);
+}
+
+void TeardownBenchmarks::SkipListTeardown(size_t size, BenchmarkReport& report)
+{
+    SkipList<int> list(GeometricLevelGenerator<>(1));
+    for (size_t i = size; i > 0; --i)
+    {
+        list.insert(static_cast<int>(i));
+    }
+
+    BenchmarkReport::Measurement measurement = report.start();
+    list.clear();
+    report.stop(measurement, "SkipList", "teardown", size, size, 0);
+}
+
+void TeardownBenchmarks::BinaryTreeTeardown(size_t size, BenchmarkReport& report)
+{
+    // A degenerate tree is the worst case for a recursive teardown
+    BinaryTree<int> tree;
+    tree.setRoot(0);
+    BinaryTree<int>::Node* node = tree.root();
+    for (size_t i = 1; i < size; ++i)
+    {
+        if ((i % 2) == 0)
+        {
+            node = tree.insertLeft(static_cast<int>(i), node);
+        }
+        else
+        {
+            node = tree.insertRight(static_cast<int>(i), node);
+        }
+    }
+
+    BenchmarkReport::Measurement measurement = report.start();
+    tree.clear();
+    report.stop(measurement, "BinaryTree", "teardown", size, size, 0);
+}
+
+void TeardownBenchmarks::SinglyLinkedListStringTeardown(size_t size, BenchmarkReport& report)
+{
+    SinglyLinkedList<std::string> list;
+    // The containers are filled again for each run so the first fill is only there to put the heap in the same
+    // state for all the runs
+    fillList(list, size);
+    list.clear();
+    fillList(list, size);
+
+    BenchmarkReport::Measurement measurement = report.start();
+    list.clear();
+    report.stop(measurement, "SinglyLinkedList<std::string>", "teardown", size, size, 0);
+
+    // The scaling with the number of threads, up to the number of hardware threads but at least 2
+    size_t max_thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+    for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        WorkStealingPool pool(thread_count - 1);
+        std::string name = ("SinglyLinkedList<std::string> " + std::to_string(thread_count) + " threads");
+        fillList(list, size);
+
+        measurement = report.start();
+        list.clear(pool);
+        report.stop(measurement, name.c_str(), "parallel teardown", size, size, 0);
+    }
+}
+
+void TeardownBenchmarks::BinaryTreeStringTeardown(size_t size, BenchmarkReport& report)
+{
+    BinaryTree<std::string> tree;
+    fillTree(tree, size);
+    tree.clear();
+    fillTree(tree, size);
+
+    BenchmarkReport::Measurement measurement = report.start();
+    tree.clear();
+    report.stop(measurement, "BinaryTree<std::string>", "teardown", size, size, 0);
+
+    size_t max_thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+    for (size_t thread_count = 1; thread_count <= max_thread_count; thread_count *= 2)
+    {
+        WorkStealingPool pool(thread_count - 1);
+        std::string name = ("BinaryTree<std::string> " + std::to_string(thread_count) + " threads");
+        fillTree(tree, size);
+
+        measurement = report.start();
+        tree.clear(pool);
+        report.stop(measurement, name.c_str(), "parallel teardown", size, size, 0);
+    }
+}
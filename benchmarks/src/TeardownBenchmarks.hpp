@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_TEARDOWNBENCHMARKS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BENCHMARKS_TEARDOWNBENCHMARKS_HPP
+
+#include "BenchmarkReport.hpp"
+#include <cstddef>
+
+// Measures how long it takes to destroy containers of a given number of elements.
+class TeardownBenchmarks
+{
+public:
+    static void Run(size_t size, BenchmarkReport& report);
+
+private:
+    static void SinglyLinkedListTeardown(size_t size, BenchmarkReport& report);
+    static void DoublyLinkedListTeardown(size_t size, BenchmarkReport& report);
+    static void SkipListTeardown(size_t size, BenchmarkReport& report);
+    static void BinaryTreeTeardown(size_t size, BenchmarkReport& report);
+    // The elements are strings allocated on the heap, whose destruction the parallel clear spreads over the threads
+    // of a pool
+    static void SinglyLinkedListStringTeardown(size_t size, BenchmarkReport& report);
+    static void BinaryTreeStringTeardown(size_t size, BenchmarkReport& report);
+};
+
+#endif
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BenchmarkReport.hpp"
+#include "BinaryTreeBenchmarks.hpp"
+#include "ConcurrencyBenchmarks.hpp"
+#include "ConstructionBenchmarks.hpp"
+#include "ContainerBenchmarks.hpp"
+#include "DynamicArrayBenchmarks.hpp"
+#include "ListTraversalBenchmarks.hpp"
+#include "LookupBenchmarks.hpp"
+#include "OrderedSetImageBenchmarks.hpp"
+#include "RedBlackTreeBenchmarks.hpp"
+#include "TeardownBenchmarks.hpp"
+#include "Ishiko/DataStructures/linkoptions.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Usage: IshikoDataStructuresBenchmarks [--json] [size]
+        size_t size = 10000000;
+        BenchmarkReport::Format format = BenchmarkReport::Format::text;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], "--json") == 0)
+            {
+                format = BenchmarkReport::Format::json;
+            }
+            else
+            {
+                size = std::strtoul(argv[i], nullptr, 10);
+            }
+        }
+
+        BenchmarkReport report(std::cout, format);
+        ContainerBenchmarks::Run(size, report);
+        ListTraversalBenchmarks::Run(size, report);
+        ConstructionBenchmarks::Run(size, report);
+        LookupBenchmarks::Run(size, report);
+        TeardownBenchmarks::Run(size, report);
+        RedBlackTreeBenchmarks::Run(size, report);
+        BinaryTreeBenchmarks::Run(size, report);
+        DynamicArrayBenchmarks::Run(size, report);
+        ConcurrencyBenchmarks::Run(size, report);
+        OrderedSetImageBenchmarks::Run(size, report);
+        report.finish();
+
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (...)
+    {
+        return EXIT_FAILURE;
+    }
+}
@@ -4,14 +4,38 @@
 #ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_HPP
 #define GUARD_ISHIKO_CPP_DATASTRUCTURES_HPP
 
+#include "DataStructures/ArenaAllocator.hpp"
+#include "DataStructures/BPlusTree.hpp"
 #include "DataStructures/BinaryTree.hpp"
+#include "DataStructures/BinaryTreeBase.hpp"
+#include "DataStructures/CompactDoublyLinkedList.hpp"
+#include "DataStructures/ConcurrentQueue.hpp"
+#include "DataStructures/ConcurrentSkipList.hpp"
+#include "DataStructures/ConcurrentStack.hpp"
+#include "DataStructures/ContainerStatistics.hpp"
+#include "DataStructures/CountingAllocator.hpp"
 #include "DataStructures/DataStructuresErrorCategory.hpp"
 #include "DataStructures/DataTypeTraits.hpp"
 #include "DataStructures/DoublyLinkedList.hpp"
+#include "DataStructures/DoublyLinkedListBase.hpp"
 #include "DataStructures/DynamicArray.hpp"
+#include "DataStructures/EpochBasedReclamation.hpp"
+#include "DataStructures/FrozenBinaryTree.hpp"
+#include "DataStructures/GeometricLevelGenerator.hpp"
+#include "DataStructures/InPlace.hpp"
+#include "DataStructures/IntrusiveBinaryTree.hpp"
+#include "DataStructures/IntrusiveDoublyLinkedList.hpp"
+#include "DataStructures/IntrusiveSinglyLinkedList.hpp"
 #include "DataStructures/linkoptions.hpp"
+#include "DataStructures/NewDeleteAllocator.hpp"
+#include "DataStructures/NodeDeletion.hpp"
+#include "DataStructures/OrderedSetImage.hpp"
+#include "DataStructures/PoolAllocator.hpp"
+#include "DataStructures/RedBlackTree.hpp"
 #include "DataStructures/SinglyLinkedList.hpp"
 #include "DataStructures/SinglyLinkedListBase.hpp"
-#include "DataStructures/Skiplist.hpp"
+#include "DataStructures/SkipList.hpp"
+#include "DataStructures/UnrolledSinglyLinkedList.hpp"
+#include "DataStructures/WorkStealingPool.hpp"
 
 #endif
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_ARENAALLOCATOR_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_ARENAALLOCATOR_HPP
+
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+#include <new>
+
+namespace Ishiko
+{
+    // A monotonic node allocator. Blocks are carved out of large slabs by bumping a pointer and deallocate does
+    // nothing, the memory is only given back when release is called or the allocator is destroyed. This makes both
+    // allocation and clearing a whole container very cheap but memory freed by erasing nodes isn't reused.
+    //
+    // See NewDeleteAllocator for the requirements of node allocators. The allocator isn't thread-safe.
+    class ArenaAllocator
+    {
+    public:
+        static const bool supports_release = true;
+        // The alignment of all the blocks, sizes are rounded up to a multiple of it
+        static const size_t alignment = alignof(std::max_align_t);
+        static const size_t default_slab_size = 64 * 1024;
+
+        explicit ArenaAllocator(size_t slab_size = default_slab_size) noexcept;
+        ArenaAllocator(const ArenaAllocator& other) = delete;
+        ArenaAllocator& operator=(const ArenaAllocator& other) = delete;
+        ~ArenaAllocator() noexcept;
+
+        void* allocate(size_t size);
+        void* allocate(size_t size, Error& error) noexcept;
+        void deallocate(void* memory, size_t size) noexcept;
+        void reserve(size_t count, size_t size);
+        void reserve(size_t count, size_t size, Error& error) noexcept;
+        // Frees all the slabs. This also discards any memory set aside by reserve.
+        void release() noexcept;
+
+        static size_t RoundUp(size_t size) noexcept;
+
+    private:
+        struct Slab
+        {
+            Slab* previous_slab;
+        };
+
+        // Makes sure the current slab has room for count blocks of size bytes
+        bool makeRoom(size_t count, size_t size) noexcept;
+        // Starts a new slab with room for at least size bytes. Returns false if the memory can't be allocated.
+        bool addSlab(size_t size) noexcept;
+
+        char* m_current = nullptr;
+        char* m_end = nullptr;
+        Slab* m_slabs = nullptr;
+        size_t m_slab_size;
+    };
+}
+
+inline size_t Ishiko::ArenaAllocator::RoundUp(size_t size) noexcept
+{
+    return ((size + (alignment - 1)) & ~(alignment - 1));
+}
+
+inline void* Ishiko::ArenaAllocator::allocate(size_t size)
+{
+    size = RoundUp(size);
+    if ((size > static_cast<size_t>(m_end - m_current)) && !addSlab(size))
+    {
+        throw std::bad_alloc();
+    }
+    void* memory = m_current;
+    m_current += size;
+    return memory;
+}
+
+inline void Ishiko::ArenaAllocator::deallocate(void* /*memory*/, size_t /*size*/) noexcept
+{
+}
+
+#endif
@@ -0,0 +1,1434 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BPLUSTREE_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BPLUSTREE_HPP
+
+#include "ContainerStatistics.hpp"
+#include "DataStructuresErrorCategory.hpp"
+#include "NewDeleteAllocator.hpp"
+#include "NodeDeletion.hpp"
+#include <Ishiko/Errors.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ISHIKO_CPP_DATASTRUCTURES_BPLUSTREE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_2__) || defined(__AVX__)
+#define ISHIKO_CPP_DATASTRUCTURES_BPLUSTREE_SSE4_2
+#include <nmmintrin.h>
+#endif
+
+namespace Ishiko
+{
+    // Finds where a value goes among the sorted keys of a BPlusTree node. The search is a binary search without
+    // branches on the comparisons, which can't be predicted.
+    template<typename DataType, typename Compare, typename Enable = void>
+    class BPlusTreeKeySearch
+    {
+    public:
+        // The number of keys less than value
+        static size_t LowerBound(const DataType* keys, size_t size, const DataType& value,
+            const Compare& compare) noexcept;
+        // The number of keys less than or equal to value
+        static size_t UpperBound(const DataType* keys, size_t size, const DataType& value,
+            const Compare& compare) noexcept;
+    };
+
+    // 32 and 64 bit integers ordered by std::less narrow the binary search down to a window of keys that is then
+    // compared with the value a vector at a time, with SSE2 for 32 bit integers and SSE4.2 for 64 bit integers. The
+    // window is scanned one key at a time if these instructions aren't available.
+    template<typename DataType>
+    class BPlusTreeKeySearch<DataType, std::less<DataType>,
+        typename std::enable_if<std::is_integral<DataType>::value
+            && ((sizeof(DataType) == 4) || (sizeof(DataType) == 8))>::type>
+    {
+    public:
+        static size_t LowerBound(const DataType* keys, size_t size, const DataType& value,
+            const std::less<DataType>& compare) noexcept;
+        static size_t UpperBound(const DataType* keys, size_t size, const DataType& value,
+            const std::less<DataType>& compare) noexcept;
+
+    private:
+        static const size_t window_size = 16;
+
+        static size_t CountLess(const DataType* keys, size_t size, DataType value) noexcept;
+        static size_t CountLessOrEqual(const DataType* keys, size_t size, DataType value) noexcept;
+        static size_t CountBits(int mask) noexcept;
+    };
+
+    // An ordered set implemented as a B+tree. Values are ordered by Compare, which must be a strict weak ordering, and
+    // each value is stored only once.
+    //
+    // All the values are stored in the leaves, which are linked in order so that iterating over a range reads
+    // consecutive memory. The inner nodes only hold copies of some of the values to guide the searches. Every node is
+    // an array of about NodeSize bytes so that the fan-out can be matched to the size of the cache lines or of the
+    // pages. Nodes other than the root are kept at least half full. Values that hold their data elsewhere, like long
+    // strings, benefit less since every comparison still has to read that data.
+    //
+    // DataType must be nothrow default constructible and nothrow move assignable since the nodes are arrays of values
+    // that are shifted around. Inserting or erasing a value invalidates all the iterators. Allocator is the node
+    // allocator, see NewDeleteAllocator. Leaves and inner nodes are allocated as blocks of the same size.
+    template<typename DataType, typename Compare = std::less<DataType>, size_t NodeSize = 256,
+        typename Allocator = NewDeleteAllocator>
+    class BPlusTree
+    {
+        static_assert(std::is_nothrow_default_constructible<DataType>::value,
+            "DataType must be nothrow default constructible");
+        static_assert(std::is_nothrow_move_assignable<DataType>::value, "DataType must be nothrow move assignable");
+
+    public:
+        // The maximum number of values in a leaf and of keys in an inner node, the number of children of an inner node
+        // is one more than its number of keys
+        static const size_t leaf_capacity = ((NodeSize - sizeof(size_t) - sizeof(void*)) / sizeof(DataType));
+        static const size_t inner_capacity =
+            ((NodeSize - sizeof(size_t) - sizeof(void*)) / (sizeof(DataType) + sizeof(void*)));
+        static_assert(leaf_capacity >= 3, "NodeSize is too small for DataType");
+        static_assert(inner_capacity >= 3, "NodeSize is too small for DataType");
+
+        class LeafNode
+        {
+        public:
+            LeafNode(const LeafNode& other) = delete;
+            LeafNode& operator=(const LeafNode& other) = delete;
+
+            size_t size() const noexcept;
+            const DataType& data(size_t index) const noexcept;
+            const LeafNode* nextLeaf() const noexcept;
+
+        private:
+            friend class BPlusTree;
+
+            LeafNode() noexcept = default;
+            ~LeafNode() noexcept = default;
+
+            size_t m_size = 0;
+            LeafNode* m_next_leaf = nullptr;
+            DataType m_data[leaf_capacity];
+        };
+
+        // A forward iterator over the values in order. The values can't be modified through it since that could break
+        // the ordering.
+        class ConstIterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef DataType value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const DataType* pointer;
+            typedef const DataType& reference;
+
+            ConstIterator() noexcept = default;
+            // index must be less than the size of leaf, the end iterator has a null leaf
+            ConstIterator(const LeafNode* leaf, size_t index) noexcept;
+
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+            ConstIterator& operator++() noexcept;
+            ConstIterator operator++(int) noexcept;
+            bool operator==(const ConstIterator& other) const noexcept;
+            bool operator!=(const ConstIterator& other) const noexcept;
+
+            const LeafNode* leaf() const noexcept;
+            size_t index() const noexcept;
+
+        private:
+            const LeafNode* m_leaf = nullptr;
+            size_t m_index = 0;
+        };
+
+        explicit BPlusTree(const Compare& compare = Compare());
+        // Builds the tree from the range [first, last), which must be sorted. Consecutive equal values are only
+        // inserted once. The tree is built bottom up without any searching and the leaves are filled completely, which
+        // is best for trees that are mostly read.
+        template<typename InputIterator>
+        BPlusTree(InputIterator first, InputIterator last, const Compare& compare = Compare());
+        BPlusTree(const BPlusTree& other) = delete;
+        BPlusTree& operator=(const BPlusTree& other) = delete;
+        ~BPlusTree() noexcept;
+
+        bool isEmpty() const noexcept;
+        size_t size() const noexcept;
+        // The number of levels, the leaves included
+        size_t height() const noexcept;
+        ConstIterator begin() const noexcept;
+        ConstIterator end() const noexcept;
+
+        ConstIterator find(const DataType& value) const noexcept;
+        bool contains(const DataType& value) const noexcept;
+        ConstIterator lowerBound(const DataType& value) const noexcept;
+        ConstIterator upperBound(const DataType& value) const noexcept;
+        // Calls callback with each value in the range [from, to) in order. The callback returns false to stop the
+        // scan early. Returns the number of values the callback was called with.
+        template<typename Callback>
+        size_t scan(const DataType& from, const DataType& to, Callback&& callback) const;
+
+        // Returns false if the tree already contains a value equal to value. The versions that take an error also
+        // return false if a node couldn't be allocated, in which case error is set and the tree is unchanged.
+        bool insert(const DataType& value);
+        bool insert(DataType&& value);
+        bool insert(const DataType& value, Error& error) noexcept;
+        bool insert(DataType&& value, Error& error) noexcept;
+        // Same as insert but the value is constructed from arguments. Since the value is needed to find where it goes
+        // it is always constructed, and destroyed again if the tree already contains an equal value.
+        template<typename... Arguments>
+        bool emplace(Arguments&&... arguments);
+        // Returns false if the tree doesn't contain a value equal to value. A leaf that borrows a value from its
+        // sibling needs a new copy of its first value in its parent, which is the only step that can throw. It happens
+        // before the tree is modified.
+        bool erase(const DataType& value) noexcept(std::is_nothrow_copy_constructible<DataType>::value);
+        void clear() noexcept;
+
+        // Makes sure count values can be inserted without the allocator needing more memory from the system. This
+        // assumes every node is half full.
+        void reserve(size_t count);
+        void reserve(size_t count, Error& error) noexcept;
+
+        // Visits every node to compute a snapshot of the memory the tree holds, see ContainerStatistics. The unused
+        // slots of the leaves are counted as spare bytes.
+        ContainerStatistics statistics() const;
+
+    private:
+        typedef BPlusTreeKeySearch<DataType, Compare> KeySearch;
+
+        // The children are leaves in the level above the leaves and inner nodes in the other levels
+        struct InnerNode
+        {
+            size_t size = 0;
+            DataType keys[inner_capacity];
+            void* children[inner_capacity + 1];
+        };
+
+        static const size_t min_leaf_size = (leaf_capacity / 2);
+        static const size_t min_inner_size = (inner_capacity / 2);
+        // Every inner node has at least 2 children so there can't be more levels than bits in a size
+        static const size_t max_height = (8 * sizeof(size_t));
+
+        // The inner nodes from the root down to a leaf, the index of the child taken at each of them and where the
+        // searched value is or would go in the leaf
+        struct Path
+        {
+            InnerNode* nodes[max_height];
+            size_t indices[max_height];
+            size_t depth;
+            LeafNode* leaf;
+            size_t index;
+        };
+
+        static size_t BlockSize() noexcept;
+        // An upper bound on the number of nodes that hold count values
+        static size_t NodeCount(size_t count) noexcept;
+
+        template<typename InputIterator>
+        void bulkLoad(InputIterator first, InputIterator last);
+        const LeafNode* findLeaf(const DataType& value) const noexcept;
+        // Returns true if the tree contains a value equal to value, the tree must not be empty
+        bool findPath(const DataType& value, Path& path) noexcept;
+        ConstIterator iteratorAt(const LeafNode* leaf, size_t index) const noexcept;
+        template<typename Data>
+        bool insertData(Data&& data);
+        template<typename Data>
+        bool insertData(Data&& data, Error& error) noexcept;
+        // The number of nodes inserting a value at path needs
+        size_t newNodeCount(const Path& path) const noexcept;
+        // The value that a split of the leaf of path moves up to the parent
+        static const DataType& SplitSeparator(const Path& path, const DataType& value) noexcept;
+        // Inserts value at path. The new nodes needed are constructed in blocks and separator must be the result of
+        // SplitSeparator if the leaf is full.
+        void insertAt(Path& path, DataType& value, DataType& separator, void** blocks) noexcept;
+        static void SplitLeaf(LeafNode* leaf, size_t index, DataType& value, LeafNode* new_leaf) noexcept;
+        // Splits inner, which is full, after separator and new_child are inserted at index. The key moved up to the
+        // parent ends up in separator.
+        static void SplitInner(InnerNode* inner, size_t index, DataType& separator, void* new_child,
+            InnerNode* new_inner) noexcept;
+        // Restores the minimum sizes of the inner nodes of path after a merge removed a key from the deepest one
+        void rebalanceInnerNodes(Path& path) noexcept;
+        static void RemoveEntry(InnerNode* inner, size_t key_index) noexcept;
+        void destroySubtree(void* node, size_t height) noexcept;
+        void countNodes(const void* node, size_t height, size_t& node_count) const noexcept;
+        LeafNode* createLeaf(void* memory) noexcept;
+        InnerNode* createInnerNode(void* memory) noexcept;
+        void destroyLeaf(LeafNode* leaf) noexcept;
+        void destroyInnerNode(InnerNode* inner) noexcept;
+
+        void* m_root = nullptr;
+        LeafNode* m_first_leaf = nullptr;
+        size_t m_size = 0;
+        size_t m_height = 0;
+        Compare m_compare;
+        Allocator m_allocator;
+    };
+}
+
+template<typename DataType, typename Compare, typename Enable>
+size_t Ishiko::BPlusTreeKeySearch<DataType, Compare, Enable>::LowerBound(const DataType* keys, size_t size,
+    const DataType& value, const Compare& compare) noexcept
+{
+    const DataType* base = keys;
+    size_t count = size;
+    while (count > 1)
+    {
+        size_t half = (count / 2);
+        base = (compare(base[half], value) ? (base + half) : base);
+        count -= half;
+    }
+    return ((base - keys) + (((count == 1) && compare(*base, value)) ? 1 : 0));
+}
+
+template<typename DataType, typename Compare, typename Enable>
+size_t Ishiko::BPlusTreeKeySearch<DataType, Compare, Enable>::UpperBound(const DataType* keys, size_t size,
+    const DataType& value, const Compare& compare) noexcept
+{
+    const DataType* base = keys;
+    size_t count = size;
+    while (count > 1)
+    {
+        size_t half = (count / 2);
+        base = (compare(value, base[half]) ? base : (base + half));
+        count -= half;
+    }
+    return ((base - keys) + (((count == 1) && !compare(value, *base)) ? 1 : 0));
+}
+
+template<typename DataType>
+size_t Ishiko::BPlusTreeKeySearch<DataType, std::less<DataType>,
+    typename std::enable_if<std::is_integral<DataType>::value
+        && ((sizeof(DataType) == 4) || (sizeof(DataType) == 8))>::type>::LowerBound(const DataType* keys, size_t size,
+    const DataType& value, const std::less<DataType>&) noexcept
+{
+    const DataType* base = keys;
+    size_t count = size;
+    while (count > window_size)
+    {
+        size_t half = (count / 2);
+        base = ((base[half] < value) ? (base + half) : base);
+        count -= half;
+    }
+    return ((base - keys) + CountLess(base, count, value));
+}
+
+template<typename DataType>
+size_t Ishiko::BPlusTreeKeySearch<DataType, std::less<DataType>,
+    typename std::enable_if<std::is_integral<DataType>::value
+        && ((sizeof(DataType) == 4) || (sizeof(DataType) == 8))>::type>::UpperBound(const DataType* keys, size_t size,
+    const DataType& value, const std::less<DataType>&) noexcept
+{
+    const DataType* base = keys;
+    size_t count = size;
+    while (count > window_size)
+    {
+        size_t half = (count / 2);
+        base = ((value < base[half]) ? base : (base + half));
+        count -= half;
+    }
+    return ((base - keys) + CountLessOrEqual(base, count, value));
+}
+
+template<typename DataType>
+size_t Ishiko::BPlusTreeKeySearch<DataType, std::less<DataType>,
+    typename std::enable_if<std::is_integral<DataType>::value
+        && ((sizeof(DataType) == 4) || (sizeof(DataType) == 8))>::type>::CountLess(const DataType* keys, size_t size,
+    DataType value) noexcept
+{
+    // The keys are sorted so the ones less than value come first and the scan stops at the first vector that isn't
+    // all less than value. The vector comparisons are signed, unsigned values are biased into the signed range.
+    size_t count = 0;
+    if (sizeof(DataType) == 4)
+    {
+#if defined(ISHIKO_CPP_DATASTRUCTURES_BPLUSTREE_SSE2)
+        const __m128i bias = _mm_set1_epi32(std::is_signed<DataType>::value ? 0 : std::numeric_limits<int32_t>::min());
+        const __m128i biased_value = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(value)), bias);
+        for (; (count + 4) <= size; count += 4)
+        {
+            __m128i biased_keys =
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + count)), bias);
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(biased_keys, biased_value)));
+            if (mask != 0xF)
+            {
+                return (count + CountBits(mask));
+            }
+        }
+#endif
+    }
+    else
+    {
+#if defined(ISHIKO_CPP_DATASTRUCTURES_BPLUSTREE_SSE4_2)
+        const __m128i bias = _mm_set1_epi64x(std::is_signed<DataType>::value ? 0 : std::numeric_limits<int64_t>::min());
+        const __m128i biased_value = _mm_xor_si128(_mm_set1_epi64x(static_cast<int64_t>(value)), bias);
+        for (; (count + 2) <= size; count += 2)
+        {
+            __m128i biased_keys =
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + count)), bias);
+            int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(biased_value, biased_keys)));
+            if (mask != 0x3)
+            {
+                return (count + CountBits(mask));
+            }
+        }
+#endif
+    }
+    while ((count < size) && (keys[count] < value))
+    {
+        ++count;
+    }
+    return count;
+}
+
+template<typename DataType>
+size_t Ishiko::BPlusTreeKeySearch<DataType, std::less<DataType>,
+    typename std::enable_if<std::is_integral<DataType>::value
+        && ((sizeof(DataType) == 4) || (sizeof(DataType) == 8))>::type>::CountLessOrEqual(const DataType* keys,
+    size_t size, DataType value) noexcept
+{
+    // See CountLess, here the scan stops at the first vector with a key greater than value
+    size_t count = 0;
+    if (sizeof(DataType) == 4)
+    {
+#if defined(ISHIKO_CPP_DATASTRUCTURES_BPLUSTREE_SSE2)
+        const __m128i bias = _mm_set1_epi32(std::is_signed<DataType>::value ? 0 : std::numeric_limits<int32_t>::min());
+        const __m128i biased_value = _mm_xor_si128(_mm_set1_epi32(static_cast<int32_t>(value)), bias);
+        for (; (count + 4) <= size; count += 4)
+        {
+            __m128i biased_keys =
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + count)), bias);
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(biased_keys, biased_value)));
+            if (mask != 0)
+            {
+                return (count + 4 - CountBits(mask));
+            }
+        }
+#endif
+    }
+    else
+    {
+#if defined(ISHIKO_CPP_DATASTRUCTURES_BPLUSTREE_SSE4_2)
+        const __m128i bias = _mm_set1_epi64x(std::is_signed<DataType>::value ? 0 : std::numeric_limits<int64_t>::min());
+        const __m128i biased_value = _mm_xor_si128(_mm_set1_epi64x(static_cast<int64_t>(value)), bias);
+        for (; (count + 2) <= size; count += 2)
+        {
+            __m128i biased_keys =
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + count)), bias);
+            int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(biased_keys, biased_value)));
+            if (mask != 0)
+            {
+                return (count + 2 - CountBits(mask));
+            }
+        }
+#endif
+    }
+    while ((count < size) && !(value < keys[count]))
+    {
+        ++count;
+    }
+    return count;
+}
+
+template<typename DataType>
+size_t Ishiko::BPlusTreeKeySearch<DataType, std::less<DataType>,
+    typename std::enable_if<std::is_integral<DataType>::value
+        && ((sizeof(DataType) == 4) || (sizeof(DataType) == 8))>::type>::CountBits(int mask) noexcept
+{
+    return static_cast<size_t>((mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::leaf_capacity;
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::inner_capacity;
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::min_leaf_size;
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::min_inner_size;
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::max_height;
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::LeafNode::size() const noexcept
+{
+    return m_size;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const DataType& Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::LeafNode::data(size_t index) const noexcept
+{
+    return m_data[index];
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::LeafNode*
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::LeafNode::nextLeaf() const noexcept
+{
+    return m_next_leaf;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::ConstIterator(const LeafNode* leaf,
+    size_t index) noexcept
+    : m_leaf(leaf), m_index(index)
+{
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::reference
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::operator*() const noexcept
+{
+    return m_leaf->data(m_index);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::pointer
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::operator->() const noexcept
+{
+    return &m_leaf->data(m_index);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator&
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::operator++() noexcept
+{
+    ++m_index;
+    if (m_index == m_leaf->size())
+    {
+        m_leaf = m_leaf->nextLeaf();
+        m_index = 0;
+    }
+    return *this;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::operator++(int) noexcept
+{
+    ConstIterator result = *this;
+    ++*this;
+    return result;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::operator==(
+    const ConstIterator& other) const noexcept
+{
+    return ((m_leaf == other.m_leaf) && (m_index == other.m_index));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::operator!=(
+    const ConstIterator& other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::LeafNode*
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::leaf() const noexcept
+{
+    return m_leaf;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator::index() const noexcept
+{
+    return m_index;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::BPlusTree(const Compare& compare)
+    : m_compare(compare)
+{
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+template<typename InputIterator>
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::BPlusTree(InputIterator first, InputIterator last,
+    const Compare& compare)
+    : m_compare(compare)
+{
+    bulkLoad(first, last);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::~BPlusTree() noexcept
+{
+    clear();
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::isEmpty() const noexcept
+{
+    return (m_size == 0);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::size() const noexcept
+{
+    return m_size;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::height() const noexcept
+{
+    return m_height;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::begin() const noexcept
+{
+    return ConstIterator(m_first_leaf, 0);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::end() const noexcept
+{
+    return ConstIterator();
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::find(const DataType& value) const noexcept
+{
+    if (!m_root)
+    {
+        return end();
+    }
+
+    const LeafNode* leaf = findLeaf(value);
+    size_t index = KeySearch::LowerBound(leaf->m_data, leaf->m_size, value, m_compare);
+    if ((index < leaf->m_size) && !m_compare(value, leaf->m_data[index]))
+    {
+        return ConstIterator(leaf, index);
+    }
+    return end();
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::contains(const DataType& value) const noexcept
+{
+    return (find(value) != end());
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::lowerBound(const DataType& value) const noexcept
+{
+    if (!m_root)
+    {
+        return end();
+    }
+
+    const LeafNode* leaf = findLeaf(value);
+    return iteratorAt(leaf, KeySearch::LowerBound(leaf->m_data, leaf->m_size, value, m_compare));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::upperBound(const DataType& value) const noexcept
+{
+    if (!m_root)
+    {
+        return end();
+    }
+
+    const LeafNode* leaf = findLeaf(value);
+    return iteratorAt(leaf, KeySearch::UpperBound(leaf->m_data, leaf->m_size, value, m_compare));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+template<typename Callback>
+size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::scan(const DataType& from, const DataType& to,
+    Callback&& callback) const
+{
+    // The values are read a leaf at a time rather than through the iterator so that the loop over a leaf is a plain
+    // loop over an array
+    ConstIterator start = lowerBound(from);
+    const LeafNode* leaf = start.leaf();
+    size_t index = start.index();
+    size_t count = 0;
+    while (leaf)
+    {
+        for (; index < leaf->m_size; ++index)
+        {
+            if (!m_compare(leaf->m_data[index], to))
+            {
+                return count;
+            }
+            ++count;
+            if (!callback(leaf->m_data[index]))
+            {
+                return count;
+            }
+        }
+        leaf = leaf->m_next_leaf;
+        index = 0;
+    }
+    return count;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::insert(const DataType& value)
+{
+    return insertData(value);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::insert(DataType&& value)
+{
+    return insertData(std::move(value));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::insert(const DataType& value, Error& error) noexcept
+{
+    static_assert(std::is_nothrow_copy_constructible<DataType>::value,
+        "DataType must be nothrow copy constructible to be inserted without exceptions");
+
+    return insertData(value, error);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::insert(DataType&& value, Error& error) noexcept
+{
+    static_assert(std::is_nothrow_move_constructible<DataType>::value,
+        "DataType must be nothrow move constructible to be inserted without exceptions");
+
+    return insertData(std::move(value), error);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+template<typename... Arguments>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::emplace(Arguments&&... arguments)
+{
+    return insertData(DataType(std::forward<Arguments>(arguments)...));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::erase(const DataType& value)
+    noexcept(std::is_nothrow_copy_constructible<DataType>::value)
+{
+    if (!m_root)
+    {
+        return false;
+    }
+
+    Path path;
+    if (!findPath(value, path))
+    {
+        return false;
+    }
+
+    LeafNode* leaf = path.leaf;
+    if ((path.depth == 0) || (leaf->m_size > min_leaf_size))
+    {
+        std::move(leaf->m_data + path.index + 1, leaf->m_data + leaf->m_size, leaf->m_data + path.index);
+        --leaf->m_size;
+        --m_size;
+        if (leaf->m_size == 0)
+        {
+            destroyLeaf(leaf);
+            m_root = nullptr;
+            m_first_leaf = nullptr;
+            m_height = 0;
+        }
+        return true;
+    }
+
+    // The leaf would fall below its minimum size. If a sibling has values to spare one of them is moved over,
+    // otherwise the leaf and a sibling are merged.
+    InnerNode* parent = path.nodes[path.depth - 1];
+    size_t child_index = path.indices[path.depth - 1];
+    LeafNode* left_sibling = ((child_index > 0) ? static_cast<LeafNode*>(parent->children[child_index - 1]) : nullptr);
+    LeafNode* right_sibling =
+        ((child_index < parent->size) ? static_cast<LeafNode*>(parent->children[child_index + 1]) : nullptr);
+    if (left_sibling && (left_sibling->m_size > min_leaf_size))
+    {
+        DataType separator(left_sibling->m_data[left_sibling->m_size - 1]);
+        std::move_backward(leaf->m_data, leaf->m_data + path.index, leaf->m_data + path.index + 1);
+        leaf->m_data[0] = std::move(left_sibling->m_data[left_sibling->m_size - 1]);
+        --left_sibling->m_size;
+        parent->keys[child_index - 1] = std::move(separator);
+    }
+    else if (right_sibling && (right_sibling->m_size > min_leaf_size))
+    {
+        DataType separator(right_sibling->m_data[1]);
+        std::move(leaf->m_data + path.index + 1, leaf->m_data + leaf->m_size, leaf->m_data + path.index);
+        leaf->m_data[leaf->m_size - 1] = std::move(right_sibling->m_data[0]);
+        std::move(right_sibling->m_data + 1, right_sibling->m_data + right_sibling->m_size, right_sibling->m_data);
+        --right_sibling->m_size;
+        parent->keys[child_index] = std::move(separator);
+    }
+    else
+    {
+        std::move(leaf->m_data + path.index + 1, leaf->m_data + leaf->m_size, leaf->m_data + path.index);
+        --leaf->m_size;
+        LeafNode* left_leaf = leaf;
+        LeafNode* right_leaf = right_sibling;
+        size_t key_index = child_index;
+        if (left_sibling)
+        {
+            left_leaf = left_sibling;
+            right_leaf = leaf;
+            key_index = (child_index - 1);
+        }
+        std::move(right_leaf->m_data, right_leaf->m_data + right_leaf->m_size, left_leaf->m_data + left_leaf->m_size);
+        left_leaf->m_size += right_leaf->m_size;
+        left_leaf->m_next_leaf = right_leaf->m_next_leaf;
+        destroyLeaf(right_leaf);
+        RemoveEntry(parent, key_index);
+        rebalanceInnerNodes(path);
+    }
+    --m_size;
+    return true;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::clear() noexcept
+{
+    ClearNodes<DataType>(m_allocator,
+        [this]()
+        {
+            if (m_root)
+            {
+                destroySubtree(m_root, m_height);
+                LeafNode* leaf = m_first_leaf;
+                while (leaf)
+                {
+                    LeafNode* next_leaf = leaf->m_next_leaf;
+                    destroyLeaf(leaf);
+                    leaf = next_leaf;
+                }
+            }
+        },
+        [this]()
+        {
+            m_root = nullptr;
+            m_first_leaf = nullptr;
+            m_size = 0;
+            m_height = 0;
+        });
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::reserve(size_t count)
+{
+    m_allocator.reserve(NodeCount(count), BlockSize());
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::reserve(size_t count, Error& error) noexcept
+{
+    m_allocator.reserve(NodeCount(count), BlockSize(), error);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+Ishiko::ContainerStatistics Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::statistics() const
+{
+    ContainerStatistics statistics;
+    statistics.element_count = m_size;
+    statistics.height = m_height;
+    if (m_root)
+    {
+        size_t node_count = 0;
+        countNodes(m_root, m_height, node_count);
+        size_t leaf_count = 0;
+        for (const LeafNode* leaf = m_first_leaf; leaf; leaf = leaf->m_next_leaf)
+        {
+            ++leaf_count;
+        }
+        statistics.spare_bytes = (((leaf_count * leaf_capacity) - m_size) * sizeof(DataType));
+        statistics.element_bytes = ((node_count * BlockSize()) - statistics.spare_bytes);
+    }
+    AddAllocationStatistics(m_allocator, statistics);
+    return statistics;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::BlockSize() noexcept
+{
+    return ((sizeof(LeafNode) > sizeof(InnerNode)) ? sizeof(LeafNode) : sizeof(InnerNode));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::NodeCount(size_t count) noexcept
+{
+    size_t level_count = ((count / min_leaf_size) + 1);
+    size_t node_count = level_count;
+    while (level_count > 1)
+    {
+        level_count = ((level_count + min_inner_size) / (min_inner_size + 1));
+        node_count += level_count;
+    }
+    return node_count;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+template<typename InputIterator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::bulkLoad(InputIterator first, InputIterator last)
+{
+    // The leaves are linked as they are created and the inner nodes are recorded in inner_nodes so that all of them
+    // can be freed if something throws
+    std::vector<void*> level_nodes;
+    std::vector<InnerNode*> inner_nodes;
+    try
+    {
+        LeafNode* leaf = nullptr;
+        for (; first != last; ++first)
+        {
+            if (leaf && !m_compare(leaf->m_data[leaf->m_size - 1], *first))
+            {
+                continue;
+            }
+            if (!leaf || (leaf->m_size == leaf_capacity))
+            {
+                LeafNode* new_leaf = createLeaf(m_allocator.allocate(BlockSize()));
+                if (leaf)
+                {
+                    leaf->m_next_leaf = new_leaf;
+                }
+                else
+                {
+                    m_first_leaf = new_leaf;
+                }
+                level_nodes.push_back(new_leaf);
+                leaf = new_leaf;
+            }
+            leaf->m_data[leaf->m_size] = *first;
+            ++leaf->m_size;
+            ++m_size;
+        }
+        if (!leaf)
+        {
+            return;
+        }
+
+        // The last leaf takes values from the one before it if it is less than half full
+        if ((level_nodes.size() > 1) && (leaf->m_size < min_leaf_size))
+        {
+            LeafNode* previous_leaf = static_cast<LeafNode*>(level_nodes[level_nodes.size() - 2]);
+            size_t moved_count = (min_leaf_size - leaf->m_size);
+            std::move_backward(leaf->m_data, leaf->m_data + leaf->m_size, leaf->m_data + leaf->m_size + moved_count);
+            std::move(previous_leaf->m_data + previous_leaf->m_size - moved_count,
+                previous_leaf->m_data + previous_leaf->m_size, leaf->m_data);
+            previous_leaf->m_size -= moved_count;
+            leaf->m_size += moved_count;
+        }
+
+        // low_keys[i] is the smallest value under level_nodes[i]. The one of the first node is never used.
+        std::vector<DataType> low_keys(level_nodes.size());
+        for (size_t i = 1; i < level_nodes.size(); ++i)
+        {
+            low_keys[i] = static_cast<LeafNode*>(level_nodes[i])->m_data[0];
+        }
+
+        // Each level above is built by spreading the nodes below it as evenly as possible over the fewest inner nodes
+        // that can hold them, which keeps all of them at least half full
+        inner_nodes.reserve(level_nodes.size());
+        m_height = 1;
+        while (level_nodes.size() > 1)
+        {
+            size_t group_count = (((level_nodes.size() - 1) / (inner_capacity + 1)) + 1);
+            std::vector<void*> parent_nodes;
+            parent_nodes.reserve(group_count);
+            std::vector<DataType> parent_low_keys(group_count);
+            size_t child_index = 0;
+            for (size_t group = 0; group < group_count; ++group)
+            {
+                size_t child_count = (level_nodes.size() / group_count);
+                if (group < (level_nodes.size() % group_count))
+                {
+                    ++child_count;
+                }
+                InnerNode* inner = createInnerNode(m_allocator.allocate(BlockSize()));
+                inner_nodes.push_back(inner);
+                parent_low_keys[group] = std::move(low_keys[child_index]);
+                inner->children[0] = level_nodes[child_index];
+                for (size_t i = 1; i < child_count; ++i)
+                {
+                    inner->keys[i - 1] = std::move(low_keys[child_index + i]);
+                    inner->children[i] = level_nodes[child_index + i];
+                }
+                inner->size = (child_count - 1);
+                child_index += child_count;
+                parent_nodes.push_back(inner);
+            }
+            level_nodes.swap(parent_nodes);
+            low_keys.swap(parent_low_keys);
+            ++m_height;
+        }
+        m_root = level_nodes[0];
+    }
+    catch (...)
+    {
+        for (InnerNode* inner : inner_nodes)
+        {
+            destroyInnerNode(inner);
+        }
+        LeafNode* leaf = m_first_leaf;
+        while (leaf)
+        {
+            LeafNode* next_leaf = leaf->m_next_leaf;
+            destroyLeaf(leaf);
+            leaf = next_leaf;
+        }
+        m_root = nullptr;
+        m_first_leaf = nullptr;
+        m_size = 0;
+        m_height = 0;
+        throw;
+    }
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::LeafNode*
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::findLeaf(const DataType& value) const noexcept
+{
+    // A key of an inner node is the smallest value of the subtree to its right so the child to follow is the one
+    // after the last key that isn't greater than value
+    const void* node = m_root;
+    for (size_t level = 1; level < m_height; ++level)
+    {
+        const InnerNode* inner = static_cast<const InnerNode*>(node);
+        node = inner->children[KeySearch::UpperBound(inner->keys, inner->size, value, m_compare)];
+    }
+    return static_cast<const LeafNode*>(node);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::findPath(const DataType& value, Path& path) noexcept
+{
+    path.depth = (m_height - 1);
+    void* node = m_root;
+    for (size_t level = 0; level < path.depth; ++level)
+    {
+        InnerNode* inner = static_cast<InnerNode*>(node);
+        size_t index = KeySearch::UpperBound(inner->keys, inner->size, value, m_compare);
+        path.nodes[level] = inner;
+        path.indices[level] = index;
+        node = inner->children[index];
+    }
+    LeafNode* leaf = static_cast<LeafNode*>(node);
+    path.leaf = leaf;
+    path.index = KeySearch::LowerBound(leaf->m_data, leaf->m_size, value, m_compare);
+    return ((path.index < leaf->m_size) && !m_compare(value, leaf->m_data[path.index]));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::ConstIterator
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::iteratorAt(const LeafNode* leaf,
+    size_t index) const noexcept
+{
+    // Past the last value of a leaf is the first value of the next one, leaves are never empty
+    if (index == leaf->m_size)
+    {
+        return ConstIterator(leaf->m_next_leaf, 0);
+    }
+    return ConstIterator(leaf, index);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+template<typename Data>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::insertData(Data&& data)
+{
+    Path path;
+    if (m_root && findPath(data, path))
+    {
+        return false;
+    }
+
+    // Everything that can throw is done before the tree is modified
+    DataType value(std::forward<Data>(data));
+    DataType separator;
+    if (m_root && (path.leaf->m_size == leaf_capacity))
+    {
+        separator = SplitSeparator(path, value);
+    }
+    void* blocks[max_height + 1];
+    size_t block_count = newNodeCount(path);
+    size_t i = 0;
+    try
+    {
+        for (; i < block_count; ++i)
+        {
+            blocks[i] = m_allocator.allocate(BlockSize());
+        }
+    }
+    catch (...)
+    {
+        while (i-- > 0)
+        {
+            m_allocator.deallocate(blocks[i], BlockSize());
+        }
+        throw;
+    }
+
+    insertAt(path, value, separator, blocks);
+    return true;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+template<typename Data>
+bool Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::insertData(Data&& data, Error& error) noexcept
+{
+    static_assert(std::is_nothrow_copy_assignable<DataType>::value,
+        "DataType must be nothrow copy assignable to be inserted without exceptions, a leaf split copies a value");
+
+    Path path;
+    if (m_root && findPath(data, path))
+    {
+        return false;
+    }
+
+    DataType value(std::forward<Data>(data));
+    DataType separator;
+    if (m_root && (path.leaf->m_size == leaf_capacity))
+    {
+        separator = SplitSeparator(path, value);
+    }
+    void* blocks[max_height + 1];
+    size_t block_count = newNodeCount(path);
+    for (size_t i = 0; i < block_count; ++i)
+    {
+        blocks[i] = m_allocator.allocate(BlockSize(), error);
+        if (!blocks[i])
+        {
+            while (i-- > 0)
+            {
+                m_allocator.deallocate(blocks[i], BlockSize());
+            }
+            return false;
+        }
+    }
+
+    insertAt(path, value, separator, blocks);
+    return true;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+size_t Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::newNodeCount(const Path& path) const noexcept
+{
+    if (!m_root)
+    {
+        return 1;
+    }
+    if (path.leaf->m_size < leaf_capacity)
+    {
+        return 0;
+    }
+
+    // The splits go up until a node has room for one more key, a new root is needed if there is none
+    size_t count = 1;
+    for (size_t level = path.depth; level-- > 0;)
+    {
+        if (path.nodes[level]->size < inner_capacity)
+        {
+            return count;
+        }
+        ++count;
+    }
+    return (count + 1);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+const DataType& Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::SplitSeparator(const Path& path,
+    const DataType& value) noexcept
+{
+    // The first value of the new leaf, see SplitLeaf
+    size_t left_size = ((leaf_capacity + 1) / 2);
+    if (path.index < left_size)
+    {
+        return path.leaf->m_data[left_size - 1];
+    }
+    else if (path.index == left_size)
+    {
+        return value;
+    }
+    else
+    {
+        return path.leaf->m_data[left_size];
+    }
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::insertAt(Path& path, DataType& value,
+    DataType& separator, void** blocks) noexcept
+{
+    ++m_size;
+    if (!m_root)
+    {
+        LeafNode* leaf = createLeaf(blocks[0]);
+        leaf->m_data[0] = std::move(value);
+        leaf->m_size = 1;
+        m_root = leaf;
+        m_first_leaf = leaf;
+        m_height = 1;
+        return;
+    }
+
+    LeafNode* leaf = path.leaf;
+    if (leaf->m_size < leaf_capacity)
+    {
+        std::move_backward(leaf->m_data + path.index, leaf->m_data + leaf->m_size, leaf->m_data + leaf->m_size + 1);
+        leaf->m_data[path.index] = std::move(value);
+        ++leaf->m_size;
+        return;
+    }
+
+    size_t block_index = 0;
+    LeafNode* new_leaf = createLeaf(blocks[block_index++]);
+    SplitLeaf(leaf, path.index, value, new_leaf);
+
+    // Each split adds a key and a child to the parent, which may have to be split in turn
+    void* new_child = new_leaf;
+    for (size_t level = path.depth; level-- > 0;)
+    {
+        InnerNode* inner = path.nodes[level];
+        size_t index = path.indices[level];
+        if (inner->size < inner_capacity)
+        {
+            std::move_backward(inner->keys + index, inner->keys + inner->size, inner->keys + inner->size + 1);
+            inner->keys[index] = std::move(separator);
+            std::move_backward(inner->children + index + 1, inner->children + inner->size + 1,
+                inner->children + inner->size + 2);
+            inner->children[index + 1] = new_child;
+            ++inner->size;
+            return;
+        }
+
+        InnerNode* new_inner = createInnerNode(blocks[block_index++]);
+        SplitInner(inner, index, separator, new_child, new_inner);
+        new_child = new_inner;
+    }
+
+    InnerNode* new_root = createInnerNode(blocks[block_index]);
+    new_root->keys[0] = std::move(separator);
+    new_root->children[0] = m_root;
+    new_root->children[1] = new_child;
+    new_root->size = 1;
+    m_root = new_root;
+    ++m_height;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::SplitLeaf(LeafNode* leaf, size_t index,
+    DataType& value, LeafNode* new_leaf) noexcept
+{
+    // The leaf keeps the first left_size of its values plus value, the others go to new_leaf
+    size_t left_size = ((leaf_capacity + 1) / 2);
+    size_t right_size = ((leaf_capacity + 1) - left_size);
+    if (index < left_size)
+    {
+        std::move(leaf->m_data + leaf_capacity - right_size, leaf->m_data + leaf_capacity, new_leaf->m_data);
+        std::move_backward(leaf->m_data + index, leaf->m_data + leaf_capacity - right_size,
+            leaf->m_data + leaf_capacity - right_size + 1);
+        leaf->m_data[index] = std::move(value);
+    }
+    else
+    {
+        size_t new_index = (index - left_size);
+        std::move(leaf->m_data + left_size, leaf->m_data + index, new_leaf->m_data);
+        new_leaf->m_data[new_index] = std::move(value);
+        std::move(leaf->m_data + index, leaf->m_data + leaf_capacity, new_leaf->m_data + new_index + 1);
+    }
+    leaf->m_size = left_size;
+    new_leaf->m_size = right_size;
+    new_leaf->m_next_leaf = leaf->m_next_leaf;
+    leaf->m_next_leaf = new_leaf;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::SplitInner(InnerNode* inner, size_t index,
+    DataType& separator, void* new_child, InnerNode* new_inner) noexcept
+{
+    // Think of the keys and children as they would be with separator inserted at index and new_child at index + 1.
+    // The first left_size keys and left_size + 1 children stay in inner, the next key moves up and the rest go to
+    // new_inner. The right keys are moved first since the left keys may have to be shifted over them.
+    size_t left_size = (inner_capacity / 2);
+    auto key = [inner, index, &separator](size_t i) -> DataType&
+    {
+        return ((i < index) ? inner->keys[i] : ((i == index) ? separator : inner->keys[i - 1]));
+    };
+
+    for (size_t i = (left_size + 1); i <= inner_capacity; ++i)
+    {
+        new_inner->keys[i - left_size - 1] = std::move(key(i));
+    }
+    new_inner->size = (inner_capacity - left_size);
+
+    DataType moved_up_key = std::move(key(left_size));
+    if (index < left_size)
+    {
+        std::move_backward(inner->keys + index, inner->keys + left_size - 1, inner->keys + left_size);
+        inner->keys[index] = std::move(separator);
+    }
+    inner->size = left_size;
+
+    // The children are only pointers so they are gathered in order before being split
+    void* children[inner_capacity + 2];
+    std::copy(inner->children, inner->children + index + 1, children);
+    children[index + 1] = new_child;
+    std::copy(inner->children + index + 1, inner->children + inner_capacity + 1, children + index + 2);
+    std::copy(children, children + left_size + 1, inner->children);
+    std::copy(children + left_size + 1, children + inner_capacity + 2, new_inner->children);
+    separator = std::move(moved_up_key);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::rebalanceInnerNodes(Path& path) noexcept
+{
+    for (size_t level = (path.depth - 1); level > 0; --level)
+    {
+        InnerNode* inner = path.nodes[level];
+        if (inner->size >= min_inner_size)
+        {
+            return;
+        }
+
+        // As for the leaves a key is taken from a sibling if it can spare one, through the parent since the key
+        // between the two nodes in the parent has to change too. Otherwise the node is merged with a sibling and
+        // the key between them in the parent comes down between their keys.
+        InnerNode* parent = path.nodes[level - 1];
+        size_t child_index = path.indices[level - 1];
+        InnerNode* left_sibling =
+            ((child_index > 0) ? static_cast<InnerNode*>(parent->children[child_index - 1]) : nullptr);
+        InnerNode* right_sibling =
+            ((child_index < parent->size) ? static_cast<InnerNode*>(parent->children[child_index + 1]) : nullptr);
+        if (left_sibling && (left_sibling->size > min_inner_size))
+        {
+            std::move_backward(inner->keys, inner->keys + inner->size, inner->keys + inner->size + 1);
+            std::move_backward(inner->children, inner->children + inner->size + 1,
+                inner->children + inner->size + 2);
+            inner->keys[0] = std::move(parent->keys[child_index - 1]);
+            inner->children[0] = left_sibling->children[left_sibling->size];
+            parent->keys[child_index - 1] = std::move(left_sibling->keys[left_sibling->size - 1]);
+            --left_sibling->size;
+            ++inner->size;
+            return;
+        }
+        if (right_sibling && (right_sibling->size > min_inner_size))
+        {
+            inner->keys[inner->size] = std::move(parent->keys[child_index]);
+            inner->children[inner->size + 1] = right_sibling->children[0];
+            parent->keys[child_index] = std::move(right_sibling->keys[0]);
+            std::move(right_sibling->keys + 1, right_sibling->keys + right_sibling->size, right_sibling->keys);
+            std::move(right_sibling->children + 1, right_sibling->children + right_sibling->size + 1,
+                right_sibling->children);
+            --right_sibling->size;
+            ++inner->size;
+            return;
+        }
+
+        InnerNode* left_node = inner;
+        InnerNode* right_node = right_sibling;
+        size_t key_index = child_index;
+        if (left_sibling)
+        {
+            left_node = left_sibling;
+            right_node = inner;
+            key_index = (child_index - 1);
+        }
+        left_node->keys[left_node->size] = std::move(parent->keys[key_index]);
+        std::move(right_node->keys, right_node->keys + right_node->size, left_node->keys + left_node->size + 1);
+        std::copy(right_node->children, right_node->children + right_node->size + 1,
+            left_node->children + left_node->size + 1);
+        left_node->size += (right_node->size + 1);
+        destroyInnerNode(right_node);
+        RemoveEntry(parent, key_index);
+    }
+
+    // The root can have a single child, it is only removed when it has none left
+    InnerNode* root = path.nodes[0];
+    if (root->size == 0)
+    {
+        m_root = root->children[0];
+        destroyInnerNode(root);
+        --m_height;
+    }
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::RemoveEntry(InnerNode* inner,
+    size_t key_index) noexcept
+{
+    // Removes the key at key_index and the child to its right
+    std::move(inner->keys + key_index + 1, inner->keys + inner->size, inner->keys + key_index);
+    std::copy(inner->children + key_index + 2, inner->children + inner->size + 1, inner->children + key_index + 1);
+    --inner->size;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::destroySubtree(void* node, size_t height) noexcept
+{
+    // The leaves are destroyed through the list that links them. The recursion only goes as deep as the tree, which
+    // grows logarithmically with the number of values.
+    if (height <= 1)
+    {
+        return;
+    }
+
+    InnerNode* inner = static_cast<InnerNode*>(node);
+    for (size_t i = 0; i <= inner->size; ++i)
+    {
+        destroySubtree(inner->children[i], height - 1);
+    }
+    destroyInnerNode(inner);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::countNodes(const void* node, size_t height,
+    size_t& node_count) const noexcept
+{
+    ++node_count;
+    if (height <= 1)
+    {
+        return;
+    }
+
+    const InnerNode* inner = static_cast<const InnerNode*>(node);
+    for (size_t i = 0; i <= inner->size; ++i)
+    {
+        countNodes(inner->children[i], height - 1, node_count);
+    }
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::LeafNode*
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::createLeaf(void* memory) noexcept
+{
+    return new(memory) LeafNode;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+typename Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::InnerNode*
+Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::createInnerNode(void* memory) noexcept
+{
+    return new(memory) InnerNode;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::destroyLeaf(LeafNode* leaf) noexcept
+{
+    leaf->~LeafNode();
+    m_allocator.deallocate(leaf, BlockSize());
+}
+
+template<typename DataType, typename Compare, size_t NodeSize, typename Allocator>
+void Ishiko::BPlusTree<DataType, Compare, NodeSize, Allocator>::destroyInnerNode(InnerNode* inner) noexcept
+{
+    inner->~InnerNode();
+    m_allocator.deallocate(inner, BlockSize());
+}
+
+#endif
@@ -4,14 +4,28 @@
 #ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BINARYTREE_HPP
 #define GUARD_ISHIKO_CPP_DATASTRUCTURES_BINARYTREE_HPP
 
+#include "BinaryTreeBase.hpp"
+#include "ContainerStatistics.hpp"
 #include "DataStructuresErrorCategory.hpp"
 #include "DataTypeTraits.hpp"
+#include "FrozenBinaryTree.hpp"
+#include "InPlace.hpp"
+#include "NewDeleteAllocator.hpp"
+#include "NodeDeletion.hpp"
+#include "WorkStealingPool.hpp"
 #include <Ishiko/Errors.hpp>
-#include <Ishiko/Memory.hpp>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Ishiko
 {
-    template<typename DataType, typename DataTypeTraits = DataTypeTraits<DataType>>
+    // Allocator is the node allocator, see NewDeleteAllocator.
+    template<typename DataType, typename DataTypeTraits = DataTypeTraits<DataType>,
+        typename Allocator = NewDeleteAllocator>
     class BinaryTree
     {
     public:
@@ -19,8 +33,11 @@ namespace Ishiko
         {
         public:
             Node(const DataType& data);
+            Node(DataType&& data);
             Node(const DataType& data, Error& error) noexcept;
-            ~Node() noexcept;
+            Node(DataType&& data, Error& error) noexcept;
+            template<typename... Arguments>
+            Node(InPlace, Arguments&&... arguments);
 
             const Node* parentNode() const noexcept;
             Node* parentNode() noexcept;
@@ -42,316 +59,804 @@ namespace Ishiko
             DataType m_data;
         };
 
+        // Visits the nodes in inorder. Moving from one node to the next follows the parent links so the iterators
+        // hold no state besides the node and the tree, whose root is needed to step back from end().
+        class ConstIterator
+        {
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef DataType value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const DataType* pointer;
+            typedef const DataType& reference;
+
+            ConstIterator() noexcept = default;
+            ConstIterator(const BinaryTreeBase<Node>* tree, const Node* node) noexcept;
+
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+            ConstIterator& operator++() noexcept;
+            ConstIterator operator++(int) noexcept;
+            ConstIterator& operator--() noexcept;
+            ConstIterator operator--(int) noexcept;
+            bool operator==(const ConstIterator& other) const noexcept;
+            bool operator!=(const ConstIterator& other) const noexcept;
+
+            const Node* node() const noexcept;
+
+        private:
+            const BinaryTreeBase<Node>* m_tree = nullptr;
+            const Node* m_node = nullptr;
+        };
+
+        class Iterator
+        {
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef DataType value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef DataType* pointer;
+            typedef DataType& reference;
+
+            Iterator() noexcept = default;
+            Iterator(BinaryTreeBase<Node>* tree, Node* node) noexcept;
+
+            operator ConstIterator() const noexcept;
+
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+            Iterator& operator++() noexcept;
+            Iterator operator++(int) noexcept;
+            Iterator& operator--() noexcept;
+            Iterator operator--(int) noexcept;
+            bool operator==(const Iterator& other) const noexcept;
+            bool operator!=(const Iterator& other) const noexcept;
+
+            Node* node() const noexcept;
+
+        private:
+            BinaryTreeBase<Node>* m_tree = nullptr;
+            Node* m_node = nullptr;
+        };
+
         BinaryTree() noexcept = default;
         ~BinaryTree() noexcept;
 
         bool isEmpty() const noexcept;
         Node* root();
         Node* root(Error& error) noexcept;
+        ConstIterator begin() const noexcept;
+        Iterator begin() noexcept;
+        ConstIterator end() const noexcept;
+        Iterator end() noexcept;
 
+        // See BinaryTreeBase for the traversals
         template<typename Callable>
         void doInorderTraversal(Callable&& callable) const;
-
         template<typename Callable>
         void doInorderTraversal(const Node* parent_node, Callable&& callable) const;
+        template<typename Callable>
+        void doPreorderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doPreorderTraversal(const Node* parent_node, Callable&& callable) const;
+        template<typename Callable>
+        void doPostorderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doPostorderTraversal(const Node* parent_node, Callable&& callable) const;
+        template<typename Callable>
+        void doLevelOrderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doLevelOrderTraversal(const Node* parent_node, Callable&& callable) const;
+        template<typename Callable>
+        void doLevelOrderTraversal(std::vector<const Node*>& buffer, Callable&& callable) const;
+        template<typename Callable>
+        void doLevelOrderTraversal(const Node* parent_node, std::vector<const Node*>& buffer,
+            Callable&& callable) const;
+        // See BinaryTreeBase for the parallel algorithms
+        template<typename Callable>
+        void parallelTraversal(WorkStealingPool& pool, Callable&& callable,
+            size_t grain_size = BinaryTreeBase<Node>::default_grain_size) const;
+        template<typename Result, typename Transform, typename Combine>
+        Result parallelReduce(WorkStealingPool& pool, const Result& identity, Transform&& transform, Combine&& combine,
+            size_t grain_size = BinaryTreeBase<Node>::default_grain_size) const;
+        // Copies the tree into a read-only array laid out for fast lookups, see FrozenBinaryTree. compare is the
+        // ordering the searches of the copy will use.
+        FrozenBinaryTree<DataType> freeze() const;
+        template<typename Compare>
+        FrozenBinaryTree<DataType, Compare> freeze(const Compare& compare) const;
 
         void setRoot(const DataType& data);
+        void setRoot(DataType&& data);
         void setRoot(const DataType& data, Error& error) noexcept;
+        void setRoot(DataType&& data, Error& error) noexcept;
         Node* insertLeft(const DataType& data, Node* parent_node);
+        Node* insertLeft(DataType&& data, Node* parent_node);
         // TODO
         //Node* insertLeft(const DataType& data, Node* parent_node, Error& error) noexcept;
         Node* insertRight(const DataType& data, Node* parent_node);
+        Node* insertRight(DataType&& data, Node* parent_node);
+        // Same as insertLeft and insertRight but the data of the new node is constructed in place from arguments
+        template<typename... Arguments>
+        Node* emplaceLeft(Node* parent_node, Arguments&&... arguments);
+        template<typename... Arguments>
+        Node* emplaceRight(Node* parent_node, Arguments&&... arguments);
+        void clear() noexcept;
+        // Same as clear but the values are destroyed on the threads of pool, see ClearNodes
+        void clear(WorkStealingPool& pool, size_t grain_size = BinaryTreeBase<Node>::default_grain_size) noexcept;
+
+        // Makes sure count nodes can be inserted without the allocator needing more memory from the system
+        void reserve(size_t count);
+        void reserve(size_t count, Error& error) noexcept;
+
+        // Visits every node to compute a snapshot of the memory the tree holds, see ContainerStatistics
+        ContainerStatistics statistics() const;
 
         void rotateLeft(Node* node);
         void rotateRight(Node* node);
 
     private:
-        static void linkLeftNode(Node* parent_node, Node* left_node) noexcept;
-        static void linkRightNode(Node* parent_node, Node* right_node) noexcept;
-
-        Node* m_root = nullptr;
+        template<typename... Arguments>
+        Node* createNode(Arguments&&... arguments);
+        template<typename Data>
+        Node* createNode(Data&& data, Error& error) noexcept;
+        void destroyNode(Node* node) noexcept;
+
+        BinaryTreeBase<Node> m_tree_impl;
+        Allocator m_allocator;
     };
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::Node(const DataType& data)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::Node(const DataType& data)
     : m_data(data)
 {
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::Node(const DataType& data, Error& error) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::Node(DataType&& data)
+    : m_data(std::move(data))
+{
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::Node(const DataType& data, Error& error) noexcept
     : m_data(DataTypeTraits::Copy(data, error))
 {
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::~Node() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::Node(DataType&& data, Error& error) noexcept
+    : m_data(DataTypeTraits::Move(std::move(data), error))
 {
-    delete m_left_child_node;
-    delete m_right_child_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-const typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node*
-Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::parentNode() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::Node(InPlace, Arguments&&... arguments)
+    : m_data(std::forward<Arguments>(arguments)...)
+{
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::parentNode() const noexcept
 {
     return m_parent_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node*
-Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::parentNode() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::parentNode() noexcept
 {
     return m_parent_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::setParentNode(Node* node) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::setParentNode(Node* node) noexcept
 {
     m_parent_node = node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-const typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node*
-Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::leftChildNode() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::leftChildNode() const noexcept
 {
     return m_left_child_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node*
-Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::leftChildNode() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::leftChildNode() noexcept
 {
     return m_left_child_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::setLeftChildNode(Node* node) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::setLeftChildNode(Node* node) noexcept
 {
     m_left_child_node = node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-const typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node*
-Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::rightChildNode() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::rightChildNode() const noexcept
 {
     return m_right_child_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node*
-Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::rightChildNode() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::rightChildNode() noexcept
 {
     return m_right_child_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::setRightChildNode(Node* node) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::setRightChildNode(Node* node) noexcept
 {
     m_right_child_node = node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-const DataType& Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::data() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const DataType& Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::data() const noexcept
 {
     return m_data;
 }
 
-template<typename DataType, typename DataTypeTraits>
-DataType& Ishiko::BinaryTree<DataType, DataTypeTraits>::Node::data() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+DataType& Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node::data() noexcept
 {
     return m_data;
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::BinaryTree<DataType, DataTypeTraits>::~BinaryTree() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::ConstIterator(const BinaryTreeBase<Node>* tree,
+    const Node* node) noexcept
+    : m_tree(tree), m_node(node)
+{
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::reference
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::operator*() const noexcept
+{
+    return m_node->data();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::pointer
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::operator->() const noexcept
+{
+    return &m_node->data();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator&
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::operator++() noexcept
+{
+    m_node = BinaryTreeBase<Node>::NextInorderNode(m_node);
+    return *this;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::operator++(int) noexcept
+{
+    ConstIterator result = *this;
+    m_node = BinaryTreeBase<Node>::NextInorderNode(m_node);
+    return result;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator&
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::operator--() noexcept
+{
+    if (m_node)
+    {
+        m_node = BinaryTreeBase<Node>::PreviousInorderNode(m_node);
+    }
+    else
+    {
+        m_node = BinaryTreeBase<Node>::LastInorderNode(m_tree->root());
+    }
+    return *this;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::operator--(int) noexcept
+{
+    ConstIterator result = *this;
+    --*this;
+    return result;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+bool Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::operator==(
+    const ConstIterator& other) const noexcept
+{
+    return (m_node == other.m_node);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+bool Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::operator!=(
+    const ConstIterator& other) const noexcept
+{
+    return (m_node != other.m_node);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator::node() const noexcept
+{
+    return m_node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::Iterator(BinaryTreeBase<Node>* tree,
+    Node* node) noexcept
+    : m_tree(tree), m_node(node)
+{
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::operator ConstIterator() const noexcept
+{
+    return ConstIterator(m_tree, m_node);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::reference
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::operator*() const noexcept
+{
+    return m_node->data();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::pointer
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::operator->() const noexcept
+{
+    return &m_node->data();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator&
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::operator++() noexcept
 {
-    delete m_root;
+    m_node = BinaryTreeBase<Node>::NextInorderNode(m_node);
+    return *this;
 }
 
-template<typename DataType, typename DataTypeTraits>
-bool Ishiko::BinaryTree<DataType, DataTypeTraits>::isEmpty() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::operator++(int) noexcept
 {
-    return (m_root == nullptr);
+    Iterator result = *this;
+    m_node = BinaryTreeBase<Node>::NextInorderNode(m_node);
+    return result;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node* Ishiko::BinaryTree<DataType, DataTypeTraits>::root()
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator&
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::operator--() noexcept
 {
-    if (m_root == nullptr)
+    if (m_node)
+    {
+        m_node = BinaryTreeBase<Node>::PreviousInorderNode(m_node);
+    }
+    else
+    {
+        m_node = BinaryTreeBase<Node>::LastInorderNode(m_tree->root());
+    }
+    return *this;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::operator--(int) noexcept
+{
+    Iterator result = *this;
+    --*this;
+    return result;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+bool Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::operator==(const Iterator& other) const noexcept
+{
+    return (m_node == other.m_node);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+bool Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::operator!=(const Iterator& other) const noexcept
+{
+    return (m_node != other.m_node);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator::node() const noexcept
+{
+    return m_node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::~BinaryTree() noexcept
+{
+    clear();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+bool Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::isEmpty() const noexcept
+{
+    return m_tree_impl.isEmpty();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::root()
+{
+    Node* root = m_tree_impl.root();
+    if (root == nullptr)
     {
         Throw(DataStructuresErrorCategory::Value::node_does_not_exist, "Binary tree is empty", __FILE__, __LINE__);
     }
-    return m_root;
+    return root;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node*
-Ishiko::BinaryTree<DataType, DataTypeTraits>::root(Error& error) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::root(Error& error) noexcept
 {
-    if (m_root == nullptr)
+    Node* root = m_tree_impl.root();
+    if (root == nullptr)
     {
         Fail(DataStructuresErrorCategory::Value::node_does_not_exist, "Binary tree is empty", __FILE__, __LINE__,
             error);
     }
-    return m_root;
+    return root;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::begin() const noexcept
+{
+    const Node* root = m_tree_impl.root();
+    return ConstIterator(&m_tree_impl, (root ? BinaryTreeBase<Node>::FirstInorderNode(root) : nullptr));
 }
 
-template<typename DataType, typename DataTypeTraits>
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::begin() noexcept
+{
+    Node* root = m_tree_impl.root();
+    return Iterator(&m_tree_impl, (root ? BinaryTreeBase<Node>::FirstInorderNode(root) : nullptr));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::ConstIterator
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::end() const noexcept
+{
+    return ConstIterator(&m_tree_impl, nullptr);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Iterator
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::end() noexcept
+{
+    return Iterator(&m_tree_impl, nullptr);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doInorderTraversal(Callable&& callable) const
+{
+    m_tree_impl.doInorderTraversal(std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doInorderTraversal(const Node* parent_node,
+    Callable&& callable) const
+{
+    m_tree_impl.doInorderTraversal(parent_node, std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doPreorderTraversal(Callable&& callable) const
+{
+    m_tree_impl.doPreorderTraversal(std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doPreorderTraversal(const Node* parent_node,
+    Callable&& callable) const
+{
+    m_tree_impl.doPreorderTraversal(parent_node, std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doPostorderTraversal(Callable&& callable) const
+{
+    m_tree_impl.doPostorderTraversal(std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
 template<typename Callable>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::doInorderTraversal(Callable&& callable) const
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doPostorderTraversal(const Node* parent_node,
+    Callable&& callable) const
 {
-    if (m_root)
+    m_tree_impl.doPostorderTraversal(parent_node, std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doLevelOrderTraversal(Callable&& callable) const
+{
+    m_tree_impl.doLevelOrderTraversal(std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doLevelOrderTraversal(const Node* parent_node,
+    Callable&& callable) const
+{
+    m_tree_impl.doLevelOrderTraversal(parent_node, std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doLevelOrderTraversal(
+    std::vector<const Node*>& buffer, Callable&& callable) const
+{
+    m_tree_impl.doLevelOrderTraversal(buffer, std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::doLevelOrderTraversal(const Node* parent_node,
+    std::vector<const Node*>& buffer, Callable&& callable) const
+{
+    m_tree_impl.doLevelOrderTraversal(parent_node, buffer, std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::parallelTraversal(WorkStealingPool& pool,
+    Callable&& callable, size_t grain_size) const
+{
+    m_tree_impl.parallelTraversal(pool, std::forward<Callable>(callable), grain_size);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Result, typename Transform, typename Combine>
+Result Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::parallelReduce(WorkStealingPool& pool,
+    const Result& identity, Transform&& transform, Combine&& combine, size_t grain_size) const
+{
+    return m_tree_impl.parallelReduce(pool, identity, std::forward<Transform>(transform),
+        std::forward<Combine>(combine), grain_size);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::FrozenBinaryTree<DataType> Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::freeze() const
+{
+    return FrozenBinaryTree<DataType>(m_tree_impl.root());
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Compare>
+Ishiko::FrozenBinaryTree<DataType, Compare>
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::freeze(const Compare& compare) const
+{
+    return FrozenBinaryTree<DataType, Compare>(m_tree_impl.root(), compare);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::setRoot(const DataType& data)
+{
+    Node* root = m_tree_impl.root();
+    if (root)
+    {
+        root->data() = data;
+    }
+    else
     {
-        doInorderTraversal(m_root, std::forward<Callable>(callable));
+        m_tree_impl.setRoot(createNode(data));
     }
 }
 
-template<typename DataType, typename DataTypeTraits>
-template<typename Callable>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::doInorderTraversal(const Node* parent_node, Callable&& callable) const
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::setRoot(DataType&& data)
 {
-    // TODO: get rid of recursions
-    if (parent_node->leftChildNode())
+    Node* root = m_tree_impl.root();
+    if (root)
     {
-        doInorderTraversal(parent_node->leftChildNode(), callable);
+        root->data() = std::move(data);
     }
-    callable(parent_node->data());
-    if (parent_node->rightChildNode())
+    else
     {
-        doInorderTraversal(parent_node->rightChildNode(), callable);
+        m_tree_impl.setRoot(createNode(std::move(data)));
     }
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::setRoot(const DataType& data)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::setRoot(const DataType& data, Error& error) noexcept
 {
-    if (m_root == nullptr)
+    Node* root = m_tree_impl.root();
+    if (root)
     {
-        m_root = new Node(data);
+        root->data() = data;
     }
     else
     {
-        m_root->data() = data;
+        m_tree_impl.setRoot(createNode(data, error));
     }
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::setRoot(const DataType& data, Error& error) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::setRoot(DataType&& data, Error& error) noexcept
 {
-    if (m_root == nullptr)
+    Node* root = m_tree_impl.root();
+    if (root)
     {
-        m_root = NewObject<Node>(error, data, error);
+        root->data() = std::move(data);
     }
     else
     {
-        m_root->data() = data;
+        m_tree_impl.setRoot(createNode(std::move(data), error));
     }
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node*
-Ishiko::BinaryTree<DataType, DataTypeTraits>::insertLeft(const DataType& data, Node* parent_node)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::insertLeft(const DataType& data, Node* parent_node)
 {
-    Node* existing_left_node = parent_node->leftChildNode();
-    Node* new_node = new Node(data);
-    linkLeftNode(new_node, existing_left_node);
-    linkLeftNode(parent_node, new_node);
+    return emplaceLeft(parent_node, data);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::insertLeft(DataType&& data, Node* parent_node)
+{
+    return emplaceLeft(parent_node, std::move(data));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::insertRight(const DataType& data, Node* parent_node)
+{
+    return emplaceRight(parent_node, data);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::insertRight(DataType&& data, Node* parent_node)
+{
+    return emplaceRight(parent_node, std::move(data));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::emplaceLeft(Node* parent_node, Arguments&&... arguments)
+{
+    Node* new_node = createNode(std::forward<Arguments>(arguments)...);
+    m_tree_impl.insertLeft(new_node, parent_node);
     return new_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::BinaryTree<DataType, DataTypeTraits>::Node*
-Ishiko::BinaryTree<DataType, DataTypeTraits>::insertRight(const DataType& data, Node* parent_node)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::emplaceRight(Node* parent_node, Arguments&&... arguments)
 {
-    Node* existing_right_node = parent_node->rightChildNode();
-    Node* new_node = new Node(data);
-    linkRightNode(new_node, existing_right_node);
-    linkRightNode(parent_node, new_node);
+    Node* new_node = createNode(std::forward<Arguments>(arguments)...);
+    m_tree_impl.insertRight(new_node, parent_node);
     return new_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::rotateLeft(Node* node)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::clear() noexcept
+{
+    ClearNodes<Node>(m_allocator, [this]() { m_tree_impl.clear([this](Node* node) { destroyNode(node); }); },
+        [this]() { m_tree_impl.setRoot(nullptr); });
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::clear(WorkStealingPool& pool, size_t grain_size) noexcept
 {
-    Node* right_child_node = node->rightChildNode();
-    if (!right_child_node)
+    if (pool.workerCount() == 0)
     {
-        Throw(DataStructuresErrorCategory::Value::right_child_node_does_not_exist,
-            "Left rotation requires a right child node", __FILE__, __LINE__);
+        clear();
+        return;
     }
 
-    Node* parent_node = node->parentNode();
-    if (parent_node)
-    {
-        if (parent_node->leftChildNode() == node)
-        {
-            linkLeftNode(parent_node, right_child_node);
-        }
-        else
+    // Once their data has been destroyed the nodes don't need to be destroyed, only deallocated
+    ClearNodes<Node>(m_allocator,
+        [this, &pool, grain_size]()
         {
-            linkRightNode(parent_node, right_child_node);
-        }
-    }
-    else
-    {
-        m_root = right_child_node;
-        right_child_node->setParentNode(nullptr);
-    }
-    linkRightNode(node, right_child_node->leftChildNode());
-    linkLeftNode(right_child_node, node);
+            m_tree_impl.destroyValues(pool, [](Node* node) { node->data().~DataType(); }, grain_size);
+        },
+        [this]() { m_tree_impl.clear([this](Node* node) { m_allocator.deallocate(node, sizeof(Node)); }); },
+        [this]() { m_tree_impl.setRoot(nullptr); });
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::rotateRight(Node* node)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::reserve(size_t count)
 {
-    Node* left_child_node = node->leftChildNode();
-    if (!left_child_node)
-    {
-        Throw(DataStructuresErrorCategory::Value::left_child_node_does_not_exist,
-            "Right rotation requires a left child node", __FILE__, __LINE__);
-    }
+    m_allocator.reserve(count, sizeof(Node));
+}
 
-    Node* parent_node = node->parentNode();
-    if (parent_node)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::reserve(size_t count, Error& error) noexcept
+{
+    m_allocator.reserve(count, sizeof(Node), error);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::ContainerStatistics Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::statistics() const
+{
+    ContainerStatistics statistics;
+    AddTreeStatistics(m_tree_impl.root(), sizeof(Node), statistics);
+    AddAllocationStatistics(m_allocator, statistics);
+    return statistics;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::createNode(Arguments&&... arguments)
+{
+    void* memory = m_allocator.allocate(sizeof(Node));
+    try
     {
-        if (parent_node->leftChildNode() == node)
-        {
-            linkLeftNode(parent_node, left_child_node);
-        }
-        else
-        {
-            linkRightNode(parent_node, left_child_node);
-        }
+        return new(memory) Node(InPlace(), std::forward<Arguments>(arguments)...);
     }
-    else
+    catch (...)
     {
-        m_root = left_child_node;
-        left_child_node->setParentNode(nullptr);
+        m_allocator.deallocate(memory, sizeof(Node));
+        throw;
     }
-    linkLeftNode(node, left_child_node->rightChildNode());
-    linkRightNode(left_child_node, node);
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::linkLeftNode(Node* parent_node, Node* left_node) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Data>
+typename Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::createNode(Data&& data, Error& error) noexcept
 {
-    parent_node->setLeftChildNode(left_node);
-    if (left_node)
+    void* memory = m_allocator.allocate(sizeof(Node), error);
+    if (!memory)
     {
-        left_node->setParentNode(parent_node);
+        return nullptr;
     }
+    Node* node = new(memory) Node(std::forward<Data>(data), error);
+    if (error)
+    {
+        destroyNode(node);
+        return nullptr;
+    }
+    return node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::BinaryTree<DataType, DataTypeTraits>::linkRightNode(Node* parent_node, Node* right_node) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::destroyNode(Node* node) noexcept
 {
-    parent_node->setRightChildNode(right_node);
-    if (right_node)
-    {
-        right_node->setParentNode(parent_node);
-    }
+    node->~Node();
+    m_allocator.deallocate(node, sizeof(Node));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::rotateLeft(Node* node)
+{
+    m_tree_impl.rotateLeft(node);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::BinaryTree<DataType, DataTypeTraits, Allocator>::rotateRight(Node* node)
+{
+    m_tree_impl.rotateRight(node);
 }
 
 #endif
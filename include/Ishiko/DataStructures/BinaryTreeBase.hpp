@@ -0,0 +1,882 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_BINARYTREEBASE_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_BINARYTREEBASE_HPP
+
+#include "DataStructuresErrorCategory.hpp"
+#include "NodeDeletion.hpp"
+#include "WorkStealingPool.hpp"
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace Ishiko
+{
+    // The linking logic of a binary tree whose nodes know their parent. The base doesn't own the nodes, the tree
+    // using it decides how they are allocated and destroyed.
+    template<class Node>
+    class BinaryTreeBase
+    {
+    public:
+        bool isEmpty() const noexcept;
+        const Node* root() const noexcept;
+        Node* root() noexcept;
+
+        // The traversals pass the data of each node to callable. The versions that take a parent_node only visit the
+        // subtree rooted at parent_node. They follow the parent links rather than recursing or keeping a stack so
+        // they need no memory whatever the shape of the tree.
+        template<typename Callable>
+        void doInorderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doInorderTraversal(const Node* parent_node, Callable&& callable) const;
+        template<typename Callable>
+        void doPreorderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doPreorderTraversal(const Node* parent_node, Callable&& callable) const;
+        template<typename Callable>
+        void doPostorderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doPostorderTraversal(const Node* parent_node, Callable&& callable) const;
+        // Without a queue the next node of a level is found by going up to the closest ancestor with an unvisited
+        // right subtree and back down. This is linear for complete and degenerate trees but would take up to
+        // O(n * h) steps for some shapes, where h is the height of the tree. Once the walk has taken more than
+        // level_order_steps_per_node steps per node visited it switches to a queue of the nodes of a level, which
+        // keeps the traversal linear at the cost of allocating the queue. The versions that take a buffer always
+        // use it as the queue, so a caller that traverses many trees can reuse the same memory.
+        static const size_t level_order_steps_per_node = 8;
+
+        template<typename Callable>
+        void doLevelOrderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doLevelOrderTraversal(const Node* parent_node, Callable&& callable) const;
+        template<typename Callable>
+        void doLevelOrderTraversal(std::vector<const Node*>& buffer, Callable&& callable) const;
+        template<typename Callable>
+        void doLevelOrderTraversal(const Node* parent_node, std::vector<const Node*>& buffer,
+            Callable&& callable) const;
+
+        // The parallel algorithms hand the subtrees of more than grain_size nodes over to the other threads of pool.
+        // Below max_fork_depth subtrees are no longer forked so that a degenerate tree doesn't nest too many tasks.
+        static const size_t default_grain_size = 1024;
+        static const size_t max_fork_depth = 64;
+
+        // Passes the data of each node to callable. The calls are made from several threads at once and in no
+        // particular order so callable must be safe to call concurrently.
+        template<typename Callable>
+        void parallelTraversal(WorkStealingPool& pool, Callable&& callable, size_t grain_size) const;
+        // Combines the results of transform for every node into one, in inorder. combine must be associative but
+        // doesn't need to be commutative so the result is the same as for a sequential inorder traversal. transform
+        // and combine are called concurrently.
+        template<typename Result, typename Transform, typename Combine>
+        Result parallelReduce(WorkStealingPool& pool, const Result& identity, Transform&& transform, Combine&& combine,
+            size_t grain_size) const;
+
+        // The functions used to walk the tree. NodePointer is either Node* or const Node*. The Next and Previous
+        // functions return nullptr at the end of the traversal of the subtree rooted at subtree_root, or of the whole
+        // tree if subtree_root is nullptr.
+        template<typename NodePointer>
+        static NodePointer FirstInorderNode(NodePointer parent_node) noexcept;
+        template<typename NodePointer>
+        static NodePointer LastInorderNode(NodePointer parent_node) noexcept;
+        template<typename NodePointer>
+        static NodePointer NextInorderNode(NodePointer node, const Node* subtree_root = nullptr) noexcept;
+        template<typename NodePointer>
+        static NodePointer PreviousInorderNode(NodePointer node, const Node* subtree_root = nullptr) noexcept;
+        template<typename NodePointer>
+        static NodePointer NextPreorderNode(NodePointer node, const Node* subtree_root = nullptr) noexcept;
+        template<typename NodePointer>
+        static NodePointer FirstPostorderNode(NodePointer parent_node) noexcept;
+        template<typename NodePointer>
+        static NodePointer NextPostorderNode(NodePointer node, const Node* subtree_root = nullptr) noexcept;
+
+        void setRoot(Node* node) noexcept;
+        // Makes new_node the left child of parent_node. The existing left subtree becomes the left subtree of
+        // new_node.
+        void insertLeft(Node* new_node, Node* parent_node) noexcept;
+        // Makes new_node the right child of parent_node. The existing right subtree becomes the right subtree of
+        // new_node.
+        void insertRight(Node* new_node, Node* parent_node) noexcept;
+        // Unlinks all the nodes and passes each of them to deleter
+        template<typename Deleter>
+        void clear(Deleter&& deleter) noexcept;
+        // Passes every node to destroy_value on the threads of pool, splitting the tree like parallelTraversal.
+        // destroy_value must only destroy the data of the node so that the links can still be followed, to
+        // deallocate the nodes with clear afterwards. A subtree the pool can't take is handled by the calling thread.
+        template<typename ValueDestroyer>
+        void destroyValues(WorkStealingPool& pool, ValueDestroyer&& destroy_value, size_t grain_size) noexcept;
+
+        void rotateLeft(Node* node);
+        void rotateRight(Node* node);
+
+    private:
+        static bool HasMoreNodesThan(const Node* parent_node, size_t count) noexcept;
+        template<typename Callable>
+        static void ParallelTraversal(WorkStealingPool& pool, const Node* parent_node, Callable& callable,
+            size_t grain_size, size_t fork_depth);
+        template<typename Result, typename Transform, typename Combine>
+        static Result ParallelReduce(WorkStealingPool& pool, const Node* parent_node, const Result& identity,
+            Transform& transform, Combine& combine, size_t grain_size, size_t fork_depth);
+        template<typename ValueDestroyer>
+        static void DestroyValues(WorkStealingPool& pool, Node* parent_node, ValueDestroyer& destroy_value,
+            size_t grain_size, size_t fork_depth) noexcept;
+        // The leftmost node depth levels below parent_node, or nullptr if the subtree isn't that deep. The number of
+        // nodes walked through is added to steps.
+        static const Node* FirstNodeAtDepth(const Node* parent_node, size_t depth, size_t& steps) noexcept;
+        // The node to the right of node at the same depth in the subtree rooted at subtree_root. The number of nodes
+        // walked through is added to steps.
+        static const Node* NextNodeAtSameDepth(const Node* node, const Node* subtree_root, size_t& steps) noexcept;
+        // Replaces the nodes of a level in buffer by their children, in order
+        static void NextLevel(std::vector<const Node*>& buffer);
+        // Visits the levels below the one in buffer
+        template<typename Callable>
+        static void VisitLevelsBelow(std::vector<const Node*>& buffer, Callable& callable);
+        static void linkLeftNode(Node* parent_node, Node* left_node) noexcept;
+        static void linkRightNode(Node* parent_node, Node* right_node) noexcept;
+
+        Node* m_root = nullptr;
+    };
+}
+
+template<class Node>
+bool Ishiko::BinaryTreeBase<Node>::isEmpty() const noexcept
+{
+    return (m_root == nullptr);
+}
+
+template<class Node>
+const Node* Ishiko::BinaryTreeBase<Node>::root() const noexcept
+{
+    return m_root;
+}
+
+template<class Node>
+Node* Ishiko::BinaryTreeBase<Node>::root() noexcept
+{
+    return m_root;
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doInorderTraversal(Callable&& callable) const
+{
+    if (m_root)
+    {
+        doInorderTraversal(m_root, std::forward<Callable>(callable));
+    }
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doInorderTraversal(const Node* parent_node, Callable&& callable) const
+{
+    for (const Node* node = FirstInorderNode(parent_node); node; node = NextInorderNode(node, parent_node))
+    {
+        callable(node->data());
+    }
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doPreorderTraversal(Callable&& callable) const
+{
+    if (m_root)
+    {
+        doPreorderTraversal(m_root, std::forward<Callable>(callable));
+    }
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doPreorderTraversal(const Node* parent_node, Callable&& callable) const
+{
+    for (const Node* node = parent_node; node; node = NextPreorderNode(node, parent_node))
+    {
+        callable(node->data());
+    }
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doPostorderTraversal(Callable&& callable) const
+{
+    if (m_root)
+    {
+        doPostorderTraversal(m_root, std::forward<Callable>(callable));
+    }
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doPostorderTraversal(const Node* parent_node, Callable&& callable) const
+{
+    for (const Node* node = FirstPostorderNode(parent_node); node; node = NextPostorderNode(node, parent_node))
+    {
+        callable(node->data());
+    }
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doLevelOrderTraversal(Callable&& callable) const
+{
+    if (m_root)
+    {
+        doLevelOrderTraversal(m_root, std::forward<Callable>(callable));
+    }
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doLevelOrderTraversal(const Node* parent_node, Callable&& callable) const
+{
+    // When a level has a single node all the levels below it are in its subtree so the searches for the next node
+    // don't need to go higher than that node. This keeps the traversal of a degenerate tree linear.
+    const Node* subtree_root = parent_node;
+    const Node* first_node_of_level = parent_node;
+    size_t depth = 0;
+    size_t visited_count = 0;
+    size_t steps = 0;
+    while (first_node_of_level)
+    {
+        const Node* first_node_of_next_level = nullptr;
+        const Node* node = first_node_of_level;
+        size_t level_size = 0;
+        while (node)
+        {
+            callable(node->data());
+            ++level_size;
+            ++visited_count;
+            if (!first_node_of_next_level)
+            {
+                first_node_of_next_level = (node->leftChildNode() ? node->leftChildNode() : node->rightChildNode());
+            }
+            const Node* next_node = NextNodeAtSameDepth(node, subtree_root, steps);
+            if (next_node && (steps > (level_order_steps_per_node * visited_count)))
+            {
+                // Rebuild the current level with a queue, which costs no more than the nodes visited so far, and
+                // finish the traversal from there
+                std::vector<const Node*> buffer(1, parent_node);
+                for (size_t i = 0; i < depth; ++i)
+                {
+                    NextLevel(buffer);
+                }
+                typename std::vector<const Node*>::const_iterator it = buffer.begin();
+                while (*it != node)
+                {
+                    ++it;
+                }
+                for (++it; it != buffer.end(); ++it)
+                {
+                    callable((*it)->data());
+                }
+                VisitLevelsBelow(buffer, callable);
+                return;
+            }
+            node = next_node;
+        }
+        if (level_size == 1)
+        {
+            subtree_root = first_node_of_level;
+        }
+        first_node_of_level = first_node_of_next_level;
+        ++depth;
+    }
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doLevelOrderTraversal(std::vector<const Node*>& buffer, Callable&& callable) const
+{
+    if (m_root)
+    {
+        doLevelOrderTraversal(m_root, buffer, std::forward<Callable>(callable));
+    }
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::doLevelOrderTraversal(const Node* parent_node, std::vector<const Node*>& buffer,
+    Callable&& callable) const
+{
+    buffer.assign(1, parent_node);
+    callable(parent_node->data());
+    VisitLevelsBelow(buffer, callable);
+}
+
+template<class Node>
+const size_t Ishiko::BinaryTreeBase<Node>::level_order_steps_per_node;
+
+template<class Node>
+const size_t Ishiko::BinaryTreeBase<Node>::default_grain_size;
+
+template<class Node>
+const size_t Ishiko::BinaryTreeBase<Node>::max_fork_depth;
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::parallelTraversal(WorkStealingPool& pool, Callable&& callable,
+    size_t grain_size) const
+{
+    if (m_root)
+    {
+        ParallelTraversal(pool, m_root, callable, grain_size, max_fork_depth);
+    }
+}
+
+template<class Node>
+template<typename Result, typename Transform, typename Combine>
+Result Ishiko::BinaryTreeBase<Node>::parallelReduce(WorkStealingPool& pool, const Result& identity,
+    Transform&& transform, Combine&& combine, size_t grain_size) const
+{
+    if (m_root)
+    {
+        return ParallelReduce(pool, m_root, identity, transform, combine, grain_size, max_fork_depth);
+    }
+    else
+    {
+        return identity;
+    }
+}
+
+template<class Node>
+template<typename NodePointer>
+NodePointer Ishiko::BinaryTreeBase<Node>::FirstInorderNode(NodePointer parent_node) noexcept
+{
+    NodePointer node = parent_node;
+    while (node->leftChildNode())
+    {
+        node = node->leftChildNode();
+    }
+    return node;
+}
+
+template<class Node>
+template<typename NodePointer>
+NodePointer Ishiko::BinaryTreeBase<Node>::LastInorderNode(NodePointer parent_node) noexcept
+{
+    NodePointer node = parent_node;
+    while (node->rightChildNode())
+    {
+        node = node->rightChildNode();
+    }
+    return node;
+}
+
+template<class Node>
+template<typename NodePointer>
+NodePointer Ishiko::BinaryTreeBase<Node>::NextInorderNode(NodePointer node, const Node* subtree_root) noexcept
+{
+    if (node->rightChildNode())
+    {
+        return FirstInorderNode(node->rightChildNode());
+    }
+
+    // The next node is the first ancestor whose left subtree node is in
+    while (node != subtree_root)
+    {
+        NodePointer parent_node = node->parentNode();
+        if (!parent_node)
+        {
+            break;
+        }
+        if (parent_node->leftChildNode() == node)
+        {
+            return parent_node;
+        }
+        node = parent_node;
+    }
+    return nullptr;
+}
+
+template<class Node>
+template<typename NodePointer>
+NodePointer Ishiko::BinaryTreeBase<Node>::PreviousInorderNode(NodePointer node, const Node* subtree_root) noexcept
+{
+    if (node->leftChildNode())
+    {
+        return LastInorderNode(node->leftChildNode());
+    }
+
+    // The previous node is the first ancestor whose right subtree node is in
+    while (node != subtree_root)
+    {
+        NodePointer parent_node = node->parentNode();
+        if (!parent_node)
+        {
+            break;
+        }
+        if (parent_node->rightChildNode() == node)
+        {
+            return parent_node;
+        }
+        node = parent_node;
+    }
+    return nullptr;
+}
+
+template<class Node>
+template<typename NodePointer>
+NodePointer Ishiko::BinaryTreeBase<Node>::NextPreorderNode(NodePointer node, const Node* subtree_root) noexcept
+{
+    if (node->leftChildNode())
+    {
+        return node->leftChildNode();
+    }
+    if (node->rightChildNode())
+    {
+        return node->rightChildNode();
+    }
+
+    // The next node is the right child of the first ancestor that has one and whose left subtree node is in
+    while (node != subtree_root)
+    {
+        NodePointer parent_node = node->parentNode();
+        if (!parent_node)
+        {
+            break;
+        }
+        if ((parent_node->leftChildNode() == node) && parent_node->rightChildNode())
+        {
+            return parent_node->rightChildNode();
+        }
+        node = parent_node;
+    }
+    return nullptr;
+}
+
+template<class Node>
+template<typename NodePointer>
+NodePointer Ishiko::BinaryTreeBase<Node>::FirstPostorderNode(NodePointer parent_node) noexcept
+{
+    NodePointer node = parent_node;
+    while (true)
+    {
+        if (node->leftChildNode())
+        {
+            node = node->leftChildNode();
+        }
+        else if (node->rightChildNode())
+        {
+            node = node->rightChildNode();
+        }
+        else
+        {
+            return node;
+        }
+    }
+}
+
+template<class Node>
+template<typename NodePointer>
+NodePointer Ishiko::BinaryTreeBase<Node>::NextPostorderNode(NodePointer node, const Node* subtree_root) noexcept
+{
+    if (node == subtree_root)
+    {
+        return nullptr;
+    }
+    NodePointer parent_node = node->parentNode();
+    if (parent_node && (parent_node->leftChildNode() == node) && parent_node->rightChildNode())
+    {
+        return FirstPostorderNode(parent_node->rightChildNode());
+    }
+    return parent_node;
+}
+
+template<class Node>
+void Ishiko::BinaryTreeBase<Node>::setRoot(Node* node) noexcept
+{
+    m_root = node;
+}
+
+template<class Node>
+void Ishiko::BinaryTreeBase<Node>::insertLeft(Node* new_node, Node* parent_node) noexcept
+{
+    linkLeftNode(new_node, parent_node->leftChildNode());
+    new_node->setRightChildNode(nullptr);
+    linkLeftNode(parent_node, new_node);
+}
+
+template<class Node>
+void Ishiko::BinaryTreeBase<Node>::insertRight(Node* new_node, Node* parent_node) noexcept
+{
+    linkRightNode(new_node, parent_node->rightChildNode());
+    new_node->setLeftChildNode(nullptr);
+    linkRightNode(parent_node, new_node);
+}
+
+template<class Node>
+template<typename Deleter>
+void Ishiko::BinaryTreeBase<Node>::clear(Deleter&& deleter) noexcept
+{
+    DeleteNodeTree(m_root, std::forward<Deleter>(deleter));
+    m_root = nullptr;
+}
+
+template<class Node>
+template<typename ValueDestroyer>
+void Ishiko::BinaryTreeBase<Node>::destroyValues(WorkStealingPool& pool, ValueDestroyer&& destroy_value,
+    size_t grain_size) noexcept
+{
+    if (m_root)
+    {
+        DestroyValues(pool, m_root, destroy_value, grain_size, max_fork_depth);
+    }
+}
+
+template<class Node>
+void Ishiko::BinaryTreeBase<Node>::rotateLeft(Node* node)
+{
+    Node* right_child_node = node->rightChildNode();
+    if (!right_child_node)
+    {
+        Throw(DataStructuresErrorCategory::Value::right_child_node_does_not_exist,
+            "Left rotation requires a right child node", __FILE__, __LINE__);
+    }
+
+    Node* parent_node = node->parentNode();
+    if (parent_node)
+    {
+        if (parent_node->leftChildNode() == node)
+        {
+            linkLeftNode(parent_node, right_child_node);
+        }
+        else
+        {
+            linkRightNode(parent_node, right_child_node);
+        }
+    }
+    else
+    {
+        m_root = right_child_node;
+        right_child_node->setParentNode(nullptr);
+    }
+    linkRightNode(node, right_child_node->leftChildNode());
+    linkLeftNode(right_child_node, node);
+}
+
+template<class Node>
+void Ishiko::BinaryTreeBase<Node>::rotateRight(Node* node)
+{
+    Node* left_child_node = node->leftChildNode();
+    if (!left_child_node)
+    {
+        Throw(DataStructuresErrorCategory::Value::left_child_node_does_not_exist,
+            "Right rotation requires a left child node", __FILE__, __LINE__);
+    }
+
+    Node* parent_node = node->parentNode();
+    if (parent_node)
+    {
+        if (parent_node->leftChildNode() == node)
+        {
+            linkLeftNode(parent_node, left_child_node);
+        }
+        else
+        {
+            linkRightNode(parent_node, left_child_node);
+        }
+    }
+    else
+    {
+        m_root = left_child_node;
+        left_child_node->setParentNode(nullptr);
+    }
+    linkLeftNode(node, left_child_node->rightChildNode());
+    linkRightNode(left_child_node, node);
+}
+
+template<class Node>
+bool Ishiko::BinaryTreeBase<Node>::HasMoreNodesThan(const Node* parent_node, size_t count) noexcept
+{
+    size_t visited_count = 0;
+    for (const Node* node = parent_node; node; node = NextPreorderNode(node, parent_node))
+    {
+        if (++visited_count > count)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::ParallelTraversal(WorkStealingPool& pool, const Node* parent_node,
+    Callable& callable, size_t grain_size, size_t fork_depth)
+{
+    // The left subtrees are forked while this thread goes down the right ones
+    WorkStealingPool::TaskGroup group;
+    std::exception_ptr exception;
+    try
+    {
+        const Node* node = parent_node;
+        while (node)
+        {
+            if ((fork_depth == 0) || !HasMoreNodesThan(node, grain_size))
+            {
+                for (const Node* subtree_node = node; subtree_node;
+                    subtree_node = NextPreorderNode(subtree_node, node))
+                {
+                    callable(subtree_node->data());
+                }
+                break;
+            }
+
+            callable(node->data());
+            --fork_depth;
+            const Node* left_child_node = node->leftChildNode();
+            if (left_child_node)
+            {
+                pool.run(group,
+                    [&pool, left_child_node, &callable, grain_size, fork_depth]()
+                    {
+                        ParallelTraversal(pool, left_child_node, callable, grain_size, fork_depth);
+                    });
+            }
+            node = node->rightChildNode();
+        }
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    // The forked tasks refer to callable so they must be finished even if this thread failed
+    pool.wait(group);
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+template<class Node>
+template<typename ValueDestroyer>
+void Ishiko::BinaryTreeBase<Node>::DestroyValues(WorkStealingPool& pool, Node* parent_node,
+    ValueDestroyer& destroy_value, size_t grain_size, size_t fork_depth) noexcept
+{
+    // Same split as ParallelTraversal
+    WorkStealingPool::TaskGroup group;
+    Node* node = parent_node;
+    while (node)
+    {
+        if ((fork_depth == 0) || !HasMoreNodesThan(node, grain_size))
+        {
+            for (Node* subtree_node = node; subtree_node; subtree_node = NextPreorderNode(subtree_node, node))
+            {
+                destroy_value(subtree_node);
+            }
+            break;
+        }
+
+        destroy_value(node);
+        --fork_depth;
+        Node* left_child_node = node->leftChildNode();
+        if (left_child_node)
+        {
+            try
+            {
+                pool.run(group,
+                    [&pool, left_child_node, &destroy_value, grain_size, fork_depth]()
+                    {
+                        DestroyValues(pool, left_child_node, destroy_value, grain_size, fork_depth);
+                    });
+            }
+            catch (...)
+            {
+                DestroyValues(pool, left_child_node, destroy_value, grain_size, 0);
+            }
+        }
+        node = node->rightChildNode();
+    }
+
+    // The tasks don't throw so this only returns once they are all done
+    pool.wait(group);
+}
+
+template<class Node>
+template<typename Result, typename Transform, typename Combine>
+Result Ishiko::BinaryTreeBase<Node>::ParallelReduce(WorkStealingPool& pool, const Node* parent_node,
+    const Result& identity, Transform& transform, Combine& combine, size_t grain_size, size_t fork_depth)
+{
+    if ((fork_depth == 0) || !HasMoreNodesThan(parent_node, grain_size))
+    {
+        Result result = identity;
+        for (const Node* node = FirstInorderNode(parent_node); node; node = NextInorderNode(node, parent_node))
+        {
+            result = combine(result, transform(node->data()));
+        }
+        return result;
+    }
+
+    // The left subtree is forked while this thread reduces the node and its right subtree
+    WorkStealingPool::TaskGroup group;
+    Result left_result = identity;
+    Result right_result = identity;
+    std::exception_ptr exception;
+    try
+    {
+        const Node* left_child_node = parent_node->leftChildNode();
+        if (left_child_node)
+        {
+            pool.run(group,
+                [&pool, left_child_node, &identity, &transform, &combine, grain_size, fork_depth, &left_result]()
+                {
+                    left_result = ParallelReduce(pool, left_child_node, identity, transform, combine, grain_size,
+                        (fork_depth - 1));
+                });
+        }
+        right_result = transform(parent_node->data());
+        const Node* right_child_node = parent_node->rightChildNode();
+        if (right_child_node)
+        {
+            right_result = combine(right_result,
+                ParallelReduce(pool, right_child_node, identity, transform, combine, grain_size, (fork_depth - 1)));
+        }
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    // The forked task refers to left_result so it must be finished even if this thread failed
+    pool.wait(group);
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+    return combine(left_result, right_result);
+}
+
+template<class Node>
+const Node* Ishiko::BinaryTreeBase<Node>::FirstNodeAtDepth(const Node* parent_node, size_t depth,
+    size_t& steps) noexcept
+{
+    // A preorder walk of the subtree that doesn't go below depth
+    const Node* node = parent_node;
+    size_t current_depth = 0;
+    while (node)
+    {
+        ++steps;
+        if (current_depth == depth)
+        {
+            return node;
+        }
+        else if (node->leftChildNode())
+        {
+            node = node->leftChildNode();
+            ++current_depth;
+            continue;
+        }
+        else if (node->rightChildNode())
+        {
+            node = node->rightChildNode();
+            ++current_depth;
+            continue;
+        }
+
+        // Go back up until there is a right subtree that hasn't been visited yet
+        const Node* next_node = nullptr;
+        while (!next_node && (node != parent_node))
+        {
+            const Node* current_parent_node = node->parentNode();
+            if ((current_parent_node->leftChildNode() == node) && current_parent_node->rightChildNode())
+            {
+                next_node = current_parent_node->rightChildNode();
+            }
+            else
+            {
+                --current_depth;
+            }
+            node = current_parent_node;
+        }
+        node = next_node;
+    }
+    return nullptr;
+}
+
+template<class Node>
+const Node* Ishiko::BinaryTreeBase<Node>::NextNodeAtSameDepth(const Node* node, const Node* subtree_root,
+    size_t& steps) noexcept
+{
+    // Go up until there is a right subtree deep enough to hold a node at the same depth. Only the part of each
+    // subtree above that depth is visited.
+    size_t height = 0;
+    while (node != subtree_root)
+    {
+        const Node* parent_node = node->parentNode();
+        ++height;
+        ++steps;
+        if ((parent_node->leftChildNode() == node) && parent_node->rightChildNode())
+        {
+            const Node* next_node = FirstNodeAtDepth(parent_node->rightChildNode(), (height - 1), steps);
+            if (next_node)
+            {
+                return next_node;
+            }
+        }
+        node = parent_node;
+    }
+    return nullptr;
+}
+
+template<class Node>
+void Ishiko::BinaryTreeBase<Node>::NextLevel(std::vector<const Node*>& buffer)
+{
+    size_t level_size = buffer.size();
+    for (size_t i = 0; i < level_size; ++i)
+    {
+        const Node* node = buffer[i];
+        if (node->leftChildNode())
+        {
+            buffer.push_back(node->leftChildNode());
+        }
+        if (node->rightChildNode())
+        {
+            buffer.push_back(node->rightChildNode());
+        }
+    }
+    buffer.erase(buffer.begin(), (buffer.begin() + level_size));
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::BinaryTreeBase<Node>::VisitLevelsBelow(std::vector<const Node*>& buffer, Callable& callable)
+{
+    while (true)
+    {
+        NextLevel(buffer);
+        if (buffer.empty())
+        {
+            break;
+        }
+        for (size_t i = 0; i < buffer.size(); ++i)
+        {
+            callable(buffer[i]->data());
+        }
+    }
+}
+
+template<class Node>
+void Ishiko::BinaryTreeBase<Node>::linkLeftNode(Node* parent_node, Node* left_node) noexcept
+{
+    parent_node->setLeftChildNode(left_node);
+    if (left_node)
+    {
+        left_node->setParentNode(parent_node);
+    }
+}
+
+template<class Node>
+void Ishiko::BinaryTreeBase<Node>::linkRightNode(Node* parent_node, Node* right_node) noexcept
+{
+    parent_node->setRightChildNode(right_node);
+    if (right_node)
+    {
+        right_node->setParentNode(parent_node);
+    }
+}
+
+#endif
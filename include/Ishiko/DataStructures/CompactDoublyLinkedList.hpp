@@ -0,0 +1,532 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_COMPACTDOUBLYLINKEDLIST_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_COMPACTDOUBLYLINKEDLIST_HPP
+
+#include "ContainerStatistics.hpp"
+#include "DataStructuresErrorCategory.hpp"
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Ishiko
+{
+    // A doubly linked list whose nodes are stored in a single growable array, the slab, and are linked by their
+    // position in it. The links are IndexType integers rather than pointers, 32 bits by default, so a list of 32 bit
+    // values uses 12 bytes per value where DoublyLinkedList uses a 24 byte node plus the allocator overhead. The
+    // nodes of erased values are kept in a free list and reused by the next insertions.
+    //
+    // Nothing in the slab depends on its address so the list is copied with a single memcpy of the slab and the slab
+    // can be moved or written out as is. This requires DataType to be trivially copyable. A value is identified by
+    // the index of its node, which stays the same until the value is erased even when the slab grows.
+    template<typename DataType, typename IndexType = uint32_t>
+    class CompactDoublyLinkedList
+    {
+        static_assert(std::is_trivially_copyable<DataType>::value, "DataType must be trivially copyable");
+        static_assert(std::is_unsigned<IndexType>::value, "IndexType must be an unsigned integer type");
+
+    public:
+        // The index of no node, returned by the functions below where a pointer based list would return nullptr
+        static const IndexType null_index = std::numeric_limits<IndexType>::max();
+
+        struct Node
+        {
+            DataType data;
+            IndexType previous_index;
+            IndexType next_index;
+        };
+
+        CompactDoublyLinkedList() noexcept = default;
+        CompactDoublyLinkedList(const CompactDoublyLinkedList& other);
+        CompactDoublyLinkedList(CompactDoublyLinkedList&& other) noexcept;
+        CompactDoublyLinkedList& operator=(const CompactDoublyLinkedList& other);
+        CompactDoublyLinkedList& operator=(CompactDoublyLinkedList&& other) noexcept;
+        ~CompactDoublyLinkedList() noexcept;
+
+        bool isEmpty() const noexcept;
+        size_t size() const noexcept;
+        // The number of nodes the slab can hold before it has to grow
+        size_t capacity() const noexcept;
+        IndexType head() const noexcept;
+        IndexType tail() const noexcept;
+        IndexType nextIndex(IndexType index) const noexcept;
+        IndexType previousIndex(IndexType index) const noexcept;
+        const DataType& data(IndexType index) const noexcept;
+        DataType& data(IndexType index) noexcept;
+
+        template<typename Callable>
+        void traverse(Callable&& callable) const;
+
+        // These return the index of the new node. The versions that take an error return null_index if the slab
+        // couldn't grow.
+        IndexType pushFront(const DataType& data);
+        IndexType pushFront(const DataType& data, Error& error) noexcept;
+        IndexType pushBack(const DataType& data);
+        IndexType pushBack(const DataType& data, Error& error) noexcept;
+        IndexType insertAfter(const DataType& data, IndexType previous_index);
+        IndexType insertAfter(const DataType& data, IndexType previous_index, Error& error) noexcept;
+        IndexType insertBefore(const DataType& data, IndexType next_index);
+        IndexType insertBefore(const DataType& data, IndexType next_index, Error& error) noexcept;
+        void popFront();
+        void popFront(Error& error) noexcept;
+        void popBack();
+        void popBack(Error& error) noexcept;
+        // Erases the value at index, which must be a node of this list. The node is reused by a later insertion.
+        void erase(IndexType index) noexcept;
+        // Erases all the values but keeps the slab
+        void clear() noexcept;
+
+        // Makes sure count values can be stored without the slab growing
+        void reserve(size_t count);
+        void reserve(size_t count, Error& error) noexcept;
+
+        // A snapshot of the memory the list holds, see ContainerStatistics. The free nodes and the unused capacity of
+        // the slab are counted as spare bytes.
+        ContainerStatistics statistics() const;
+
+    private:
+        // Returns the index of an unused node, or null_index if the slab is full and can't grow
+        IndexType newNode() noexcept;
+        // Stores data in node index and links it between previous_index and next_index, either of which can be
+        // null_index
+        void link(IndexType index, const DataType& data, IndexType previous_index, IndexType next_index) noexcept;
+        bool reallocate(size_t capacity) noexcept;
+
+        Node* m_nodes = nullptr;
+        size_t m_size = 0;
+        // The number of nodes at the start of the slab that have been used, the others have never been
+        size_t m_used_count = 0;
+        size_t m_capacity = 0;
+        IndexType m_head = null_index;
+        IndexType m_tail = null_index;
+        // The free nodes are linked through their next index
+        IndexType m_free_head = null_index;
+    };
+}
+
+template<typename DataType, typename IndexType>
+const IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::null_index;
+
+template<typename DataType, typename IndexType>
+Ishiko::CompactDoublyLinkedList<DataType, IndexType>::CompactDoublyLinkedList(const CompactDoublyLinkedList& other)
+    : m_size(other.m_size), m_used_count(other.m_used_count), m_capacity(other.m_used_count), m_head(other.m_head),
+    m_tail(other.m_tail), m_free_head(other.m_free_head)
+{
+    if (m_used_count != 0)
+    {
+        m_nodes = static_cast<Node*>(std::malloc(m_used_count * sizeof(Node)));
+        if (!m_nodes)
+        {
+            throw std::bad_alloc();
+        }
+        std::memcpy(static_cast<void*>(m_nodes), static_cast<const void*>(other.m_nodes), m_used_count * sizeof(Node));
+    }
+}
+
+template<typename DataType, typename IndexType>
+Ishiko::CompactDoublyLinkedList<DataType, IndexType>::CompactDoublyLinkedList(
+    CompactDoublyLinkedList&& other) noexcept
+    : m_nodes(other.m_nodes), m_size(other.m_size), m_used_count(other.m_used_count), m_capacity(other.m_capacity),
+    m_head(other.m_head), m_tail(other.m_tail), m_free_head(other.m_free_head)
+{
+    other.m_nodes = nullptr;
+    other.m_size = 0;
+    other.m_used_count = 0;
+    other.m_capacity = 0;
+    other.m_head = null_index;
+    other.m_tail = null_index;
+    other.m_free_head = null_index;
+}
+
+template<typename DataType, typename IndexType>
+Ishiko::CompactDoublyLinkedList<DataType, IndexType>&
+Ishiko::CompactDoublyLinkedList<DataType, IndexType>::operator=(const CompactDoublyLinkedList& other)
+{
+    if (this != &other)
+    {
+        CompactDoublyLinkedList copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template<typename DataType, typename IndexType>
+Ishiko::CompactDoublyLinkedList<DataType, IndexType>&
+Ishiko::CompactDoublyLinkedList<DataType, IndexType>::operator=(CompactDoublyLinkedList&& other) noexcept
+{
+    if (this != &other)
+    {
+        std::free(m_nodes);
+        m_nodes = other.m_nodes;
+        m_size = other.m_size;
+        m_used_count = other.m_used_count;
+        m_capacity = other.m_capacity;
+        m_head = other.m_head;
+        m_tail = other.m_tail;
+        m_free_head = other.m_free_head;
+        other.m_nodes = nullptr;
+        other.m_size = 0;
+        other.m_used_count = 0;
+        other.m_capacity = 0;
+        other.m_head = null_index;
+        other.m_tail = null_index;
+        other.m_free_head = null_index;
+    }
+    return *this;
+}
+
+template<typename DataType, typename IndexType>
+Ishiko::CompactDoublyLinkedList<DataType, IndexType>::~CompactDoublyLinkedList() noexcept
+{
+    std::free(m_nodes);
+}
+
+template<typename DataType, typename IndexType>
+bool Ishiko::CompactDoublyLinkedList<DataType, IndexType>::isEmpty() const noexcept
+{
+    return (m_size == 0);
+}
+
+template<typename DataType, typename IndexType>
+size_t Ishiko::CompactDoublyLinkedList<DataType, IndexType>::size() const noexcept
+{
+    return m_size;
+}
+
+template<typename DataType, typename IndexType>
+size_t Ishiko::CompactDoublyLinkedList<DataType, IndexType>::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::head() const noexcept
+{
+    return m_head;
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::tail() const noexcept
+{
+    return m_tail;
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::nextIndex(IndexType index) const noexcept
+{
+    return m_nodes[index].next_index;
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::previousIndex(IndexType index) const noexcept
+{
+    return m_nodes[index].previous_index;
+}
+
+template<typename DataType, typename IndexType>
+const DataType& Ishiko::CompactDoublyLinkedList<DataType, IndexType>::data(IndexType index) const noexcept
+{
+    return m_nodes[index].data;
+}
+
+template<typename DataType, typename IndexType>
+DataType& Ishiko::CompactDoublyLinkedList<DataType, IndexType>::data(IndexType index) noexcept
+{
+    return m_nodes[index].data;
+}
+
+template<typename DataType, typename IndexType>
+template<typename Callable>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::traverse(Callable&& callable) const
+{
+    IndexType index = m_head;
+    while (index != null_index)
+    {
+        const Node& node = m_nodes[index];
+        callable(node.data);
+        index = node.next_index;
+    }
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::pushFront(const DataType& data)
+{
+    return insertBefore(data, m_head);
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::pushFront(const DataType& data, Error& error) noexcept
+{
+    return insertBefore(data, m_head, error);
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::pushBack(const DataType& data)
+{
+    return insertAfter(data, m_tail);
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::pushBack(const DataType& data, Error& error) noexcept
+{
+    return insertAfter(data, m_tail, error);
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::insertAfter(const DataType& data,
+    IndexType previous_index)
+{
+    // data may be a value of this list, which growing the slab would invalidate
+    DataType value = data;
+    IndexType index = newNode();
+    if (index == null_index)
+    {
+        throw std::bad_alloc();
+    }
+    IndexType next_index = ((previous_index == null_index) ? m_head : m_nodes[previous_index].next_index);
+    link(index, value, previous_index, next_index);
+    return index;
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::insertAfter(const DataType& data,
+    IndexType previous_index, Error& error) noexcept
+{
+    DataType value = data;
+    IndexType index = newNode();
+    if (index == null_index)
+    {
+        Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to grow compact doubly linked list",
+            __FILE__, __LINE__, error);
+        return null_index;
+    }
+    IndexType next_index = ((previous_index == null_index) ? m_head : m_nodes[previous_index].next_index);
+    link(index, value, previous_index, next_index);
+    return index;
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::insertBefore(const DataType& data,
+    IndexType next_index)
+{
+    DataType value = data;
+    IndexType index = newNode();
+    if (index == null_index)
+    {
+        throw std::bad_alloc();
+    }
+    IndexType previous_index = ((next_index == null_index) ? m_tail : m_nodes[next_index].previous_index);
+    link(index, value, previous_index, next_index);
+    return index;
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::insertBefore(const DataType& data,
+    IndexType next_index, Error& error) noexcept
+{
+    DataType value = data;
+    IndexType index = newNode();
+    if (index == null_index)
+    {
+        Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to grow compact doubly linked list",
+            __FILE__, __LINE__, error);
+        return null_index;
+    }
+    IndexType previous_index = ((next_index == null_index) ? m_tail : m_nodes[next_index].previous_index);
+    link(index, value, previous_index, next_index);
+    return index;
+}
+
+template<typename DataType, typename IndexType>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::popFront()
+{
+    if (m_head == null_index)
+    {
+        Throw(DataStructuresErrorCategory::Value::node_does_not_exist, "Linked list is empty", __FILE__, __LINE__);
+    }
+    erase(m_head);
+}
+
+template<typename DataType, typename IndexType>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::popFront(Error& error) noexcept
+{
+    if (m_head == null_index)
+    {
+        Fail(DataStructuresErrorCategory::Value::node_does_not_exist, "Linked list is empty", __FILE__, __LINE__,
+            error);
+        return;
+    }
+    erase(m_head);
+}
+
+template<typename DataType, typename IndexType>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::popBack()
+{
+    if (m_tail == null_index)
+    {
+        Throw(DataStructuresErrorCategory::Value::node_does_not_exist, "Linked list is empty", __FILE__, __LINE__);
+    }
+    erase(m_tail);
+}
+
+template<typename DataType, typename IndexType>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::popBack(Error& error) noexcept
+{
+    if (m_tail == null_index)
+    {
+        Fail(DataStructuresErrorCategory::Value::node_does_not_exist, "Linked list is empty", __FILE__, __LINE__,
+            error);
+        return;
+    }
+    erase(m_tail);
+}
+
+template<typename DataType, typename IndexType>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::erase(IndexType index) noexcept
+{
+    Node& node = m_nodes[index];
+    if (node.previous_index == null_index)
+    {
+        m_head = node.next_index;
+    }
+    else
+    {
+        m_nodes[node.previous_index].next_index = node.next_index;
+    }
+    if (node.next_index == null_index)
+    {
+        m_tail = node.previous_index;
+    }
+    else
+    {
+        m_nodes[node.next_index].previous_index = node.previous_index;
+    }
+    node.previous_index = null_index;
+    node.next_index = m_free_head;
+    m_free_head = index;
+    --m_size;
+}
+
+template<typename DataType, typename IndexType>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::clear() noexcept
+{
+    // The values don't need to be destroyed so forgetting all the nodes is enough
+    m_size = 0;
+    m_used_count = 0;
+    m_head = null_index;
+    m_tail = null_index;
+    m_free_head = null_index;
+}
+
+template<typename DataType, typename IndexType>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::reserve(size_t count)
+{
+    if ((count > m_capacity) && !reallocate(count))
+    {
+        throw std::bad_alloc();
+    }
+}
+
+template<typename DataType, typename IndexType>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::reserve(size_t count, Error& error) noexcept
+{
+    if ((count > m_capacity) && !reallocate(count))
+    {
+        Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to grow compact doubly linked list",
+            __FILE__, __LINE__, error);
+    }
+}
+
+template<typename DataType, typename IndexType>
+Ishiko::ContainerStatistics Ishiko::CompactDoublyLinkedList<DataType, IndexType>::statistics() const
+{
+    ContainerStatistics statistics;
+    statistics.element_count = m_size;
+    statistics.element_bytes = (m_size * sizeof(Node));
+    statistics.spare_bytes = ((m_capacity - m_size) * sizeof(Node));
+    return statistics;
+}
+
+template<typename DataType, typename IndexType>
+IndexType Ishiko::CompactDoublyLinkedList<DataType, IndexType>::newNode() noexcept
+{
+    if (m_free_head != null_index)
+    {
+        IndexType index = m_free_head;
+        m_free_head = m_nodes[index].next_index;
+        return index;
+    }
+    if (m_used_count == m_capacity)
+    {
+        // null_index can't be the index of a node
+        size_t max_capacity = static_cast<size_t>(null_index);
+        if (m_capacity == max_capacity)
+        {
+            return null_index;
+        }
+        size_t capacity = ((m_capacity != 0) ? (2 * m_capacity) : 8);
+        if ((capacity > max_capacity) || (capacity < m_capacity))
+        {
+            capacity = max_capacity;
+        }
+        if (!reallocate(capacity))
+        {
+            return null_index;
+        }
+    }
+    return static_cast<IndexType>(m_used_count++);
+}
+
+template<typename DataType, typename IndexType>
+void Ishiko::CompactDoublyLinkedList<DataType, IndexType>::link(IndexType index, const DataType& data,
+    IndexType previous_index, IndexType next_index) noexcept
+{
+    Node& node = m_nodes[index];
+    node.data = data;
+    node.previous_index = previous_index;
+    node.next_index = next_index;
+    if (previous_index == null_index)
+    {
+        m_head = index;
+    }
+    else
+    {
+        m_nodes[previous_index].next_index = index;
+    }
+    if (next_index == null_index)
+    {
+        m_tail = index;
+    }
+    else
+    {
+        m_nodes[next_index].previous_index = index;
+    }
+    ++m_size;
+}
+
+template<typename DataType, typename IndexType>
+bool Ishiko::CompactDoublyLinkedList<DataType, IndexType>::reallocate(size_t capacity) noexcept
+{
+    if ((capacity > static_cast<size_t>(null_index)) || (capacity > (static_cast<size_t>(-1) / sizeof(Node))))
+    {
+        return false;
+    }
+    // The nodes can be moved with memcpy so realloc does all the work
+    void* memory = std::realloc(static_cast<void*>(m_nodes), capacity * sizeof(Node));
+    if (!memory)
+    {
+        return false;
+    }
+    m_nodes = static_cast<Node*>(memory);
+    m_capacity = capacity;
+    return true;
+}
+
+#endif
@@ -0,0 +1,311 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_CONCURRENTQUEUE_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_CONCURRENTQUEUE_HPP
+
+#include "EpochBasedReclamation.hpp"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Ishiko
+{
+    // A lock-free first-in first-out queue that any number of threads can push to and pop from without external
+    // synchronization.
+    //
+    // This is the queue described by Michael and Scott. The elements are stored in singly linked nodes that follow
+    // the same model as the nodes of SinglyLinkedList except that their links are atomic. The head always points to a
+    // dummy node whose successor holds the first element, push links a node after the tail with compare-and-swap and
+    // pop advances the head with compare-and-swap. A thread that finds the tail lagging behind moves it forward
+    // before retrying, so no thread ever waits for another one.
+    //
+    // Nodes that leave the queue are reclaimed through EpochBasedReclamation. Once no thread can access them any
+    // longer they are put on a free list shared by all the queues with the same DataType, which push takes its nodes
+    // from before it falls back to the heap. The free list holds at most max_free_nodes nodes, the others are
+    // returned to the heap, so a burst of pushes doesn't keep its memory forever. Because a node only goes back on
+    // the free list after a full grace period, a thread that is taking a node from the free list can't see the same
+    // node come back behind its back and the free list doesn't suffer from the ABA problem.
+    template<typename DataType>
+    class ConcurrentQueue
+    {
+        // An element is moved out of its node after the node has been unlinked, at which point the pop can no longer
+        // be abandoned.
+        static_assert(std::is_nothrow_move_assignable<DataType>::value,
+            "ConcurrentQueue requires a nothrow move assignable DataType");
+
+    public:
+        // The maximum number of nodes kept on the free list of each DataType
+        static const size_t max_free_nodes = 4096;
+
+        ConcurrentQueue();
+        ConcurrentQueue(const ConcurrentQueue& other) = delete;
+        ConcurrentQueue& operator=(const ConcurrentQueue& other) = delete;
+        // The destructor must not run concurrently with any other member function.
+        ~ConcurrentQueue() noexcept;
+
+        bool isEmpty() const noexcept;
+
+        void push(const DataType& data);
+        void push(DataType&& data);
+        template<typename... Args>
+        void emplace(Args&&... args);
+        // Moves the first element into data and returns true, or returns false if the queue is empty
+        bool tryPop(DataType& data) noexcept;
+
+    private:
+        class Node
+        {
+        public:
+            Node(const Node& other) = delete;
+            Node& operator=(const Node& other) = delete;
+
+            // Takes a node from the free list or allocates a new one. The node's data is not constructed. The calling
+            // thread must hold a Guard.
+            static Node* Create();
+            // Puts the node on the free list or deletes it if the free list is full. The node's data must have been
+            // destroyed and no thread must be able to access the node any longer.
+            static void Recycle(void* node) noexcept;
+
+            Node* nextNode() const noexcept;
+            void setNextNode(Node* node) noexcept;
+            bool compareExchangeNextNode(Node*& expected, Node* desired) noexcept;
+
+            DataType& data() noexcept;
+
+        private:
+            Node() noexcept = default;
+            ~Node() noexcept = default;
+
+            std::atomic<Node*> m_next_node;
+            typename std::aligned_storage<sizeof(DataType), alignof(DataType)>::type m_data;
+        };
+
+        template<typename... Args>
+        void pushValue(Args&&... args);
+        void link(Node* new_node) noexcept;
+
+        static std::atomic<Node*> s_free_nodes;
+        static std::atomic<size_t> s_free_node_count;
+
+        // The head and the tail are written by different threads in a producer-consumer setup so they are kept on
+        // separate cache lines.
+        std::atomic<Node*> m_head;
+        char m_padding[64 - sizeof(std::atomic<Node*>)];
+        std::atomic<Node*> m_tail;
+    };
+}
+
+template<typename DataType>
+const size_t Ishiko::ConcurrentQueue<DataType>::max_free_nodes;
+
+template<typename DataType>
+std::atomic<typename Ishiko::ConcurrentQueue<DataType>::Node*> Ishiko::ConcurrentQueue<DataType>::s_free_nodes(
+    nullptr);
+
+template<typename DataType>
+std::atomic<size_t> Ishiko::ConcurrentQueue<DataType>::s_free_node_count(0);
+
+template<typename DataType>
+typename Ishiko::ConcurrentQueue<DataType>::Node* Ishiko::ConcurrentQueue<DataType>::Node::Create()
+{
+    Node* node = s_free_nodes.load(std::memory_order_acquire);
+    while (node)
+    {
+        if (s_free_nodes.compare_exchange_weak(node, node->nextNode(), std::memory_order_acquire,
+            std::memory_order_acquire))
+        {
+            s_free_node_count.fetch_sub(1, std::memory_order_relaxed);
+            node->setNextNode(nullptr);
+            return node;
+        }
+    }
+
+    node = new(::operator new(sizeof(Node))) Node();
+    node->setNextNode(nullptr);
+    return node;
+}
+
+template<typename DataType>
+void Ishiko::ConcurrentQueue<DataType>::Node::Recycle(void* node) noexcept
+{
+    Node* free_node = static_cast<Node*>(node);
+
+    // The count is only approximate when several threads recycle at once but it is never off by more than the number
+    // of threads
+    if (s_free_node_count.load(std::memory_order_relaxed) >= max_free_nodes)
+    {
+        free_node->~Node();
+        ::operator delete(node);
+        return;
+    }
+    s_free_node_count.fetch_add(1, std::memory_order_relaxed);
+
+    Node* head = s_free_nodes.load(std::memory_order_relaxed);
+    do
+    {
+        free_node->setNextNode(head);
+    } while (!s_free_nodes.compare_exchange_weak(head, free_node, std::memory_order_release,
+        std::memory_order_relaxed));
+}
+
+template<typename DataType>
+typename Ishiko::ConcurrentQueue<DataType>::Node* Ishiko::ConcurrentQueue<DataType>::Node::nextNode() const noexcept
+{
+    return m_next_node.load(std::memory_order_acquire);
+}
+
+template<typename DataType>
+void Ishiko::ConcurrentQueue<DataType>::Node::setNextNode(Node* node) noexcept
+{
+    m_next_node.store(node, std::memory_order_release);
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentQueue<DataType>::Node::compareExchangeNextNode(Node*& expected, Node* desired) noexcept
+{
+    return m_next_node.compare_exchange_strong(expected, desired);
+}
+
+template<typename DataType>
+DataType& Ishiko::ConcurrentQueue<DataType>::Node::data() noexcept
+{
+    return *reinterpret_cast<DataType*>(&m_data);
+}
+
+template<typename DataType>
+Ishiko::ConcurrentQueue<DataType>::ConcurrentQueue()
+{
+    EpochBasedReclamation::Guard guard;
+    Node* dummy_node = Node::Create();
+    m_head.store(dummy_node, std::memory_order_relaxed);
+    m_tail.store(dummy_node, std::memory_order_relaxed);
+}
+
+template<typename DataType>
+Ishiko::ConcurrentQueue<DataType>::~ConcurrentQueue() noexcept
+{
+    // Even though no other thread uses this queue, a thread working on another queue may still be reading a node
+    // that it saw on the free list before this queue took it, so the nodes are retired rather than deleted.
+    Node* node = m_head.load(std::memory_order_relaxed);
+    Node* next_node = node->nextNode();
+    EpochBasedReclamation::Retire(node, &Node::Recycle);
+    while (next_node)
+    {
+        node = next_node;
+        next_node = node->nextNode();
+        node->data().~DataType();
+        EpochBasedReclamation::Retire(node, &Node::Recycle);
+    }
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentQueue<DataType>::isEmpty() const noexcept
+{
+    EpochBasedReclamation::Guard guard;
+    return (m_head.load(std::memory_order_acquire)->nextNode() == nullptr);
+}
+
+template<typename DataType>
+void Ishiko::ConcurrentQueue<DataType>::push(const DataType& data)
+{
+    pushValue(data);
+}
+
+template<typename DataType>
+void Ishiko::ConcurrentQueue<DataType>::push(DataType&& data)
+{
+    pushValue(std::move(data));
+}
+
+template<typename DataType>
+template<typename... Args>
+void Ishiko::ConcurrentQueue<DataType>::emplace(Args&&... args)
+{
+    pushValue(std::forward<Args>(args)...);
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentQueue<DataType>::tryPop(DataType& data) noexcept
+{
+    EpochBasedReclamation::Guard guard;
+
+    while (true)
+    {
+        Node* head = m_head.load(std::memory_order_acquire);
+        Node* tail = m_tail.load(std::memory_order_acquire);
+        Node* next_node = head->nextNode();
+        if (head != m_head.load(std::memory_order_acquire))
+        {
+            continue;
+        }
+        if (!next_node)
+        {
+            return false;
+        }
+        if (head == tail)
+        {
+            // A push has linked a node but not yet moved the tail, help it so the head never overtakes the tail
+            m_tail.compare_exchange_strong(tail, next_node);
+            continue;
+        }
+        if (m_head.compare_exchange_strong(head, next_node))
+        {
+            // next_node is the new dummy node. Only the thread that advanced the head touches its data.
+            data = std::move(next_node->data());
+            next_node->data().~DataType();
+            EpochBasedReclamation::Retire(head, &Node::Recycle);
+            return true;
+        }
+    }
+}
+
+template<typename DataType>
+template<typename... Args>
+void Ishiko::ConcurrentQueue<DataType>::pushValue(Args&&... args)
+{
+    EpochBasedReclamation::Guard guard;
+
+    Node* new_node = Node::Create();
+    try
+    {
+        new(&new_node->data()) DataType(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        // The node may have come from the free list so another thread can still be reading it
+        EpochBasedReclamation::Retire(new_node, &Node::Recycle);
+        throw;
+    }
+    link(new_node);
+}
+
+template<typename DataType>
+void Ishiko::ConcurrentQueue<DataType>::link(Node* new_node) noexcept
+{
+    while (true)
+    {
+        Node* tail = m_tail.load(std::memory_order_acquire);
+        Node* next_node = tail->nextNode();
+        if (tail != m_tail.load(std::memory_order_acquire))
+        {
+            continue;
+        }
+        if (next_node)
+        {
+            // The tail is lagging behind, move it forward before trying again
+            m_tail.compare_exchange_strong(tail, next_node);
+            continue;
+        }
+        if (tail->compareExchangeNextNode(next_node, new_node))
+        {
+            // If this fails another thread has already moved the tail past the new node
+            m_tail.compare_exchange_strong(tail, new_node);
+            return;
+        }
+    }
+}
+
+#endif
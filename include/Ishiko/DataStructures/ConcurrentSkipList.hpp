@@ -0,0 +1,485 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSKIPLIST_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSKIPLIST_HPP
+
+#include "EpochBasedReclamation.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace Ishiko
+{
+    // A lock-free ordered set that can be used from multiple threads without external synchronization.
+    //
+    // Nodes are linked with compare-and-swap. A node is erased by first marking its forward pointers, which is done
+    // by setting their lowest bit, and then unlinking it. Searches unlink the marked nodes they come across. Unlinked
+    // nodes are reclaimed through EpochBasedReclamation so a thread never accesses a node that has been deleted.
+    //
+    // The level generator may be called from several threads at once and must therefore be thread-safe.
+    template<typename DataType>
+    class ConcurrentSkipList
+    {
+    public:
+        // The maximum number of levels a node can have. Levels returned by the level generator are capped to this
+        // value.
+        static const size_t max_levels = 32;
+
+        ConcurrentSkipList(size_t (*get_random_level)()) noexcept;
+        ConcurrentSkipList(const ConcurrentSkipList& other) = delete;
+        ConcurrentSkipList& operator=(const ConcurrentSkipList& other) = delete;
+        // The destructor must not run concurrently with any other member function.
+        ~ConcurrentSkipList() noexcept;
+
+        bool isEmpty() const noexcept;
+
+        bool contains(const DataType& data) const noexcept;
+        // Calls callback with the element equal to data if there is one. The element is guaranteed to stay alive for
+        // the duration of the call but may be erased concurrently.
+        template<typename Callback>
+        bool find(const DataType& data, Callback&& callback) const;
+
+        // Returns false if the list already contains an element equal to data.
+        bool insert(const DataType& data);
+        // Returns false if the list doesn't contain an element equal to data.
+        bool erase(const DataType& data) noexcept;
+
+    private:
+        class Node
+        {
+        public:
+            // Set by insert once it no longer links the node and by erase once it has unlinked it. The thread that
+            // sets the second flag retires the node.
+            static const unsigned char insert_done = 1;
+            static const unsigned char erase_done = 2;
+
+            Node(const Node& other) = delete;
+            Node& operator=(const Node& other) = delete;
+
+            static Node* Create(const DataType& data, size_t levels);
+            static void Destroy(void* node) noexcept;
+
+            std::atomic<uintptr_t>* tower() noexcept;
+            const std::atomic<uintptr_t>* tower() const noexcept;
+
+            size_t levels() const noexcept;
+            const DataType& data() const noexcept;
+
+            // Sets flag and returns true if the other flag was already set
+            bool setDone(unsigned char flag) noexcept;
+
+        private:
+            Node(const DataType& data, size_t levels);
+            ~Node() noexcept = default;
+
+            size_t m_levels;
+            std::atomic<unsigned char> m_done;
+            DataType m_data;
+        };
+
+        static bool IsMarked(uintptr_t link) noexcept;
+        static Node* ToNode(uintptr_t link) noexcept;
+
+        // Finds the predecessors and successors of data on the first levels and unlinks the marked nodes along the
+        // way. Returns true if next_nodes[0] is equal to data.
+        bool find(const DataType& data, size_t levels, std::atomic<uintptr_t>** previous_links,
+            Node** next_nodes) noexcept;
+        // A single attempt at find. Returns false if it raced with another thread and needs to be restarted.
+        bool tryFind(const DataType& data, size_t levels, std::atomic<uintptr_t>** previous_links,
+            Node** next_nodes) noexcept;
+        const Node* findNode(const DataType& data) const noexcept;
+        void linkUpperLevels(Node* node, std::atomic<uintptr_t>** previous_links, Node** next_nodes) noexcept;
+        // Returns false if the node has been marked for erasure, in which case it must not be linked any further.
+        bool linkLevel(Node* node, size_t level, std::atomic<uintptr_t>** previous_links, Node** next_nodes) noexcept;
+        size_t randomLevel() noexcept;
+
+        std::atomic<uintptr_t> m_head[max_levels];
+        // An upper bound on the number of levels in use. It only ever grows.
+        std::atomic<size_t> m_levels;
+        size_t (*m_get_random_level)() = nullptr;
+    };
+}
+
+template<typename DataType>
+const size_t Ishiko::ConcurrentSkipList<DataType>::max_levels;
+
+template<typename DataType>
+const unsigned char Ishiko::ConcurrentSkipList<DataType>::Node::insert_done;
+
+template<typename DataType>
+const unsigned char Ishiko::ConcurrentSkipList<DataType>::Node::erase_done;
+
+template<typename DataType>
+Ishiko::ConcurrentSkipList<DataType>::Node::Node(const DataType& data, size_t levels)
+    : m_levels(levels), m_done(0), m_data(data)
+{
+    std::atomic<uintptr_t>* next_links = tower();
+    for (size_t i = 0; i < levels; ++i)
+    {
+        new(&next_links[i]) std::atomic<uintptr_t>(0);
+    }
+}
+
+template<typename DataType>
+typename Ishiko::ConcurrentSkipList<DataType>::Node* Ishiko::ConcurrentSkipList<DataType>::Node::Create(
+    const DataType& data, size_t levels)
+{
+    void* memory = ::operator new(sizeof(Node) + (levels * sizeof(std::atomic<uintptr_t>)));
+    try
+    {
+        return new(memory) Node(data, levels);
+    }
+    catch (...)
+    {
+        ::operator delete(memory);
+        throw;
+    }
+}
+
+template<typename DataType>
+void Ishiko::ConcurrentSkipList<DataType>::Node::Destroy(void* node) noexcept
+{
+    static_cast<Node*>(node)->~Node();
+    ::operator delete(node);
+}
+
+template<typename DataType>
+std::atomic<uintptr_t>* Ishiko::ConcurrentSkipList<DataType>::Node::tower() noexcept
+{
+    return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1);
+}
+
+template<typename DataType>
+const std::atomic<uintptr_t>* Ishiko::ConcurrentSkipList<DataType>::Node::tower() const noexcept
+{
+    return reinterpret_cast<const std::atomic<uintptr_t>*>(this + 1);
+}
+
+template<typename DataType>
+size_t Ishiko::ConcurrentSkipList<DataType>::Node::levels() const noexcept
+{
+    return m_levels;
+}
+
+template<typename DataType>
+const DataType& Ishiko::ConcurrentSkipList<DataType>::Node::data() const noexcept
+{
+    return m_data;
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentSkipList<DataType>::Node::setDone(unsigned char flag) noexcept
+{
+    return ((m_done.fetch_or(flag) & (insert_done | erase_done) & ~flag) != 0);
+}
+
+template<typename DataType>
+Ishiko::ConcurrentSkipList<DataType>::ConcurrentSkipList(size_t (*get_random_level)()) noexcept
+    : m_levels(1), m_get_random_level(get_random_level)
+{
+    for (size_t i = 0; i < max_levels; ++i)
+    {
+        m_head[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+template<typename DataType>
+Ishiko::ConcurrentSkipList<DataType>::~ConcurrentSkipList() noexcept
+{
+    // Erased nodes have been unlinked from level 0 before erase returned so this only sees the live nodes. The
+    // erased ones are owned by EpochBasedReclamation.
+    Node* node = ToNode(m_head[0].load(std::memory_order_relaxed));
+    while (node)
+    {
+        Node* next_node = ToNode(node->tower()[0].load(std::memory_order_relaxed));
+        Node::Destroy(node);
+        node = next_node;
+    }
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentSkipList<DataType>::isEmpty() const noexcept
+{
+    EpochBasedReclamation::Guard guard;
+    const Node* node = ToNode(m_head[0].load(std::memory_order_acquire));
+    while (node)
+    {
+        uintptr_t next_link = node->tower()[0].load(std::memory_order_acquire);
+        if (!IsMarked(next_link))
+        {
+            return false;
+        }
+        node = ToNode(next_link);
+    }
+    return true;
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentSkipList<DataType>::contains(const DataType& data) const noexcept
+{
+    EpochBasedReclamation::Guard guard;
+    return (findNode(data) != nullptr);
+}
+
+template<typename DataType>
+template<typename Callback>
+bool Ishiko::ConcurrentSkipList<DataType>::find(const DataType& data, Callback&& callback) const
+{
+    EpochBasedReclamation::Guard guard;
+    const Node* node = findNode(data);
+    if (node)
+    {
+        callback(node->data());
+        return true;
+    }
+    return false;
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentSkipList<DataType>::insert(const DataType& data)
+{
+    EpochBasedReclamation::Guard guard;
+
+    size_t levels = randomLevel();
+    size_t current_levels = m_levels.load();
+    while ((current_levels < levels) && !m_levels.compare_exchange_weak(current_levels, levels))
+    {
+    }
+
+    std::atomic<uintptr_t>* previous_links[max_levels];
+    Node* next_nodes[max_levels];
+    Node* new_node = nullptr;
+    while (true)
+    {
+        if (find(data, m_levels.load(), previous_links, next_nodes))
+        {
+            if (new_node)
+            {
+                Node::Destroy(new_node);
+            }
+            return false;
+        }
+
+        if (!new_node)
+        {
+            new_node = Node::Create(data, levels);
+        }
+        for (size_t i = 0; i < levels; ++i)
+        {
+            new_node->tower()[i].store(reinterpret_cast<uintptr_t>(next_nodes[i]), std::memory_order_relaxed);
+        }
+
+        uintptr_t expected = reinterpret_cast<uintptr_t>(next_nodes[0]);
+        if (previous_links[0]->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(new_node)))
+        {
+            break;
+        }
+    }
+
+    linkUpperLevels(new_node, previous_links, next_nodes);
+    if (new_node->setDone(Node::insert_done))
+    {
+        EpochBasedReclamation::Retire(new_node, &Node::Destroy);
+    }
+
+    return true;
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentSkipList<DataType>::erase(const DataType& data) noexcept
+{
+    EpochBasedReclamation::Guard guard;
+
+    std::atomic<uintptr_t>* previous_links[max_levels];
+    Node* next_nodes[max_levels];
+    if (!find(data, m_levels.load(), previous_links, next_nodes))
+    {
+        return false;
+    }
+
+    // Mark the upper levels first so that a concurrent insert stops linking the node
+    Node* victim = next_nodes[0];
+    for (size_t level = victim->levels(); level-- > 1;)
+    {
+        uintptr_t next_link = victim->tower()[level].load();
+        while (!IsMarked(next_link) && !victim->tower()[level].compare_exchange_weak(next_link, next_link | 1))
+        {
+        }
+    }
+
+    // Whoever marks level 0 owns the erase
+    uintptr_t next_link = victim->tower()[0].load();
+    do
+    {
+        if (IsMarked(next_link))
+        {
+            return false;
+        }
+    } while (!victim->tower()[0].compare_exchange_weak(next_link, next_link | 1));
+
+    find(data, m_levels.load(), previous_links, next_nodes);
+    if (victim->setDone(Node::erase_done))
+    {
+        EpochBasedReclamation::Retire(victim, &Node::Destroy);
+    }
+
+    return true;
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentSkipList<DataType>::IsMarked(uintptr_t link) noexcept
+{
+    return ((link & 1) != 0);
+}
+
+template<typename DataType>
+typename Ishiko::ConcurrentSkipList<DataType>::Node* Ishiko::ConcurrentSkipList<DataType>::ToNode(
+    uintptr_t link) noexcept
+{
+    return reinterpret_cast<Node*>(link & ~static_cast<uintptr_t>(1));
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentSkipList<DataType>::find(const DataType& data, size_t levels,
+    std::atomic<uintptr_t>** previous_links, Node** next_nodes) noexcept
+{
+    while (!tryFind(data, levels, previous_links, next_nodes))
+    {
+    }
+    return (next_nodes[0] && !(data < next_nodes[0]->data()));
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentSkipList<DataType>::tryFind(const DataType& data, size_t levels,
+    std::atomic<uintptr_t>** previous_links, Node** next_nodes) noexcept
+{
+    std::atomic<uintptr_t>* links = m_head;
+    for (size_t level = levels; level-- > 0;)
+    {
+        Node* current_node = ToNode(links[level].load(std::memory_order_acquire));
+        while (current_node)
+        {
+            uintptr_t next_link = current_node->tower()[level].load(std::memory_order_acquire);
+            while (IsMarked(next_link))
+            {
+                // The CAS fails if the predecessor has itself been marked in the meantime, in which case the search
+                // starts again from the head
+                uintptr_t expected = reinterpret_cast<uintptr_t>(current_node);
+                if (!links[level].compare_exchange_strong(expected, next_link & ~static_cast<uintptr_t>(1)))
+                {
+                    return false;
+                }
+                current_node = ToNode(next_link);
+                if (!current_node)
+                {
+                    break;
+                }
+                next_link = current_node->tower()[level].load(std::memory_order_acquire);
+            }
+            if (!current_node || !(current_node->data() < data))
+            {
+                break;
+            }
+            links = current_node->tower();
+            current_node = ToNode(next_link);
+        }
+        previous_links[level] = &links[level];
+        next_nodes[level] = current_node;
+    }
+    return true;
+}
+
+template<typename DataType>
+const typename Ishiko::ConcurrentSkipList<DataType>::Node* Ishiko::ConcurrentSkipList<DataType>::findNode(
+    const DataType& data) const noexcept
+{
+    // Unlike find this never writes to the list, it just steps over the marked nodes
+    const std::atomic<uintptr_t>* links = m_head;
+    const Node* current_node = nullptr;
+    for (size_t level = m_levels.load(std::memory_order_acquire); level-- > 0;)
+    {
+        current_node = ToNode(links[level].load(std::memory_order_acquire));
+        while (current_node)
+        {
+            uintptr_t next_link = current_node->tower()[level].load(std::memory_order_acquire);
+            if (!IsMarked(next_link))
+            {
+                if (!(current_node->data() < data))
+                {
+                    break;
+                }
+                links = current_node->tower();
+            }
+            current_node = ToNode(next_link);
+        }
+    }
+    if (current_node && !(data < current_node->data())
+        && !IsMarked(current_node->tower()[0].load(std::memory_order_acquire)))
+    {
+        return current_node;
+    }
+    return nullptr;
+}
+
+template<typename DataType>
+void Ishiko::ConcurrentSkipList<DataType>::linkUpperLevels(Node* node, std::atomic<uintptr_t>** previous_links,
+    Node** next_nodes) noexcept
+{
+    for (size_t level = 1; level < node->levels(); ++level)
+    {
+        if (!linkLevel(node, level, previous_links, next_nodes))
+        {
+            break;
+        }
+    }
+
+    // If the node was erased while it was being linked, erase may have unlinked it before the last link above was
+    // made. Search again so that none of the links survive.
+    if (IsMarked(node->tower()[0].load()))
+    {
+        find(node->data(), node->levels(), previous_links, next_nodes);
+    }
+}
+
+template<typename DataType>
+bool Ishiko::ConcurrentSkipList<DataType>::linkLevel(Node* node, size_t level,
+    std::atomic<uintptr_t>** previous_links, Node** next_nodes) noexcept
+{
+    while (true)
+    {
+        uintptr_t expected = reinterpret_cast<uintptr_t>(next_nodes[level]);
+        if (previous_links[level]->compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node)))
+        {
+            return true;
+        }
+
+        // The neighbourhood changed, search again and update the forward pointer of the node to match
+        find(node->data(), node->levels(), previous_links, next_nodes);
+        uintptr_t next_link = node->tower()[level].load();
+        if (IsMarked(next_link)
+            || !node->tower()[level].compare_exchange_strong(next_link,
+                reinterpret_cast<uintptr_t>(next_nodes[level])))
+        {
+            return false;
+        }
+    }
+}
+
+template<typename DataType>
+size_t Ishiko::ConcurrentSkipList<DataType>::randomLevel() noexcept
+{
+    size_t levels = m_get_random_level();
+    if (levels == 0)
+    {
+        levels = 1;
+    }
+    else if (levels > max_levels)
+    {
+        levels = max_levels;
+    }
+    return levels;
+}
+
+#endif
@@ -0,0 +1,439 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSTACK_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSTACK_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) && defined(__SIZEOF_INT128__) && defined(__BYTE_ORDER__)
+#define ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSTACK_DOUBLE_WIDTH_CAS
+#endif
+
+namespace Ishiko
+{
+    template<class T, class Tag, size_t EliminationSlots>
+    class ConcurrentStack;
+
+    // The link an object needs to be in a ConcurrentStack. This is the same as SinglyLinkedListHook except that the
+    // link is atomic since a thread popping an object may read it while another thread pushes the object again.
+    template<class T, class Tag = void>
+    class ConcurrentStackHook
+    {
+    public:
+        ConcurrentStackHook() noexcept;
+        ConcurrentStackHook(const ConcurrentStackHook& other) noexcept;
+        ConcurrentStackHook& operator=(const ConcurrentStackHook& other) noexcept;
+
+    private:
+        template<class, class, size_t>
+        friend class ConcurrentStack;
+
+        ConcurrentStackHook* nextNode() const noexcept;
+        void setNextNode(ConcurrentStackHook* node) noexcept;
+
+        std::atomic<ConcurrentStackHook*> m_next_node;
+    };
+
+    // A lock-free last-in first-out stack of objects it doesn't own, typically used to recycle objects between
+    // threads. Like IntrusiveSinglyLinkedList the links are stored in the objects, see ConcurrentStackHook, so push
+    // and pop never allocate.
+    //
+    // This is a Treiber stack: push and pop replace the head with compare-and-swap. To protect pop against the ABA
+    // problem the head carries a tag that is incremented by every update, so a pop that read a head that has since
+    // been popped and pushed again fails instead of installing a stale next object. A pop would only be fooled if the
+    // tag wrapped around exactly while it was preempted.
+    //
+    // Where the compiler provides a 16 byte compare-and-swap, for instance on AArch64 or on x86-64 with -mcx16, the
+    // pointer and a 64-bit tag are updated together with it. Otherwise the tag lives in the bits of a 64-bit head that
+    // the pointer doesn't use: 16 bits on 64-bit platforms and 32 bits on 32-bit platforms. On 64-bit platforms this
+    // requires every object pushed to have an address that fits in 48 bits, which rules out pointers carrying a tag in
+    // their top byte (AArch64 top byte ignore as used by HWASan, MTE or the Android heap) and mappings above 2^47 with
+    // 5-level paging. Debug builds check this precondition.
+    //
+    // A pop may read the link of an object that another thread has just popped, so objects that have been in the
+    // stack must stay alive as long as other threads may be popping from it. This is the case for the objects of a
+    // recycler, which are only destroyed once every thread is done with it.
+    //
+    // If EliminationSlots is not 0 the stack also has an elimination array with that many slots. A push or a pop
+    // that fails its compare-and-swap because of contention goes to a slot instead of retrying straight away. A push
+    // offers its object there for a short while and a pop that visits the slot in the meantime takes it, so the two
+    // operations cancel each other without touching the head at all.
+    template<class T, class Tag = void, size_t EliminationSlots = 0>
+    class ConcurrentStack
+    {
+    public:
+        typedef ConcurrentStackHook<T, Tag> Hook;
+
+        // The number of times a push waits for a pop to take the object it offered in the elimination array
+        static const size_t elimination_spins = 128;
+
+        ConcurrentStack() noexcept;
+        ConcurrentStack(const ConcurrentStack& other) = delete;
+        ConcurrentStack& operator=(const ConcurrentStack& other) = delete;
+        ~ConcurrentStack() noexcept = default;
+
+        bool isEmpty() const noexcept;
+        // The object after node in a chain returned by popAll or built with SetNextNode
+        static T* NextNode(T* node) noexcept;
+        // Links next_node after node to build a chain for pushChain. Neither object can be in a stack.
+        static void SetNextNode(T* node, T* next_node) noexcept;
+
+        void push(T* node) noexcept;
+        // Pushes a chain of objects linked with SetNextNode with a single compare-and-swap. first ends up on top
+        // of the stack and last is the object whose link is overwritten.
+        void pushChain(T* first, T* last) noexcept;
+        // Unlinks the top object and returns it, or returns nullptr if the stack is empty
+        T* pop() noexcept;
+        // Unlinks all the objects at once and returns the chain, which can be walked with NextNode, or returns
+        // nullptr if the stack is empty
+        T* popAll() noexcept;
+
+    private:
+        // The top of the stack together with the tag that protects it against the ABA problem
+        struct TaggedHead
+        {
+            Hook* node;
+            uint64_t tag;
+        };
+
+#if !defined(ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSTACK_DOUBLE_WIDTH_CAS)
+        // The head is packed as a pointer in the low pointer_bits bits and a tag in the high ones
+        static const unsigned int pointer_bits = ((sizeof(void*) == 8) ? 48 : 32);
+        static const uint64_t pointer_mask = ((uint64_t(1) << pointer_bits) - 1);
+#endif
+
+        // Each slot is on its own cache line so that threads using different slots don't contend
+        struct EliminationSlot
+        {
+            std::atomic<Hook*> node;
+            char padding[64 - sizeof(std::atomic<Hook*>)];
+        };
+
+        static Hook* ToHook(T* node) noexcept;
+        static T* ToNode(Hook* hook) noexcept;
+#if !defined(ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSTACK_DOUBLE_WIDTH_CAS)
+        static uint64_t Pack(const TaggedHead& head) noexcept;
+        static TaggedHead Unpack(uint64_t head) noexcept;
+#endif
+
+        TaggedHead loadHead() const noexcept;
+        // Replaces the head with node and the next tag if it is still equal to expected. Otherwise loads the current
+        // head into expected and returns false.
+        bool replaceHead(TaggedHead& expected, Hook* node) noexcept;
+
+        bool tryPush(Hook* first, Hook* last) noexcept;
+        // Returns false if the head changed after it was read, in which case node is left untouched
+        bool tryPop(Hook*& node) noexcept;
+        bool eliminatePush(Hook* node) noexcept;
+        Hook* eliminatePop() noexcept;
+        EliminationSlot& eliminationSlot() noexcept;
+
+#if defined(ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSTACK_DOUBLE_WIDTH_CAS)
+        // The pointer and the tag as the low and high halves of a 16 byte integer. The halves are read separately,
+        // which may see them from different updates, but such a head never passes the compare-and-swap.
+        alignas(16) uint64_t m_head[2];
+        char m_padding[64 - (2 * sizeof(uint64_t))];
+#else
+        std::atomic<uint64_t> m_head;
+        char m_padding[64 - sizeof(std::atomic<uint64_t>)];
+#endif
+        EliminationSlot m_elimination_slots[(EliminationSlots > 0) ? EliminationSlots : 1];
+    };
+}
+
+template<class T, class Tag>
+Ishiko::ConcurrentStackHook<T, Tag>::ConcurrentStackHook() noexcept
+    : m_next_node(nullptr)
+{
+}
+
+template<class T, class Tag>
+Ishiko::ConcurrentStackHook<T, Tag>::ConcurrentStackHook(const ConcurrentStackHook&) noexcept
+    : m_next_node(nullptr)
+{
+}
+
+template<class T, class Tag>
+Ishiko::ConcurrentStackHook<T, Tag>& Ishiko::ConcurrentStackHook<T, Tag>::operator=(
+    const ConcurrentStackHook&) noexcept
+{
+    return *this;
+}
+
+template<class T, class Tag>
+Ishiko::ConcurrentStackHook<T, Tag>* Ishiko::ConcurrentStackHook<T, Tag>::nextNode() const noexcept
+{
+    return m_next_node.load(std::memory_order_relaxed);
+}
+
+template<class T, class Tag>
+void Ishiko::ConcurrentStackHook<T, Tag>::setNextNode(ConcurrentStackHook* node) noexcept
+{
+    m_next_node.store(node, std::memory_order_relaxed);
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+const size_t Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::elimination_spins;
+
+#if !defined(ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSTACK_DOUBLE_WIDTH_CAS)
+template<class T, class Tag, size_t EliminationSlots>
+const unsigned int Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::pointer_bits;
+
+template<class T, class Tag, size_t EliminationSlots>
+const uint64_t Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::pointer_mask;
+#endif
+
+template<class T, class Tag, size_t EliminationSlots>
+Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::ConcurrentStack() noexcept
+#if defined(ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSTACK_DOUBLE_WIDTH_CAS)
+    : m_head{ 0, 0 }
+#else
+    : m_head(0)
+#endif
+{
+    for (EliminationSlot& slot : m_elimination_slots)
+    {
+        slot.node.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+bool Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::isEmpty() const noexcept
+{
+    return (loadHead().node == nullptr);
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+T* Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::NextNode(T* node) noexcept
+{
+    return ToNode(ToHook(node)->nextNode());
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+void Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::SetNextNode(T* node, T* next_node) noexcept
+{
+    ToHook(node)->setNextNode(ToHook(next_node));
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+void Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::push(T* node) noexcept
+{
+    Hook* hook = ToHook(node);
+    while (!tryPush(hook, hook))
+    {
+        if ((EliminationSlots > 0) && eliminatePush(hook))
+        {
+            return;
+        }
+    }
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+void Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::pushChain(T* first, T* last) noexcept
+{
+    while (!tryPush(ToHook(first), ToHook(last)))
+    {
+    }
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+T* Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::pop() noexcept
+{
+    Hook* hook = nullptr;
+    while (!tryPop(hook))
+    {
+        if (EliminationSlots > 0)
+        {
+            hook = eliminatePop();
+            if (hook)
+            {
+                break;
+            }
+        }
+    }
+    return ToNode(hook);
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+T* Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::popAll() noexcept
+{
+    TaggedHead head = loadHead();
+    while (head.node && !replaceHead(head, nullptr))
+    {
+    }
+    return ToNode(head.node);
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+typename Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::Hook*
+Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::ToHook(T* node) noexcept
+{
+    return static_cast<Hook*>(node);
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+T* Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::ToNode(Hook* hook) noexcept
+{
+    // static_cast maps nullptr to nullptr
+    return static_cast<T*>(hook);
+}
+
+#if defined(ISHIKO_CPP_DATASTRUCTURES_CONCURRENTSTACK_DOUBLE_WIDTH_CAS)
+template<class T, class Tag, size_t EliminationSlots>
+typename Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::TaggedHead
+Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::loadHead() const noexcept
+{
+    const size_t node_index = ((__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) ? 0 : 1);
+    TaggedHead head;
+    head.tag = __atomic_load_n(&m_head[1 - node_index], __ATOMIC_ACQUIRE);
+    head.node = reinterpret_cast<Hook*>(static_cast<uintptr_t>(__atomic_load_n(&m_head[node_index],
+        __ATOMIC_ACQUIRE)));
+    return head;
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+bool Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::replaceHead(TaggedHead& expected, Hook* node) noexcept
+{
+    typedef unsigned __int128 Word;
+
+    Word expected_word = ((static_cast<Word>(expected.tag) << 64)
+        | static_cast<uint64_t>(reinterpret_cast<uintptr_t>(expected.node)));
+    Word new_word = ((static_cast<Word>(expected.tag + 1) << 64)
+        | static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node)));
+    Word previous_word = __sync_val_compare_and_swap(reinterpret_cast<Word*>(m_head), expected_word, new_word);
+    if (previous_word == expected_word)
+    {
+        return true;
+    }
+    expected.node = reinterpret_cast<Hook*>(static_cast<uintptr_t>(static_cast<uint64_t>(previous_word)));
+    expected.tag = static_cast<uint64_t>(previous_word >> 64);
+    return false;
+}
+#else
+template<class T, class Tag, size_t EliminationSlots>
+uint64_t Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::Pack(const TaggedHead& head) noexcept
+{
+    uint64_t node = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(head.node));
+    // See the precondition in the description of the class
+    assert((node >> pointer_bits) == 0);
+    return ((head.tag << pointer_bits) | node);
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+typename Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::TaggedHead
+Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::Unpack(uint64_t head) noexcept
+{
+    TaggedHead result;
+    result.node = reinterpret_cast<Hook*>(static_cast<uintptr_t>(head & pointer_mask));
+    result.tag = (head >> pointer_bits);
+    return result;
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+typename Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::TaggedHead
+Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::loadHead() const noexcept
+{
+    return Unpack(m_head.load(std::memory_order_acquire));
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+bool Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::replaceHead(TaggedHead& expected, Hook* node) noexcept
+{
+    uint64_t expected_head = Pack(expected);
+    TaggedHead new_head;
+    new_head.node = node;
+    new_head.tag = (expected.tag + 1);
+    if (m_head.compare_exchange_weak(expected_head, Pack(new_head), std::memory_order_acq_rel,
+        std::memory_order_acquire))
+    {
+        return true;
+    }
+    expected = Unpack(expected_head);
+    return false;
+}
+#endif
+
+template<class T, class Tag, size_t EliminationSlots>
+bool Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::tryPush(Hook* first, Hook* last) noexcept
+{
+    TaggedHead head = loadHead();
+    last->setNextNode(head.node);
+    return replaceHead(head, first);
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+bool Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::tryPop(Hook*& node) noexcept
+{
+    TaggedHead head = loadHead();
+    Hook* head_node = head.node;
+    if (!head_node)
+    {
+        node = nullptr;
+        return true;
+    }
+
+    // head_node may have been popped by another thread since head was read, in which case this reads a link that
+    // is being changed but the compare-and-swap fails because the tag has changed
+    if (replaceHead(head, head_node->nextNode()))
+    {
+        node = head_node;
+        return true;
+    }
+    return false;
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+bool Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::eliminatePush(Hook* node) noexcept
+{
+    EliminationSlot& slot = eliminationSlot();
+    Hook* expected = nullptr;
+    if (!slot.node.compare_exchange_strong(expected, node, std::memory_order_release, std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < elimination_spins; ++i)
+    {
+        if (slot.node.load(std::memory_order_relaxed) != node)
+        {
+            // A pop has taken the object
+            return true;
+        }
+    }
+
+    // Withdraw the offer. If this fails a pop took the object in the meantime.
+    expected = node;
+    return !slot.node.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed,
+        std::memory_order_relaxed);
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+typename Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::Hook*
+Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::eliminatePop() noexcept
+{
+    EliminationSlot& slot = eliminationSlot();
+    Hook* node = slot.node.load(std::memory_order_relaxed);
+    if (node && slot.node.compare_exchange_strong(node, nullptr, std::memory_order_acquire,
+        std::memory_order_relaxed))
+    {
+        return node;
+    }
+    return nullptr;
+}
+
+template<class T, class Tag, size_t EliminationSlots>
+typename Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::EliminationSlot&
+Ishiko::ConcurrentStack<T, Tag, EliminationSlots>::eliminationSlot() noexcept
+{
+    // Each thread walks the slots with its own xorshift generator so that threads spread over the array
+    thread_local uint32_t state = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&state) >> 4) | 1;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return m_elimination_slots[state % ((EliminationSlots > 0) ? EliminationSlots : 1)];
+}
+
+#endif
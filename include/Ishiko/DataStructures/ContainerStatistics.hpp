@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_CONTAINERSTATISTICS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_CONTAINERSTATISTICS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Ishiko
+{
+    // The allocations seen by a CountingAllocator
+    struct AllocationStatistics
+    {
+        size_t allocation_count = 0;
+        size_t deallocation_count = 0;
+        // The bytes requested for the blocks that are currently allocated
+        size_t allocated_bytes = 0;
+        // The highest value allocated_bytes ever had
+        size_t peak_allocated_bytes = 0;
+    };
+
+    // A snapshot of the memory a container holds and of its shape, as returned by the statistics() function of the
+    // containers. Nothing is tracked while the container is used, the snapshot is computed by visiting every node
+    // when it is asked for. The allocation counts are only available if the container allocates its nodes with a
+    // CountingAllocator.
+    struct ContainerStatistics
+    {
+        size_t element_count = 0;
+        // The bytes used by the elements. For the node based containers these are the bytes requested for the nodes,
+        // which includes the links, the SkipList towers and the padding. The allocator may round them up.
+        size_t element_bytes = 0;
+        // The bytes held for future elements: the SkipList nodes kept for reuse, the unused slots of the BPlusTree
+        // leaves and of the UnrolledSinglyLinkedList chunks or the unused capacity of a DynamicArray or of the slab of
+        // a CompactDoublyLinkedList
+        size_t spare_bytes = 0;
+        // The number of nodes on the longest path from the root to a leaf for the trees, the number of levels in use
+        // for SkipList and 0 for the other containers
+        size_t height = 0;
+        // level_histogram[i] is the number of SkipList nodes with i + 1 levels, empty for the other containers
+        std::vector<size_t> level_histogram;
+        bool has_allocation_statistics = false;
+        AllocationStatistics allocations;
+
+        std::string toString() const;
+        std::string toJSON() const;
+    };
+
+    // Fills in statistics.allocations if allocator keeps count of its allocations, which only CountingAllocator does
+    template<class Allocator>
+    void AddAllocationStatistics(const Allocator& allocator, ContainerStatistics& statistics) noexcept;
+
+    // Adds the nodes of the binary tree rooted at root_node, each of node_size bytes, to statistics and computes the
+    // height of the tree. The tree is walked iteratively through the parent links so the memory used doesn't depend
+    // on the shape of the tree.
+    template<class Node>
+    void AddTreeStatistics(const Node* root_node, size_t node_size, ContainerStatistics& statistics) noexcept;
+}
+
+template<class Allocator>
+void Ishiko::AddAllocationStatistics(const Allocator& /*allocator*/, ContainerStatistics& /*statistics*/) noexcept
+{
+}
+
+template<class Node>
+void Ishiko::AddTreeStatistics(const Node* root_node, size_t node_size, ContainerStatistics& statistics) noexcept
+{
+    if (!root_node)
+    {
+        return;
+    }
+
+    // The walk is over when it goes back up from root_node
+    const Node* end_node = root_node->parentNode();
+    const Node* node = root_node;
+    const Node* previous_node = end_node;
+    size_t depth = 1;
+    while (node != end_node)
+    {
+        const Node* next_node;
+        if (previous_node == node->parentNode())
+        {
+            // First visit, coming down from the parent
+            ++statistics.element_count;
+            statistics.element_bytes += node_size;
+            if (depth > statistics.height)
+            {
+                statistics.height = depth;
+            }
+            if (node->leftChildNode())
+            {
+                next_node = node->leftChildNode();
+            }
+            else if (node->rightChildNode())
+            {
+                next_node = node->rightChildNode();
+            }
+            else
+            {
+                next_node = node->parentNode();
+            }
+        }
+        else if ((previous_node == node->leftChildNode()) && node->rightChildNode())
+        {
+            next_node = node->rightChildNode();
+        }
+        else
+        {
+            next_node = node->parentNode();
+        }
+
+        if (next_node == node->parentNode())
+        {
+            --depth;
+        }
+        else
+        {
+            ++depth;
+        }
+        previous_node = node;
+        node = next_node;
+    }
+}
+
+#endif
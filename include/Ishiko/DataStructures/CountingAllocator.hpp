@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_COUNTINGALLOCATOR_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_COUNTINGALLOCATOR_HPP
+
+#include "ContainerStatistics.hpp"
+#include "NewDeleteAllocator.hpp"
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+
+namespace Ishiko
+{
+    // A node allocator that forwards to Allocator and keeps count of the allocations. A container that uses it
+    // includes the counts in its statistics(). Counting is opt-in so the containers using other allocators don't pay
+    // for it.
+    //
+    // See NewDeleteAllocator for the requirements of node allocators. The allocator isn't thread-safe.
+    template<class Allocator = NewDeleteAllocator>
+    class CountingAllocator
+    {
+    public:
+        static const bool supports_release = Allocator::supports_release;
+
+        CountingAllocator() = default;
+        CountingAllocator(const CountingAllocator& other) = delete;
+        CountingAllocator& operator=(const CountingAllocator& other) = delete;
+
+        const AllocationStatistics& statistics() const noexcept;
+
+        void* allocate(size_t size);
+        void* allocate(size_t size, Error& error) noexcept;
+        void deallocate(void* memory, size_t size) noexcept;
+        void reserve(size_t count, size_t size);
+        void reserve(size_t count, size_t size, Error& error) noexcept;
+        // All the blocks still allocated are counted as deallocated
+        void release() noexcept;
+
+    private:
+        void countAllocation(size_t size) noexcept;
+
+        Allocator m_allocator;
+        AllocationStatistics m_statistics;
+    };
+
+    template<class Allocator>
+    void AddAllocationStatistics(const CountingAllocator<Allocator>& allocator,
+        ContainerStatistics& statistics) noexcept;
+}
+
+template<class Allocator>
+const bool Ishiko::CountingAllocator<Allocator>::supports_release;
+
+template<class Allocator>
+const Ishiko::AllocationStatistics& Ishiko::CountingAllocator<Allocator>::statistics() const noexcept
+{
+    return m_statistics;
+}
+
+template<class Allocator>
+void* Ishiko::CountingAllocator<Allocator>::allocate(size_t size)
+{
+    void* memory = m_allocator.allocate(size);
+    countAllocation(size);
+    return memory;
+}
+
+template<class Allocator>
+void* Ishiko::CountingAllocator<Allocator>::allocate(size_t size, Error& error) noexcept
+{
+    void* memory = m_allocator.allocate(size, error);
+    if (memory)
+    {
+        countAllocation(size);
+    }
+    return memory;
+}
+
+template<class Allocator>
+void Ishiko::CountingAllocator<Allocator>::deallocate(void* memory, size_t size) noexcept
+{
+    m_allocator.deallocate(memory, size);
+    ++m_statistics.deallocation_count;
+    m_statistics.allocated_bytes -= size;
+}
+
+template<class Allocator>
+void Ishiko::CountingAllocator<Allocator>::reserve(size_t count, size_t size)
+{
+    m_allocator.reserve(count, size);
+}
+
+template<class Allocator>
+void Ishiko::CountingAllocator<Allocator>::reserve(size_t count, size_t size, Error& error) noexcept
+{
+    m_allocator.reserve(count, size, error);
+}
+
+template<class Allocator>
+void Ishiko::CountingAllocator<Allocator>::release() noexcept
+{
+    m_allocator.release();
+    m_statistics.deallocation_count = m_statistics.allocation_count;
+    m_statistics.allocated_bytes = 0;
+}
+
+template<class Allocator>
+void Ishiko::CountingAllocator<Allocator>::countAllocation(size_t size) noexcept
+{
+    ++m_statistics.allocation_count;
+    m_statistics.allocated_bytes += size;
+    if (m_statistics.allocated_bytes > m_statistics.peak_allocated_bytes)
+    {
+        m_statistics.peak_allocated_bytes = m_statistics.allocated_bytes;
+    }
+}
+
+template<class Allocator>
+void Ishiko::AddAllocationStatistics(const CountingAllocator<Allocator>& allocator,
+    ContainerStatistics& statistics) noexcept
+{
+    statistics.has_allocation_statistics = true;
+    statistics.allocations = allocator.statistics();
+}
+
+#endif
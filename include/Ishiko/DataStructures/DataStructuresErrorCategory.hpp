@@ -16,7 +16,9 @@ namespace Ishiko
             generic_error = -1,
             node_does_not_exist = -2,
             right_child_node_does_not_exist = -3,
-            left_child_node_does_not_exist = -4
+            left_child_node_does_not_exist = -4,
+            allocation_failure = -5,
+            invalid_image = -6
         };
 
         static const DataStructuresErrorCategory& Get() noexcept;
@@ -4,31 +4,75 @@
 #ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_DATATYPETRAITS_HPP
 #define GUARD_ISHIKO_CPP_DATASTRUCTURES_DATATYPETRAITS_HPP
 
+#include "DataStructuresErrorCategory.hpp"
 #include <Ishiko/Errors.hpp>
 #include <type_traits>
+#include <utility>
 
 namespace Ishiko
 {
+    // The Move function of DataTypeTraits. If moving a value can throw the error is reported through error and a
+    // default constructed value is returned instead.
+    template<typename DataType, typename Enable = void>
+    class DataTypeMoveTraits
+    {
+    };
+
+    template<typename DataType>
+    class DataTypeMoveTraits<DataType,
+        typename std::enable_if<std::is_nothrow_move_constructible<DataType>::value>::type>
+    {
+    public:
+        static DataType Move(DataType&& source, Error& error);
+    };
+
+    template<typename DataType>
+    class DataTypeMoveTraits<DataType,
+        typename std::enable_if<!std::is_nothrow_move_constructible<DataType>::value>::type>
+    {
+    public:
+        static DataType Move(DataType&& source, Error& error);
+    };
+
     template<typename DataType, typename Enable = void>
     class DataTypeTraits
     {
     };
 
+    // trivially_relocatable means a value can be moved to another address with memcpy, which the containers use to
+    // move whole blocks of values at once. Trivially copyable types always are but many other types, e.g. ones that
+    // only hold an owning pointer, are too and custom traits can declare it.
     template<typename DataType>
     class DataTypeTraits<DataType, typename std::enable_if<std::is_nothrow_copy_constructible<DataType>::value>::type>
+        : public DataTypeMoveTraits<DataType>
     {
     public:
+        static const bool trivially_relocatable = std::is_trivially_copyable<DataType>::value;
+
         static DataType Copy(const DataType& source, Error& error);
     };
 
     template<typename DataType>
     class DataTypeTraits<DataType, typename std::enable_if<!std::is_nothrow_copy_constructible<DataType>::value>::type>
+        : public DataTypeMoveTraits<DataType>
     {
     public:
+        static const bool trivially_relocatable = false;
+
         static DataType Copy(const DataType& source, Error& error);
     };
 }
 
+template<typename DataType>
+const bool
+Ishiko::DataTypeTraits<DataType, typename std::enable_if<std::is_nothrow_copy_constructible<DataType>::value>::type>::
+trivially_relocatable;
+
+template<typename DataType>
+const bool
+Ishiko::DataTypeTraits<DataType, typename std::enable_if<!std::is_nothrow_copy_constructible<DataType>::value>::type>::
+trivially_relocatable;
+
 template<typename DataType>
 DataType
 Ishiko::DataTypeTraits<DataType, typename std::enable_if<std::is_nothrow_copy_constructible<DataType>::value>::type>::
@@ -55,4 +99,30 @@ Copy(const DataType& source, Error& error)
     }
 }
 
+template<typename DataType>
+DataType Ishiko::DataTypeMoveTraits<DataType,
+    typename std::enable_if<std::is_nothrow_move_constructible<DataType>::value>::type>::Move(DataType&& source,
+        Error& /*error*/)
+{
+    return DataType(std::move(source));
+}
+
+template<typename DataType>
+DataType Ishiko::DataTypeMoveTraits<DataType,
+    typename std::enable_if<!std::is_nothrow_move_constructible<DataType>::value>::type>::Move(DataType&& source,
+        Error& error)
+{
+    static_assert(noexcept(DataType()));
+
+    try
+    {
+        return DataType(std::move(source));
+    }
+    catch (...)
+    {
+        Fail(DataStructuresErrorCategory::Value::generic_error, "Failed to move value", __FILE__, __LINE__, error);
+        return DataType();
+    }
+}
+
 #endif
@@ -4,13 +4,24 @@
 #ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_DOUBLYLINKEDLIST_HPP
 #define GUARD_ISHIKO_CPP_DATASTRUCTURES_DOUBLYLINKEDLIST_HPP
 
+#include "ContainerStatistics.hpp"
 #include "DataStructuresErrorCategory.hpp"
 #include "DataTypeTraits.hpp"
+#include "DoublyLinkedListBase.hpp"
+#include "InPlace.hpp"
+#include "NewDeleteAllocator.hpp"
+#include "NodeDeletion.hpp"
 #include <Ishiko/Errors.hpp>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace Ishiko
 {
-    template<typename DataType, typename DataTypeTraits = DataTypeTraits<DataType>>
+    // The list keeps track of its last node and of its size so that adding or removing a node at either end, size()
+    // and splice() all take constant time. Allocator is the node allocator, see NewDeleteAllocator.
+    template<typename DataType, typename DataTypeTraits = DataTypeTraits<DataType>,
+        typename Allocator = NewDeleteAllocator>
     class DoublyLinkedList
     {
     public:
@@ -18,8 +29,11 @@ namespace Ishiko
         {
         public:
             Node(const DataType& data);
+            Node(DataType&& data);
             Node(const DataType& data, Error& error) noexcept;
-            ~Node() noexcept;
+            Node(DataType&& data, Error& error) noexcept;
+            template<typename... Arguments>
+            Node(InPlace, Arguments&&... arguments);
 
             const Node* previousNode() const noexcept;
             Node* previousNode() noexcept;
@@ -37,208 +51,617 @@ namespace Ishiko
             DataType m_data;
         };
 
+        // The number of nodes whose data each task of the parallel clear destroys
+        static const size_t default_grain_size = 1024;
+
         DoublyLinkedList() noexcept = default;
         ~DoublyLinkedList() noexcept;
 
         bool isEmpty() const noexcept;
+        size_t size() const noexcept;
         Node* head();
         Node* head(Error& error) noexcept;
+        Node* tail();
+        Node* tail(Error& error) noexcept;
 
         template<typename Callable>
         void traverse(Callable&& callable) const;
 
         void setHead(const DataType& data);
+        void setHead(DataType&& data);
         void setHead(const DataType& data, Error& error) noexcept;
+        void setHead(DataType&& data, Error& error) noexcept;
         Node* insertAfter(const DataType& data, Node* previous_node);
+        Node* insertAfter(DataType&& data, Node* previous_node);
         Node* insertBefore(const DataType& data, Node* next_node);
+        Node* insertBefore(DataType&& data, Node* next_node);
+        // Same as insertAfter and insertBefore but the data of the new node is constructed in place from arguments
+        template<typename... Arguments>
+        Node* emplaceAfter(Node* previous_node, Arguments&&... arguments);
+        template<typename... Arguments>
+        Node* emplaceBefore(Node* next_node, Arguments&&... arguments);
+        // The versions that take an error return nullptr if the node couldn't be created
+        Node* pushFront(const DataType& data);
+        Node* pushFront(DataType&& data);
+        Node* pushFront(const DataType& data, Error& error) noexcept;
+        Node* pushFront(DataType&& data, Error& error) noexcept;
+        Node* pushBack(const DataType& data);
+        Node* pushBack(DataType&& data);
+        Node* pushBack(const DataType& data, Error& error) noexcept;
+        Node* pushBack(DataType&& data, Error& error) noexcept;
+        template<typename... Arguments>
+        Node* emplaceFront(Arguments&&... arguments);
+        template<typename... Arguments>
+        Node* emplaceBack(Arguments&&... arguments);
+        void popFront();
+        void popFront(Error& error) noexcept;
+        void popBack();
+        void popBack(Error& error) noexcept;
+        // Destroys node, which must be in this list
+        void erase(Node* node) noexcept;
+        // Moves nodes from other to this list before next_node, or at the end of the list if next_node is nullptr.
+        // The nodes are relinked, not copied, so this doesn't allocate and pointers to the nodes stay valid. The
+        // first version moves all the nodes of other and the second one moves node. The third one moves the count
+        // nodes from first_node to last_node included, count has to be given so that the nodes don't have to be
+        // counted. next_node must not be one of the nodes moved. The nodes change owner so the lists must use an
+        // allocator without state, like NewDeleteAllocator, that can free the nodes the other one allocated.
+        void splice(Node* next_node, DoublyLinkedList& other) noexcept;
+        void splice(Node* next_node, DoublyLinkedList& other, Node* node) noexcept;
+        void splice(Node* next_node, DoublyLinkedList& other, Node* first_node, Node* last_node,
+            size_t count) noexcept;
+        void clear() noexcept;
+        // Same as clear but the values are destroyed on the threads of pool, see ClearNodes
+        void clear(WorkStealingPool& pool, size_t grain_size = default_grain_size) noexcept;
+
+        // Makes sure count nodes can be inserted without the allocator needing more memory from the system
+        void reserve(size_t count);
+        void reserve(size_t count, Error& error) noexcept;
+
+        // Visits every node to compute a snapshot of the memory the list holds, see ContainerStatistics
+        ContainerStatistics statistics() const;
 
     private:
-        static void linkNodes(Node* start_node, Node* end_node) noexcept;
-
-        Node* m_head = nullptr;
+        template<typename... Arguments>
+        Node* createNode(Arguments&&... arguments);
+        template<typename Data>
+        Node* createNode(Data&& data, Error& error) noexcept;
+        void destroyNode(Node* node) noexcept;
+
+        DoublyLinkedListBase<Node> m_list_impl;
+        Allocator m_allocator;
     };
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::Node(const DataType& data)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const size_t Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::default_grain_size;
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(const DataType& data)
     : m_data(data)
 {
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::Node(const DataType& data, Error& error) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(DataType&& data)
+    : m_data(std::move(data))
+{
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(const DataType& data, Error& error) noexcept
     : m_data(DataTypeTraits::Copy(data, error))
 {
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::~Node() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(DataType&& data, Error& error) noexcept
+    : m_data(DataTypeTraits::Move(std::move(data), error))
 {
-    delete m_next_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-const typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::previousNode() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(InPlace, Arguments&&... arguments)
+    : m_data(std::forward<Arguments>(arguments)...)
+{
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::previousNode() const noexcept
 {
     return m_previous_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::previousNode() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::previousNode() noexcept
 {
     return m_previous_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::setPreviousNode(Node* node) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::setPreviousNode(Node* node) noexcept
 {
     m_previous_node = node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-const typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::nextNode() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::nextNode() const noexcept
 {
     return m_next_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::nextNode() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::nextNode() noexcept
 {
     return m_next_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::setNextNode(Node* node) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::setNextNode(Node* node) noexcept
 {
     m_next_node = node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-const DataType& Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::data() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const DataType& Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::data() const noexcept
 {
     return m_data;
 }
 
-template<typename DataType, typename DataTypeTraits>
-DataType& Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node::data() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+DataType& Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node::data() noexcept
 {
     return m_data;
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::~DoublyLinkedList() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::~DoublyLinkedList() noexcept
+{
+    clear();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+bool Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::isEmpty() const noexcept
+{
+    return m_list_impl.isEmpty();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+size_t Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::size() const noexcept
 {
-    delete m_head;
+    return m_list_impl.size();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::head()
+{
+    Node* head = m_list_impl.head();
+    if (head == nullptr)
+    {
+        Throw(DataStructuresErrorCategory::Value::node_does_not_exist, "Linked list is empty", __FILE__, __LINE__);
+    }
+    return head;
 }
 
-template<typename DataType, typename DataTypeTraits>
-bool Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::isEmpty() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::head(Error& error) noexcept
 {
-    return (m_head == nullptr);
+    Node* head = m_list_impl.head();
+    if (head == nullptr)
+    {
+        Fail(DataStructuresErrorCategory::Value::node_does_not_exist, "Linked list is empty", __FILE__, __LINE__,
+            error);
+    }
+    return head;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::head()
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::tail()
 {
-    if (m_head == nullptr)
+    Node* tail = m_list_impl.tail();
+    if (tail == nullptr)
     {
         Throw(DataStructuresErrorCategory::Value::node_does_not_exist, "Linked list is empty", __FILE__, __LINE__);
     }
-    return m_head;
+    return tail;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::head(Error& error) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::tail(Error& error) noexcept
 {
-    if (m_head == nullptr)
+    Node* tail = m_list_impl.tail();
+    if (tail == nullptr)
     {
         Fail(DataStructuresErrorCategory::Value::node_does_not_exist, "Linked list is empty", __FILE__, __LINE__,
             error);
     }
-    return m_head;
+    return tail;
 }
 
-template<typename DataType, typename DataTypeTraits>
+template<typename DataType, typename DataTypeTraits, typename Allocator>
 template<typename Callable>
-void Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::traverse(Callable&& callable) const
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::traverse(Callable&& callable) const
 {
-    Node* current_node = m_head;
-    while (current_node)
+    m_list_impl.traverse(std::forward<Callable>(callable));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::setHead(const DataType& data)
+{
+    Node* head = m_list_impl.head();
+    if (head)
+    {
+        head->data() = data;
+    }
+    else
     {
-        callable(current_node->data());
-        current_node = current_node->nextNode();
+        m_list_impl.pushFront(createNode(data));
     }
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::setHead(const DataType& data)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::setHead(DataType&& data)
 {
-    if (m_head == nullptr)
+    Node* head = m_list_impl.head();
+    if (head)
     {
-        m_head = new Node(data);
+        head->data() = std::move(data);
     }
     else
     {
-        m_head->data() = data;
+        m_list_impl.pushFront(createNode(std::move(data)));
     }
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::setHead(const DataType& data, Error& error) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::setHead(const DataType& data, Error& error) noexcept
 {
-    if (m_head == nullptr)
+    Node* head = m_list_impl.head();
+    if (head)
     {
-        m_head = NewObject<Node>(error, data, error);
+        head->data() = data;
     }
     else
     {
-        m_head->data() = data;
+        Node* new_node = createNode(data, error);
+        if (new_node)
+        {
+            m_list_impl.pushFront(new_node);
+        }
     }
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::insertAfter(const DataType& data, Node* previous_node)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::setHead(DataType&& data, Error& error) noexcept
 {
-    Node* new_node = new Node(data);
-    Node* next_node = previous_node->nextNode();
-    if (next_node)
+    Node* head = m_list_impl.head();
+    if (head)
+    {
+        head->data() = std::move(data);
+    }
+    else
     {
-        linkNodes(new_node, next_node);
+        Node* new_node = createNode(std::move(data), error);
+        if (new_node)
+        {
+            m_list_impl.pushFront(new_node);
+        }
     }
-    linkNodes(previous_node, new_node);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::insertAfter(const DataType& data, Node* previous_node)
+{
+    return emplaceAfter(previous_node, data);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::insertAfter(DataType&& data, Node* previous_node)
+{
+    return emplaceAfter(previous_node, std::move(data));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::insertBefore(const DataType& data, Node* next_node)
+{
+    return emplaceBefore(next_node, data);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::insertBefore(DataType&& data, Node* next_node)
+{
+    return emplaceBefore(next_node, std::move(data));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::emplaceAfter(Node* previous_node,
+    Arguments&&... arguments)
+{
+    Node* new_node = createNode(std::forward<Arguments>(arguments)...);
+    m_list_impl.insertAfter(new_node, previous_node);
+    return new_node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::emplaceBefore(Node* next_node, Arguments&&... arguments)
+{
+    Node* new_node = createNode(std::forward<Arguments>(arguments)...);
+    m_list_impl.insertBefore(new_node, next_node);
     return new_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::insertBefore(const DataType& data, Node* next_node)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::pushFront(const DataType& data)
 {
-    Node* new_node = new Node(data);
-    Node* previous_node = next_node->previousNode();
-    if (previous_node)
+    return emplaceFront(data);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::pushFront(DataType&& data)
+{
+    return emplaceFront(std::move(data));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::pushFront(const DataType& data, Error& error) noexcept
+{
+    Node* new_node = createNode(data, error);
+    if (new_node)
     {
-        linkNodes(previous_node, new_node);
+        m_list_impl.pushFront(new_node);
     }
-    else
+    return new_node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::pushFront(DataType&& data, Error& error) noexcept
+{
+    Node* new_node = createNode(std::move(data), error);
+    if (new_node)
     {
-        m_head = new_node;
+        m_list_impl.pushFront(new_node);
     }
-    linkNodes(new_node, next_node);
     return new_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::DoublyLinkedList<DataType, DataTypeTraits>::linkNodes(Node* start_node, Node* end_node) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::pushBack(const DataType& data)
+{
+    return emplaceBack(data);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::pushBack(DataType&& data)
+{
+    return emplaceBack(std::move(data));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::pushBack(const DataType& data, Error& error) noexcept
+{
+    Node* new_node = createNode(data, error);
+    if (new_node)
+    {
+        m_list_impl.pushBack(new_node);
+    }
+    return new_node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::pushBack(DataType&& data, Error& error) noexcept
+{
+    Node* new_node = createNode(std::move(data), error);
+    if (new_node)
+    {
+        m_list_impl.pushBack(new_node);
+    }
+    return new_node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::emplaceFront(Arguments&&... arguments)
+{
+    Node* new_node = createNode(std::forward<Arguments>(arguments)...);
+    m_list_impl.pushFront(new_node);
+    return new_node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::emplaceBack(Arguments&&... arguments)
+{
+    Node* new_node = createNode(std::forward<Arguments>(arguments)...);
+    m_list_impl.pushBack(new_node);
+    return new_node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::popFront()
+{
+    erase(head());
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::popFront(Error& error) noexcept
+{
+    Node* node = head(error);
+    if (node)
+    {
+        erase(node);
+    }
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::popBack()
+{
+    erase(tail());
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::popBack(Error& error) noexcept
+{
+    Node* node = tail(error);
+    if (node)
+    {
+        erase(node);
+    }
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::erase(Node* node) noexcept
+{
+    m_list_impl.remove(node);
+    destroyNode(node);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::splice(Node* next_node,
+    DoublyLinkedList& other) noexcept
+{
+    if (!other.isEmpty())
+    {
+        splice(next_node, other, other.m_list_impl.head(), other.m_list_impl.tail(), other.size());
+    }
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::splice(Node* next_node, DoublyLinkedList& other,
+    Node* node) noexcept
+{
+    splice(next_node, other, node, node, 1);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::splice(Node* next_node, DoublyLinkedList& other,
+    Node* first_node, Node* last_node, size_t count) noexcept
+{
+    static_assert(std::is_empty<Allocator>::value, "splice needs an allocator without state");
+
+    m_list_impl.splice(next_node, other.m_list_impl, first_node, last_node, count);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::clear() noexcept
+{
+    ClearNodes<Node>(m_allocator, [this]() { m_list_impl.clear([this](Node* node) { destroyNode(node); }); },
+        [this]() { m_list_impl.clear(); });
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::clear(WorkStealingPool& pool,
+    size_t grain_size) noexcept
+{
+    if (pool.workerCount() == 0)
+    {
+        clear();
+        return;
+    }
+
+    // Once their data has been destroyed the nodes don't need to be destroyed, only deallocated
+    ClearNodes<Node>(m_allocator,
+        [this, &pool, grain_size]()
+        {
+            DestroyNodeListValues(pool, m_list_impl.head(), grain_size,
+                [](Node* node) { node->data().~DataType(); });
+        },
+        [this]() { m_list_impl.clear([this](Node* node) { m_allocator.deallocate(node, sizeof(Node)); }); },
+        [this]() { m_list_impl.clear(); });
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::reserve(size_t count)
+{
+    m_allocator.reserve(count, sizeof(Node));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::reserve(size_t count, Error& error) noexcept
+{
+    m_allocator.reserve(count, sizeof(Node), error);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::ContainerStatistics Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::statistics() const
+{
+    ContainerStatistics statistics;
+    m_list_impl.traverse(
+        [&statistics](const DataType&)
+        {
+            ++statistics.element_count;
+            statistics.element_bytes += sizeof(Node);
+        });
+    AddAllocationStatistics(m_allocator, statistics);
+    return statistics;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::createNode(Arguments&&... arguments)
+{
+    void* memory = m_allocator.allocate(sizeof(Node));
+    try
+    {
+        return new(memory) Node(InPlace(), std::forward<Arguments>(arguments)...);
+    }
+    catch (...)
+    {
+        m_allocator.deallocate(memory, sizeof(Node));
+        throw;
+    }
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Data>
+typename Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::createNode(Data&& data, Error& error) noexcept
+{
+    void* memory = m_allocator.allocate(sizeof(Node), error);
+    if (!memory)
+    {
+        return nullptr;
+    }
+    Node* node = new(memory) Node(std::forward<Data>(data), error);
+    if (error)
+    {
+        destroyNode(node);
+        return nullptr;
+    }
+    return node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::DoublyLinkedList<DataType, DataTypeTraits, Allocator>::destroyNode(Node* node) noexcept
 {
-    start_node->setNextNode(end_node);
-    end_node->setPreviousNode(start_node);
+    node->~Node();
+    m_allocator.deallocate(node, sizeof(Node));
 }
 
 #endif
@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_DOUBLYLINKEDLISTBASE_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_DOUBLYLINKEDLISTBASE_HPP
+
+#include "NodeDeletion.hpp"
+#include <cstddef>
+#include <utility>
+
+namespace Ishiko
+{
+    // The linking logic of a doubly linked list. The base doesn't own the nodes, the list using it decides how they
+    // are allocated and destroyed. The last node and the number of nodes are tracked so that all the operations,
+    // splice included, take constant time.
+    template<class Node>
+    class DoublyLinkedListBase
+    {
+    public:
+        bool isEmpty() const noexcept;
+        size_t size() const noexcept;
+        Node* head() noexcept;
+        Node* tail() noexcept;
+
+        template<typename Callable>
+        void traverse(Callable&& callable) const;
+
+        void pushFront(Node* new_node) noexcept;
+        void pushBack(Node* new_node) noexcept;
+        void insertAfter(Node* new_node, Node* previous_node) noexcept;
+        void insertBefore(Node* new_node, Node* next_node) noexcept;
+        // Unlinks node, which must be in the list
+        void remove(Node* node) noexcept;
+        // Moves the count nodes from first_node to last_node included out of other and links them in before
+        // next_node, or at the end of the list if next_node is nullptr. The nodes must be in that order in other and
+        // next_node must not be one of them. The count is needed to keep the sizes right without walking the nodes.
+        void splice(Node* next_node, DoublyLinkedListBase& other, Node* first_node, Node* last_node,
+            size_t count) noexcept;
+        // Unlinks all the nodes and passes each of them to deleter
+        template<typename Deleter>
+        void clear(Deleter&& deleter) noexcept;
+        // Forgets all the nodes without visiting them
+        void clear() noexcept;
+
+    private:
+        static void linkNodes(Node* start_node, Node* end_node) noexcept;
+
+        Node* m_head = nullptr;
+        Node* m_tail = nullptr;
+        size_t m_size = 0;
+    };
+}
+
+template<class Node>
+bool Ishiko::DoublyLinkedListBase<Node>::isEmpty() const noexcept
+{
+    return (m_head == nullptr);
+}
+
+template<class Node>
+size_t Ishiko::DoublyLinkedListBase<Node>::size() const noexcept
+{
+    return m_size;
+}
+
+template<class Node>
+Node* Ishiko::DoublyLinkedListBase<Node>::head() noexcept
+{
+    return m_head;
+}
+
+template<class Node>
+Node* Ishiko::DoublyLinkedListBase<Node>::tail() noexcept
+{
+    return m_tail;
+}
+
+template<class Node>
+template<typename Callable>
+void Ishiko::DoublyLinkedListBase<Node>::traverse(Callable&& callable) const
+{
+    Node* current_node = m_head;
+    while (current_node)
+    {
+        callable(current_node->data());
+        current_node = current_node->nextNode();
+    }
+}
+
+template<class Node>
+void Ishiko::DoublyLinkedListBase<Node>::pushFront(Node* new_node) noexcept
+{
+    new_node->setPreviousNode(nullptr);
+    new_node->setNextNode(m_head);
+    if (m_head)
+    {
+        m_head->setPreviousNode(new_node);
+    }
+    else
+    {
+        m_tail = new_node;
+    }
+    m_head = new_node;
+    ++m_size;
+}
+
+template<class Node>
+void Ishiko::DoublyLinkedListBase<Node>::pushBack(Node* new_node) noexcept
+{
+    if (m_tail)
+    {
+        insertAfter(new_node, m_tail);
+    }
+    else
+    {
+        pushFront(new_node);
+    }
+}
+
+template<class Node>
+void Ishiko::DoublyLinkedListBase<Node>::insertAfter(Node* new_node, Node* previous_node) noexcept
+{
+    Node* next_node = previous_node->nextNode();
+    new_node->setNextNode(next_node);
+    if (next_node)
+    {
+        next_node->setPreviousNode(new_node);
+    }
+    else
+    {
+        m_tail = new_node;
+    }
+    linkNodes(previous_node, new_node);
+    ++m_size;
+}
+
+template<class Node>
+void Ishiko::DoublyLinkedListBase<Node>::insertBefore(Node* new_node, Node* next_node) noexcept
+{
+    Node* previous_node = next_node->previousNode();
+    if (previous_node)
+    {
+        linkNodes(previous_node, new_node);
+    }
+    else
+    {
+        new_node->setPreviousNode(nullptr);
+        m_head = new_node;
+    }
+    linkNodes(new_node, next_node);
+    ++m_size;
+}
+
+template<class Node>
+void Ishiko::DoublyLinkedListBase<Node>::remove(Node* node) noexcept
+{
+    Node* previous_node = node->previousNode();
+    Node* next_node = node->nextNode();
+    if (previous_node)
+    {
+        previous_node->setNextNode(next_node);
+    }
+    else
+    {
+        m_head = next_node;
+    }
+    if (next_node)
+    {
+        next_node->setPreviousNode(previous_node);
+    }
+    else
+    {
+        m_tail = previous_node;
+    }
+    node->setPreviousNode(nullptr);
+    node->setNextNode(nullptr);
+    --m_size;
+}
+
+template<class Node>
+void Ishiko::DoublyLinkedListBase<Node>::splice(Node* next_node, DoublyLinkedListBase& other, Node* first_node,
+    Node* last_node, size_t count) noexcept
+{
+    // Close the gap the nodes leave in other
+    Node* other_previous_node = first_node->previousNode();
+    Node* other_next_node = last_node->nextNode();
+    if (other_previous_node)
+    {
+        other_previous_node->setNextNode(other_next_node);
+    }
+    else
+    {
+        other.m_head = other_next_node;
+    }
+    if (other_next_node)
+    {
+        other_next_node->setPreviousNode(other_previous_node);
+    }
+    else
+    {
+        other.m_tail = other_previous_node;
+    }
+    other.m_size -= count;
+
+    Node* previous_node = (next_node ? next_node->previousNode() : m_tail);
+    if (previous_node)
+    {
+        linkNodes(previous_node, first_node);
+    }
+    else
+    {
+        first_node->setPreviousNode(nullptr);
+        m_head = first_node;
+    }
+    if (next_node)
+    {
+        linkNodes(last_node, next_node);
+    }
+    else
+    {
+        last_node->setNextNode(nullptr);
+        m_tail = last_node;
+    }
+    m_size += count;
+}
+
+template<class Node>
+template<typename Deleter>
+void Ishiko::DoublyLinkedListBase<Node>::clear(Deleter&& deleter) noexcept
+{
+    DeleteNodeList(m_head, std::forward<Deleter>(deleter));
+    clear();
+}
+
+template<class Node>
+void Ishiko::DoublyLinkedListBase<Node>::clear() noexcept
+{
+    m_head = nullptr;
+    m_tail = nullptr;
+    m_size = 0;
+}
+
+template<class Node>
+void Ishiko::DoublyLinkedListBase<Node>::linkNodes(Node* start_node, Node* end_node) noexcept
+{
+    start_node->setNextNode(end_node);
+    end_node->setPreviousNode(start_node);
+}
+
+#endif
@@ -4,4 +4,493 @@
 #ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_DYNAMICARRAY_HPP
 #define GUARD_ISHIKO_CPP_DATASTRUCTURES_DYNAMICARRAY_HPP
 
+#include "ContainerStatistics.hpp"
+#include "DataStructuresErrorCategory.hpp"
+#include "DataTypeTraits.hpp"
+#include <Ishiko/Errors.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Ishiko
+{
+    // A growable array. The first InlineCapacity values are stored inside the object itself so short arrays don't
+    // allocate any memory.
+    //
+    // The values are moved to a new buffer when the array grows. If DataTypeTraits::trivially_relocatable is true
+    // this is done with memcpy, or realloc once the values are on the heap, otherwise each value is moved or copied
+    // individually.
+    template<typename DataType, size_t InlineCapacity = 4, typename DataTypeTraits = DataTypeTraits<DataType>>
+    class DynamicArray
+    {
+    public:
+        DynamicArray() noexcept;
+        DynamicArray(const DynamicArray& other) = delete;
+        DynamicArray& operator=(const DynamicArray& other) = delete;
+        ~DynamicArray() noexcept;
+
+        bool isEmpty() const noexcept;
+        size_t size() const noexcept;
+        size_t capacity() const noexcept;
+        const DataType* data() const noexcept;
+        DataType* data() noexcept;
+        const DataType& operator[](size_t index) const noexcept;
+        DataType& operator[](size_t index) noexcept;
+        const DataType& back() const noexcept;
+        DataType& back() noexcept;
+        const DataType* begin() const noexcept;
+        DataType* begin() noexcept;
+        const DataType* end() const noexcept;
+        DataType* end() noexcept;
+
+        void reserve(size_t capacity);
+        void reserve(size_t capacity, Error& error) noexcept;
+        // A snapshot of the memory the array holds, see ContainerStatistics. The spare bytes include the unused inline
+        // capacity.
+        ContainerStatistics statistics() const;
+        void pushBack(const DataType& value);
+        void pushBack(DataType&& value);
+        void pushBack(const DataType& value, Error& error) noexcept;
+        void pushBack(DataType&& value, Error& error) noexcept;
+        // Appends a value constructed in place from arguments
+        template<typename... Arguments>
+        void emplaceBack(Arguments&&... arguments);
+        void popBack() noexcept;
+        void erase(size_t index);
+        // Erases the values in [first, last)
+        void erase(size_t first, size_t last);
+        void clear() noexcept;
+        // Moves the values back to the inline storage, or to a heap buffer of the exact size, if that frees memory
+        void shrinkToFit();
+
+    private:
+        typedef typename std::aligned_storage<sizeof(DataType), std::alignment_of<DataType>::value>::type Storage;
+
+        DataType* inlineBuffer() noexcept;
+        bool isInline() const noexcept;
+        // Returns the index of value if it is one of the values of this array, or size() otherwise. Needed because
+        // growing the array invalidates value.
+        size_t indexOf(const DataType& value) const noexcept;
+        size_t grownCapacity(size_t minimum_capacity) const noexcept;
+        // Moves the values to a buffer that holds capacity values. Returns false and leaves the array unchanged if
+        // the memory can't be allocated or a value can't be copied.
+        bool reallocate(size_t capacity) noexcept;
+        static void Destroy(DataType* first, DataType* last) noexcept;
+
+        DataType* m_data;
+        size_t m_size = 0;
+        size_t m_capacity = InlineCapacity;
+        // An array can't have a size of 0 so there is one unused slot when InlineCapacity is 0
+        Storage m_inline_buffer[InlineCapacity ? InlineCapacity : 1];
+    };
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::DynamicArray() noexcept
+    : m_data(inlineBuffer())
+{
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::~DynamicArray() noexcept
+{
+    Destroy(m_data, m_data + m_size);
+    if (!isInline())
+    {
+        std::free(m_data);
+    }
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+bool Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::isEmpty() const noexcept
+{
+    return (m_size == 0);
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+size_t Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::size() const noexcept
+{
+    return m_size;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+size_t Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+const DataType* Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::data() const noexcept
+{
+    return m_data;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+DataType* Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::data() noexcept
+{
+    return m_data;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+const DataType& Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::operator[](size_t index) const noexcept
+{
+    return m_data[index];
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+DataType& Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::operator[](size_t index) noexcept
+{
+    return m_data[index];
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+const DataType& Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::back() const noexcept
+{
+    return m_data[m_size - 1];
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+DataType& Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::back() noexcept
+{
+    return m_data[m_size - 1];
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+const DataType* Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::begin() const noexcept
+{
+    return m_data;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+DataType* Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::begin() noexcept
+{
+    return m_data;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+const DataType* Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::end() const noexcept
+{
+    return (m_data + m_size);
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+DataType* Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::end() noexcept
+{
+    return (m_data + m_size);
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::reserve(size_t capacity)
+{
+    if ((capacity > m_capacity) && !reallocate(capacity))
+    {
+        throw std::bad_alloc();
+    }
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::reserve(size_t capacity, Error& error) noexcept
+{
+    if ((capacity > m_capacity) && !reallocate(capacity))
+    {
+        Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to grow dynamic array", __FILE__,
+            __LINE__, error);
+    }
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+Ishiko::ContainerStatistics
+Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::statistics() const
+{
+    ContainerStatistics statistics;
+    statistics.element_count = m_size;
+    statistics.element_bytes = (m_size * sizeof(DataType));
+    statistics.spare_bytes = ((m_capacity - m_size) * sizeof(DataType));
+    return statistics;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::pushBack(const DataType& value)
+{
+    const DataType* source = &value;
+    if (m_size == m_capacity)
+    {
+        size_t index = indexOf(value);
+        if (!reallocate(grownCapacity(m_size + 1)))
+        {
+            throw std::bad_alloc();
+        }
+        if (index != m_size)
+        {
+            source = m_data + index;
+        }
+    }
+    new(m_data + m_size) DataType(*source);
+    ++m_size;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::pushBack(DataType&& value)
+{
+    DataType* source = &value;
+    if (m_size == m_capacity)
+    {
+        size_t index = indexOf(value);
+        if (!reallocate(grownCapacity(m_size + 1)))
+        {
+            throw std::bad_alloc();
+        }
+        if (index != m_size)
+        {
+            source = m_data + index;
+        }
+    }
+    new(m_data + m_size) DataType(std::move(*source));
+    ++m_size;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::pushBack(const DataType& value,
+    Error& error) noexcept
+{
+    const DataType* source = &value;
+    if (m_size == m_capacity)
+    {
+        size_t index = indexOf(value);
+        if (!reallocate(grownCapacity(m_size + 1)))
+        {
+            Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to grow dynamic array", __FILE__,
+                __LINE__, error);
+            return;
+        }
+        if (index != m_size)
+        {
+            source = m_data + index;
+        }
+    }
+    DataType* new_value = new(m_data + m_size) DataType(DataTypeTraits::Copy(*source, error));
+    if (error)
+    {
+        new_value->~DataType();
+        return;
+    }
+    ++m_size;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::pushBack(DataType&& value, Error& error) noexcept
+{
+    DataType* source = &value;
+    if (m_size == m_capacity)
+    {
+        size_t index = indexOf(value);
+        if (!reallocate(grownCapacity(m_size + 1)))
+        {
+            Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to grow dynamic array", __FILE__,
+                __LINE__, error);
+            return;
+        }
+        if (index != m_size)
+        {
+            source = m_data + index;
+        }
+    }
+    DataType* new_value = new(m_data + m_size) DataType(DataTypeTraits::Move(std::move(*source), error));
+    if (error)
+    {
+        new_value->~DataType();
+        return;
+    }
+    ++m_size;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+template<typename... Arguments>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::emplaceBack(Arguments&&... arguments)
+{
+    if (m_size == m_capacity)
+    {
+        // The arguments may refer to values of this array and growing it would invalidate them, so the value is
+        // constructed first and then moved into place
+        DataType value(std::forward<Arguments>(arguments)...);
+        pushBack(std::move(value));
+        return;
+    }
+    new(m_data + m_size) DataType(std::forward<Arguments>(arguments)...);
+    ++m_size;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::popBack() noexcept
+{
+    --m_size;
+    m_data[m_size].~DataType();
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::erase(size_t index)
+{
+    erase(index, index + 1);
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::erase(size_t first, size_t last)
+{
+    if (first == last)
+    {
+        return;
+    }
+
+    if (DataTypeTraits::trivially_relocatable)
+    {
+        Destroy(m_data + first, m_data + last);
+        std::memmove(static_cast<void*>(m_data + first), static_cast<const void*>(m_data + last),
+            (m_size - last) * sizeof(DataType));
+    }
+    else
+    {
+        DataType* new_end = std::move(m_data + last, m_data + m_size, m_data + first);
+        Destroy(new_end, m_data + m_size);
+    }
+    m_size -= (last - first);
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::clear() noexcept
+{
+    Destroy(m_data, m_data + m_size);
+    m_size = 0;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::shrinkToFit()
+{
+    if (!isInline() && (m_size < m_capacity))
+    {
+        if (!reallocate((m_size > InlineCapacity) ? m_size : InlineCapacity))
+        {
+            throw std::bad_alloc();
+        }
+    }
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+DataType* Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::inlineBuffer() noexcept
+{
+    return reinterpret_cast<DataType*>(m_inline_buffer);
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+bool Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::isInline() const noexcept
+{
+    return (m_data == reinterpret_cast<const DataType*>(m_inline_buffer));
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+size_t Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::indexOf(const DataType& value) const noexcept
+{
+    // std::less gives a total order even for pointers that don't point into the same array
+    std::less<const DataType*> less;
+    if (!less(&value, m_data) && less(&value, m_data + m_size))
+    {
+        return static_cast<size_t>(&value - m_data);
+    }
+    return m_size;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+size_t
+Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::grownCapacity(size_t minimum_capacity) const noexcept
+{
+    size_t capacity = (m_capacity ? (2 * m_capacity) : 1);
+    return ((capacity > minimum_capacity) ? capacity : minimum_capacity);
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+bool Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::reallocate(size_t capacity) noexcept
+{
+    if (capacity > (static_cast<size_t>(-1) / sizeof(DataType)))
+    {
+        return false;
+    }
+
+    DataType* new_data;
+    if ((capacity <= InlineCapacity) && !isInline())
+    {
+        new_data = inlineBuffer();
+        capacity = InlineCapacity;
+    }
+    else if (DataTypeTraits::trivially_relocatable && !isInline())
+    {
+        // realloc can often grow the block in place and otherwise does the memcpy itself
+        void* memory = std::realloc(static_cast<void*>(m_data), capacity * sizeof(DataType));
+        if (!memory)
+        {
+            return false;
+        }
+        m_data = static_cast<DataType*>(memory);
+        m_capacity = capacity;
+        return true;
+    }
+    else
+    {
+        new_data = static_cast<DataType*>(std::malloc(capacity * sizeof(DataType)));
+        if (!new_data)
+        {
+            return false;
+        }
+    }
+
+    if (DataTypeTraits::trivially_relocatable)
+    {
+        std::memcpy(static_cast<void*>(new_data), static_cast<const void*>(m_data), m_size * sizeof(DataType));
+    }
+    else
+    {
+        size_t i = 0;
+        try
+        {
+            for (; i < m_size; ++i)
+            {
+                new(new_data + i) DataType(std::move_if_noexcept(m_data[i]));
+            }
+        }
+        catch (...)
+        {
+            Destroy(new_data, new_data + i);
+            if (new_data != inlineBuffer())
+            {
+                std::free(new_data);
+            }
+            return false;
+        }
+        Destroy(m_data, m_data + m_size);
+    }
+
+    if (!isInline())
+    {
+        std::free(m_data);
+    }
+    m_data = new_data;
+    m_capacity = capacity;
+    return true;
+}
+
+template<typename DataType, size_t InlineCapacity, typename DataTypeTraits>
+void Ishiko::DynamicArray<DataType, InlineCapacity, DataTypeTraits>::Destroy(DataType* first, DataType* last) noexcept
+{
+    if (!std::is_trivially_destructible<DataType>::value)
+    {
+        for (DataType* it = first; it != last; ++it)
+        {
+            it->~DataType();
+        }
+    }
+}
+
 #endif
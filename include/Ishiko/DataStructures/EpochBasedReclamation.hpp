@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_EPOCHBASEDRECLAMATION_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_EPOCHBASEDRECLAMATION_HPP
+
+namespace Ishiko
+{
+    // Process-wide epoch based reclamation for the lock-free containers.
+    //
+    // A thread accesses shared nodes only while it holds a Guard. Nodes that have been unlinked are passed to Retire
+    // instead of being deleted. They are deleted once the global epoch has advanced twice since they were retired,
+    // at which point no thread can still hold a reference to them.
+    class EpochBasedReclamation
+    {
+    public:
+        // Pins the calling thread to the current epoch for the lifetime of the guard. Guards can be nested.
+        //
+        // The first guard or call to Retire of a thread allocates the record that tracks the thread. If that
+        // allocation fails the guard still protects the thread but stops the epoch from advancing until it is
+        // destroyed, and the allocation is attempted again by the next guard.
+        class Guard
+        {
+        public:
+            Guard() noexcept;
+            Guard(const Guard& other) = delete;
+            Guard& operator=(const Guard& other) = delete;
+            ~Guard() noexcept;
+
+        private:
+            bool m_without_record;
+        };
+
+        // Schedules object for deletion by deleter once no thread can access it any longer. If the bookkeeping for
+        // the object can't be allocated the object is leaked rather than deleted early. The objects left behind by
+        // threads that have exited are deleted by Synchronize or by the next thread that retires objects.
+        static void Retire(void* object, void (*deleter)(void* object)) noexcept;
+
+        // Waits until all the objects retired so far can be deleted and deletes those retired by the calling thread
+        // and by threads that have exited. The calling thread must not hold a Guard.
+        static void Synchronize() noexcept;
+    };
+}
+
+#endif
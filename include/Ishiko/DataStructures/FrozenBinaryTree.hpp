@@ -0,0 +1,503 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_FROZENBINARYTREE_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_FROZENBINARYTREE_HPP
+
+#include "BinaryTreeBase.hpp"
+#include "ContainerStatistics.hpp"
+#include "DataStructuresErrorCategory.hpp"
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Ishiko
+{
+    // An immutable copy of a binary tree, as returned by BinaryTree::freeze(), for trees that are read much more
+    // often than they are modified.
+    //
+    // The nodes are stored in a single array in van Emde Boas order: the top half of the levels is laid out first,
+    // followed by each of the subtrees hanging below it, and each of these parts is laid out the same way
+    // recursively. Whatever the size of the cache lines or pages, a path from the root to a leaf then only touches
+    // O(log_B(n)) of them instead of one per level. The links are 32 bit offsets relative to the node so that a node
+    // holding an int is 16 bytes.
+    //
+    // The shape of the tree is kept as it is. The searches assume the tree is a binary search tree ordered by
+    // Compare, their result is meaningless otherwise. The iterators and the traversals work for any tree.
+    template<typename DataType, typename Compare = std::less<DataType>>
+    class FrozenBinaryTree
+    {
+    public:
+        class Node
+        {
+        public:
+            explicit Node(const DataType& data);
+
+            const Node* parentNode() const noexcept;
+            const Node* leftChildNode() const noexcept;
+            const Node* rightChildNode() const noexcept;
+
+            const DataType& data() const noexcept;
+
+        private:
+            friend class FrozenBinaryTree;
+
+            // An offset of 0 means there is no such node since a node can't be linked to itself
+            int32_t m_parent_offset = 0;
+            int32_t m_left_child_offset = 0;
+            int32_t m_right_child_offset = 0;
+            DataType m_data;
+        };
+
+        // Visits the nodes in inorder, see BinaryTree::ConstIterator
+        class ConstIterator
+        {
+        public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef DataType value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const DataType* pointer;
+            typedef const DataType& reference;
+
+            ConstIterator() noexcept = default;
+            ConstIterator(const FrozenBinaryTree* tree, const Node* node) noexcept;
+
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+            ConstIterator& operator++() noexcept;
+            ConstIterator operator++(int) noexcept;
+            ConstIterator& operator--() noexcept;
+            ConstIterator operator--(int) noexcept;
+            bool operator==(const ConstIterator& other) const noexcept;
+            bool operator!=(const ConstIterator& other) const noexcept;
+
+            const Node* node() const noexcept;
+
+        private:
+            const FrozenBinaryTree* m_tree = nullptr;
+            const Node* m_node = nullptr;
+        };
+
+        FrozenBinaryTree() = default;
+        // Copies the tree rooted at root_node. SourceNode must have the data(), parentNode(), leftChildNode() and
+        // rightChildNode() functions of BinaryTree::Node.
+        template<typename SourceNode>
+        explicit FrozenBinaryTree(const SourceNode* root_node, const Compare& compare = Compare());
+
+        bool isEmpty() const noexcept;
+        size_t size() const noexcept;
+        const Node* root() const noexcept;
+        ConstIterator begin() const noexcept;
+        ConstIterator end() const noexcept;
+
+        // The node holding a value equal to value, or nullptr if there is none
+        const Node* find(const DataType& value) const noexcept;
+        bool contains(const DataType& value) const noexcept;
+        // The first node, in inorder, whose value is not less than value, or nullptr if there is none
+        const Node* lowerBound(const DataType& value) const noexcept;
+        // The first node, in inorder, whose value is greater than value, or nullptr if there is none
+        const Node* upperBound(const DataType& value) const noexcept;
+
+        template<typename Callable>
+        void doInorderTraversal(Callable&& callable) const;
+
+        // See ContainerStatistics. element_bytes is the size of the array the nodes are stored in.
+        ContainerStatistics statistics() const;
+
+    private:
+        static const uint32_t no_node = std::numeric_limits<uint32_t>::max();
+
+        // The links of a node while the layout is computed, as indices in preorder
+        struct LayoutNode
+        {
+            uint32_t left_child;
+            uint32_t right_child;
+        };
+
+        // Appends to order the indices of the first height levels of the subtree rooted at root_node in van Emde
+        // Boas order. bottom_roots and stack are scratch space shared by the recursive calls.
+        static void Layout(const std::vector<LayoutNode>& layout_nodes, uint32_t root_node, size_t height,
+            std::vector<uint32_t>& order, std::vector<uint32_t>& bottom_roots,
+            std::vector<std::pair<uint32_t, size_t>>& stack);
+        static int32_t Offset(size_t from, size_t to) noexcept;
+
+        std::vector<Node> m_nodes;
+        Compare m_compare;
+    };
+}
+
+template<typename DataType, typename Compare>
+const uint32_t Ishiko::FrozenBinaryTree<DataType, Compare>::no_node;
+
+template<typename DataType, typename Compare>
+Ishiko::FrozenBinaryTree<DataType, Compare>::Node::Node(const DataType& data)
+    : m_data(data)
+{
+}
+
+template<typename DataType, typename Compare>
+const typename Ishiko::FrozenBinaryTree<DataType, Compare>::Node*
+Ishiko::FrozenBinaryTree<DataType, Compare>::Node::parentNode() const noexcept
+{
+    return (m_parent_offset ? (this + m_parent_offset) : nullptr);
+}
+
+template<typename DataType, typename Compare>
+const typename Ishiko::FrozenBinaryTree<DataType, Compare>::Node*
+Ishiko::FrozenBinaryTree<DataType, Compare>::Node::leftChildNode() const noexcept
+{
+    return (m_left_child_offset ? (this + m_left_child_offset) : nullptr);
+}
+
+template<typename DataType, typename Compare>
+const typename Ishiko::FrozenBinaryTree<DataType, Compare>::Node*
+Ishiko::FrozenBinaryTree<DataType, Compare>::Node::rightChildNode() const noexcept
+{
+    return (m_right_child_offset ? (this + m_right_child_offset) : nullptr);
+}
+
+template<typename DataType, typename Compare>
+const DataType& Ishiko::FrozenBinaryTree<DataType, Compare>::Node::data() const noexcept
+{
+    return m_data;
+}
+
+template<typename DataType, typename Compare>
+Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::ConstIterator(const FrozenBinaryTree* tree,
+    const Node* node) noexcept
+    : m_tree(tree), m_node(node)
+{
+}
+
+template<typename DataType, typename Compare>
+typename Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::reference
+Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::operator*() const noexcept
+{
+    return m_node->data();
+}
+
+template<typename DataType, typename Compare>
+typename Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::pointer
+Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::operator->() const noexcept
+{
+    return &m_node->data();
+}
+
+template<typename DataType, typename Compare>
+typename Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator&
+Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::operator++() noexcept
+{
+    m_node = BinaryTreeBase<Node>::NextInorderNode(m_node);
+    return *this;
+}
+
+template<typename DataType, typename Compare>
+typename Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator
+Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::operator++(int) noexcept
+{
+    ConstIterator result = *this;
+    m_node = BinaryTreeBase<Node>::NextInorderNode(m_node);
+    return result;
+}
+
+template<typename DataType, typename Compare>
+typename Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator&
+Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::operator--() noexcept
+{
+    if (m_node)
+    {
+        m_node = BinaryTreeBase<Node>::PreviousInorderNode(m_node);
+    }
+    else
+    {
+        m_node = BinaryTreeBase<Node>::LastInorderNode(m_tree->root());
+    }
+    return *this;
+}
+
+template<typename DataType, typename Compare>
+typename Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator
+Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::operator--(int) noexcept
+{
+    ConstIterator result = *this;
+    --*this;
+    return result;
+}
+
+template<typename DataType, typename Compare>
+bool Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::operator==(const ConstIterator& other) const noexcept
+{
+    return (m_node == other.m_node);
+}
+
+template<typename DataType, typename Compare>
+bool Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::operator!=(const ConstIterator& other) const noexcept
+{
+    return (m_node != other.m_node);
+}
+
+template<typename DataType, typename Compare>
+const typename Ishiko::FrozenBinaryTree<DataType, Compare>::Node*
+Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator::node() const noexcept
+{
+    return m_node;
+}
+
+template<typename DataType, typename Compare>
+template<typename SourceNode>
+Ishiko::FrozenBinaryTree<DataType, Compare>::FrozenBinaryTree(const SourceNode* root_node, const Compare& compare)
+    : m_compare(compare)
+{
+    if (!root_node)
+    {
+        return;
+    }
+
+    // Number the nodes in preorder. The stack holds the path from root_node to the current node, its size is the
+    // depth of the node.
+    std::vector<const SourceNode*> source_nodes;
+    std::vector<LayoutNode> layout_nodes;
+    std::vector<uint32_t> stack;
+    size_t height = 0;
+    const SourceNode* node = root_node;
+    while (node)
+    {
+        if (source_nodes.size() == static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+        {
+            Throw(DataStructuresErrorCategory::Value::generic_error, "Binary tree is too large to be frozen", __FILE__,
+                __LINE__);
+        }
+
+        uint32_t index = static_cast<uint32_t>(source_nodes.size());
+        while (!stack.empty() && (source_nodes[stack.back()] != node->parentNode()))
+        {
+            stack.pop_back();
+        }
+        if (!stack.empty())
+        {
+            LayoutNode& parent_node = layout_nodes[stack.back()];
+            if (source_nodes[stack.back()]->leftChildNode() == node)
+            {
+                parent_node.left_child = index;
+            }
+            else
+            {
+                parent_node.right_child = index;
+            }
+        }
+        source_nodes.push_back(node);
+        LayoutNode layout_node = { no_node, no_node };
+        layout_nodes.push_back(layout_node);
+        stack.push_back(index);
+        if (stack.size() > height)
+        {
+            height = stack.size();
+        }
+
+        node = BinaryTreeBase<SourceNode>::NextPreorderNode(node, root_node);
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(layout_nodes.size());
+    std::vector<uint32_t> bottom_roots;
+    std::vector<std::pair<uint32_t, size_t>> layout_stack;
+    Layout(layout_nodes, 0, height, order, bottom_roots, layout_stack);
+
+    // The parents come before their children in the layout so the links can be set as the nodes are copied
+    std::vector<uint32_t> positions(layout_nodes.size());
+    m_nodes.reserve(order.size());
+    for (size_t position = 0; position < order.size(); ++position)
+    {
+        uint32_t index = order[position];
+        positions[index] = static_cast<uint32_t>(position);
+        m_nodes.emplace_back(source_nodes[index]->data());
+    }
+    for (size_t position = 0; position < order.size(); ++position)
+    {
+        const LayoutNode& layout_node = layout_nodes[order[position]];
+        if (layout_node.left_child != no_node)
+        {
+            size_t child_position = positions[layout_node.left_child];
+            m_nodes[position].m_left_child_offset = Offset(position, child_position);
+            m_nodes[child_position].m_parent_offset = Offset(child_position, position);
+        }
+        if (layout_node.right_child != no_node)
+        {
+            size_t child_position = positions[layout_node.right_child];
+            m_nodes[position].m_right_child_offset = Offset(position, child_position);
+            m_nodes[child_position].m_parent_offset = Offset(child_position, position);
+        }
+    }
+}
+
+template<typename DataType, typename Compare>
+bool Ishiko::FrozenBinaryTree<DataType, Compare>::isEmpty() const noexcept
+{
+    return m_nodes.empty();
+}
+
+template<typename DataType, typename Compare>
+size_t Ishiko::FrozenBinaryTree<DataType, Compare>::size() const noexcept
+{
+    return m_nodes.size();
+}
+
+template<typename DataType, typename Compare>
+const typename Ishiko::FrozenBinaryTree<DataType, Compare>::Node*
+Ishiko::FrozenBinaryTree<DataType, Compare>::root() const noexcept
+{
+    // The root is always the first node of the layout
+    return (m_nodes.empty() ? nullptr : m_nodes.data());
+}
+
+template<typename DataType, typename Compare>
+typename Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator
+Ishiko::FrozenBinaryTree<DataType, Compare>::begin() const noexcept
+{
+    const Node* root_node = root();
+    return ConstIterator(this, (root_node ? BinaryTreeBase<Node>::FirstInorderNode(root_node) : nullptr));
+}
+
+template<typename DataType, typename Compare>
+typename Ishiko::FrozenBinaryTree<DataType, Compare>::ConstIterator
+Ishiko::FrozenBinaryTree<DataType, Compare>::end() const noexcept
+{
+    return ConstIterator(this, nullptr);
+}
+
+template<typename DataType, typename Compare>
+const typename Ishiko::FrozenBinaryTree<DataType, Compare>::Node*
+Ishiko::FrozenBinaryTree<DataType, Compare>::find(const DataType& value) const noexcept
+{
+    const Node* node = lowerBound(value);
+    if (node && !m_compare(value, node->m_data))
+    {
+        return node;
+    }
+    return nullptr;
+}
+
+template<typename DataType, typename Compare>
+bool Ishiko::FrozenBinaryTree<DataType, Compare>::contains(const DataType& value) const noexcept
+{
+    return (find(value) != nullptr);
+}
+
+template<typename DataType, typename Compare>
+const typename Ishiko::FrozenBinaryTree<DataType, Compare>::Node*
+Ishiko::FrozenBinaryTree<DataType, Compare>::lowerBound(const DataType& value) const noexcept
+{
+    // The direction taken at each level can't be predicted so it selects the offset to follow rather than branching
+    // on it, which lets the compiler use conditional moves. The only branch left is the end of the path.
+    const Node* result = nullptr;
+    const Node* node = root();
+    while (node)
+    {
+        bool go_right = m_compare(node->m_data, value);
+        result = (go_right ? result : node);
+        int32_t offset = (go_right ? node->m_right_child_offset : node->m_left_child_offset);
+        node = (offset ? (node + offset) : nullptr);
+    }
+    return result;
+}
+
+template<typename DataType, typename Compare>
+const typename Ishiko::FrozenBinaryTree<DataType, Compare>::Node*
+Ishiko::FrozenBinaryTree<DataType, Compare>::upperBound(const DataType& value) const noexcept
+{
+    // See lowerBound
+    const Node* result = nullptr;
+    const Node* node = root();
+    while (node)
+    {
+        bool go_left = m_compare(value, node->m_data);
+        result = (go_left ? node : result);
+        int32_t offset = (go_left ? node->m_left_child_offset : node->m_right_child_offset);
+        node = (offset ? (node + offset) : nullptr);
+    }
+    return result;
+}
+
+template<typename DataType, typename Compare>
+template<typename Callable>
+void Ishiko::FrozenBinaryTree<DataType, Compare>::doInorderTraversal(Callable&& callable) const
+{
+    const Node* node = root();
+    if (node)
+    {
+        node = BinaryTreeBase<Node>::FirstInorderNode(node);
+    }
+    while (node)
+    {
+        callable(node->data());
+        node = BinaryTreeBase<Node>::NextInorderNode(node);
+    }
+}
+
+template<typename DataType, typename Compare>
+Ishiko::ContainerStatistics Ishiko::FrozenBinaryTree<DataType, Compare>::statistics() const
+{
+    ContainerStatistics statistics;
+    AddTreeStatistics(root(), sizeof(Node), statistics);
+    statistics.spare_bytes = ((m_nodes.capacity() - m_nodes.size()) * sizeof(Node));
+    return statistics;
+}
+
+template<typename DataType, typename Compare>
+void Ishiko::FrozenBinaryTree<DataType, Compare>::Layout(const std::vector<LayoutNode>& layout_nodes,
+    uint32_t root_node, size_t height, std::vector<uint32_t>& order, std::vector<uint32_t>& bottom_roots,
+    std::vector<std::pair<uint32_t, size_t>>& stack)
+{
+    if (height == 1)
+    {
+        order.push_back(root_node);
+        return;
+    }
+
+    size_t top_height = (height / 2);
+    Layout(layout_nodes, root_node, top_height, order, bottom_roots, stack);
+
+    // Collect the roots of the bottom subtrees, from left to right. The recursive calls below append their own
+    // roots after ours and remove them before returning.
+    size_t first_bottom_root = bottom_roots.size();
+    stack.push_back(std::make_pair(root_node, 0));
+    while (!stack.empty())
+    {
+        uint32_t node = stack.back().first;
+        size_t depth = stack.back().second;
+        stack.pop_back();
+        if (depth == top_height)
+        {
+            bottom_roots.push_back(node);
+            continue;
+        }
+        if (layout_nodes[node].right_child != no_node)
+        {
+            stack.push_back(std::make_pair(layout_nodes[node].right_child, depth + 1));
+        }
+        if (layout_nodes[node].left_child != no_node)
+        {
+            stack.push_back(std::make_pair(layout_nodes[node].left_child, depth + 1));
+        }
+    }
+
+    size_t last_bottom_root = bottom_roots.size();
+    for (size_t i = first_bottom_root; i < last_bottom_root; ++i)
+    {
+        Layout(layout_nodes, bottom_roots[i], (height - top_height), order, bottom_roots, stack);
+    }
+    bottom_roots.resize(first_bottom_root);
+}
+
+template<typename DataType, typename Compare>
+int32_t Ishiko::FrozenBinaryTree<DataType, Compare>::Offset(size_t from, size_t to) noexcept
+{
+    return static_cast<int32_t>(static_cast<ptrdiff_t>(to) - static_cast<ptrdiff_t>(from));
+}
+
+#endif
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_GEOMETRICLEVELGENERATOR_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_GEOMETRICLEVELGENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Ishiko
+{
+    // Generates skip list node heights. A node gets more than k levels with probability p^k where
+    // p = 1 / 2^ProbabilityShift, so the default of 1 gives the usual p = 1/2.
+    //
+    // Each height costs a single xorshift64* step and a count of the trailing zero bits of the result, every
+    // ProbabilityShift zero bits adding a level. The state is per instance so it isn't safe to share a generator
+    // between threads.
+    template<unsigned int ProbabilityShift = 1>
+    class GeometricLevelGenerator
+    {
+    public:
+        static const uint64_t default_seed = 0x9E3779B97F4A7C15ull;
+
+        explicit GeometricLevelGenerator(size_t max_levels = 32, uint64_t seed = default_seed) noexcept;
+
+        size_t operator()() noexcept;
+
+    private:
+        static unsigned int CountTrailingZeros(uint64_t value) noexcept;
+
+        uint64_t m_state;
+        size_t m_max_levels;
+    };
+}
+
+template<unsigned int ProbabilityShift>
+const uint64_t Ishiko::GeometricLevelGenerator<ProbabilityShift>::default_seed;
+
+template<unsigned int ProbabilityShift>
+Ishiko::GeometricLevelGenerator<ProbabilityShift>::GeometricLevelGenerator(size_t max_levels, uint64_t seed) noexcept
+    : m_state(seed ? seed : default_seed), m_max_levels(max_levels ? max_levels : 1)
+{
+    static_assert(ProbabilityShift > 0, "ProbabilityShift must be at least 1");
+}
+
+template<unsigned int ProbabilityShift>
+size_t Ishiko::GeometricLevelGenerator<ProbabilityShift>::operator()() noexcept
+{
+    m_state ^= m_state >> 12;
+    m_state ^= m_state << 25;
+    m_state ^= m_state >> 27;
+    uint64_t bits = m_state * 0x2545F4914F6CDD1Dull;
+
+    // Setting the top bit bounds the count and avoids the undefined result for 0
+    size_t levels = 1 + (CountTrailingZeros(bits | (1ull << 63)) / ProbabilityShift);
+    return ((levels < m_max_levels) ? levels : m_max_levels);
+}
+
+template<unsigned int ProbabilityShift>
+unsigned int Ishiko::GeometricLevelGenerator<ProbabilityShift>::CountTrailingZeros(uint64_t value) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctzll(value));
+#endif
+}
+
+#endif
@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_INPLACE_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_INPLACE_HPP
+
+namespace Ishiko
+{
+    // Selects the node constructors that construct the data in place from the arguments of an emplace function
+    // instead of copying or moving an existing value.
+    struct InPlace
+    {
+    };
+}
+
+#endif
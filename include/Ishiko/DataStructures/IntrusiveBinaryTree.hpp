@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_INTRUSIVEBINARYTREE_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_INTRUSIVEBINARYTREE_HPP
+
+#include "BinaryTreeBase.hpp"
+#include <utility>
+
+namespace Ishiko
+{
+    template<class T, class Tag>
+    class IntrusiveBinaryTree;
+
+    // The links an object needs to be in an IntrusiveBinaryTree. T derives publicly from this class, once per tree
+    // the object can be in at the same time with a different Tag for each. The links belong to the tree so they
+    // aren't copied along with the object.
+    template<class T, class Tag = void>
+    class BinaryTreeHook
+    {
+    public:
+        BinaryTreeHook() noexcept = default;
+        BinaryTreeHook(const BinaryTreeHook& other) noexcept;
+        BinaryTreeHook& operator=(const BinaryTreeHook& other) noexcept;
+
+    private:
+        friend class BinaryTreeBase<BinaryTreeHook>;
+        friend class IntrusiveBinaryTree<T, Tag>;
+
+        const BinaryTreeHook* parentNode() const noexcept;
+        BinaryTreeHook* parentNode() noexcept;
+        void setParentNode(BinaryTreeHook* node) noexcept;
+        const BinaryTreeHook* leftChildNode() const noexcept;
+        BinaryTreeHook* leftChildNode() noexcept;
+        void setLeftChildNode(BinaryTreeHook* node) noexcept;
+        const BinaryTreeHook* rightChildNode() const noexcept;
+        BinaryTreeHook* rightChildNode() noexcept;
+        void setRightChildNode(BinaryTreeHook* node) noexcept;
+
+        const T& data() const noexcept;
+        T& data() noexcept;
+
+        BinaryTreeHook* m_parent_node = nullptr;
+        BinaryTreeHook* m_left_child_node = nullptr;
+        BinaryTreeHook* m_right_child_node = nullptr;
+    };
+
+    // A binary tree of objects it doesn't own. The link pointers are stored in the objects themselves, see
+    // BinaryTreeHook, so linking an object never allocates and traversing the tree only touches the objects. An
+    // object must stay at the same address while it is in a tree and it can only be in one tree per hook.
+    template<class T, class Tag = void>
+    class IntrusiveBinaryTree
+    {
+    public:
+        typedef BinaryTreeHook<T, Tag> Hook;
+
+        IntrusiveBinaryTree() noexcept = default;
+        IntrusiveBinaryTree(const IntrusiveBinaryTree& other) = delete;
+        IntrusiveBinaryTree& operator=(const IntrusiveBinaryTree& other) = delete;
+
+        bool isEmpty() const noexcept;
+        T* root() noexcept;
+        // The parent and children of node, or nullptr if there is none
+        static T* ParentNode(T* node) noexcept;
+        static T* LeftChildNode(T* node) noexcept;
+        static T* RightChildNode(T* node) noexcept;
+
+        // See BinaryTreeBase for the traversals
+        template<typename Callable>
+        void doInorderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doPreorderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doPostorderTraversal(Callable&& callable) const;
+        template<typename Callable>
+        void doLevelOrderTraversal(Callable&& callable) const;
+
+        // Makes node the root of the tree, which must be empty
+        void setRoot(T* node) noexcept;
+        void insertLeft(T* node, T* parent_node) noexcept;
+        void insertRight(T* node, T* parent_node) noexcept;
+        // Unlinks all the objects. The objects themselves are not visited so this doesn't depend on the size of the
+        // tree.
+        void clear() noexcept;
+
+        void rotateLeft(T* node);
+        void rotateRight(T* node);
+
+    private:
+        static Hook* ToHook(T* node) noexcept;
+        static T* ToNode(Hook* hook) noexcept;
+
+        BinaryTreeBase<Hook> m_tree_impl;
+    };
+}
+
+template<class T, class Tag>
+Ishiko::BinaryTreeHook<T, Tag>::BinaryTreeHook(const BinaryTreeHook&) noexcept
+{
+}
+
+template<class T, class Tag>
+Ishiko::BinaryTreeHook<T, Tag>& Ishiko::BinaryTreeHook<T, Tag>::operator=(const BinaryTreeHook&) noexcept
+{
+    return *this;
+}
+
+template<class T, class Tag>
+const Ishiko::BinaryTreeHook<T, Tag>* Ishiko::BinaryTreeHook<T, Tag>::parentNode() const noexcept
+{
+    return m_parent_node;
+}
+
+template<class T, class Tag>
+Ishiko::BinaryTreeHook<T, Tag>* Ishiko::BinaryTreeHook<T, Tag>::parentNode() noexcept
+{
+    return m_parent_node;
+}
+
+template<class T, class Tag>
+void Ishiko::BinaryTreeHook<T, Tag>::setParentNode(BinaryTreeHook* node) noexcept
+{
+    m_parent_node = node;
+}
+
+template<class T, class Tag>
+const Ishiko::BinaryTreeHook<T, Tag>* Ishiko::BinaryTreeHook<T, Tag>::leftChildNode() const noexcept
+{
+    return m_left_child_node;
+}
+
+template<class T, class Tag>
+Ishiko::BinaryTreeHook<T, Tag>* Ishiko::BinaryTreeHook<T, Tag>::leftChildNode() noexcept
+{
+    return m_left_child_node;
+}
+
+template<class T, class Tag>
+void Ishiko::BinaryTreeHook<T, Tag>::setLeftChildNode(BinaryTreeHook* node) noexcept
+{
+    m_left_child_node = node;
+}
+
+template<class T, class Tag>
+const Ishiko::BinaryTreeHook<T, Tag>* Ishiko::BinaryTreeHook<T, Tag>::rightChildNode() const noexcept
+{
+    return m_right_child_node;
+}
+
+template<class T, class Tag>
+Ishiko::BinaryTreeHook<T, Tag>* Ishiko::BinaryTreeHook<T, Tag>::rightChildNode() noexcept
+{
+    return m_right_child_node;
+}
+
+template<class T, class Tag>
+void Ishiko::BinaryTreeHook<T, Tag>::setRightChildNode(BinaryTreeHook* node) noexcept
+{
+    m_right_child_node = node;
+}
+
+template<class T, class Tag>
+const T& Ishiko::BinaryTreeHook<T, Tag>::data() const noexcept
+{
+    return static_cast<const T&>(*this);
+}
+
+template<class T, class Tag>
+T& Ishiko::BinaryTreeHook<T, Tag>::data() noexcept
+{
+    return static_cast<T&>(*this);
+}
+
+template<class T, class Tag>
+bool Ishiko::IntrusiveBinaryTree<T, Tag>::isEmpty() const noexcept
+{
+    return m_tree_impl.isEmpty();
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveBinaryTree<T, Tag>::root() noexcept
+{
+    return ToNode(m_tree_impl.root());
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveBinaryTree<T, Tag>::ParentNode(T* node) noexcept
+{
+    return ToNode(ToHook(node)->parentNode());
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveBinaryTree<T, Tag>::LeftChildNode(T* node) noexcept
+{
+    return ToNode(ToHook(node)->leftChildNode());
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveBinaryTree<T, Tag>::RightChildNode(T* node) noexcept
+{
+    return ToNode(ToHook(node)->rightChildNode());
+}
+
+template<class T, class Tag>
+template<typename Callable>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::doInorderTraversal(Callable&& callable) const
+{
+    m_tree_impl.doInorderTraversal(std::forward<Callable>(callable));
+}
+
+template<class T, class Tag>
+template<typename Callable>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::doPreorderTraversal(Callable&& callable) const
+{
+    m_tree_impl.doPreorderTraversal(std::forward<Callable>(callable));
+}
+
+template<class T, class Tag>
+template<typename Callable>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::doPostorderTraversal(Callable&& callable) const
+{
+    m_tree_impl.doPostorderTraversal(std::forward<Callable>(callable));
+}
+
+template<class T, class Tag>
+template<typename Callable>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::doLevelOrderTraversal(Callable&& callable) const
+{
+    m_tree_impl.doLevelOrderTraversal(std::forward<Callable>(callable));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::setRoot(T* node) noexcept
+{
+    Hook* hook = ToHook(node);
+    hook->setParentNode(nullptr);
+    hook->setLeftChildNode(nullptr);
+    hook->setRightChildNode(nullptr);
+    m_tree_impl.setRoot(hook);
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::insertLeft(T* node, T* parent_node) noexcept
+{
+    m_tree_impl.insertLeft(ToHook(node), ToHook(parent_node));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::insertRight(T* node, T* parent_node) noexcept
+{
+    m_tree_impl.insertRight(ToHook(node), ToHook(parent_node));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::clear() noexcept
+{
+    m_tree_impl.setRoot(nullptr);
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::rotateLeft(T* node)
+{
+    m_tree_impl.rotateLeft(ToHook(node));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveBinaryTree<T, Tag>::rotateRight(T* node)
+{
+    m_tree_impl.rotateRight(ToHook(node));
+}
+
+template<class T, class Tag>
+typename Ishiko::IntrusiveBinaryTree<T, Tag>::Hook* Ishiko::IntrusiveBinaryTree<T, Tag>::ToHook(T* node) noexcept
+{
+    return static_cast<Hook*>(node);
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveBinaryTree<T, Tag>::ToNode(Hook* hook) noexcept
+{
+    // static_cast maps nullptr to nullptr
+    return static_cast<T*>(hook);
+}
+
+#endif
@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_INTRUSIVEDOUBLYLINKEDLIST_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_INTRUSIVEDOUBLYLINKEDLIST_HPP
+
+#include "DoublyLinkedListBase.hpp"
+#include <utility>
+
+namespace Ishiko
+{
+    template<class T, class Tag>
+    class IntrusiveDoublyLinkedList;
+
+    // The links an object needs to be in an IntrusiveDoublyLinkedList. T derives publicly from this class, once per
+    // list the object can be in at the same time with a different Tag for each. The links belong to the list so they
+    // aren't copied along with the object.
+    template<class T, class Tag = void>
+    class DoublyLinkedListHook
+    {
+    public:
+        DoublyLinkedListHook() noexcept = default;
+        DoublyLinkedListHook(const DoublyLinkedListHook& other) noexcept;
+        DoublyLinkedListHook& operator=(const DoublyLinkedListHook& other) noexcept;
+
+    private:
+        friend class DoublyLinkedListBase<DoublyLinkedListHook>;
+        friend class IntrusiveDoublyLinkedList<T, Tag>;
+
+        const DoublyLinkedListHook* previousNode() const noexcept;
+        DoublyLinkedListHook* previousNode() noexcept;
+        void setPreviousNode(DoublyLinkedListHook* node) noexcept;
+        const DoublyLinkedListHook* nextNode() const noexcept;
+        DoublyLinkedListHook* nextNode() noexcept;
+        void setNextNode(DoublyLinkedListHook* node) noexcept;
+
+        const T& data() const noexcept;
+        T& data() noexcept;
+
+        DoublyLinkedListHook* m_previous_node = nullptr;
+        DoublyLinkedListHook* m_next_node = nullptr;
+    };
+
+    // A doubly linked list of objects it doesn't own. The link pointers are stored in the objects themselves, see
+    // DoublyLinkedListHook, so linking and unlinking an object never allocates and traversing the list only touches
+    // the objects. An object must stay at the same address while it is in a list and it can only be in one list per
+    // hook.
+    template<class T, class Tag = void>
+    class IntrusiveDoublyLinkedList
+    {
+    public:
+        typedef DoublyLinkedListHook<T, Tag> Hook;
+
+        IntrusiveDoublyLinkedList() noexcept = default;
+        IntrusiveDoublyLinkedList(const IntrusiveDoublyLinkedList& other) = delete;
+        IntrusiveDoublyLinkedList& operator=(const IntrusiveDoublyLinkedList& other) = delete;
+
+        bool isEmpty() const noexcept;
+        T* head() noexcept;
+        // The objects before and after node, or nullptr if node is the first or last one
+        static T* PreviousNode(T* node) noexcept;
+        static T* NextNode(T* node) noexcept;
+
+        template<typename Callable>
+        void traverse(Callable&& callable) const;
+
+        void pushFront(T* node) noexcept;
+        void insertAfter(T* node, T* previous_node) noexcept;
+        void insertBefore(T* node, T* next_node) noexcept;
+        // Unlinks node, which must be in this list, in constant time
+        void erase(T* node) noexcept;
+        // Unlinks all the objects. The objects themselves are not visited so this doesn't depend on the size of the
+        // list.
+        void clear() noexcept;
+
+    private:
+        static Hook* ToHook(T* node) noexcept;
+        static T* ToNode(Hook* hook) noexcept;
+
+        DoublyLinkedListBase<Hook> m_list_impl;
+    };
+}
+
+template<class T, class Tag>
+Ishiko::DoublyLinkedListHook<T, Tag>::DoublyLinkedListHook(const DoublyLinkedListHook&) noexcept
+{
+}
+
+template<class T, class Tag>
+Ishiko::DoublyLinkedListHook<T, Tag>& Ishiko::DoublyLinkedListHook<T, Tag>::operator=(
+    const DoublyLinkedListHook&) noexcept
+{
+    return *this;
+}
+
+template<class T, class Tag>
+const Ishiko::DoublyLinkedListHook<T, Tag>* Ishiko::DoublyLinkedListHook<T, Tag>::previousNode() const noexcept
+{
+    return m_previous_node;
+}
+
+template<class T, class Tag>
+Ishiko::DoublyLinkedListHook<T, Tag>* Ishiko::DoublyLinkedListHook<T, Tag>::previousNode() noexcept
+{
+    return m_previous_node;
+}
+
+template<class T, class Tag>
+void Ishiko::DoublyLinkedListHook<T, Tag>::setPreviousNode(DoublyLinkedListHook* node) noexcept
+{
+    m_previous_node = node;
+}
+
+template<class T, class Tag>
+const Ishiko::DoublyLinkedListHook<T, Tag>* Ishiko::DoublyLinkedListHook<T, Tag>::nextNode() const noexcept
+{
+    return m_next_node;
+}
+
+template<class T, class Tag>
+Ishiko::DoublyLinkedListHook<T, Tag>* Ishiko::DoublyLinkedListHook<T, Tag>::nextNode() noexcept
+{
+    return m_next_node;
+}
+
+template<class T, class Tag>
+void Ishiko::DoublyLinkedListHook<T, Tag>::setNextNode(DoublyLinkedListHook* node) noexcept
+{
+    m_next_node = node;
+}
+
+template<class T, class Tag>
+const T& Ishiko::DoublyLinkedListHook<T, Tag>::data() const noexcept
+{
+    return static_cast<const T&>(*this);
+}
+
+template<class T, class Tag>
+T& Ishiko::DoublyLinkedListHook<T, Tag>::data() noexcept
+{
+    return static_cast<T&>(*this);
+}
+
+template<class T, class Tag>
+bool Ishiko::IntrusiveDoublyLinkedList<T, Tag>::isEmpty() const noexcept
+{
+    return m_list_impl.isEmpty();
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveDoublyLinkedList<T, Tag>::head() noexcept
+{
+    return ToNode(m_list_impl.head());
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveDoublyLinkedList<T, Tag>::PreviousNode(T* node) noexcept
+{
+    return ToNode(ToHook(node)->previousNode());
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveDoublyLinkedList<T, Tag>::NextNode(T* node) noexcept
+{
+    return ToNode(ToHook(node)->nextNode());
+}
+
+template<class T, class Tag>
+template<typename Callable>
+void Ishiko::IntrusiveDoublyLinkedList<T, Tag>::traverse(Callable&& callable) const
+{
+    m_list_impl.traverse(std::forward<Callable>(callable));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveDoublyLinkedList<T, Tag>::pushFront(T* node) noexcept
+{
+    m_list_impl.pushFront(ToHook(node));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveDoublyLinkedList<T, Tag>::insertAfter(T* node, T* previous_node) noexcept
+{
+    m_list_impl.insertAfter(ToHook(node), ToHook(previous_node));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveDoublyLinkedList<T, Tag>::insertBefore(T* node, T* next_node) noexcept
+{
+    m_list_impl.insertBefore(ToHook(node), ToHook(next_node));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveDoublyLinkedList<T, Tag>::erase(T* node) noexcept
+{
+    m_list_impl.remove(ToHook(node));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveDoublyLinkedList<T, Tag>::clear() noexcept
+{
+    m_list_impl.clear();
+}
+
+template<class T, class Tag>
+typename Ishiko::IntrusiveDoublyLinkedList<T, Tag>::Hook* Ishiko::IntrusiveDoublyLinkedList<T, Tag>::ToHook(
+    T* node) noexcept
+{
+    return static_cast<Hook*>(node);
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveDoublyLinkedList<T, Tag>::ToNode(Hook* hook) noexcept
+{
+    // static_cast maps nullptr to nullptr
+    return static_cast<T*>(hook);
+}
+
+#endif
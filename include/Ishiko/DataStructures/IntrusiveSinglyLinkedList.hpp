@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_INTRUSIVESINGLYLINKEDLIST_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_INTRUSIVESINGLYLINKEDLIST_HPP
+
+#include "SinglyLinkedListBase.hpp"
+#include <utility>
+
+namespace Ishiko
+{
+    template<class T, class Tag>
+    class IntrusiveSinglyLinkedList;
+
+    // The link an object needs to be in an IntrusiveSinglyLinkedList. T derives publicly from this class, once per
+    // list the object can be in at the same time with a different Tag for each. The link belongs to the list so it
+    // isn't copied along with the object.
+    template<class T, class Tag = void>
+    class SinglyLinkedListHook
+    {
+    public:
+        SinglyLinkedListHook() noexcept = default;
+        SinglyLinkedListHook(const SinglyLinkedListHook& other) noexcept;
+        SinglyLinkedListHook& operator=(const SinglyLinkedListHook& other) noexcept;
+
+    private:
+        friend class SinglyLinkedListBase<SinglyLinkedListHook>;
+        friend class IntrusiveSinglyLinkedList<T, Tag>;
+
+        const SinglyLinkedListHook* nextNode() const noexcept;
+        SinglyLinkedListHook* nextNode() noexcept;
+        void setNextNode(SinglyLinkedListHook* node) noexcept;
+
+        const T& data() const noexcept;
+        T& data() noexcept;
+
+        SinglyLinkedListHook* m_next_node = nullptr;
+    };
+
+    // A singly linked list of objects it doesn't own. The link pointers are stored in the objects themselves, see
+    // SinglyLinkedListHook, so linking and unlinking an object never allocates and traversing the list only touches
+    // the objects. An object must stay at the same address while it is in a list and it can only be in one list per
+    // hook.
+    template<class T, class Tag = void>
+    class IntrusiveSinglyLinkedList
+    {
+    public:
+        typedef SinglyLinkedListHook<T, Tag> Hook;
+
+        IntrusiveSinglyLinkedList() noexcept = default;
+        IntrusiveSinglyLinkedList(const IntrusiveSinglyLinkedList& other) = delete;
+        IntrusiveSinglyLinkedList& operator=(const IntrusiveSinglyLinkedList& other) = delete;
+
+        bool isEmpty() const noexcept;
+        T* head() noexcept;
+        // The object after node, or nullptr if node is the last one
+        static T* NextNode(T* node) noexcept;
+
+        template<typename Callable>
+        void traverse(Callable&& callable) const;
+
+        void pushFront(T* node) noexcept;
+        void insert(T* node, T* previous_node) noexcept;
+        // Unlinks the first object and returns it, or returns nullptr if the list is empty
+        T* popFront() noexcept;
+        // Unlinks the object after previous_node and returns it, or returns nullptr if previous_node is the last one
+        T* eraseAfter(T* previous_node) noexcept;
+        // Unlinks all the objects. The objects themselves are not visited so this doesn't depend on the size of the
+        // list.
+        void clear() noexcept;
+
+    private:
+        static Hook* ToHook(T* node) noexcept;
+        static T* ToNode(Hook* hook) noexcept;
+
+        SinglyLinkedListBase<Hook> m_list_impl;
+    };
+}
+
+template<class T, class Tag>
+Ishiko::SinglyLinkedListHook<T, Tag>::SinglyLinkedListHook(const SinglyLinkedListHook&) noexcept
+{
+}
+
+template<class T, class Tag>
+Ishiko::SinglyLinkedListHook<T, Tag>& Ishiko::SinglyLinkedListHook<T, Tag>::operator=(
+    const SinglyLinkedListHook&) noexcept
+{
+    return *this;
+}
+
+template<class T, class Tag>
+const Ishiko::SinglyLinkedListHook<T, Tag>* Ishiko::SinglyLinkedListHook<T, Tag>::nextNode() const noexcept
+{
+    return m_next_node;
+}
+
+template<class T, class Tag>
+Ishiko::SinglyLinkedListHook<T, Tag>* Ishiko::SinglyLinkedListHook<T, Tag>::nextNode() noexcept
+{
+    return m_next_node;
+}
+
+template<class T, class Tag>
+void Ishiko::SinglyLinkedListHook<T, Tag>::setNextNode(SinglyLinkedListHook* node) noexcept
+{
+    m_next_node = node;
+}
+
+template<class T, class Tag>
+const T& Ishiko::SinglyLinkedListHook<T, Tag>::data() const noexcept
+{
+    return static_cast<const T&>(*this);
+}
+
+template<class T, class Tag>
+T& Ishiko::SinglyLinkedListHook<T, Tag>::data() noexcept
+{
+    return static_cast<T&>(*this);
+}
+
+template<class T, class Tag>
+bool Ishiko::IntrusiveSinglyLinkedList<T, Tag>::isEmpty() const noexcept
+{
+    return m_list_impl.isEmpty();
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveSinglyLinkedList<T, Tag>::head() noexcept
+{
+    return ToNode(m_list_impl.head());
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveSinglyLinkedList<T, Tag>::NextNode(T* node) noexcept
+{
+    return ToNode(ToHook(node)->nextNode());
+}
+
+template<class T, class Tag>
+template<typename Callable>
+void Ishiko::IntrusiveSinglyLinkedList<T, Tag>::traverse(Callable&& callable) const
+{
+    m_list_impl.traverse(std::forward<Callable>(callable));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveSinglyLinkedList<T, Tag>::pushFront(T* node) noexcept
+{
+    m_list_impl.pushFront(ToHook(node));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveSinglyLinkedList<T, Tag>::insert(T* node, T* previous_node) noexcept
+{
+    m_list_impl.insert(ToHook(node), ToHook(previous_node));
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveSinglyLinkedList<T, Tag>::popFront() noexcept
+{
+    return ToNode(m_list_impl.popFront());
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveSinglyLinkedList<T, Tag>::eraseAfter(T* previous_node) noexcept
+{
+    return ToNode(m_list_impl.removeAfter(ToHook(previous_node)));
+}
+
+template<class T, class Tag>
+void Ishiko::IntrusiveSinglyLinkedList<T, Tag>::clear() noexcept
+{
+    m_list_impl.setHead(nullptr);
+}
+
+template<class T, class Tag>
+typename Ishiko::IntrusiveSinglyLinkedList<T, Tag>::Hook* Ishiko::IntrusiveSinglyLinkedList<T, Tag>::ToHook(
+    T* node) noexcept
+{
+    return static_cast<Hook*>(node);
+}
+
+template<class T, class Tag>
+T* Ishiko::IntrusiveSinglyLinkedList<T, Tag>::ToNode(Hook* hook) noexcept
+{
+    // static_cast maps nullptr to nullptr
+    return static_cast<T*>(hook);
+}
+
+#endif
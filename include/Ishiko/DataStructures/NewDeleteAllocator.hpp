@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_NEWDELETEALLOCATOR_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_NEWDELETEALLOCATOR_HPP
+
+#include "DataStructuresErrorCategory.hpp"
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+#include <new>
+
+namespace Ishiko
+{
+    // The default node allocator of the containers, every node is a separate allocation from the global operator new.
+    //
+    // A node allocator is a class with the same members as this one. The containers store their allocator by value
+    // and default construct it.
+    //  - allocate returns a block of at least size bytes aligned like std::max_align_t.
+    //  - deallocate returns a block, size is the size it was allocated with.
+    //  - reserve makes sure count blocks of size bytes can be allocated without any further memory being obtained
+    //    from the system.
+    //  - release frees all the blocks at once. It is only called if supports_release is true and in that case the
+    //    containers skip deallocating the nodes one by one when the nodes don't need to be destroyed either.
+    class NewDeleteAllocator
+    {
+    public:
+        static const bool supports_release = false;
+
+        void* allocate(size_t size);
+        void* allocate(size_t size, Error& error) noexcept;
+        void deallocate(void* memory, size_t size) noexcept;
+        // Does nothing, there is no way to pre-allocate memory for operator new
+        void reserve(size_t count, size_t size);
+        void reserve(size_t count, size_t size, Error& error) noexcept;
+        void release() noexcept;
+    };
+}
+
+inline void* Ishiko::NewDeleteAllocator::allocate(size_t size)
+{
+    return ::operator new(size);
+}
+
+inline void* Ishiko::NewDeleteAllocator::allocate(size_t size, Error& error) noexcept
+{
+    void* memory = ::operator new(size, std::nothrow);
+    if (!memory)
+    {
+        Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to allocate node", __FILE__, __LINE__,
+            error);
+    }
+    return memory;
+}
+
+inline void Ishiko::NewDeleteAllocator::deallocate(void* memory, size_t /*size*/) noexcept
+{
+    ::operator delete(memory);
+}
+
+inline void Ishiko::NewDeleteAllocator::reserve(size_t /*count*/, size_t /*size*/)
+{
+}
+
+inline void Ishiko::NewDeleteAllocator::reserve(size_t /*count*/, size_t /*size*/, Error& /*error*/) noexcept
+{
+}
+
+inline void Ishiko::NewDeleteAllocator::release() noexcept
+{
+}
+
+#endif
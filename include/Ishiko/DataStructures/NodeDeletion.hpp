@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_NODEDELETION_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_NODEDELETION_HPP
+
+#include "WorkStealingPool.hpp"
+#include <cstddef>
+#include <type_traits>
+
+namespace Ishiko
+{
+    // Deletes a chain of nodes linked through nextNode() starting at first_node. The chain is walked iteratively so
+    // the stack usage doesn't depend on the length of the chain.
+    template<class Node>
+    void DeleteNodeList(Node* first_node) noexcept;
+
+    template<class Node, typename Deleter>
+    void DeleteNodeList(Node* first_node, Deleter&& deleter) noexcept;
+
+    // Deletes all the nodes of the binary tree rooted at root_node without recursion and without any auxiliary
+    // storage. The left subtrees are rotated into the right spine as the walk proceeds so that every node can be
+    // deleted as soon as it no longer has a left child. The links of the nodes are modified in the process so the
+    // tree can't be used once this function has been called.
+    template<class Node>
+    void DeleteNodeTree(Node* root_node) noexcept;
+
+    template<class Node, typename Deleter>
+    void DeleteNodeTree(Node* root_node, Deleter&& deleter) noexcept;
+
+    // Calls destroy_value for every node of the chain starting at first_node, on the threads of pool. Each task
+    // handles grain_size consecutive nodes. destroy_value must only destroy the value of the node so that the links
+    // can still be followed, by the other tasks and afterwards to deallocate the nodes. If the pool can't take a task
+    // the remaining values are destroyed by the calling thread.
+    template<class Node, typename ValueDestroyer>
+    void DestroyNodeListValues(WorkStealingPool& pool, Node* first_node, size_t grain_size,
+        ValueDestroyer&& destroy_value) noexcept;
+
+    // Empties a container whose nodes all come from allocator. destroy_nodes destroys and deallocates the nodes and
+    // reset_container then puts the container back in its empty state. If values of type Value don't need to be
+    // destroyed and the allocator can free all its memory at once there is no need to visit the nodes, so
+    // destroy_nodes isn't called and the allocator is released instead.
+    template<typename Value, typename Allocator, typename NodesDestroyer, typename ContainerResetter>
+    void ClearNodes(Allocator& allocator, NodesDestroyer&& destroy_nodes, ContainerResetter&& reset_container)
+        noexcept;
+
+    // Same as ClearNodes but for the parallel clear of the containers. destroy_values destroys the values of the nodes
+    // on the threads of a pool, see DestroyNodeListValues, and deallocate_nodes then gives the memory of the nodes back
+    // to the allocator without destroying anything. This pays off when destroying a value costs a lot more than
+    // freeing a node. The nodes are still freed by the calling thread since the allocators aren't thread-safe, so the
+    // nodes are walked more times than by ClearNodes, which the containers use instead when the pool has no workers.
+    // destroy_values isn't called if values of type Value don't need to be destroyed and deallocate_nodes isn't called
+    // if the allocator can free all its memory at once.
+    template<typename Value, typename Allocator, typename ValuesDestroyer, typename NodesDeallocator,
+        typename ContainerResetter>
+    void ClearNodes(Allocator& allocator, ValuesDestroyer&& destroy_values, NodesDeallocator&& deallocate_nodes,
+        ContainerResetter&& reset_container) noexcept;
+}
+
+template<class Node>
+void Ishiko::DeleteNodeList(Node* first_node) noexcept
+{
+    DeleteNodeList(first_node, [](Node* node) { delete node; });
+}
+
+template<class Node, typename Deleter>
+void Ishiko::DeleteNodeList(Node* first_node, Deleter&& deleter) noexcept
+{
+    Node* current_node = first_node;
+    while (current_node)
+    {
+        Node* next_node = current_node->nextNode();
+        deleter(current_node);
+        current_node = next_node;
+    }
+}
+
+template<class Node>
+void Ishiko::DeleteNodeTree(Node* root_node) noexcept
+{
+    DeleteNodeTree(root_node, [](Node* node) { delete node; });
+}
+
+template<class Node, typename Deleter>
+void Ishiko::DeleteNodeTree(Node* root_node, Deleter&& deleter) noexcept
+{
+    Node* current_node = root_node;
+    while (current_node)
+    {
+        Node* left_child_node = current_node->leftChildNode();
+        if (left_child_node)
+        {
+            current_node->setLeftChildNode(left_child_node->rightChildNode());
+            left_child_node->setRightChildNode(current_node);
+            current_node = left_child_node;
+        }
+        else
+        {
+            Node* right_child_node = current_node->rightChildNode();
+            deleter(current_node);
+            current_node = right_child_node;
+        }
+    }
+}
+
+template<class Node, typename ValueDestroyer>
+void Ishiko::DestroyNodeListValues(WorkStealingPool& pool, Node* first_node, size_t grain_size,
+    ValueDestroyer&& destroy_value) noexcept
+{
+    WorkStealingPool::TaskGroup group;
+    Node* chunk_first_node = first_node;
+    while (chunk_first_node)
+    {
+        Node* next_chunk_first_node = chunk_first_node;
+        for (size_t i = 0; (i < grain_size) && next_chunk_first_node; ++i)
+        {
+            next_chunk_first_node = next_chunk_first_node->nextNode();
+        }
+
+        try
+        {
+            pool.run(group,
+                [chunk_first_node, next_chunk_first_node, &destroy_value]()
+                {
+                    for (Node* node = chunk_first_node; node != next_chunk_first_node; node = node->nextNode())
+                    {
+                        destroy_value(node);
+                    }
+                });
+        }
+        catch (...)
+        {
+            for (Node* node = chunk_first_node; node; node = node->nextNode())
+            {
+                destroy_value(node);
+            }
+            break;
+        }
+        chunk_first_node = next_chunk_first_node;
+    }
+
+    // The tasks don't throw so this only returns once they are all done
+    pool.wait(group);
+}
+
+template<typename Value, typename Allocator, typename NodesDestroyer, typename ContainerResetter>
+void Ishiko::ClearNodes(Allocator& allocator, NodesDestroyer&& destroy_nodes, ContainerResetter&& reset_container)
+    noexcept
+{
+    if (!std::is_trivially_destructible<Value>::value || !Allocator::supports_release)
+    {
+        destroy_nodes();
+    }
+    reset_container();
+    if (Allocator::supports_release)
+    {
+        allocator.release();
+    }
+}
+
+template<typename Value, typename Allocator, typename ValuesDestroyer, typename NodesDeallocator,
+    typename ContainerResetter>
+void Ishiko::ClearNodes(Allocator& allocator, ValuesDestroyer&& destroy_values, NodesDeallocator&& deallocate_nodes,
+    ContainerResetter&& reset_container) noexcept
+{
+    if (!std::is_trivially_destructible<Value>::value)
+    {
+        destroy_values();
+    }
+    if (!Allocator::supports_release)
+    {
+        deallocate_nodes();
+    }
+    reset_container();
+    if (Allocator::supports_release)
+    {
+        allocator.release();
+    }
+}
+
+#endif
@@ -0,0 +1,684 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_ORDEREDSETIMAGE_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_ORDEREDSETIMAGE_HPP
+
+#include "ContainerStatistics.hpp"
+#include "DataStructuresErrorCategory.hpp"
+#include <Ishiko/Errors.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace Ishiko
+{
+    // The binary format shared by OrderedSetImage and OrderedSetImageWriter.
+    //
+    // An image is a static B+tree made of nodes of NodeSize bytes. The first NodeSize bytes hold a FileHeader, the
+    // nodes follow and a Trailer ends the image. The links between nodes are offsets from the start of the image so
+    // the image can be used wherever it is loaded or mapped. Every node starts with a NodeHeader. A leaf then holds up
+    // to leaf_capacity values in ascending order and the NodeHeader links it to the next leaf. An internal node holds
+    // up to internal_capacity keys followed by as many child offsets, the key of a child being its first value.
+    //
+    // The integers and the values are stored in the byte order of the machine that wrote the image. An image can only
+    // be read on a machine with the same byte order and with the same DataType and NodeSize it was written with,
+    // which OrderedSetImage checks when it opens the image.
+    template<typename DataType, size_t NodeSize>
+    class OrderedSetImageLayout
+    {
+        static_assert(std::is_trivially_copyable<DataType>::value, "DataType must be trivially copyable");
+        static_assert(alignof(DataType) <= 16, "DataType can't be aligned on more than 16 bytes");
+        static_assert((NodeSize % 16) == 0, "NodeSize must be a multiple of 16");
+
+    public:
+        static const uint32_t version = 1;
+        static const uint32_t byte_order_mark = 0x01020304;
+
+        struct FileHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t byte_order_mark;
+            uint32_t node_size;
+            uint32_t element_size;
+            uint32_t element_alignment;
+            uint32_t reserved;
+        };
+
+        struct NodeHeader
+        {
+            uint32_t count;
+            // 0 for the leaves
+            uint32_t level;
+            // The offset of the next leaf, 0 for the last leaf and for the internal nodes
+            uint64_t next_offset;
+        };
+
+        struct Trailer
+        {
+            // 0 if the image is empty
+            uint64_t root_offset;
+            uint64_t element_count;
+            // The number of levels of the tree, 0 if the image is empty
+            uint32_t height;
+            uint32_t reserved;
+            char magic[8];
+        };
+
+        static const size_t leaf_capacity = ((NodeSize - sizeof(NodeHeader)) / sizeof(DataType));
+        // 8 bytes are set aside for the padding between the keys and the child offsets
+        static const size_t internal_capacity = ((NodeSize - sizeof(NodeHeader) - 8)
+            / (sizeof(DataType) + sizeof(uint64_t)));
+        static const size_t child_offsets_offset = (((sizeof(NodeHeader) + (internal_capacity * sizeof(DataType)))
+            + 7) & ~size_t(7));
+
+        static_assert(sizeof(FileHeader) <= NodeSize, "NodeSize is too small");
+        static_assert(internal_capacity >= 2, "NodeSize is too small for DataType");
+
+        static const char* FileMagic() noexcept;
+        static const char* TrailerMagic() noexcept;
+
+        static const NodeHeader* Header(const char* node) noexcept;
+        static const DataType* Values(const char* node) noexcept;
+        static const DataType* Keys(const char* node) noexcept;
+        static const uint64_t* ChildOffsets(const char* node) noexcept;
+    };
+
+    // A read-only view of an ordered set image written by OrderedSetImageWriter. The image is used where it is, for
+    // instance in memory mapped from a file, so opening it takes constant time whatever its size and only the nodes a
+    // query goes through are ever read.
+    //
+    // The image must stay at the same address as long as the view is used. It must be aligned on 8 bytes and on the
+    // alignment of DataType, which mapped memory always is. Opening an image only checks its header and its trailer,
+    // the nodes themselves are trusted.
+    template<typename DataType, typename Compare = std::less<DataType>, size_t NodeSize = 4096>
+    class OrderedSetImage
+    {
+    public:
+        typedef OrderedSetImageLayout<DataType, NodeSize> Layout;
+
+        // Visits the values in ascending order by walking the chain of leaves
+        class ConstIterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef DataType value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const DataType* pointer;
+            typedef const DataType& reference;
+
+            ConstIterator() noexcept = default;
+            // Moves to the next leaf straight away if index is past the last value of leaf
+            ConstIterator(const char* image, const char* leaf, size_t index) noexcept;
+
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+            ConstIterator& operator++() noexcept;
+            ConstIterator operator++(int) noexcept;
+            bool operator==(const ConstIterator& other) const noexcept;
+            bool operator!=(const ConstIterator& other) const noexcept;
+
+        private:
+            void skipEmptyLeaf() noexcept;
+
+            const char* m_image = nullptr;
+            const char* m_leaf = nullptr;
+            size_t m_index = 0;
+        };
+
+        OrderedSetImage() noexcept = default;
+        OrderedSetImage(const void* image, size_t size, const Compare& compare = Compare());
+        OrderedSetImage(const void* image, size_t size, Error& error, const Compare& compare = Compare()) noexcept;
+
+        bool isEmpty() const noexcept;
+        size_t size() const noexcept;
+        ConstIterator begin() const noexcept;
+        ConstIterator end() const noexcept;
+
+        // The value equal to value, or nullptr if there is none. The pointer points into the image.
+        const DataType* find(const DataType& value) const noexcept;
+        bool contains(const DataType& value) const noexcept;
+        // The first value that is not less than value
+        ConstIterator lowerBound(const DataType& value) const noexcept;
+
+        template<typename Callable>
+        void traverse(Callable&& callable) const;
+
+        // See ContainerStatistics. element_bytes is the size of the image. The nodes are not visited so spare_bytes
+        // is always 0.
+        ContainerStatistics statistics() const noexcept;
+
+    private:
+        void open(const void* image, size_t size, Error& error) noexcept;
+        // The leaf where value is or would be
+        const char* findLeaf(const DataType& value) const noexcept;
+
+        const char* m_image = nullptr;
+        size_t m_image_size = 0;
+        const char* m_root = nullptr;
+        uint64_t m_element_count = 0;
+        uint32_t m_height = 0;
+        Compare m_compare;
+    };
+
+    // Writes an ordered set image to a stream. The values must be added in strictly ascending order, which is the
+    // order in which the sorted containers such as SkipList or BinaryTree visit them.
+    //
+    // The tree is built bottom-up while the values arrive: each node is written as soon as it is full and only one
+    // node per level is kept in memory, so the memory used is proportional to the height of the tree rather than to
+    // the size of the image. The stream doesn't need to be seekable. finish() must be called once all the values have
+    // been added to write the nodes that are not full and the trailer.
+    template<typename DataType, typename Compare = std::less<DataType>, size_t NodeSize = 4096>
+    class OrderedSetImageWriter
+    {
+    public:
+        typedef OrderedSetImageLayout<DataType, NodeSize> Layout;
+
+        // Writes the header of the image to output
+        explicit OrderedSetImageWriter(std::ostream& output, const Compare& compare = Compare());
+        OrderedSetImageWriter(const OrderedSetImageWriter& other) = delete;
+        OrderedSetImageWriter& operator=(const OrderedSetImageWriter& other) = delete;
+
+        void add(const DataType& value);
+        template<typename InputIterator>
+        void add(InputIterator first, InputIterator last);
+        void finish();
+
+    private:
+        // The internal node being filled at one level of the tree
+        struct Level
+        {
+            std::vector<char> node;
+            uint32_t count;
+        };
+
+        // Writes the current leaf. has_next tells whether another leaf will follow, in which case the offset of that
+        // leaf is already known: it comes right after the internal nodes this leaf fills up.
+        void writeLeaf(bool has_next);
+        void writeInternalNode(size_t level);
+        void addChild(size_t level, uint64_t offset, const DataType& key);
+        void write(const void* bytes, size_t size);
+
+        std::ostream& m_output;
+        Compare m_compare;
+        uint64_t m_position = 0;
+        uint64_t m_element_count = 0;
+        std::vector<char> m_leaf;
+        uint32_t m_leaf_count = 0;
+        std::vector<Level> m_levels;
+        bool m_finished = false;
+    };
+}
+
+template<typename DataType, size_t NodeSize>
+const uint32_t Ishiko::OrderedSetImageLayout<DataType, NodeSize>::version;
+
+template<typename DataType, size_t NodeSize>
+const uint32_t Ishiko::OrderedSetImageLayout<DataType, NodeSize>::byte_order_mark;
+
+template<typename DataType, size_t NodeSize>
+const size_t Ishiko::OrderedSetImageLayout<DataType, NodeSize>::leaf_capacity;
+
+template<typename DataType, size_t NodeSize>
+const size_t Ishiko::OrderedSetImageLayout<DataType, NodeSize>::internal_capacity;
+
+template<typename DataType, size_t NodeSize>
+const size_t Ishiko::OrderedSetImageLayout<DataType, NodeSize>::child_offsets_offset;
+
+template<typename DataType, size_t NodeSize>
+const char* Ishiko::OrderedSetImageLayout<DataType, NodeSize>::FileMagic() noexcept
+{
+    return "ISKOSETI";
+}
+
+template<typename DataType, size_t NodeSize>
+const char* Ishiko::OrderedSetImageLayout<DataType, NodeSize>::TrailerMagic() noexcept
+{
+    return "ISKOSETE";
+}
+
+template<typename DataType, size_t NodeSize>
+const typename Ishiko::OrderedSetImageLayout<DataType, NodeSize>::NodeHeader*
+Ishiko::OrderedSetImageLayout<DataType, NodeSize>::Header(const char* node) noexcept
+{
+    return reinterpret_cast<const NodeHeader*>(node);
+}
+
+template<typename DataType, size_t NodeSize>
+const DataType* Ishiko::OrderedSetImageLayout<DataType, NodeSize>::Values(const char* node) noexcept
+{
+    return reinterpret_cast<const DataType*>(node + sizeof(NodeHeader));
+}
+
+template<typename DataType, size_t NodeSize>
+const DataType* Ishiko::OrderedSetImageLayout<DataType, NodeSize>::Keys(const char* node) noexcept
+{
+    return reinterpret_cast<const DataType*>(node + sizeof(NodeHeader));
+}
+
+template<typename DataType, size_t NodeSize>
+const uint64_t* Ishiko::OrderedSetImageLayout<DataType, NodeSize>::ChildOffsets(const char* node) noexcept
+{
+    return reinterpret_cast<const uint64_t*>(node + child_offsets_offset);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator::ConstIterator(const char* image,
+    const char* leaf, size_t index) noexcept
+    : m_image(image), m_leaf(leaf), m_index(index)
+{
+    skipEmptyLeaf();
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+const DataType& Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator::operator*() const noexcept
+{
+    return Layout::Values(m_leaf)[m_index];
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+const DataType* Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator::operator->() const noexcept
+{
+    return &Layout::Values(m_leaf)[m_index];
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+typename Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator&
+Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator::operator++() noexcept
+{
+    ++m_index;
+    skipEmptyLeaf();
+    return *this;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+typename Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator
+Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator::operator++(int) noexcept
+{
+    ConstIterator result = *this;
+    ++(*this);
+    return result;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+bool Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator::operator==(
+    const ConstIterator& other) const noexcept
+{
+    return ((m_leaf == other.m_leaf) && (m_index == other.m_index));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+bool Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator::operator!=(
+    const ConstIterator& other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+void Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator::skipEmptyLeaf() noexcept
+{
+    if (m_leaf && (m_index == Layout::Header(m_leaf)->count))
+    {
+        uint64_t next_offset = Layout::Header(m_leaf)->next_offset;
+        m_leaf = (next_offset ? (m_image + next_offset) : nullptr);
+        m_index = 0;
+    }
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::OrderedSetImage(const void* image, size_t size,
+    const Compare& compare)
+    : m_compare(compare)
+{
+    Error error;
+    open(image, size, error);
+    if (error)
+    {
+        Throw(DataStructuresErrorCategory::Value::invalid_image, "Invalid ordered set image", __FILE__, __LINE__);
+    }
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::OrderedSetImage(const void* image, size_t size,
+    Error& error, const Compare& compare) noexcept
+    : m_compare(compare)
+{
+    open(image, size, error);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+bool Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::isEmpty() const noexcept
+{
+    return (m_element_count == 0);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+size_t Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::size() const noexcept
+{
+    return static_cast<size_t>(m_element_count);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+typename Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator
+Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::begin() const noexcept
+{
+    const char* node = m_root;
+    for (uint32_t level = 1; level < m_height; ++level)
+    {
+        node = (m_image + Layout::ChildOffsets(node)[0]);
+    }
+    return ConstIterator(m_image, node, 0);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+typename Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator
+Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::end() const noexcept
+{
+    return ConstIterator();
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+const DataType* Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::find(const DataType& value) const noexcept
+{
+    ConstIterator it = lowerBound(value);
+    if ((it != end()) && !m_compare(value, *it))
+    {
+        return &*it;
+    }
+    return nullptr;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+bool Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::contains(const DataType& value) const noexcept
+{
+    return (find(value) != nullptr);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+typename Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::ConstIterator
+Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::lowerBound(const DataType& value) const noexcept
+{
+    const char* leaf = findLeaf(value);
+    if (!leaf)
+    {
+        return end();
+    }
+
+    // If value is greater than all the values in the leaf the iterator moves on to the first value of the next leaf
+    const DataType* values = Layout::Values(leaf);
+    const DataType* it = std::lower_bound(values, values + Layout::Header(leaf)->count, value, m_compare);
+    return ConstIterator(m_image, leaf, static_cast<size_t>(it - values));
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+template<typename Callable>
+void Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::traverse(Callable&& callable) const
+{
+    for (ConstIterator it = begin(); it != end(); ++it)
+    {
+        callable(*it);
+    }
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+Ishiko::ContainerStatistics Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::statistics() const noexcept
+{
+    ContainerStatistics statistics;
+    statistics.element_count = size();
+    statistics.element_bytes = m_image_size;
+    statistics.height = m_height;
+    return statistics;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+void Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::open(const void* image, size_t size,
+    Error& error) noexcept
+{
+    typedef typename Layout::FileHeader FileHeader;
+    typedef typename Layout::Trailer Trailer;
+
+    const char* bytes = static_cast<const char*>(image);
+    if (!bytes || (size < (NodeSize + sizeof(Trailer))) || (((size - sizeof(Trailer)) % NodeSize) != 0))
+    {
+        Fail(DataStructuresErrorCategory::Value::invalid_image, "Image has an invalid size", __FILE__, __LINE__,
+            error);
+        return;
+    }
+    if ((reinterpret_cast<uintptr_t>(bytes) % std::max(alignof(DataType), alignof(uint64_t))) != 0)
+    {
+        Fail(DataStructuresErrorCategory::Value::invalid_image, "Image is not suitably aligned", __FILE__, __LINE__,
+            error);
+        return;
+    }
+
+    FileHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    if ((memcmp(header.magic, Layout::FileMagic(), sizeof(header.magic)) != 0)
+        || (header.version != Layout::version) || (header.byte_order_mark != Layout::byte_order_mark))
+    {
+        Fail(DataStructuresErrorCategory::Value::invalid_image, "Image has an invalid header", __FILE__, __LINE__,
+            error);
+        return;
+    }
+    if ((header.node_size != NodeSize) || (header.element_size != sizeof(DataType))
+        || (header.element_alignment != alignof(DataType)))
+    {
+        Fail(DataStructuresErrorCategory::Value::invalid_image, "Image was written with a different data type",
+            __FILE__, __LINE__, error);
+        return;
+    }
+
+    Trailer trailer;
+    memcpy(&trailer, bytes + size - sizeof(Trailer), sizeof(trailer));
+    bool valid_root = ((trailer.height == 0)
+        ? ((trailer.root_offset == 0) && (trailer.element_count == 0))
+        : ((trailer.root_offset >= NodeSize) && ((trailer.root_offset % NodeSize) == 0)
+            && (trailer.root_offset < (size - sizeof(Trailer))) && (trailer.element_count != 0)));
+    if ((memcmp(trailer.magic, Layout::TrailerMagic(), sizeof(trailer.magic)) != 0) || !valid_root)
+    {
+        Fail(DataStructuresErrorCategory::Value::invalid_image, "Image has an invalid trailer", __FILE__, __LINE__,
+            error);
+        return;
+    }
+
+    m_image = bytes;
+    m_image_size = size;
+    m_root = ((trailer.height == 0) ? nullptr : (bytes + trailer.root_offset));
+    m_element_count = trailer.element_count;
+    m_height = trailer.height;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+const char* Ishiko::OrderedSetImage<DataType, Compare, NodeSize>::findLeaf(const DataType& value) const noexcept
+{
+    const char* node = m_root;
+    for (uint32_t level = 1; level < m_height; ++level)
+    {
+        // The child to descend into is the last one whose key is not greater than value, or the first child if
+        // value is less than all the keys
+        const DataType* keys = Layout::Keys(node);
+        const DataType* it = std::upper_bound(keys + 1, keys + Layout::Header(node)->count, value, m_compare);
+        node = (m_image + Layout::ChildOffsets(node)[(it - keys) - 1]);
+    }
+    return node;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+Ishiko::OrderedSetImageWriter<DataType, Compare, NodeSize>::OrderedSetImageWriter(std::ostream& output,
+    const Compare& compare)
+    : m_output(output), m_compare(compare), m_leaf(NodeSize, 0)
+{
+    typename Layout::FileHeader header;
+    memcpy(header.magic, Layout::FileMagic(), sizeof(header.magic));
+    header.version = Layout::version;
+    header.byte_order_mark = Layout::byte_order_mark;
+    header.node_size = static_cast<uint32_t>(NodeSize);
+    header.element_size = static_cast<uint32_t>(sizeof(DataType));
+    header.element_alignment = static_cast<uint32_t>(alignof(DataType));
+    header.reserved = 0;
+
+    std::vector<char> first_node(NodeSize, 0);
+    memcpy(first_node.data(), &header, sizeof(header));
+    write(first_node.data(), first_node.size());
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+void Ishiko::OrderedSetImageWriter<DataType, Compare, NodeSize>::add(const DataType& value)
+{
+    DataType* values = reinterpret_cast<DataType*>(m_leaf.data() + sizeof(typename Layout::NodeHeader));
+    if (m_leaf_count > 0)
+    {
+        if (!m_compare(values[m_leaf_count - 1], value))
+        {
+            Throw(DataStructuresErrorCategory::Value::generic_error,
+                "Values must be added in strictly ascending order", __FILE__, __LINE__);
+        }
+        if (m_leaf_count == Layout::leaf_capacity)
+        {
+            writeLeaf(true);
+        }
+    }
+
+    memcpy(&values[m_leaf_count], &value, sizeof(DataType));
+    ++m_leaf_count;
+    ++m_element_count;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+template<typename InputIterator>
+void Ishiko::OrderedSetImageWriter<DataType, Compare, NodeSize>::add(InputIterator first, InputIterator last)
+{
+    for (; first != last; ++first)
+    {
+        add(*first);
+    }
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+void Ishiko::OrderedSetImageWriter<DataType, Compare, NodeSize>::finish()
+{
+    if (m_finished)
+    {
+        return;
+    }
+
+    typename Layout::Trailer trailer;
+    trailer.root_offset = 0;
+    trailer.element_count = m_element_count;
+    trailer.height = 0;
+    trailer.reserved = 0;
+    memcpy(trailer.magic, Layout::TrailerMagic(), sizeof(trailer.magic));
+
+    if (m_leaf_count > 0)
+    {
+        writeLeaf(false);
+
+        // Write the nodes that are not full from the bottom up until a level is left with a single child, which is
+        // the root. Writing a level adds a child to the level above it so the loop always reaches such a level.
+        for (size_t level = 0; level < m_levels.size(); ++level)
+        {
+            if (((level + 1) == m_levels.size()) && (m_levels[level].count == 1))
+            {
+                const char* node = m_levels[level].node.data();
+                trailer.root_offset = Layout::ChildOffsets(node)[0];
+                trailer.height = static_cast<uint32_t>(level + 1);
+                break;
+            }
+            writeInternalNode(level);
+        }
+    }
+
+    write(&trailer, sizeof(trailer));
+    m_output.flush();
+    if (!m_output)
+    {
+        Throw(DataStructuresErrorCategory::Value::generic_error, "Failed to write the image", __FILE__, __LINE__);
+    }
+    m_finished = true;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+void Ishiko::OrderedSetImageWriter<DataType, Compare, NodeSize>::writeLeaf(bool has_next)
+{
+    // Adding this leaf to its parent writes the parent first if it is full, which adds it to its own parent and so
+    // on up the tree. All these nodes are written before the next leaf.
+    size_t full_levels = 0;
+    while ((full_levels < m_levels.size()) && (m_levels[full_levels].count == Layout::internal_capacity))
+    {
+        ++full_levels;
+    }
+
+    uint64_t offset = m_position;
+    typename Layout::NodeHeader header;
+    header.count = m_leaf_count;
+    header.level = 0;
+    header.next_offset = (has_next ? (offset + (NodeSize * (1 + full_levels))) : 0);
+    memcpy(m_leaf.data(), &header, sizeof(header));
+    write(m_leaf.data(), m_leaf.size());
+
+    DataType key = Layout::Values(m_leaf.data())[0];
+    std::fill(m_leaf.begin(), m_leaf.end(), 0);
+    m_leaf_count = 0;
+    addChild(0, offset, key);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+void Ishiko::OrderedSetImageWriter<DataType, Compare, NodeSize>::writeInternalNode(size_t level)
+{
+    uint64_t offset = m_position;
+    std::vector<char>& node = m_levels[level].node;
+    typename Layout::NodeHeader header;
+    header.count = m_levels[level].count;
+    header.level = static_cast<uint32_t>(level + 1);
+    header.next_offset = 0;
+    memcpy(node.data(), &header, sizeof(header));
+    write(node.data(), node.size());
+
+    DataType key = Layout::Keys(node.data())[0];
+    std::fill(node.begin(), node.end(), 0);
+    m_levels[level].count = 0;
+    addChild(level + 1, offset, key);
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+void Ishiko::OrderedSetImageWriter<DataType, Compare, NodeSize>::addChild(size_t level, uint64_t offset,
+    const DataType& key)
+{
+    if (level == m_levels.size())
+    {
+        m_levels.push_back(Level{ std::vector<char>(NodeSize, 0), 0 });
+    }
+    if (m_levels[level].count == Layout::internal_capacity)
+    {
+        writeInternalNode(level);
+    }
+
+    // writeInternalNode may have added a level so the reference is only taken now
+    Level& current_level = m_levels[level];
+    char* node = current_level.node.data();
+    memcpy(node + sizeof(typename Layout::NodeHeader) + (current_level.count * sizeof(DataType)), &key,
+        sizeof(DataType));
+    memcpy(node + Layout::child_offsets_offset + (current_level.count * sizeof(uint64_t)), &offset,
+        sizeof(uint64_t));
+    ++current_level.count;
+}
+
+template<typename DataType, typename Compare, size_t NodeSize>
+void Ishiko::OrderedSetImageWriter<DataType, Compare, NodeSize>::write(const void* bytes, size_t size)
+{
+    m_output.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+    if (!m_output)
+    {
+        Throw(DataStructuresErrorCategory::Value::generic_error, "Failed to write the image", __FILE__, __LINE__);
+    }
+    m_position += size;
+}
+
+#endif
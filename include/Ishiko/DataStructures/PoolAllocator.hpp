@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_POOLALLOCATOR_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_POOLALLOCATOR_HPP
+
+#include "ArenaAllocator.hpp"
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+
+namespace Ishiko
+{
+    // A slab node allocator. Blocks are grouped in size classes that are multiples of ArenaAllocator::alignment and
+    // carved out of slabs. Deallocated blocks go on a free list per size class and are reused by the next
+    // allocation of the same class, so erasing and inserting nodes doesn't go back to the system. Blocks larger than
+    // the largest class are allocated individually.
+    //
+    // See NewDeleteAllocator for the requirements of node allocators. The allocator isn't thread-safe.
+    class PoolAllocator
+    {
+    public:
+        static const bool supports_release = true;
+        static const size_t size_classes = 32;
+        static const size_t max_block_size = (size_classes * ArenaAllocator::alignment);
+
+        explicit PoolAllocator(size_t slab_size = ArenaAllocator::default_slab_size) noexcept;
+        PoolAllocator(const PoolAllocator& other) = delete;
+        PoolAllocator& operator=(const PoolAllocator& other) = delete;
+        ~PoolAllocator() noexcept;
+
+        void* allocate(size_t size);
+        void* allocate(size_t size, Error& error) noexcept;
+        void deallocate(void* memory, size_t size) noexcept;
+        void reserve(size_t count, size_t size);
+        void reserve(size_t count, size_t size, Error& error) noexcept;
+        // Frees all the blocks, including the large ones
+        void release() noexcept;
+
+    private:
+        // Large blocks are kept in a doubly linked list so release can free them. The header is padded to keep the
+        // block aligned.
+        struct LargeBlock
+        {
+            LargeBlock* previous_block;
+            LargeBlock* next_block;
+        };
+
+        static size_t SizeClass(size_t size) noexcept;
+        static size_t LargeBlockHeaderSize() noexcept;
+
+        void* allocateLarge(size_t size) noexcept;
+        void deallocateLarge(void* memory) noexcept;
+
+        ArenaAllocator m_arena;
+        // A free block holds the address of the next free block of the same class in its first bytes
+        void* m_free_blocks[size_classes];
+        LargeBlock* m_large_blocks = nullptr;
+    };
+}
+
+inline size_t Ishiko::PoolAllocator::SizeClass(size_t size) noexcept
+{
+    return ((size == 0) ? 0 : ((size - 1) / ArenaAllocator::alignment));
+}
+
+inline void* Ishiko::PoolAllocator::allocate(size_t size)
+{
+    size_t size_class = SizeClass(size);
+    if (size_class < size_classes)
+    {
+        void* memory = m_free_blocks[size_class];
+        if (memory)
+        {
+            m_free_blocks[size_class] = *static_cast<void**>(memory);
+            return memory;
+        }
+        return m_arena.allocate((size_class + 1) * ArenaAllocator::alignment);
+    }
+
+    void* memory = allocateLarge(size);
+    if (!memory)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+inline void Ishiko::PoolAllocator::deallocate(void* memory, size_t size) noexcept
+{
+    size_t size_class = SizeClass(size);
+    if (size_class < size_classes)
+    {
+        *static_cast<void**>(memory) = m_free_blocks[size_class];
+        m_free_blocks[size_class] = memory;
+    }
+    else
+    {
+        deallocateLarge(memory);
+    }
+}
+
+#endif
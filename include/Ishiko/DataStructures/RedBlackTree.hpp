@@ -4,46 +4,935 @@
 #ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_REDBLACKTREE_HPP
 #define GUARD_ISHIKO_CPP_DATASTRUCTURES_REDBLACKTREE_HPP
 
+#include "ContainerStatistics.hpp"
+#include "NewDeleteAllocator.hpp"
+#include "NodeDeletion.hpp"
+#include <Ishiko/Errors.hpp>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace Ishiko
 {
-    template<class ValueType>
+    // An ordered set implemented as a red-black tree. Values are ordered by Compare, which must be a strict weak
+    // ordering, and each value is stored only once. Allocator is the node allocator, see NewDeleteAllocator.
+    template<class ValueType, class Compare = std::less<ValueType>, class Allocator = NewDeleteAllocator>
     class RedBlackTree
     {
     public:
+        // The color of a node is stored in the lowest bit of its parent pointer, which is always 0 because nodes are
+        // at least pointer aligned. A node is therefore three pointers plus the value.
         class Node
         {
+        public:
+            Node(const Node& other) = delete;
+            Node& operator=(const Node& other) = delete;
+
+            const Node* parentNode() const noexcept;
+            Node* parentNode() noexcept;
+            const Node* leftChildNode() const noexcept;
+            Node* leftChildNode() noexcept;
+            const Node* rightChildNode() const noexcept;
+            Node* rightChildNode() noexcept;
+            // The in-order successor and predecessor, or nullptr if there is none
+            const Node* nextNode() const noexcept;
+            Node* nextNode() noexcept;
+            const Node* previousNode() const noexcept;
+            Node* previousNode() noexcept;
+
+            bool isRed() const noexcept;
+            bool isBlack() const noexcept;
+
+            const ValueType& value() const noexcept;
+
+        private:
+            friend class RedBlackTree;
+
+            static const uintptr_t red_bit = 1;
+
+            // The value is constructed from arguments
+            template<class... Arguments>
+            Node(Node* parent_node, Arguments&&... arguments);
+            ~Node() noexcept = default;
+
+            void setParentNode(Node* node) noexcept;
+            void setRed() noexcept;
+            void setBlack() noexcept;
+            void copyColor(const Node& other) noexcept;
+
+            uintptr_t m_parent_node_and_color;
+            Node* m_left_child_node = nullptr;
+            Node* m_right_child_node = nullptr;
+            ValueType m_value;
         };
 
-        RedBlackTree() noexcept = default;
-        ~RedBlackTree() noexcept;
+        // A forward iterator over the values in order. The values can't be modified through it since that could
+        // break the ordering.
+        class ConstIterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef ValueType value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const ValueType* pointer;
+            typedef const ValueType& reference;
+
+            ConstIterator() noexcept = default;
+            explicit ConstIterator(const Node* node) noexcept;
+
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+            ConstIterator& operator++() noexcept;
+            ConstIterator operator++(int) noexcept;
+            bool operator==(const ConstIterator& other) const noexcept;
+            bool operator!=(const ConstIterator& other) const noexcept;
 
-        void insert(const ValueType& value);
+            const Node* node() const noexcept;
+
+        private:
+            const Node* m_node = nullptr;
+        };
+
+        RedBlackTree() = default;
+        explicit RedBlackTree(const Compare& compare);
+        RedBlackTree(const RedBlackTree& other) = delete;
+        RedBlackTree& operator=(const RedBlackTree& other) = delete;
+        ~RedBlackTree() noexcept;
 
+        bool isEmpty() const noexcept;
         size_t size() const noexcept;
+        const Node* root() const noexcept;
+        ConstIterator begin() const noexcept;
+        ConstIterator end() const noexcept;
+
+        const Node* find(const ValueType& value) const noexcept;
+        Node* find(const ValueType& value) noexcept;
+        bool contains(const ValueType& value) const noexcept;
+        // The first node whose value is not less than value
+        const Node* lowerBound(const ValueType& value) const noexcept;
+        Node* lowerBound(const ValueType& value) noexcept;
+        // The first node whose value is greater than value
+        const Node* upperBound(const ValueType& value) const noexcept;
+        Node* upperBound(const ValueType& value) noexcept;
+
+        // Returns the node holding value, which is the existing node if the tree already contains an equal value.
+        Node* insert(const ValueType& value);
+        Node* insert(ValueType&& value);
+        // Same as insert but the value is constructed in place from arguments. Since the value is needed to find where
+        // it goes it is always constructed, and destroyed again if the tree already contains an equal value.
+        template<class... Arguments>
+        Node* emplace(Arguments&&... arguments);
+        // Returns false if the tree doesn't contain a value equal to value.
+        bool erase(const ValueType& value) noexcept;
+        void erase(Node* node) noexcept;
+        void clear() noexcept;
+
+        // Makes sure count values can be inserted without the allocator needing more memory from the system
+        void reserve(size_t count);
+        void reserve(size_t count, Error& error) noexcept;
+
+        // Visits every node to compute a snapshot of the memory the tree holds, see ContainerStatistics
+        ContainerStatistics statistics() const;
 
     private:
+        static Node* LeftmostNode(Node* node) noexcept;
+
+        void rotateLeft(Node* node) noexcept;
+        void rotateRight(Node* node) noexcept;
+        // Replaces the subtree rooted at node by the one rooted at replacement_node
+        void replaceSubtree(Node* node, Node* replacement_node) noexcept;
+        void fixAfterInsert(Node* node) noexcept;
+        // Restores the red-black properties after a black node was removed from above node, which may be nullptr
+        // and is then identified by its parent
+        void fixAfterErase(Node* node, Node* parent_node) noexcept;
+
+        // Returns the link where a node holding value goes and sets parent_node to the parent of that node. If the
+        // tree already contains an equal value this returns nullptr and sets parent_node to the node holding it.
+        Node** findLink(const ValueType& value, Node*& parent_node) noexcept;
+        template<class Value>
+        Node* insertValue(Value&& value);
+        void linkNode(Node* node, Node** link) noexcept;
+
+        template<class... Arguments>
+        Node* createNode(Node* parent_node, Arguments&&... arguments);
+        void destroyNode(Node* node) noexcept;
+
+        Compare m_compare;
+        Allocator m_allocator;
         size_t m_size = 0;
         Node* m_root = nullptr;
     };
 }
 
-template<class ValueType>
-Ishiko::RedBlackTree<ValueType>::~RedBlackTree() noexcept
+template<class ValueType, class Compare, class Allocator>
+const uintptr_t Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::red_bit;
+
+template<class ValueType, class Compare, class Allocator>
+template<class... Arguments>
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::Node(Node* parent_node, Arguments&&... arguments)
+    : m_parent_node_and_color(reinterpret_cast<uintptr_t>(parent_node) | red_bit),
+    m_value(std::forward<Arguments>(arguments)...)
+{
+}
+
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::parentNode() const noexcept
+{
+    return reinterpret_cast<const Node*>(m_parent_node_and_color & ~red_bit);
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::parentNode() noexcept
+{
+    return reinterpret_cast<Node*>(m_parent_node_and_color & ~red_bit);
+}
+
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::leftChildNode() const noexcept
+{
+    return m_left_child_node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::leftChildNode() noexcept
+{
+    return m_left_child_node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::rightChildNode() const noexcept
+{
+    return m_right_child_node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::rightChildNode() noexcept
+{
+    return m_right_child_node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::nextNode() const noexcept
+{
+    return const_cast<Node*>(this)->nextNode();
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::nextNode() noexcept
+{
+    if (m_right_child_node)
+    {
+        return LeftmostNode(m_right_child_node);
+    }
+
+    Node* node = this;
+    Node* parent_node = parentNode();
+    while (parent_node && (node == parent_node->m_right_child_node))
+    {
+        node = parent_node;
+        parent_node = parent_node->parentNode();
+    }
+    return parent_node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::previousNode() const noexcept
+{
+    return const_cast<Node*>(this)->previousNode();
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::previousNode() noexcept
+{
+    if (m_left_child_node)
+    {
+        Node* node = m_left_child_node;
+        while (node->m_right_child_node)
+        {
+            node = node->m_right_child_node;
+        }
+        return node;
+    }
+
+    Node* node = this;
+    Node* parent_node = parentNode();
+    while (parent_node && (node == parent_node->m_left_child_node))
+    {
+        node = parent_node;
+        parent_node = parent_node->parentNode();
+    }
+    return parent_node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+bool Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::isRed() const noexcept
+{
+    return ((m_parent_node_and_color & red_bit) != 0);
+}
+
+template<class ValueType, class Compare, class Allocator>
+bool Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::isBlack() const noexcept
+{
+    return ((m_parent_node_and_color & red_bit) == 0);
+}
+
+template<class ValueType, class Compare, class Allocator>
+const ValueType& Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::value() const noexcept
+{
+    return m_value;
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::setParentNode(Node* node) noexcept
+{
+    m_parent_node_and_color = (reinterpret_cast<uintptr_t>(node) | (m_parent_node_and_color & red_bit));
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::setRed() noexcept
+{
+    m_parent_node_and_color |= red_bit;
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::setBlack() noexcept
+{
+    m_parent_node_and_color &= ~red_bit;
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node::copyColor(const Node& other) noexcept
+{
+    m_parent_node_and_color = ((m_parent_node_and_color & ~red_bit) | (other.m_parent_node_and_color & red_bit));
+}
+
+template<class ValueType, class Compare, class Allocator>
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::ConstIterator(const Node* node) noexcept
+    : m_node(node)
+{
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::reference
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::operator*() const noexcept
+{
+    return m_node->value();
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::pointer
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::operator->() const noexcept
 {
-    delete m_root;
+    return &m_node->value();
 }
 
-template<class ValueType>
-void Ishiko::RedBlackTree<ValueType>::insert(const ValueType& value)
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator&
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::operator++() noexcept
 {
+    m_node = m_node->nextNode();
+    return *this;
 }
 
-template<class ValueType>
-size_t Ishiko::RedBlackTree<ValueType>::size() const noexcept
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::operator++(int) noexcept
+{
+    ConstIterator result = *this;
+    m_node = m_node->nextNode();
+    return result;
+}
+
+template<class ValueType, class Compare, class Allocator>
+bool Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::operator==(
+    const ConstIterator& other) const noexcept
+{
+    return (m_node == other.m_node);
+}
+
+template<class ValueType, class Compare, class Allocator>
+bool Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::operator!=(
+    const ConstIterator& other) const noexcept
+{
+    return (m_node != other.m_node);
+}
+
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator::node() const noexcept
+{
+    return m_node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::RedBlackTree(const Compare& compare)
+    : m_compare(compare)
+{
+}
+
+template<class ValueType, class Compare, class Allocator>
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::~RedBlackTree() noexcept
+{
+    clear();
+}
+
+template<class ValueType, class Compare, class Allocator>
+bool Ishiko::RedBlackTree<ValueType, Compare, Allocator>::isEmpty() const noexcept
+{
+    return (m_root == nullptr);
+}
+
+template<class ValueType, class Compare, class Allocator>
+size_t Ishiko::RedBlackTree<ValueType, Compare, Allocator>::size() const noexcept
 {
     return m_size;
 }
 
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::root() const noexcept
+{
+    return m_root;
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::begin() const noexcept
+{
+    return ConstIterator(m_root ? LeftmostNode(m_root) : nullptr);
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::ConstIterator
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::end() const noexcept
+{
+    return ConstIterator();
+}
+
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::find(const ValueType& value) const noexcept
+{
+    return const_cast<RedBlackTree*>(this)->find(value);
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::find(const ValueType& value) noexcept
+{
+    Node* node = lowerBound(value);
+    if (node && !m_compare(value, node->m_value))
+    {
+        return node;
+    }
+    return nullptr;
+}
+
+template<class ValueType, class Compare, class Allocator>
+bool Ishiko::RedBlackTree<ValueType, Compare, Allocator>::contains(const ValueType& value) const noexcept
+{
+    return (find(value) != nullptr);
+}
+
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::lowerBound(const ValueType& value) const noexcept
+{
+    return const_cast<RedBlackTree*>(this)->lowerBound(value);
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::lowerBound(const ValueType& value) noexcept
+{
+    Node* result = nullptr;
+    Node* node = m_root;
+    while (node)
+    {
+        if (m_compare(node->m_value, value))
+        {
+            node = node->m_right_child_node;
+        }
+        else
+        {
+            result = node;
+            node = node->m_left_child_node;
+        }
+    }
+    return result;
+}
+
+template<class ValueType, class Compare, class Allocator>
+const typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::upperBound(const ValueType& value) const noexcept
+{
+    return const_cast<RedBlackTree*>(this)->upperBound(value);
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::upperBound(const ValueType& value) noexcept
+{
+    Node* result = nullptr;
+    Node* node = m_root;
+    while (node)
+    {
+        if (m_compare(value, node->m_value))
+        {
+            result = node;
+            node = node->m_left_child_node;
+        }
+        else
+        {
+            node = node->m_right_child_node;
+        }
+    }
+    return result;
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::insert(const ValueType& value)
+{
+    return insertValue(value);
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::insert(ValueType&& value)
+{
+    return insertValue(std::move(value));
+}
+
+template<class ValueType, class Compare, class Allocator>
+template<class... Arguments>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::emplace(Arguments&&... arguments)
+{
+    Node* new_node = createNode(nullptr, std::forward<Arguments>(arguments)...);
+    Node* parent_node;
+    Node** link = findLink(new_node->m_value, parent_node);
+    if (!link)
+    {
+        destroyNode(new_node);
+        return parent_node;
+    }
+    new_node->setParentNode(parent_node);
+    linkNode(new_node, link);
+    return new_node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+bool Ishiko::RedBlackTree<ValueType, Compare, Allocator>::erase(const ValueType& value) noexcept
+{
+    Node* node = find(value);
+    if (!node)
+    {
+        return false;
+    }
+    erase(node);
+    return true;
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::erase(Node* node) noexcept
+{
+    // The node that takes the place of the removed one and its parent, needed because it may be nullptr
+    Node* replacement_node;
+    Node* replacement_parent_node;
+    bool removed_black;
+
+    if (!node->m_left_child_node || !node->m_right_child_node)
+    {
+        replacement_node = (node->m_left_child_node ? node->m_left_child_node : node->m_right_child_node);
+        replacement_parent_node = node->parentNode();
+        removed_black = node->isBlack();
+        replaceSubtree(node, replacement_node);
+    }
+    else
+    {
+        // Move the successor, which has no left child, into the place of the node
+        Node* successor_node = LeftmostNode(node->m_right_child_node);
+        replacement_node = successor_node->m_right_child_node;
+        removed_black = successor_node->isBlack();
+        if (successor_node->parentNode() == node)
+        {
+            replacement_parent_node = successor_node;
+        }
+        else
+        {
+            replacement_parent_node = successor_node->parentNode();
+            replaceSubtree(successor_node, replacement_node);
+            successor_node->m_right_child_node = node->m_right_child_node;
+            successor_node->m_right_child_node->setParentNode(successor_node);
+        }
+        replaceSubtree(node, successor_node);
+        successor_node->m_left_child_node = node->m_left_child_node;
+        successor_node->m_left_child_node->setParentNode(successor_node);
+        successor_node->copyColor(*node);
+    }
+
+    destroyNode(node);
+    --m_size;
+
+    if (removed_black)
+    {
+        fixAfterErase(replacement_node, replacement_parent_node);
+    }
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::clear() noexcept
+{
+    ClearNodes<ValueType>(m_allocator,
+        [this]()
+        {
+            // The parent pointers make a post-order walk possible without a stack
+            Node* node = m_root;
+            while (node)
+            {
+                if (node->m_left_child_node)
+                {
+                    node = node->m_left_child_node;
+                }
+                else if (node->m_right_child_node)
+                {
+                    node = node->m_right_child_node;
+                }
+                else
+                {
+                    Node* parent_node = node->parentNode();
+                    if (parent_node)
+                    {
+                        if (parent_node->m_left_child_node == node)
+                        {
+                            parent_node->m_left_child_node = nullptr;
+                        }
+                        else
+                        {
+                            parent_node->m_right_child_node = nullptr;
+                        }
+                    }
+                    destroyNode(node);
+                    node = parent_node;
+                }
+            }
+        },
+        [this]()
+        {
+            m_root = nullptr;
+            m_size = 0;
+        });
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::reserve(size_t count)
+{
+    m_allocator.reserve(count, sizeof(Node));
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::reserve(size_t count, Error& error) noexcept
+{
+    m_allocator.reserve(count, sizeof(Node), error);
+}
+
+template<class ValueType, class Compare, class Allocator>
+Ishiko::ContainerStatistics Ishiko::RedBlackTree<ValueType, Compare, Allocator>::statistics() const
+{
+    ContainerStatistics statistics;
+    AddTreeStatistics(m_root, sizeof(Node), statistics);
+    AddAllocationStatistics(m_allocator, statistics);
+    return statistics;
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::LeftmostNode(Node* node) noexcept
+{
+    while (node->m_left_child_node)
+    {
+        node = node->m_left_child_node;
+    }
+    return node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::rotateLeft(Node* node) noexcept
+{
+    Node* right_node = node->m_right_child_node;
+    node->m_right_child_node = right_node->m_left_child_node;
+    if (right_node->m_left_child_node)
+    {
+        right_node->m_left_child_node->setParentNode(node);
+    }
+    replaceSubtree(node, right_node);
+    right_node->m_left_child_node = node;
+    node->setParentNode(right_node);
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::rotateRight(Node* node) noexcept
+{
+    Node* left_node = node->m_left_child_node;
+    node->m_left_child_node = left_node->m_right_child_node;
+    if (left_node->m_right_child_node)
+    {
+        left_node->m_right_child_node->setParentNode(node);
+    }
+    replaceSubtree(node, left_node);
+    left_node->m_right_child_node = node;
+    node->setParentNode(left_node);
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::replaceSubtree(Node* node, Node* replacement_node) noexcept
+{
+    Node* parent_node = node->parentNode();
+    if (!parent_node)
+    {
+        m_root = replacement_node;
+    }
+    else if (parent_node->m_left_child_node == node)
+    {
+        parent_node->m_left_child_node = replacement_node;
+    }
+    else
+    {
+        parent_node->m_right_child_node = replacement_node;
+    }
+    if (replacement_node)
+    {
+        replacement_node->setParentNode(parent_node);
+    }
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::fixAfterInsert(Node* node) noexcept
+{
+    Node* parent_node = node->parentNode();
+    while (parent_node && parent_node->isRed())
+    {
+        // The parent is red so it isn't the root and the grandparent exists
+        Node* grandparent_node = parent_node->parentNode();
+        if (parent_node == grandparent_node->m_left_child_node)
+        {
+            Node* uncle_node = grandparent_node->m_right_child_node;
+            if (uncle_node && uncle_node->isRed())
+            {
+                parent_node->setBlack();
+                uncle_node->setBlack();
+                grandparent_node->setRed();
+                node = grandparent_node;
+                parent_node = node->parentNode();
+                continue;
+            }
+            if (node == parent_node->m_right_child_node)
+            {
+                rotateLeft(parent_node);
+                node = parent_node;
+                parent_node = node->parentNode();
+            }
+            parent_node->setBlack();
+            grandparent_node->setRed();
+            rotateRight(grandparent_node);
+        }
+        else
+        {
+            Node* uncle_node = grandparent_node->m_left_child_node;
+            if (uncle_node && uncle_node->isRed())
+            {
+                parent_node->setBlack();
+                uncle_node->setBlack();
+                grandparent_node->setRed();
+                node = grandparent_node;
+                parent_node = node->parentNode();
+                continue;
+            }
+            if (node == parent_node->m_left_child_node)
+            {
+                rotateRight(parent_node);
+                node = parent_node;
+                parent_node = node->parentNode();
+            }
+            parent_node->setBlack();
+            grandparent_node->setRed();
+            rotateLeft(grandparent_node);
+        }
+        break;
+    }
+    m_root->setBlack();
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::fixAfterErase(Node* node, Node* parent_node) noexcept
+{
+    // The path through node is one black node short. The sibling can't be nullptr since its side of the tree has a
+    // black height of at least 1.
+    while ((node != m_root) && (!node || node->isBlack()))
+    {
+        if (node == parent_node->m_left_child_node)
+        {
+            Node* sibling_node = parent_node->m_right_child_node;
+            if (sibling_node->isRed())
+            {
+                sibling_node->setBlack();
+                parent_node->setRed();
+                rotateLeft(parent_node);
+                sibling_node = parent_node->m_right_child_node;
+            }
+            if ((!sibling_node->m_left_child_node || sibling_node->m_left_child_node->isBlack())
+                && (!sibling_node->m_right_child_node || sibling_node->m_right_child_node->isBlack()))
+            {
+                sibling_node->setRed();
+                node = parent_node;
+                parent_node = node->parentNode();
+            }
+            else
+            {
+                if (!sibling_node->m_right_child_node || sibling_node->m_right_child_node->isBlack())
+                {
+                    sibling_node->m_left_child_node->setBlack();
+                    sibling_node->setRed();
+                    rotateRight(sibling_node);
+                    sibling_node = parent_node->m_right_child_node;
+                }
+                sibling_node->copyColor(*parent_node);
+                parent_node->setBlack();
+                sibling_node->m_right_child_node->setBlack();
+                rotateLeft(parent_node);
+                node = m_root;
+            }
+        }
+        else
+        {
+            Node* sibling_node = parent_node->m_left_child_node;
+            if (sibling_node->isRed())
+            {
+                sibling_node->setBlack();
+                parent_node->setRed();
+                rotateRight(parent_node);
+                sibling_node = parent_node->m_left_child_node;
+            }
+            if ((!sibling_node->m_left_child_node || sibling_node->m_left_child_node->isBlack())
+                && (!sibling_node->m_right_child_node || sibling_node->m_right_child_node->isBlack()))
+            {
+                sibling_node->setRed();
+                node = parent_node;
+                parent_node = node->parentNode();
+            }
+            else
+            {
+                if (!sibling_node->m_left_child_node || sibling_node->m_left_child_node->isBlack())
+                {
+                    sibling_node->m_right_child_node->setBlack();
+                    sibling_node->setRed();
+                    rotateLeft(sibling_node);
+                    sibling_node = parent_node->m_left_child_node;
+                }
+                sibling_node->copyColor(*parent_node);
+                parent_node->setBlack();
+                sibling_node->m_left_child_node->setBlack();
+                rotateRight(parent_node);
+                node = m_root;
+            }
+        }
+    }
+    if (node)
+    {
+        node->setBlack();
+    }
+}
+
+template<class ValueType, class Compare, class Allocator>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node**
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::findLink(const ValueType& value, Node*& parent_node) noexcept
+{
+    // One comparison per level, the only node that can be equal to value is the last one we went left at
+    parent_node = nullptr;
+    Node* lower_bound_node = nullptr;
+    Node** link = &m_root;
+    while (*link)
+    {
+        parent_node = *link;
+        if (m_compare(parent_node->m_value, value))
+        {
+            link = &parent_node->m_right_child_node;
+        }
+        else
+        {
+            lower_bound_node = parent_node;
+            link = &parent_node->m_left_child_node;
+        }
+    }
+    if (lower_bound_node && !m_compare(value, lower_bound_node->m_value))
+    {
+        parent_node = lower_bound_node;
+        return nullptr;
+    }
+    return link;
+}
+
+template<class ValueType, class Compare, class Allocator>
+template<class Value>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::insertValue(Value&& value)
+{
+    Node* parent_node;
+    Node** link = findLink(value, parent_node);
+    if (!link)
+    {
+        return parent_node;
+    }
+    Node* new_node = createNode(parent_node, std::forward<Value>(value));
+    linkNode(new_node, link);
+    return new_node;
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::linkNode(Node* node, Node** link) noexcept
+{
+    *link = node;
+    ++m_size;
+    fixAfterInsert(node);
+}
+
+template<class ValueType, class Compare, class Allocator>
+template<class... Arguments>
+typename Ishiko::RedBlackTree<ValueType, Compare, Allocator>::Node*
+Ishiko::RedBlackTree<ValueType, Compare, Allocator>::createNode(Node* parent_node, Arguments&&... arguments)
+{
+    void* memory = m_allocator.allocate(sizeof(Node));
+    try
+    {
+        return new(memory) Node(parent_node, std::forward<Arguments>(arguments)...);
+    }
+    catch (...)
+    {
+        m_allocator.deallocate(memory, sizeof(Node));
+        throw;
+    }
+}
+
+template<class ValueType, class Compare, class Allocator>
+void Ishiko::RedBlackTree<ValueType, Compare, Allocator>::destroyNode(Node* node) noexcept
+{
+    node->~Node();
+    m_allocator.deallocate(node, sizeof(Node));
+}
+
 #endif
@@ -4,15 +4,23 @@
 #ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_SINGLYLINKEDLIST_HPP
 #define GUARD_ISHIKO_CPP_DATASTRUCTURES_SINGLYLINKEDLIST_HPP
 
+#include "ContainerStatistics.hpp"
 #include "DataStructuresErrorCategory.hpp"
 #include "DataTypeTraits.hpp"
+#include "InPlace.hpp"
+#include "NewDeleteAllocator.hpp"
+#include "NodeDeletion.hpp"
 #include "SinglyLinkedListBase.hpp"
 #include <Ishiko/Errors.hpp>
-#include <Ishiko/Memory.hpp>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace Ishiko
 {
-    template<typename DataType, typename DataTypeTraits = DataTypeTraits<DataType>>
+    // Allocator is the node allocator, see NewDeleteAllocator.
+    template<typename DataType, typename DataTypeTraits = DataTypeTraits<DataType>,
+        typename Allocator = NewDeleteAllocator>
     class SinglyLinkedList
     {
     public:
@@ -20,8 +28,11 @@ namespace Ishiko
         {
         public:
             Node(const DataType& data);
+            Node(DataType&& data);
             Node(const DataType& data, Error& error) noexcept;
-            ~Node() noexcept;
+            Node(DataType&& data, Error& error) noexcept;
+            template<typename... Arguments>
+            Node(InPlace, Arguments&&... arguments);
 
             const Node* nextNode() const noexcept;
             Node* nextNode() noexcept;
@@ -35,8 +46,11 @@ namespace Ishiko
             DataType m_data;
         };
 
+        // The number of nodes whose data each task of the parallel clear destroys
+        static const size_t default_grain_size = 1024;
+
         SinglyLinkedList() noexcept = default;
-        ~SinglyLinkedList() noexcept = default;
+        ~SinglyLinkedList() noexcept;
 
         bool isEmpty() const noexcept;
         Node* head() noexcept;
@@ -45,86 +59,131 @@ namespace Ishiko
         void traverse(Callable&& callable) const;
 
         void setHead(const DataType& data);
+        void setHead(DataType&& data);
         void setHead(const DataType& data, Error& error) noexcept;
+        void setHead(DataType&& data, Error& error) noexcept;
         Node* insert(const DataType& data, Node* previous_node);
+        Node* insert(DataType&& data, Node* previous_node);
+        // Inserts a node after previous_node whose data is constructed in place from arguments
+        template<typename... Arguments>
+        Node* emplace(Node* previous_node, Arguments&&... arguments);
+        void clear() noexcept;
+        // Same as clear but the values are destroyed on the threads of pool, see ClearNodes
+        void clear(WorkStealingPool& pool, size_t grain_size = default_grain_size) noexcept;
+
+        // Makes sure count nodes can be inserted without the allocator needing more memory from the system
+        void reserve(size_t count);
+        void reserve(size_t count, Error& error) noexcept;
+
+        // Visits every node to compute a snapshot of the memory the list holds, see ContainerStatistics
+        ContainerStatistics statistics() const;
 
     private:
+        template<typename... Arguments>
+        Node* createNode(Arguments&&... arguments);
+        template<typename Data>
+        Node* createNode(Data&& data, Error& error) noexcept;
+        void destroyNode(Node* node) noexcept;
+
         SinglyLinkedListBase<Node> m_list_impl;
+        Allocator m_allocator;
     };
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node::Node(const DataType& data)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const size_t Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::default_grain_size;
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(const DataType& data)
     : m_data(data)
 {
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node::Node(const DataType& data, Error& error) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(DataType&& data)
+    : m_data(std::move(data))
+{
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(const DataType& data, Error& error) noexcept
     : m_data(DataTypeTraits::Copy(data, error))
 {
 }
 
-template<typename DataType, typename DataTypeTraits>
-Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node::~Node() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(DataType&& data, Error& error) noexcept
+    : m_data(DataTypeTraits::Move(std::move(data), error))
+{
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::Node(InPlace, Arguments&&... arguments)
+    : m_data(std::forward<Arguments>(arguments)...)
 {
-    delete m_next_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-const typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node::nextNode() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::nextNode() const noexcept
 {
     return m_next_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node::nextNode() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::nextNode() noexcept
 {
     return m_next_node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node::setNextNode(Node* node) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::setNextNode(Node* node) noexcept
 {
     m_next_node = node;
 }
 
-template<typename DataType, typename DataTypeTraits>
-const DataType& Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node::data() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+const DataType& Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::data() const noexcept
 {
     return m_data;
 }
 
-template<typename DataType, typename DataTypeTraits>
-DataType& Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node::data() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+DataType& Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node::data() noexcept
 {
     return m_data;
 }
 
-template<typename DataType, typename DataTypeTraits>
-bool Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::isEmpty() const noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::~SinglyLinkedList() noexcept
+{
+    clear();
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+bool Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::isEmpty() const noexcept
 {
     return m_list_impl.isEmpty();
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::head() noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::head() noexcept
 {
     return m_list_impl.head();
 }
 
-template<typename DataType, typename DataTypeTraits>
+template<typename DataType, typename DataTypeTraits, typename Allocator>
 template<typename Callable>
-void Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::traverse(Callable&& callable) const
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::traverse(Callable&& callable) const
 {
     m_list_impl.traverse(std::forward<Callable>(callable));
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::setHead(const DataType& data)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::setHead(const DataType& data)
 {
     Node* head = m_list_impl.head();
     if (head)
@@ -133,12 +192,26 @@ void Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::setHead(const DataType&
     }
     else
     {
-        m_list_impl.setHead(new Node(data));
+        m_list_impl.setHead(createNode(data));
+    }
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::setHead(DataType&& data)
+{
+    Node* head = m_list_impl.head();
+    if (head)
+    {
+        head->data() = std::move(data);
+    }
+    else
+    {
+        m_list_impl.setHead(createNode(std::move(data)));
     }
 }
 
-template<typename DataType, typename DataTypeTraits>
-void Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::setHead(const DataType& data, Error& error) noexcept
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::setHead(const DataType& data, Error& error) noexcept
 {
     Node* head = m_list_impl.head();
     if (head)
@@ -147,21 +220,151 @@ void Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::setHead(const DataType&
     }
     else
     {
-        Node* new_head = NewObject<Node>(error, data, error);
-        if (!error)
+        Node* new_head = createNode(data, error);
+        if (new_head)
+        {
+            m_list_impl.setHead(new_head);
+        }
+    }
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::setHead(DataType&& data, Error& error) noexcept
+{
+    Node* head = m_list_impl.head();
+    if (head)
+    {
+        head->data() = std::move(data);
+    }
+    else
+    {
+        Node* new_head = createNode(std::move(data), error);
+        if (new_head)
         {
             m_list_impl.setHead(new_head);
         }
     }
 }
 
-template<typename DataType, typename DataTypeTraits>
-typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::Node*
-Ishiko::SinglyLinkedList<DataType, DataTypeTraits>::insert(const DataType& data, Node* previous_node)
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::insert(const DataType& data, Node* previous_node)
+{
+    return emplace(previous_node, data);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::insert(DataType&& data, Node* previous_node)
 {
-    Node* new_node = new Node(data);
+    return emplace(previous_node, std::move(data));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::emplace(Node* previous_node, Arguments&&... arguments)
+{
+    Node* new_node = createNode(std::forward<Arguments>(arguments)...);
     m_list_impl.insert(new_node, previous_node);
     return new_node;
 }
 
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::clear() noexcept
+{
+    ClearNodes<Node>(m_allocator, [this]() { m_list_impl.clear([this](Node* node) { destroyNode(node); }); },
+        [this]() { m_list_impl.setHead(nullptr); });
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::clear(WorkStealingPool& pool,
+    size_t grain_size) noexcept
+{
+    if (pool.workerCount() == 0)
+    {
+        clear();
+        return;
+    }
+
+    // Once their data has been destroyed the nodes don't need to be destroyed, only deallocated
+    ClearNodes<Node>(m_allocator,
+        [this, &pool, grain_size]()
+        {
+            DestroyNodeListValues(pool, m_list_impl.head(), grain_size,
+                [](Node* node) { node->data().~DataType(); });
+        },
+        [this]() { m_list_impl.clear([this](Node* node) { m_allocator.deallocate(node, sizeof(Node)); }); },
+        [this]() { m_list_impl.setHead(nullptr); });
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::reserve(size_t count)
+{
+    m_allocator.reserve(count, sizeof(Node));
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::reserve(size_t count, Error& error) noexcept
+{
+    m_allocator.reserve(count, sizeof(Node), error);
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+Ishiko::ContainerStatistics Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::statistics() const
+{
+    ContainerStatistics statistics;
+    m_list_impl.traverse(
+        [&statistics](const DataType&)
+        {
+            ++statistics.element_count;
+            statistics.element_bytes += sizeof(Node);
+        });
+    AddAllocationStatistics(m_allocator, statistics);
+    return statistics;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::createNode(Arguments&&... arguments)
+{
+    void* memory = m_allocator.allocate(sizeof(Node));
+    try
+    {
+        return new(memory) Node(InPlace(), std::forward<Arguments>(arguments)...);
+    }
+    catch (...)
+    {
+        m_allocator.deallocate(memory, sizeof(Node));
+        throw;
+    }
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+template<typename Data>
+typename Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::Node*
+Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::createNode(Data&& data, Error& error) noexcept
+{
+    void* memory = m_allocator.allocate(sizeof(Node), error);
+    if (!memory)
+    {
+        return nullptr;
+    }
+    Node* node = new(memory) Node(std::forward<Data>(data), error);
+    if (error)
+    {
+        destroyNode(node);
+        return nullptr;
+    }
+    return node;
+}
+
+template<typename DataType, typename DataTypeTraits, typename Allocator>
+void Ishiko::SinglyLinkedList<DataType, DataTypeTraits, Allocator>::destroyNode(Node* node) noexcept
+{
+    node->~Node();
+    m_allocator.deallocate(node, sizeof(Node));
+}
+
 #endif
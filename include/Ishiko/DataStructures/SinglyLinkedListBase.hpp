@@ -4,22 +4,34 @@
 #ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_SINGLYLINKEDLISTBASE_HPP
 #define GUARD_ISHIKO_CPP_DATASTRUCTURES_SINGLYLINKEDLISTBASE_HPP
 
+#include "NodeDeletion.hpp"
+#include <utility>
+
 namespace Ishiko
 {
+    // The linking logic of a singly linked list. The base doesn't own the nodes, the list using it decides how they
+    // are allocated and destroyed.
     template<class Node>
     class SinglyLinkedListBase
     {
     public:
-        ~SinglyLinkedListBase() noexcept;
-
         bool isEmpty() const noexcept;
+        const Node* head() const noexcept;
         Node* head() noexcept;
 
         template<typename Callable>
         void traverse(Callable&& callable) const;
 
         void setHead(Node* node) noexcept;
+        void pushFront(Node* new_node) noexcept;
         void insert(Node* new_node, Node* previous_node);
+        // Unlinks the first node and returns it, or returns nullptr if the list is empty
+        Node* popFront() noexcept;
+        // Unlinks the node after previous_node and returns it, or returns nullptr if previous_node is the last node
+        Node* removeAfter(Node* previous_node) noexcept;
+        // Unlinks all the nodes and passes each of them to deleter
+        template<typename Deleter>
+        void clear(Deleter&& deleter) noexcept;
 
     private:
         Node* m_head = nullptr;
@@ -27,15 +39,15 @@ namespace Ishiko
 }
 
 template<class Node>
-Ishiko::SinglyLinkedListBase<Node>::~SinglyLinkedListBase() noexcept
+bool Ishiko::SinglyLinkedListBase<Node>::isEmpty() const noexcept
 {
-    delete m_head;
+    return (m_head == nullptr);
 }
 
 template<class Node>
-bool Ishiko::SinglyLinkedListBase<Node>::isEmpty() const noexcept
+const Node* Ishiko::SinglyLinkedListBase<Node>::head() const noexcept
 {
-    return (m_head == nullptr);
+    return m_head;
 }
 
 template<class Node>
@@ -62,6 +74,13 @@ void Ishiko::SinglyLinkedListBase<Node>::setHead(Node* node) noexcept
     m_head = node;
 }
 
+template<class Node>
+void Ishiko::SinglyLinkedListBase<Node>::pushFront(Node* new_node) noexcept
+{
+    new_node->setNextNode(m_head);
+    m_head = new_node;
+}
+
 
 template<typename Node>
 void Ishiko::SinglyLinkedListBase<Node>::insert(Node* new_node, Node* previous_node)
@@ -70,4 +89,36 @@ void Ishiko::SinglyLinkedListBase<Node>::insert(Node* new_node, Node* previous_n
     previous_node->setNextNode(new_node);
 }
 
+template<class Node>
+Node* Ishiko::SinglyLinkedListBase<Node>::popFront() noexcept
+{
+    Node* node = m_head;
+    if (node)
+    {
+        m_head = node->nextNode();
+        node->setNextNode(nullptr);
+    }
+    return node;
+}
+
+template<class Node>
+Node* Ishiko::SinglyLinkedListBase<Node>::removeAfter(Node* previous_node) noexcept
+{
+    Node* node = previous_node->nextNode();
+    if (node)
+    {
+        previous_node->setNextNode(node->nextNode());
+        node->setNextNode(nullptr);
+    }
+    return node;
+}
+
+template<typename Node>
+template<typename Deleter>
+void Ishiko::SinglyLinkedListBase<Node>::clear(Deleter&& deleter) noexcept
+{
+    DeleteNodeList(m_head, std::forward<Deleter>(deleter));
+    m_head = nullptr;
+}
+
 #endif
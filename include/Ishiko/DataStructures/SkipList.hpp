@@ -4,199 +4,999 @@
 #ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_SKIPLIST_HPP
 #define GUARD_ISHIKO_CPP_DATASTRUCTURES_SKIPLIST_HPP
 
-#include "SinglyLinkedListBase.hpp"
-#include <vector>
+#include "ContainerStatistics.hpp"
+#include "GeometricLevelGenerator.hpp"
+#include "NewDeleteAllocator.hpp"
+#include "NodeDeletion.hpp"
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace Ishiko
 {
-    template<typename DataType>
+    // An ordered set. Elements are ordered by Compare, which must be a strict weak ordering. LevelGenerator is called
+    // with no arguments to draw the height of each new node and can be a function pointer or a function object.
+    // Allocator is the node allocator, see NewDeleteAllocator.
+    template<typename DataType, typename Compare = std::less<DataType>,
+        typename LevelGenerator = GeometricLevelGenerator<>, typename Allocator = NewDeleteAllocator>
     class SkipList
     {
     public:
+        // The maximum number of levels a node can have. Levels returned by the level generator are capped to this
+        // value.
+        static const size_t max_levels = 32;
+        // The number of nodes whose data each task of the parallel clear destroys
+        static const size_t default_grain_size = 1024;
+
+        // A node and its tower of forward pointers are allocated as a single block. The tower is stored right after
+        // the node and its size is fixed when the node is created.
         class Node
         {
         public:
-            Node(const DataType& data) noexcept;
-            ~Node() noexcept;
+            Node(const Node& other) = delete;
+            Node& operator=(const Node& other) = delete;
 
             const Node* nextNode() const noexcept;
             Node* nextNode() noexcept;
             void setNextNode(Node* node) noexcept;
+            const Node* nextNode(size_t level) const noexcept;
+            Node* nextNode(size_t level) noexcept;
+            void setNextNode(size_t level, Node* node) noexcept;
+            size_t levels() const noexcept;
 
             const DataType& data() const noexcept;
             DataType& data() noexcept;
 
+        private:
+            friend class SkipList;
+
+            // The data is constructed from arguments
+            template<typename... Arguments>
+            Node(size_t levels, Arguments&&... arguments);
+            ~Node() noexcept = default;
+
+            // The size of the block holding a node and its tower
+            static size_t Size(size_t levels) noexcept;
+            template<typename... Arguments>
+            static Node* Create(Allocator& allocator, size_t levels, Arguments&&... arguments);
+            static void Destroy(Allocator& allocator, Node* node) noexcept;
+
+            Node* const* tower() const noexcept;
+            Node** tower() noexcept;
+
+            size_t m_levels;
+            DataType m_data;
+        };
+
+        // The result of a search. For each level it holds the last node whose data is less than or equal to the
+        // searched data, or nullptr if there is no such node in which case the head of the list is the predecessor at
+        // that level. The storage is fixed so a search never allocates.
+        class SearchPath
+        {
         public:
-            std::vector<Node*> m_next_nodes;
+            size_t size() const noexcept;
+            Node* operator[](size_t level) const noexcept;
 
         private:
-            DataType m_data;
+            friend class SkipList;
+
+            Node* m_previous_nodes[max_levels];
+            size_t m_size = 0;
         };
 
-        SkipList(size_t (*get_random_level)()) noexcept;
-        ~SkipList() noexcept = default;
+        // A forward iterator over the elements in order. The elements can't be modified through it since that could
+        // break the ordering.
+        class ConstIterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef DataType value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const DataType* pointer;
+            typedef const DataType& reference;
+
+            ConstIterator() noexcept = default;
+            explicit ConstIterator(const Node* node) noexcept;
+
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+            ConstIterator& operator++() noexcept;
+            ConstIterator operator++(int) noexcept;
+            bool operator==(const ConstIterator& other) const noexcept;
+            bool operator!=(const ConstIterator& other) const noexcept;
+
+            // The node the iterator points to, which can be used as a finger for the next search
+            const Node* node() const noexcept;
+
+        private:
+            const Node* m_node = nullptr;
+        };
+
+        // How the bulk load constructor picks the height of the nodes.
+        enum class BulkLoadHeights
+        {
+            // The heights are drawn from the level generator, as insert does.
+            sampled,
+            // Node i (counting from 1) gets 1 + the number of trailing zero bits of i so that every level has half as
+            // many nodes as the one below it, which gives the best search times for the initial content.
+            deterministic
+        };
+
+        explicit SkipList(const LevelGenerator& level_generator = LevelGenerator(),
+            const Compare& compare = Compare());
+        // Builds the list from the range [first, last), which must be sorted. Consecutive equal elements are only
+        // inserted once. The nodes are linked in a single pass without any searching. If the range is at least a
+        // forward range the memory for the nodes is reserved up front, see reserve.
+        template<typename InputIterator>
+        SkipList(InputIterator first, InputIterator last, BulkLoadHeights heights = BulkLoadHeights::sampled);
+        template<typename InputIterator>
+        SkipList(const LevelGenerator& level_generator, InputIterator first, InputIterator last,
+            BulkLoadHeights heights = BulkLoadHeights::sampled, const Compare& compare = Compare());
+        SkipList(const SkipList& other) = delete;
+        SkipList& operator=(const SkipList& other) = delete;
+        ~SkipList() noexcept;
 
         bool isEmpty() const noexcept;
         Node* head() noexcept;
+        ConstIterator begin() const noexcept;
+        ConstIterator end() const noexcept;
 
-        std::vector<Node*> find(const DataType& data) noexcept;
+        SearchPath find(const DataType& data) noexcept;
+        bool contains(const DataType& data) const noexcept;
+        Node* lowerBound(const DataType& data) noexcept;
+        // Finger search: finds the first node whose data is not less than data starting from finger rather than from
+        // the head of the list. The finger must be a node of this list, typically the result of the previous search.
+        // For data that is d elements past the finger this takes O(log d) rather than O(log n). If data comes before
+        // the finger the search starts from the head instead.
+        Node* lowerBound(const DataType& data, const Node* finger) noexcept;
+        Node* upperBound(const DataType& data) noexcept;
+
+        // Calls callback with each element in the range [from, to) in order. The callback returns false to stop the
+        // scan early. Returns the number of elements the callback was called with.
+        template<typename Callback>
+        size_t scan(const DataType& from, const DataType& to, Callback&& callback) const;
 
         Node* insert(const DataType& data);
+        Node* insert(DataType&& data);
+        // Same as insert but the element is constructed in place from arguments. Since the element is needed to find
+        // where it goes it is always constructed, and destroyed again if the list already contains an equal element.
+        template<typename... Arguments>
+        Node* emplace(Arguments&&... arguments);
+        // Returns false if the list doesn't contain an element equal to data.
+        bool erase(const DataType& data) noexcept;
+        // Erases the elements in the range [first, last) and returns how many were erased.
+        size_t erase(const DataType& first, const DataType& last) noexcept;
+        void clear() noexcept;
+        // Same as clear but the values are destroyed on the threads of pool, see ClearNodes
+        void clear(WorkStealingPool& pool, size_t grain_size = default_grain_size) noexcept;
+
+        // Erased nodes are kept in free lists, one per height, and reused by insert. This returns the memory held by
+        // the free lists to the allocator.
+        void shrinkToFit() noexcept;
+
+        // Makes sure count nodes can be inserted without the allocator needing more memory from the system. The
+        // heights of the nodes aren't known in advance so this assumes towers of 2 levels, the average for the
+        // default level generator.
+        void reserve(size_t count);
+        void reserve(size_t count, Error& error) noexcept;
+
+        // Visits every node, and the nodes kept for reuse, to compute a snapshot of the memory the list holds, see
+        // ContainerStatistics
+        ContainerStatistics statistics() const;
 
     private:
-        SinglyLinkedListBase<Node> m_list_impl;
-        size_t (*m_get_random_level)() = nullptr;
+        template<typename InputIterator>
+        void bulkLoad(InputIterator first, InputIterator last, BulkLoadHeights heights);
+        // Reserves room for the nodes of [first, last) if the range can be traversed twice
+        template<typename InputIterator>
+        void reserveRange(InputIterator first, InputIterator last, std::input_iterator_tag) noexcept;
+        template<typename ForwardIterator>
+        void reserveRange(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+        // Fills previous_links with, for each level in use, the forward pointer that points to the first node whose
+        // data is not less than data.
+        void findPreviousLinks(const DataType& data, Node*** previous_links) noexcept;
+        template<typename Data>
+        Node* insertData(Data&& data);
+        // Links new_node in after the nodes of previous_nodes
+        void linkNode(Node* new_node, const SearchPath& previous_nodes) noexcept;
+        template<typename... Arguments>
+        Node* createNode(size_t levels, Arguments&&... arguments);
+        void recycleNode(Node* node) noexcept;
+        void shrinkLevels() noexcept;
+        size_t randomLevel() noexcept;
+
+        // The forward pointers of the head of the list. Unlike the towers of the nodes this has room for the maximum
+        // number of levels so it never needs to grow. Only the first m_levels entries can be non-null.
+        Node* m_head[max_levels];
+        size_t m_levels = 0;
+        // The free lists of erased nodes indexed by height - 1. A free node is raw memory whose first bytes hold the
+        // address of the next free node of the same height.
+        void* m_free_nodes[max_levels];
+        LevelGenerator m_level_generator;
+        Compare m_compare;
+        Allocator m_allocator;
     };
 }
 
-template<typename DataType>
-Ishiko::SkipList<DataType>::Node::Node(const DataType& data) noexcept
-    : m_data(data)
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+const size_t Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::max_levels;
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+const size_t Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::default_grain_size;
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename... Arguments>
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::Node(size_t levels, Arguments&&... arguments)
+    : m_levels(levels), m_data(std::forward<Arguments>(arguments)...)
 {
-    m_next_nodes.push_back(nullptr);
+    Node** next_nodes = tower();
+    for (size_t i = 0; i < levels; ++i)
+    {
+        next_nodes[i] = nullptr;
+    }
 }
 
-template<typename DataType>
-Ishiko::SkipList<DataType>::Node::~Node() noexcept
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+size_t Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::Size(size_t levels) noexcept
 {
-    delete m_next_nodes[0];
+    return (sizeof(Node) + (levels * sizeof(Node*)));
 }
 
-template<typename DataType>
-const typename Ishiko::SkipList<DataType>::Node* Ishiko::SkipList<DataType>::Node::nextNode() const noexcept
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::Create(Allocator& allocator, size_t levels,
+    Arguments&&... arguments)
 {
-    return m_next_nodes[0];
+    void* memory = allocator.allocate(Size(levels));
+    try
+    {
+        return new(memory) Node(levels, std::forward<Arguments>(arguments)...);
+    }
+    catch (...)
+    {
+        allocator.deallocate(memory, Size(levels));
+        throw;
+    }
 }
 
-template<typename DataType>
-typename Ishiko::SkipList<DataType>::Node* Ishiko::SkipList<DataType>::Node::nextNode() noexcept
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::Destroy(Allocator& allocator,
+    Node* node) noexcept
 {
-    return m_next_nodes[0];
+    size_t levels = node->levels();
+    node->~Node();
+    allocator.deallocate(node, Size(levels));
 }
 
-template<typename DataType>
-void Ishiko::SkipList<DataType>::Node::setNextNode(Node* node) noexcept
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+const typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::nextNode() const noexcept
 {
-    m_next_nodes[0] = node;
+    return tower()[0];
 }
 
-template<typename DataType>
-const DataType& Ishiko::SkipList<DataType>::Node::data() const noexcept
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::nextNode() noexcept
+{
+    return tower()[0];
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::setNextNode(Node* node) noexcept
+{
+    tower()[0] = node;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+const typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::nextNode(size_t level) const noexcept
+{
+    return tower()[level];
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::nextNode(size_t level) noexcept
+{
+    return tower()[level];
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::setNextNode(size_t level,
+    Node* node) noexcept
+{
+    tower()[level] = node;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+size_t Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::levels() const noexcept
+{
+    return m_levels;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+const DataType& Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::data() const noexcept
 {
     return m_data;
 }
 
-template<typename DataType>
-DataType& Ishiko::SkipList<DataType>::Node::data() noexcept
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+DataType& Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::data() noexcept
 {
     return m_data;
 }
 
-template<typename DataType>
-Ishiko::SkipList<DataType>::SkipList(size_t(*get_random_level)()) noexcept
-    : m_get_random_level(get_random_level)
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node* const*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::tower() const noexcept
 {
+    return reinterpret_cast<Node* const*>(this + 1);
 }
 
-template<typename DataType>
-bool Ishiko::SkipList<DataType>::isEmpty() const noexcept
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node**
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node::tower() noexcept
 {
-    return m_list_impl.isEmpty();
+    return reinterpret_cast<Node**>(this + 1);
 }
 
-template<typename DataType>
-typename Ishiko::SkipList<DataType>::Node* Ishiko::SkipList<DataType>::head() noexcept
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::ConstIterator(const Node* node) noexcept
+    : m_node(node)
 {
-    return m_list_impl.head();
 }
 
-template<typename DataType>
-std::vector<typename Ishiko::SkipList<DataType>::Node*> Ishiko::SkipList<DataType>::find(const DataType& data) noexcept
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::reference
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::operator*() const noexcept
 {
-    std::vector<Node*> previous_nodes;
+    return m_node->data();
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::pointer
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::operator->() const noexcept
+{
+    return &m_node->data();
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator&
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::operator++() noexcept
+{
+    m_node = m_node->nextNode();
+    return *this;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::operator++(int) noexcept
+{
+    ConstIterator result = *this;
+    m_node = m_node->nextNode();
+    return result;
+}
 
-    Node* head = m_list_impl.head();
-    if (head)
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+bool Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::operator==(
+    const ConstIterator& other) const noexcept
+{
+    return (m_node == other.m_node);
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+bool Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::operator!=(
+    const ConstIterator& other) const noexcept
+{
+    return (m_node != other.m_node);
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+const typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator::node() const noexcept
+{
+    return m_node;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+size_t Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::SearchPath::size() const noexcept
+{
+    return m_size;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::SearchPath::operator[](size_t level) const noexcept
+{
+    return m_previous_nodes[level];
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::SkipList(const LevelGenerator& level_generator,
+    const Compare& compare)
+    : m_level_generator(level_generator), m_compare(compare)
+{
+    for (size_t i = 0; i < max_levels; ++i)
+    {
+        m_head[i] = nullptr;
+        m_free_nodes[i] = nullptr;
+    }
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename InputIterator>
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::SkipList(InputIterator first, InputIterator last,
+    BulkLoadHeights heights)
+    : SkipList()
+{
+    // The delegating constructor has completed so if this throws the destructor frees the nodes created so far
+    bulkLoad(first, last, heights);
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename InputIterator>
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::SkipList(const LevelGenerator& level_generator,
+    InputIterator first, InputIterator last, BulkLoadHeights heights, const Compare& compare)
+    : SkipList(level_generator, compare)
+{
+    bulkLoad(first, last, heights);
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename InputIterator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::bulkLoad(InputIterator first, InputIterator last,
+    BulkLoadHeights heights)
+{
+    // The forward pointers of the last node linked at each level, which is where the next node at that level goes
+    Node** last_links[max_levels];
+    for (size_t i = 0; i < max_levels; ++i)
+    {
+        last_links[i] = &m_head[i];
+    }
+
+    reserveRange(first, last, typename std::iterator_traits<InputIterator>::iterator_category());
+
+    Node* last_node = nullptr;
+    size_t count = 0;
+    for (; first != last; ++first)
     {
-        size_t level = head->m_next_nodes.size() - 1;
-        Node* current_node = head;
-        while (true)
+        if (last_node && !m_compare(last_node->data(), *first))
         {
-            Node* next_node = current_node->m_next_nodes[level];
-            if (next_node && (next_node->data() <= data))
-            {
-                current_node = next_node;
-            }
-            else if (level == 0)
-            {
-                previous_nodes.insert(previous_nodes.begin(), current_node);
-                break;
-            }
-            else
+            continue;
+        }
+
+        size_t levels = 1;
+        if (heights == BulkLoadHeights::deterministic)
+        {
+            ++count;
+            for (size_t bits = count; ((bits & 1) == 0) && (levels < max_levels); bits >>= 1)
             {
-                previous_nodes.insert(previous_nodes.begin(), current_node);
-                --level;
+                ++levels;
             }
         }
+        else
+        {
+            levels = randomLevel();
+        }
+
+        last_node = Node::Create(m_allocator, levels, *first);
+        for (size_t i = 0; i < levels; ++i)
+        {
+            *last_links[i] = last_node;
+            last_links[i] = &last_node->tower()[i];
+        }
+        if (levels > m_levels)
+        {
+            m_levels = levels;
+        }
+    }
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename InputIterator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::reserveRange(InputIterator /*first*/,
+    InputIterator /*last*/, std::input_iterator_tag) noexcept
+{
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename ForwardIterator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::reserveRange(ForwardIterator first,
+    ForwardIterator last, std::forward_iterator_tag)
+{
+    // Duplicates are counted too so this may reserve a little more than needed
+    reserve(static_cast<size_t>(std::distance(first, last)));
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::~SkipList() noexcept
+{
+    clear();
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+bool Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::isEmpty() const noexcept
+{
+    return (m_head[0] == nullptr);
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::head() noexcept
+{
+    return m_head[0];
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::begin() const noexcept
+{
+    return ConstIterator(m_head[0]);
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::ConstIterator
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::end() const noexcept
+{
+    return ConstIterator();
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::SearchPath
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::find(const DataType& data) noexcept
+{
+    SearchPath previous_nodes;
+    previous_nodes.m_size = m_levels;
+
+    Node* current_node = nullptr;
+    Node* const* next_nodes = m_head;
+    for (size_t level = m_levels; level-- > 0;)
+    {
+        Node* next_node = next_nodes[level];
+        while (next_node && !m_compare(data, next_node->data()))
+        {
+            current_node = next_node;
+            next_nodes = current_node->tower();
+            next_node = next_nodes[level];
+        }
+        previous_nodes.m_previous_nodes[level] = current_node;
     }
 
     return previous_nodes;
 }
 
-template<typename DataType>
-typename Ishiko::SkipList<DataType>::Node* Ishiko::SkipList<DataType>::insert(const DataType& data)
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+bool Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::contains(const DataType& data) const noexcept
+{
+    Node* const* next_nodes = m_head;
+    for (size_t level = m_levels; level-- > 0;)
+    {
+        Node* next_node = next_nodes[level];
+        while (next_node && m_compare(next_node->data(), data))
+        {
+            next_nodes = next_node->tower();
+            next_node = next_nodes[level];
+        }
+        if (next_node && !m_compare(data, next_node->data()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::lowerBound(const DataType& data) noexcept
 {
-    Node* head = m_list_impl.head();
-    if (!head)
+    Node* const* next_nodes = m_head;
+    for (size_t level = m_levels; level-- > 0;)
     {
-        Node* new_node = new Node(data);
-        m_list_impl.setHead(new_node);
-        return new_node;
+        Node* next_node = next_nodes[level];
+        while (next_node && m_compare(next_node->data(), data))
+        {
+            next_nodes = next_node->tower();
+            next_node = next_nodes[level];
+        }
     }
-    else if (data < head->data())
+    return next_nodes[0];
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::lowerBound(const DataType& data,
+    const Node* finger) noexcept
+{
+    if (!finger || !m_compare(finger->data(), data))
     {
-        Node* new_node = new Node(data);
-        size_t levels = m_get_random_level();
-        if (levels > head->m_next_nodes.size())
+        return lowerBound(data);
+    }
+
+    // Move forward on the highest level that doesn't overshoot, climbing each time the current node is tall enough
+    // for its next node on the level above to still come before data
+    const Node* current_node = finger;
+    size_t level = 0;
+    while (true)
+    {
+        while (((level + 1) < current_node->levels()) && current_node->tower()[level + 1]
+            && m_compare(current_node->tower()[level + 1]->data(), data))
+        {
+            ++level;
+        }
+        Node* next_node = current_node->tower()[level];
+        if (!next_node || !m_compare(next_node->data(), data))
         {
-            m_list_impl.head()->m_next_nodes.resize(levels, nullptr);
+            break;
         }
+        current_node = next_node;
+    }
 
-        m_list_impl.setHead(new_node);
-        new_node->m_next_nodes = head->m_next_nodes;
+    // Then descend as a search from the head would
+    Node* const* next_nodes = current_node->tower();
+    for (++level; level-- > 0;)
+    {
+        Node* next_node = next_nodes[level];
+        while (next_node && m_compare(next_node->data(), data))
+        {
+            next_nodes = next_node->tower();
+            next_node = next_nodes[level];
+        }
+    }
+    return next_nodes[0];
+}
 
-        head->m_next_nodes.resize(levels);
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::upperBound(const DataType& data) noexcept
+{
+    Node* const* next_nodes = m_head;
+    for (size_t level = m_levels; level-- > 0;)
+    {
+        Node* next_node = next_nodes[level];
+        while (next_node && !m_compare(data, next_node->data()))
+        {
+            next_nodes = next_node->tower();
+            next_node = next_nodes[level];
+        }
+    }
+    return next_nodes[0];
+}
 
-        for (size_t i = 0; i < head->m_next_nodes.size(); ++i)
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename Callback>
+size_t Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::scan(const DataType& from, const DataType& to,
+    Callback&& callback) const
+{
+    Node* const* next_nodes = m_head;
+    for (size_t level = m_levels; level-- > 0;)
+    {
+        Node* next_node = next_nodes[level];
+        while (next_node && m_compare(next_node->data(), from))
         {
-            head->m_next_nodes[i] = new_node->m_next_nodes[i];
-            new_node->m_next_nodes[i] = head;
+            next_nodes = next_node->tower();
+            next_node = next_nodes[level];
         }
+    }
 
-        return new_node;
+    size_t count = 0;
+    for (const Node* node = ((m_levels > 0) ? next_nodes[0] : nullptr); node && m_compare(node->data(), to);
+        node = node->nextNode())
+    {
+        ++count;
+        if (!callback(node->data()))
+        {
+            break;
+        }
     }
-    else
+    return count;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::insert(const DataType& data)
+{
+    return insertData(data);
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::insert(DataType&& data)
+{
+    return insertData(std::move(data));
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::emplace(Arguments&&... arguments)
+{
+    Node* new_node = createNode(randomLevel(), std::forward<Arguments>(arguments)...);
+    SearchPath previous_nodes = find(new_node->data());
+    if ((previous_nodes.size() > 0) && previous_nodes[0]
+        && !m_compare(previous_nodes[0]->data(), new_node->data()))
+    {
+        recycleNode(new_node);
+        return previous_nodes[0];
+    }
+
+    linkNode(new_node, previous_nodes);
+    return new_node;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+bool Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::erase(const DataType& data) noexcept
+{
+    Node** previous_links[max_levels];
+    findPreviousLinks(data, previous_links);
+
+    Node* node = ((m_levels > 0) ? *previous_links[0] : nullptr);
+    if (!node || m_compare(data, node->data()))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < node->levels(); ++i)
+    {
+        *previous_links[i] = node->tower()[i];
+    }
+    recycleNode(node);
+    shrinkLevels();
+
+    return true;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+size_t Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::erase(const DataType& first,
+    const DataType& last) noexcept
+{
+    if ((m_levels == 0) || !m_compare(first, last))
+    {
+        return 0;
+    }
+
+    Node** previous_links[max_levels];
+    findPreviousLinks(first, previous_links);
+
+    // Bypass the range on the upper levels first, every node in the range is still reachable from level 0
+    for (size_t level = m_levels; level-- > 1;)
     {
-        std::vector<Node*> previous_nodes = find(data);
-        if (previous_nodes[0]->data() == data)
+        Node* next_node = *previous_links[level];
+        while (next_node && m_compare(next_node->data(), last))
         {
-            return previous_nodes[0];
+            next_node = next_node->tower()[level];
         }
-        Node* new_node = new Node(data);
-        size_t levels = m_get_random_level();
-        if (levels > previous_nodes.size())
+        *previous_links[level] = next_node;
+    }
+
+    size_t count = 0;
+    Node* next_node = *previous_links[0];
+    while (next_node && m_compare(next_node->data(), last))
+    {
+        Node* erased_node = next_node;
+        next_node = erased_node->tower()[0];
+        recycleNode(erased_node);
+        ++count;
+    }
+    *previous_links[0] = next_node;
+    shrinkLevels();
+
+    return count;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::clear() noexcept
+{
+    ClearNodes<DataType>(m_allocator,
+        [this]()
+        {
+            DeleteNodeList(m_head[0], [this](Node* node) { Node::Destroy(m_allocator, node); });
+        },
+        [this]()
         {
-            head->m_next_nodes.resize(levels, nullptr);
-            previous_nodes.resize(levels, head);
+            for (size_t i = 0; i < m_levels; ++i)
+            {
+                m_head[i] = nullptr;
+            }
+            m_levels = 0;
+            shrinkToFit();
+        });
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::clear(WorkStealingPool& pool,
+    size_t grain_size) noexcept
+{
+    if (pool.workerCount() == 0)
+    {
+        clear();
+        return;
+    }
+
+    // Once their data has been destroyed the nodes don't need to be destroyed, only deallocated
+    ClearNodes<DataType>(m_allocator,
+        [this, &pool, grain_size]()
+        {
+            DestroyNodeListValues(pool, m_head[0], grain_size, [](Node* node) { node->data().~DataType(); });
+        },
+        [this]()
+        {
+            DeleteNodeList(m_head[0],
+                [this](Node* node) { m_allocator.deallocate(node, Node::Size(node->levels())); });
+        },
+        [this]()
+        {
+            for (size_t i = 0; i < m_levels; ++i)
+            {
+                m_head[i] = nullptr;
+            }
+            m_levels = 0;
+            shrinkToFit();
+        });
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::shrinkToFit() noexcept
+{
+    for (size_t i = 0; i < max_levels; ++i)
+    {
+        void* memory = m_free_nodes[i];
+        while (memory)
+        {
+            void* next_memory = *static_cast<void**>(memory);
+            m_allocator.deallocate(memory, Node::Size(i + 1));
+            memory = next_memory;
+        }
+        m_free_nodes[i] = nullptr;
+    }
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::reserve(size_t count)
+{
+    m_allocator.reserve(count, Node::Size(2));
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::reserve(size_t count, Error& error) noexcept
+{
+    m_allocator.reserve(count, Node::Size(2), error);
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+Ishiko::ContainerStatistics Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::statistics() const
+{
+    ContainerStatistics statistics;
+    statistics.height = m_levels;
+    statistics.level_histogram.resize(m_levels, 0);
+    for (const Node* node = m_head[0]; node; node = node->nextNode())
+    {
+        ++statistics.element_count;
+        statistics.element_bytes += Node::Size(node->levels());
+        ++statistics.level_histogram[node->levels() - 1];
+    }
+    for (size_t i = 0; i < max_levels; ++i)
+    {
+        for (void* memory = m_free_nodes[i]; memory; memory = *static_cast<void**>(memory))
+        {
+            statistics.spare_bytes += Node::Size(i + 1);
         }
-        new_node->m_next_nodes.resize(levels);
-        for (size_t i = 0; i < new_node->m_next_nodes.size(); ++i)
+    }
+    AddAllocationStatistics(m_allocator, statistics);
+    return statistics;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::findPreviousLinks(const DataType& data,
+    Node*** previous_links) noexcept
+{
+    Node** next_nodes = m_head;
+    for (size_t level = m_levels; level-- > 0;)
+    {
+        Node* next_node = next_nodes[level];
+        while (next_node && m_compare(next_node->data(), data))
         {
-            new_node->m_next_nodes[i] = previous_nodes[i]->m_next_nodes[i];
-            previous_nodes[i]->m_next_nodes[i] = new_node;
+            next_nodes = next_node->tower();
+            next_node = next_nodes[level];
         }
-        return new_node;
+        previous_links[level] = &next_nodes[level];
+    }
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename Data>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::insertData(Data&& data)
+{
+    SearchPath previous_nodes = find(data);
+    if ((previous_nodes.size() > 0) && previous_nodes[0]
+        && !m_compare(previous_nodes[0]->data(), data))
+    {
+        return previous_nodes[0];
+    }
+
+    Node* new_node = createNode(randomLevel(), std::forward<Data>(data));
+    linkNode(new_node, previous_nodes);
+    return new_node;
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::linkNode(Node* new_node,
+    const SearchPath& previous_nodes) noexcept
+{
+    size_t levels = new_node->levels();
+    for (size_t i = 0; i < levels; ++i)
+    {
+        Node* previous_node = ((i < previous_nodes.size()) ? previous_nodes[i] : nullptr);
+        Node** next_nodes = (previous_node ? previous_node->tower() : m_head);
+        new_node->tower()[i] = next_nodes[i];
+        next_nodes[i] = new_node;
+    }
+    if (levels > m_levels)
+    {
+        m_levels = levels;
+    }
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::Node*
+Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::createNode(size_t levels, Arguments&&... arguments)
+{
+    void* memory = m_free_nodes[levels - 1];
+    if (!memory)
+    {
+        return Node::Create(m_allocator, levels, std::forward<Arguments>(arguments)...);
+    }
+
+    m_free_nodes[levels - 1] = *static_cast<void**>(memory);
+    try
+    {
+        return new(memory) Node(levels, std::forward<Arguments>(arguments)...);
+    }
+    catch (...)
+    {
+        m_free_nodes[levels - 1] = new(memory) void*(m_free_nodes[levels - 1]);
+        throw;
+    }
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::recycleNode(Node* node) noexcept
+{
+    size_t levels = node->levels();
+    node->~Node();
+    void* memory = node;
+    m_free_nodes[levels - 1] = new(memory) void*(m_free_nodes[levels - 1]);
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+void Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::shrinkLevels() noexcept
+{
+    while ((m_levels > 0) && !m_head[m_levels - 1])
+    {
+        --m_levels;
+    }
+}
+
+template<typename DataType, typename Compare, typename LevelGenerator, typename Allocator>
+size_t Ishiko::SkipList<DataType, Compare, LevelGenerator, Allocator>::randomLevel() noexcept
+{
+    size_t levels = m_level_generator();
+    if (levels == 0)
+    {
+        levels = 1;
+    }
+    else if (levels > max_levels)
+    {
+        levels = max_levels;
     }
+    return levels;
 }
 
 #endif
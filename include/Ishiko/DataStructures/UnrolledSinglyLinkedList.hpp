@@ -0,0 +1,684 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_UNROLLEDSINGLYLINKEDLIST_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_UNROLLEDSINGLYLINKEDLIST_HPP
+
+#include "ContainerStatistics.hpp"
+#include "DataStructuresErrorCategory.hpp"
+#include "DataTypeTraits.hpp"
+#include "NewDeleteAllocator.hpp"
+#include "NodeDeletion.hpp"
+#include "SinglyLinkedListBase.hpp"
+#include <Ishiko/Errors.hpp>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Ishiko
+{
+    // A singly linked list that stores the values in chunks of consecutive values rather than one value per node.
+    // Every chunk is a block of about ChunkSize bytes so a traversal only follows one link per chunk and reads the
+    // values in between from consecutive memory.
+    //
+    // A full chunk is split in two when a value is inserted into it, except when the value is appended after the
+    // last chunk, which starts a new chunk so that a list built by appending has full chunks. A chunk that falls
+    // below half full when a value is erased takes values from the next chunk, or is merged with it if they fit in
+    // one chunk. All the chunks but the last are therefore at least half full.
+    //
+    // Values are identified by an Iterator rather than a node. Inserting or erasing a value invalidates all the
+    // iterators except the one returned. DataType must be nothrow move constructible since values are moved within and
+    // between chunks, with memcpy if DataTypeTraits::trivially_relocatable is true. Allocator is the chunk allocator,
+    // see NewDeleteAllocator.
+    template<typename DataType, size_t ChunkSize = 256, typename DataTypeTraits = DataTypeTraits<DataType>,
+        typename Allocator = NewDeleteAllocator>
+    class UnrolledSinglyLinkedList
+    {
+        static_assert(std::is_nothrow_move_constructible<DataType>::value,
+            "DataType must be nothrow move constructible");
+
+    public:
+        static const size_t chunk_capacity = ((ChunkSize - sizeof(size_t) - sizeof(void*)) / sizeof(DataType));
+        static_assert(chunk_capacity >= 2, "ChunkSize is too small for DataType");
+
+        class Chunk
+        {
+        public:
+            Chunk(const Chunk& other) = delete;
+            Chunk& operator=(const Chunk& other) = delete;
+
+            size_t size() const noexcept;
+            const DataType& data(size_t index) const noexcept;
+            DataType& data(size_t index) noexcept;
+
+            const Chunk* nextNode() const noexcept;
+            Chunk* nextNode() noexcept;
+            void setNextNode(Chunk* node) noexcept;
+
+        private:
+            friend class UnrolledSinglyLinkedList;
+
+            typedef typename std::aligned_storage<sizeof(DataType), std::alignment_of<DataType>::value>::type Storage;
+
+            Chunk() noexcept = default;
+            ~Chunk() noexcept = default;
+
+            const DataType* values() const noexcept;
+            DataType* values() noexcept;
+
+            Chunk* m_next_node = nullptr;
+            size_t m_size = 0;
+            Storage m_data[chunk_capacity];
+        };
+
+        // A forward iterator over the values. It also remembers the chunk before the one the value is in so that the
+        // value can be erased without going back to the start of the list.
+        class Iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef DataType value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef DataType* pointer;
+            typedef DataType& reference;
+
+            Iterator() noexcept = default;
+
+            reference operator*() const noexcept;
+            pointer operator->() const noexcept;
+            Iterator& operator++() noexcept;
+            Iterator operator++(int) noexcept;
+            bool operator==(const Iterator& other) const noexcept;
+            bool operator!=(const Iterator& other) const noexcept;
+
+        private:
+            friend class UnrolledSinglyLinkedList;
+
+            Iterator(Chunk* previous_chunk, Chunk* chunk, size_t index) noexcept;
+
+            Chunk* m_previous_chunk = nullptr;
+            Chunk* m_chunk = nullptr;
+            size_t m_index = 0;
+        };
+
+        UnrolledSinglyLinkedList() noexcept = default;
+        UnrolledSinglyLinkedList(const UnrolledSinglyLinkedList& other) = delete;
+        UnrolledSinglyLinkedList& operator=(const UnrolledSinglyLinkedList& other) = delete;
+        ~UnrolledSinglyLinkedList() noexcept;
+
+        bool isEmpty() const noexcept;
+        size_t size() const noexcept;
+        // The first value, same as begin()
+        Iterator head() noexcept;
+        Iterator begin() noexcept;
+        Iterator end() noexcept;
+
+        template<typename Callable>
+        void traverse(Callable&& callable) const;
+
+        void setHead(const DataType& data);
+        void setHead(DataType&& data);
+        void setHead(const DataType& data, Error& error) noexcept;
+        void setHead(DataType&& data, Error& error) noexcept;
+        // Inserts data after the value previous points to, which must be a value of this list, and returns an
+        // iterator to the new value
+        Iterator insert(const DataType& data, Iterator previous);
+        Iterator insert(DataType&& data, Iterator previous);
+        // Same as insert but the value is constructed from arguments. The value is constructed before the list is
+        // modified so the list is unchanged if that throws.
+        template<typename... Arguments>
+        Iterator emplace(Iterator previous, Arguments&&... arguments);
+        // Erases the value position points to and returns an iterator to the value that followed it
+        Iterator erase(Iterator position) noexcept;
+        void clear() noexcept;
+
+        // Makes sure count values can be inserted without the allocator needing more memory from the system. This
+        // assumes every chunk is half full.
+        void reserve(size_t count);
+        void reserve(size_t count, Error& error) noexcept;
+
+        // Visits every chunk to compute a snapshot of the memory the list holds, see ContainerStatistics. The unused
+        // slots of the chunks are counted as spare bytes.
+        ContainerStatistics statistics() const;
+
+    private:
+        static const size_t min_chunk_size = (chunk_capacity / 2);
+
+        // An upper bound on the number of chunks that hold count values
+        static size_t ChunkCount(size_t count) noexcept;
+
+        // Makes value the only value of the list, which must be empty
+        void setHeadValue(DataType& value, Error& error) noexcept;
+        // Moves value to position index of chunk, which must not be full
+        static void InsertValue(Chunk* chunk, size_t index, DataType& value) noexcept;
+        // Moves the count values at source to the uninitialized slots at destination, the ranges may overlap
+        static void Relocate(DataType* destination, DataType* source, size_t count) noexcept;
+        // Restores the minimum size of chunk after a value was erased from it, unless it is the last chunk
+        void rebalance(Chunk* chunk) noexcept;
+        Chunk* createChunk();
+        Chunk* createChunk(Error& error) noexcept;
+        void destroyChunk(Chunk* chunk) noexcept;
+
+        SinglyLinkedListBase<Chunk> m_list_impl;
+        size_t m_size = 0;
+        Allocator m_allocator;
+    };
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+const size_t Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::chunk_capacity;
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+const size_t Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::min_chunk_size;
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+size_t Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk::size() const noexcept
+{
+    return m_size;
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+const DataType& Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk::data(
+    size_t index) const noexcept
+{
+    return values()[index];
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+DataType& Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk::data(
+    size_t index) noexcept
+{
+    return values()[index];
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+const typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk*
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk::nextNode() const noexcept
+{
+    return m_next_node;
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk*
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk::nextNode() noexcept
+{
+    return m_next_node;
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk::setNextNode(
+    Chunk* node) noexcept
+{
+    m_next_node = node;
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+const DataType*
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk::values() const noexcept
+{
+    return reinterpret_cast<const DataType*>(m_data);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+DataType* Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk::values() noexcept
+{
+    return reinterpret_cast<DataType*>(m_data);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator::Iterator(
+    Chunk* previous_chunk, Chunk* chunk, size_t index) noexcept
+    : m_previous_chunk(previous_chunk), m_chunk(chunk), m_index(index)
+{
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+DataType& Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator::operator*()
+    const noexcept
+{
+    return m_chunk->data(m_index);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+DataType* Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator::operator->()
+    const noexcept
+{
+    return &m_chunk->data(m_index);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator&
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator::operator++() noexcept
+{
+    ++m_index;
+    if (m_index == m_chunk->size())
+    {
+        m_previous_chunk = m_chunk;
+        m_chunk = m_chunk->nextNode();
+        m_index = 0;
+    }
+    return *this;
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator::operator++(int) noexcept
+{
+    Iterator result = *this;
+    ++(*this);
+    return result;
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+bool Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator::operator==(
+    const Iterator& other) const noexcept
+{
+    return ((m_chunk == other.m_chunk) && (m_index == other.m_index));
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+bool Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator::operator!=(
+    const Iterator& other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::~UnrolledSinglyLinkedList() noexcept
+{
+    clear();
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+bool Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::isEmpty() const noexcept
+{
+    return m_list_impl.isEmpty();
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+size_t Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::size() const noexcept
+{
+    return m_size;
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::head() noexcept
+{
+    return begin();
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::begin() noexcept
+{
+    return Iterator(nullptr, m_list_impl.head(), 0);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::end() noexcept
+{
+    return Iterator();
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+template<typename Callable>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::traverse(
+    Callable&& callable) const
+{
+    const Chunk* chunk = m_list_impl.head();
+    while (chunk)
+    {
+        const DataType* values = chunk->values();
+        for (size_t i = 0; i < chunk->m_size; ++i)
+        {
+            callable(values[i]);
+        }
+        chunk = chunk->nextNode();
+    }
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::setHead(const DataType& data)
+{
+    if (m_list_impl.isEmpty())
+    {
+        emplace(end(), data);
+    }
+    else
+    {
+        m_list_impl.head()->data(0) = data;
+    }
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::setHead(DataType&& data)
+{
+    if (m_list_impl.isEmpty())
+    {
+        emplace(end(), std::move(data));
+    }
+    else
+    {
+        m_list_impl.head()->data(0) = std::move(data);
+    }
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::setHead(const DataType& data,
+    Error& error) noexcept
+{
+    Chunk* head = m_list_impl.head();
+    if (head)
+    {
+        head->data(0) = data;
+    }
+    else
+    {
+        DataType value(DataTypeTraits::Copy(data, error));
+        if (!error)
+        {
+            setHeadValue(value, error);
+        }
+    }
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::setHead(DataType&& data,
+    Error& error) noexcept
+{
+    Chunk* head = m_list_impl.head();
+    if (head)
+    {
+        head->data(0) = std::move(data);
+    }
+    else
+    {
+        DataType value(DataTypeTraits::Move(std::move(data), error));
+        if (!error)
+        {
+            setHeadValue(value, error);
+        }
+    }
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::insert(const DataType& data,
+    Iterator previous)
+{
+    return emplace(previous, data);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::insert(DataType&& data,
+    Iterator previous)
+{
+    return emplace(previous, std::move(data));
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+template<typename... Arguments>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::emplace(Iterator previous,
+    Arguments&&... arguments)
+{
+    DataType value(std::forward<Arguments>(arguments)...);
+
+    Chunk* previous_chunk = previous.m_previous_chunk;
+    Chunk* chunk = previous.m_chunk;
+    size_t index = (previous.m_index + 1);
+    if (!chunk)
+    {
+        // Only the head of an empty list is inserted without a previous value
+        chunk = createChunk();
+        m_list_impl.pushFront(chunk);
+        index = 0;
+    }
+    else if (chunk->m_size == chunk_capacity)
+    {
+        Chunk* next_chunk = chunk->nextNode();
+        if ((index == chunk_capacity) && next_chunk && (next_chunk->m_size < chunk_capacity))
+        {
+            previous_chunk = chunk;
+            chunk = next_chunk;
+            index = 0;
+        }
+        else
+        {
+            Chunk* new_chunk = createChunk();
+            m_list_impl.insert(new_chunk, chunk);
+            if ((index == chunk_capacity) && !next_chunk)
+            {
+                previous_chunk = chunk;
+                chunk = new_chunk;
+                index = 0;
+            }
+            else
+            {
+                // The chunk keeps the first half of the values, the new value then goes in whichever half it belongs
+                // to
+                Relocate(new_chunk->values(), chunk->values() + min_chunk_size, (chunk_capacity - min_chunk_size));
+                new_chunk->m_size = (chunk_capacity - min_chunk_size);
+                chunk->m_size = min_chunk_size;
+                if (index > min_chunk_size)
+                {
+                    previous_chunk = chunk;
+                    chunk = new_chunk;
+                    index -= min_chunk_size;
+                }
+            }
+        }
+    }
+
+    InsertValue(chunk, index, value);
+    ++m_size;
+    return Iterator(previous_chunk, chunk, index);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Iterator
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::erase(Iterator position) noexcept
+{
+    Chunk* previous_chunk = position.m_previous_chunk;
+    Chunk* chunk = position.m_chunk;
+    size_t index = position.m_index;
+
+    DataType* values = chunk->values();
+    values[index].~DataType();
+    Relocate(values + index, values + index + 1, (chunk->m_size - index - 1));
+    --chunk->m_size;
+    --m_size;
+
+    rebalance(chunk);
+    if (chunk->m_size == 0)
+    {
+        // Only the last chunk can become empty since the others take values from the chunk after them
+        if (previous_chunk)
+        {
+            m_list_impl.removeAfter(previous_chunk);
+        }
+        else
+        {
+            m_list_impl.popFront();
+        }
+        destroyChunk(chunk);
+        return end();
+    }
+    else if (index == chunk->m_size)
+    {
+        return Iterator(chunk, chunk->nextNode(), 0);
+    }
+    else
+    {
+        return Iterator(previous_chunk, chunk, index);
+    }
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::clear() noexcept
+{
+    ClearNodes<DataType>(m_allocator, [this]() { m_list_impl.clear([this](Chunk* chunk) { destroyChunk(chunk); }); },
+        [this]()
+        {
+            m_list_impl.setHead(nullptr);
+            m_size = 0;
+        });
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::reserve(size_t count)
+{
+    m_allocator.reserve(ChunkCount(count), sizeof(Chunk));
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::reserve(size_t count,
+    Error& error) noexcept
+{
+    m_allocator.reserve(ChunkCount(count), sizeof(Chunk), error);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+Ishiko::ContainerStatistics
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::statistics() const
+{
+    size_t chunk_count = 0;
+    for (const Chunk* chunk = m_list_impl.head(); chunk; chunk = chunk->nextNode())
+    {
+        ++chunk_count;
+    }
+
+    ContainerStatistics statistics;
+    statistics.element_count = m_size;
+    statistics.spare_bytes = (((chunk_count * chunk_capacity) - m_size) * sizeof(DataType));
+    statistics.element_bytes = ((chunk_count * sizeof(Chunk)) - statistics.spare_bytes);
+    AddAllocationStatistics(m_allocator, statistics);
+    return statistics;
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+size_t Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::ChunkCount(
+    size_t count) noexcept
+{
+    return ((count / min_chunk_size) + 1);
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::setHeadValue(DataType& value,
+    Error& error) noexcept
+{
+    Chunk* chunk = createChunk(error);
+    if (chunk)
+    {
+        InsertValue(chunk, 0, value);
+        m_list_impl.pushFront(chunk);
+        m_size = 1;
+    }
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::InsertValue(Chunk* chunk,
+    size_t index, DataType& value) noexcept
+{
+    DataType* values = chunk->values();
+    Relocate(values + index + 1, values + index, (chunk->m_size - index));
+    new(values + index) DataType(std::move(value));
+    ++chunk->m_size;
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Relocate(DataType* destination,
+    DataType* source, size_t count) noexcept
+{
+    if (DataTypeTraits::trivially_relocatable)
+    {
+        std::memmove(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(DataType));
+    }
+    else if (destination < source)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            new(destination + i) DataType(std::move(source[i]));
+            source[i].~DataType();
+        }
+    }
+    else
+    {
+        for (size_t i = count; i > 0; --i)
+        {
+            new(destination + i - 1) DataType(std::move(source[i - 1]));
+            source[i - 1].~DataType();
+        }
+    }
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::rebalance(Chunk* chunk) noexcept
+{
+    Chunk* next_chunk = chunk->nextNode();
+    if ((chunk->m_size >= min_chunk_size) || !next_chunk)
+    {
+        return;
+    }
+
+    if ((chunk->m_size + next_chunk->m_size) <= chunk_capacity)
+    {
+        Relocate(chunk->values() + chunk->m_size, next_chunk->values(), next_chunk->m_size);
+        chunk->m_size += next_chunk->m_size;
+        next_chunk->m_size = 0;
+        m_list_impl.removeAfter(chunk);
+        destroyChunk(next_chunk);
+    }
+    else
+    {
+        // The next chunk is left with more than min_chunk_size values
+        size_t count = (min_chunk_size - chunk->m_size);
+        Relocate(chunk->values() + chunk->m_size, next_chunk->values(), count);
+        Relocate(next_chunk->values(), next_chunk->values() + count, (next_chunk->m_size - count));
+        chunk->m_size += count;
+        next_chunk->m_size -= count;
+    }
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk*
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::createChunk()
+{
+    return new(m_allocator.allocate(sizeof(Chunk))) Chunk();
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+typename Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::Chunk*
+Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::createChunk(Error& error) noexcept
+{
+    void* memory = m_allocator.allocate(sizeof(Chunk), error);
+    if (!memory)
+    {
+        return nullptr;
+    }
+    return new(memory) Chunk();
+}
+
+template<typename DataType, size_t ChunkSize, typename DataTypeTraits, typename Allocator>
+void Ishiko::UnrolledSinglyLinkedList<DataType, ChunkSize, DataTypeTraits, Allocator>::destroyChunk(
+    Chunk* chunk) noexcept
+{
+    if (!std::is_trivially_destructible<DataType>::value)
+    {
+        DataType* values = chunk->values();
+        for (size_t i = 0; i < chunk->m_size; ++i)
+        {
+            values[i].~DataType();
+        }
+    }
+    chunk->~Chunk();
+    m_allocator.deallocate(chunk, sizeof(Chunk));
+}
+
+#endif
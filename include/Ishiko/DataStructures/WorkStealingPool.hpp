@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_WORKSTEALINGPOOL_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ishiko
+{
+    // A pool of threads for fork/join parallelism, used by the parallel algorithms of the containers.
+    //
+    // Each worker has its own queue. A worker runs the tasks it queued most recently first, which are the smallest
+    // ones in a divide and conquer algorithm, and when its queue is empty it steals the oldest task from the queue of
+    // another thread. A thread that waits for a group of tasks runs queued tasks until the group is done, so tasks
+    // can themselves fork tasks and wait for them. Only when there is no task left to run does it block until the
+    // group is done or new tasks are queued.
+    //
+    // The queues of the workers are Chase-Lev deques: the worker pushes and pops its own tasks without locking and
+    // only contends with thieves for the last task. The threads outside the pool share a single queue protected by a
+    // mutex, and all the threads update a shared count of queued tasks that idle threads sleep on, so the pool scales
+    // with tasks that are each worth at least a few microseconds of work rather than with very fine-grained ones.
+    class WorkStealingPool
+    {
+    public:
+        // A set of tasks that can be waited for together. If tasks throw the first exception is rethrown by wait.
+        class TaskGroup
+        {
+        public:
+            TaskGroup() noexcept = default;
+            TaskGroup(const TaskGroup& other) = delete;
+            TaskGroup& operator=(const TaskGroup& other) = delete;
+
+        private:
+            friend class WorkStealingPool;
+
+            // The number of tasks not done yet, with waiting_flag set once a thread blocks in wait
+            std::atomic<size_t> m_pending_count{0};
+            std::mutex m_exception_mutex;
+            std::exception_ptr m_exception;
+        };
+
+        // Uses one worker per hardware thread except one since the thread that waits for the tasks runs them too
+        WorkStealingPool();
+        // With 0 workers the tasks all run in the thread that waits for them
+        explicit WorkStealingPool(size_t worker_count);
+        WorkStealingPool(const WorkStealingPool& other) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool& other) = delete;
+        // All the task groups must have been waited for and no other thread may still be in wait
+        ~WorkStealingPool() noexcept;
+
+        size_t workerCount() const noexcept;
+
+        void run(TaskGroup& group, std::function<void()> task);
+        // Runs tasks until all the tasks of group are done
+        void wait(TaskGroup& group);
+
+    private:
+        // Tells the thread that runs the last task of a group that it needs to wake up the waiting thread. It is
+        // part of the count so that the thread doesn't access the group after its decrement.
+        static const size_t waiting_flag = (size_t(1) << ((8 * sizeof(size_t)) - 1));
+
+        struct Task
+        {
+            std::function<void()> function;
+            TaskGroup* group;
+        };
+
+        // The queue of a worker. Only the worker pushes and pops, at the bottom, and the other threads steal from the
+        // top. The arrays replaced when the queue grows are kept until the queue is destroyed since a thief may still
+        // be reading them.
+        class WorkerQueue
+        {
+        public:
+            WorkerQueue();
+            WorkerQueue(const WorkerQueue& other) = delete;
+            WorkerQueue& operator=(const WorkerQueue& other) = delete;
+
+            void push(Task* task);
+            // Returns nullptr if the queue is empty
+            Task* pop() noexcept;
+            // Returns nullptr if the queue is empty or another thread took the task first
+            Task* steal() noexcept;
+
+        private:
+            struct Array
+            {
+                explicit Array(size_t capacity);
+
+                size_t capacity;
+                std::unique_ptr<std::atomic<Task*>[]> slots;
+            };
+
+            static const size_t initial_capacity = 256;
+
+            Array* grow(Array* array, int64_t top, int64_t bottom);
+
+            std::atomic<int64_t> m_top{0};
+            std::atomic<int64_t> m_bottom{0};
+            std::atomic<Array*> m_array;
+            std::vector<std::unique_ptr<Array>> m_arrays;
+        };
+
+        struct SharedQueue
+        {
+            std::mutex mutex;
+            std::deque<Task*> tasks;
+        };
+
+        void work(size_t queue_index) noexcept;
+        size_t currentQueueIndex() const noexcept;
+        void push(size_t queue_index, Task* task);
+        // Takes the newest task of the queue at queue_index, or steals the oldest task of another queue
+        Task* takeTask(size_t queue_index) noexcept;
+        // Takes a task from the queue at queue_index, from the bottom for its owner and from the top for the others
+        Task* takeTask(size_t queue_index, bool own_queue) noexcept;
+        void execute(Task* task) noexcept;
+
+        // The queues at index 0 to m_workers.size() - 1 are those of the workers, the queue at m_workers.size() is
+        // m_shared_queue, used by the threads outside the pool
+        std::vector<std::unique_ptr<WorkerQueue>> m_worker_queues;
+        SharedQueue m_shared_queue;
+        std::vector<std::thread> m_workers;
+        std::atomic<size_t> m_queued_count{0};
+        std::mutex m_idle_mutex;
+        std::condition_variable m_idle_condition;
+        bool m_stopping = false;
+    };
+}
+
+#endif
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ArenaAllocator.hpp"
+#include "DataStructuresErrorCategory.hpp"
+
+using namespace Ishiko;
+
+const bool ArenaAllocator::supports_release;
+const size_t ArenaAllocator::alignment;
+const size_t ArenaAllocator::default_slab_size;
+
+ArenaAllocator::ArenaAllocator(size_t slab_size) noexcept
+    : m_slab_size(slab_size)
+{
+}
+
+ArenaAllocator::~ArenaAllocator() noexcept
+{
+    release();
+}
+
+void* ArenaAllocator::allocate(size_t size, Error& error) noexcept
+{
+    size = RoundUp(size);
+    if ((size > static_cast<size_t>(m_end - m_current)) && !addSlab(size))
+    {
+        Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to allocate arena slab", __FILE__,
+            __LINE__, error);
+        return nullptr;
+    }
+    void* memory = m_current;
+    m_current += size;
+    return memory;
+}
+
+void ArenaAllocator::reserve(size_t count, size_t size)
+{
+    if (!makeRoom(count, size))
+    {
+        throw std::bad_alloc();
+    }
+}
+
+void ArenaAllocator::reserve(size_t count, size_t size, Error& error) noexcept
+{
+    if (!makeRoom(count, size))
+    {
+        Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to allocate arena slab", __FILE__,
+            __LINE__, error);
+    }
+}
+
+void ArenaAllocator::release() noexcept
+{
+    while (m_slabs)
+    {
+        Slab* previous_slab = m_slabs->previous_slab;
+        ::operator delete(m_slabs);
+        m_slabs = previous_slab;
+    }
+    m_current = nullptr;
+    m_end = nullptr;
+}
+
+bool ArenaAllocator::makeRoom(size_t count, size_t size) noexcept
+{
+    size = RoundUp(size);
+    if ((size != 0) && (count > (static_cast<size_t>(-1) / size)))
+    {
+        return false;
+    }
+    size_t total_size = (count * size);
+    return ((total_size <= static_cast<size_t>(m_end - m_current)) || addSlab(total_size));
+}
+
+bool ArenaAllocator::addSlab(size_t size) noexcept
+{
+    // The slab header is padded so the first block is aligned
+    size_t header_size = RoundUp(sizeof(Slab));
+    if (size > (static_cast<size_t>(-1) - header_size))
+    {
+        return false;
+    }
+    size_t slab_size = (((header_size + size) > m_slab_size) ? (header_size + size) : m_slab_size);
+    void* memory = ::operator new(slab_size, std::nothrow);
+    if (!memory)
+    {
+        return false;
+    }
+
+    Slab* slab = static_cast<Slab*>(memory);
+    slab->previous_slab = m_slabs;
+    m_slabs = slab;
+    m_current = (static_cast<char*>(memory) + header_size);
+    m_end = (static_cast<char*>(memory) + slab_size);
+    return true;
+}
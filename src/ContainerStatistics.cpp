@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ContainerStatistics.hpp"
+
+using namespace Ishiko;
+
+namespace
+{
+    std::string histogramToString(const std::vector<size_t>& histogram)
+    {
+        std::string result = "[";
+        for (size_t i = 0; i < histogram.size(); ++i)
+        {
+            if (i != 0)
+            {
+                result += ", ";
+            }
+            result += std::to_string(histogram[i]);
+        }
+        result += "]";
+        return result;
+    }
+}
+
+std::string ContainerStatistics::toString() const
+{
+    std::string result = "elements: " + std::to_string(element_count)
+        + ", element bytes: " + std::to_string(element_bytes)
+        + ", spare bytes: " + std::to_string(spare_bytes)
+        + ", height: " + std::to_string(height)
+        + ", level histogram: " + histogramToString(level_histogram);
+    if (has_allocation_statistics)
+    {
+        result += ", allocations: " + std::to_string(allocations.allocation_count)
+            + ", deallocations: " + std::to_string(allocations.deallocation_count)
+            + ", allocated bytes: " + std::to_string(allocations.allocated_bytes)
+            + ", peak allocated bytes: " + std::to_string(allocations.peak_allocated_bytes);
+    }
+    return result;
+}
+
+std::string ContainerStatistics::toJSON() const
+{
+    // All the keys are always present so that consumers can rely on a fixed schema
+    std::string result = "{\"element_count\": " + std::to_string(element_count)
+        + ", \"element_bytes\": " + std::to_string(element_bytes)
+        + ", \"spare_bytes\": " + std::to_string(spare_bytes)
+        + ", \"height\": " + std::to_string(height)
+        + ", \"level_histogram\": " + histogramToString(level_histogram)
+        + ", \"allocations\": ";
+    if (has_allocation_statistics)
+    {
+        result += "{\"allocation_count\": " + std::to_string(allocations.allocation_count)
+            + ", \"deallocation_count\": " + std::to_string(allocations.deallocation_count)
+            + ", \"allocated_bytes\": " + std::to_string(allocations.allocated_bytes)
+            + ", \"peak_allocated_bytes\": " + std::to_string(allocations.peak_allocated_bytes) + "}";
+    }
+    else
+    {
+        result += "null";
+    }
+    result += "}";
+    return result;
+}
@@ -32,6 +32,12 @@ const char* DataStructuresErrorCategory::message(int ev, char* buffer, size_t le
     case Value::left_child_node_does_not_exist:
         return "left child node does not exist";
 
+    case Value::allocation_failure:
+        return "allocation failure";
+
+    case Value::invalid_image:
+        return "invalid image";
+
     default:
         return "unknown value";
     }
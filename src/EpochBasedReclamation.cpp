@@ -0,0 +1,241 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "EpochBasedReclamation.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    // The number of objects a thread retires before it tries to advance the epoch and reclaim memory
+    const size_t collect_threshold = 64;
+
+    struct RetiredObject
+    {
+        void* object;
+        void (*deleter)(void* object);
+        uint64_t epoch;
+    };
+
+    // The state of a thread taking part in the reclamation. Records are never freed, a record released by a thread
+    // that exits is reused by the next thread that needs one.
+    struct ThreadRecord
+    {
+        // 0 when the thread isn't pinned, (epoch << 1) | 1 otherwise
+        std::atomic<uint64_t> state{0};
+        std::atomic<bool> in_use{true};
+        ThreadRecord* next = nullptr;
+        unsigned int nesting = 0;
+        std::vector<RetiredObject> retired_objects;
+        size_t retired_since_collect = 0;
+    };
+
+    std::atomic<uint64_t> global_epoch{1};
+    std::atomic<ThreadRecord*> thread_records{nullptr};
+    // The number of guards held by threads whose record couldn't be allocated. The epoch can't advance while it is
+    // not 0 since there is no way to know which epoch these threads observed.
+    std::atomic<size_t> guards_without_record{0};
+
+    // Objects retired by threads that have exited
+    std::mutex orphans_mutex;
+    std::vector<RetiredObject> orphans;
+
+    // Returns nullptr if a new record is needed and can't be allocated
+    ThreadRecord* AcquireThreadRecord() noexcept
+    {
+        for (ThreadRecord* record = thread_records.load(); record; record = record->next)
+        {
+            bool in_use = false;
+            if (!record->in_use.load(std::memory_order_relaxed)
+                && record->in_use.compare_exchange_strong(in_use, true))
+            {
+                return record;
+            }
+        }
+
+        ThreadRecord* record = new(std::nothrow) ThreadRecord();
+        if (!record)
+        {
+            return nullptr;
+        }
+        ThreadRecord* head = thread_records.load();
+        do
+        {
+            record->next = head;
+        } while (!thread_records.compare_exchange_weak(head, record));
+        return record;
+    }
+
+    // Deletes the objects at the front of retired_objects that were retired at least two epochs ago. Objects are
+    // appended in epoch order so the reclaimable ones always form a prefix.
+    void Reclaim(std::vector<RetiredObject>& retired_objects, uint64_t epoch) noexcept
+    {
+        std::vector<RetiredObject>::iterator it = retired_objects.begin();
+        while ((it != retired_objects.end()) && ((it->epoch + 2) <= epoch))
+        {
+            it->deleter(it->object);
+            ++it;
+        }
+        retired_objects.erase(retired_objects.begin(), it);
+    }
+
+    // Advances the global epoch if every pinned thread has observed the current one
+    bool TryAdvanceEpoch() noexcept
+    {
+        uint64_t epoch = global_epoch.load();
+        if (guards_without_record.load() != 0)
+        {
+            return false;
+        }
+        for (ThreadRecord* record = thread_records.load(); record; record = record->next)
+        {
+            uint64_t state = record->state.load();
+            if ((state & 1) && ((state >> 1) != epoch))
+            {
+                return false;
+            }
+        }
+        return global_epoch.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    void ReclaimOrphans() noexcept
+    {
+        std::lock_guard<std::mutex> lock(orphans_mutex);
+        Reclaim(orphans, global_epoch.load());
+    }
+
+    // Same as ReclaimOrphans but gives up instead of waiting if another thread is already using the orphans
+    void TryReclaimOrphans() noexcept
+    {
+        std::unique_lock<std::mutex> lock(orphans_mutex, std::try_to_lock);
+        if (lock.owns_lock())
+        {
+            Reclaim(orphans, global_epoch.load());
+        }
+    }
+
+    class ThreadRecordHolder
+    {
+    public:
+        ~ThreadRecordHolder()
+        {
+            if (m_record)
+            {
+                if (!m_record->retired_objects.empty())
+                {
+                    std::lock_guard<std::mutex> lock(orphans_mutex);
+                    try
+                    {
+                        orphans.insert(orphans.end(), m_record->retired_objects.begin(),
+                            m_record->retired_objects.end());
+                    }
+                    catch (...)
+                    {
+                        // The objects are leaked, see EpochBasedReclamation::Retire
+                    }
+                    m_record->retired_objects.clear();
+                }
+                m_record->retired_since_collect = 0;
+                m_record->in_use.store(false);
+            }
+        }
+
+        // Returns nullptr if the thread has no record yet and one can't be allocated
+        ThreadRecord* record() noexcept
+        {
+            if (!m_record)
+            {
+                m_record = AcquireThreadRecord();
+            }
+            return m_record;
+        }
+
+    private:
+        ThreadRecord* m_record = nullptr;
+    };
+
+    thread_local ThreadRecordHolder current_thread;
+}
+
+EpochBasedReclamation::Guard::Guard() noexcept
+{
+    ThreadRecord* record = current_thread.record();
+    m_without_record = !record;
+    if (m_without_record)
+    {
+        // The increment is sequentially consistent so it is visible before this thread reads any shared pointer
+        guards_without_record.fetch_add(1);
+    }
+    else if (record->nesting++ == 0)
+    {
+        record->state.store((global_epoch.load() << 1) | 1, std::memory_order_relaxed);
+        // The state must be visible to the other threads before this thread reads any shared pointer
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+EpochBasedReclamation::Guard::~Guard() noexcept
+{
+    if (m_without_record)
+    {
+        guards_without_record.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    ThreadRecord* record = current_thread.record();
+    if (--record->nesting == 0)
+    {
+        record->state.store(0, std::memory_order_release);
+    }
+}
+
+void EpochBasedReclamation::Retire(void* object, void (*deleter)(void* object)) noexcept
+{
+    ThreadRecord* record = current_thread.record();
+    if (!record)
+    {
+        return;
+    }
+    try
+    {
+        RetiredObject retired_object = { object, deleter, global_epoch.load() };
+        record->retired_objects.push_back(retired_object);
+    }
+    catch (...)
+    {
+        return;
+    }
+
+    if (++record->retired_since_collect >= collect_threshold)
+    {
+        record->retired_since_collect = 0;
+        TryAdvanceEpoch();
+        Reclaim(record->retired_objects, global_epoch.load());
+        TryReclaimOrphans();
+    }
+}
+
+void EpochBasedReclamation::Synchronize() noexcept
+{
+    uint64_t target_epoch = global_epoch.load() + 2;
+    while (global_epoch.load() < target_epoch)
+    {
+        if (!TryAdvanceEpoch())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    ThreadRecord* record = current_thread.record();
+    if (record)
+    {
+        Reclaim(record->retired_objects, global_epoch.load());
+    }
+    ReclaimOrphans();
+}
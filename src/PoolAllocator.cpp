@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PoolAllocator.hpp"
+#include "DataStructuresErrorCategory.hpp"
+
+using namespace Ishiko;
+
+const bool PoolAllocator::supports_release;
+const size_t PoolAllocator::size_classes;
+const size_t PoolAllocator::max_block_size;
+
+PoolAllocator::PoolAllocator(size_t slab_size) noexcept
+    : m_arena(slab_size)
+{
+    for (size_t i = 0; i < size_classes; ++i)
+    {
+        m_free_blocks[i] = nullptr;
+    }
+}
+
+PoolAllocator::~PoolAllocator() noexcept
+{
+    release();
+}
+
+void* PoolAllocator::allocate(size_t size, Error& error) noexcept
+{
+    void* memory;
+    size_t size_class = SizeClass(size);
+    if (size_class < size_classes)
+    {
+        memory = m_free_blocks[size_class];
+        if (memory)
+        {
+            m_free_blocks[size_class] = *static_cast<void**>(memory);
+            return memory;
+        }
+        return m_arena.allocate((size_class + 1) * ArenaAllocator::alignment, error);
+    }
+
+    memory = allocateLarge(size);
+    if (!memory)
+    {
+        Fail(DataStructuresErrorCategory::Value::allocation_failure, "Failed to allocate pool block", __FILE__,
+            __LINE__, error);
+    }
+    return memory;
+}
+
+void PoolAllocator::reserve(size_t count, size_t size)
+{
+    // Large blocks are allocated individually so there is nothing that can be set aside for them
+    if (size <= max_block_size)
+    {
+        m_arena.reserve(count, size);
+    }
+}
+
+void PoolAllocator::reserve(size_t count, size_t size, Error& error) noexcept
+{
+    if (size <= max_block_size)
+    {
+        m_arena.reserve(count, size, error);
+    }
+}
+
+void PoolAllocator::release() noexcept
+{
+    m_arena.release();
+    for (size_t i = 0; i < size_classes; ++i)
+    {
+        m_free_blocks[i] = nullptr;
+    }
+    while (m_large_blocks)
+    {
+        LargeBlock* next_block = m_large_blocks->next_block;
+        ::operator delete(m_large_blocks);
+        m_large_blocks = next_block;
+    }
+}
+
+size_t PoolAllocator::LargeBlockHeaderSize() noexcept
+{
+    return ArenaAllocator::RoundUp(sizeof(LargeBlock));
+}
+
+void* PoolAllocator::allocateLarge(size_t size) noexcept
+{
+    if (size > (static_cast<size_t>(-1) - LargeBlockHeaderSize()))
+    {
+        return nullptr;
+    }
+    void* memory = ::operator new(LargeBlockHeaderSize() + size, std::nothrow);
+    if (!memory)
+    {
+        return nullptr;
+    }
+
+    LargeBlock* block = static_cast<LargeBlock*>(memory);
+    block->previous_block = nullptr;
+    block->next_block = m_large_blocks;
+    if (m_large_blocks)
+    {
+        m_large_blocks->previous_block = block;
+    }
+    m_large_blocks = block;
+    return (static_cast<char*>(memory) + LargeBlockHeaderSize());
+}
+
+void PoolAllocator::deallocateLarge(void* memory) noexcept
+{
+    LargeBlock* block = reinterpret_cast<LargeBlock*>(static_cast<char*>(memory) - LargeBlockHeaderSize());
+    if (block->previous_block)
+    {
+        block->previous_block->next_block = block->next_block;
+    }
+    else
+    {
+        m_large_blocks = block->next_block;
+    }
+    if (block->next_block)
+    {
+        block->next_block->previous_block = block->previous_block;
+    }
+    ::operator delete(block);
+}
@@ -0,0 +1,330 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "WorkStealingPool.hpp"
+
+using namespace Ishiko;
+
+namespace
+{
+    // The pool the calling thread is a worker of, if any, and the index of its queue
+    thread_local const WorkStealingPool* current_pool = nullptr;
+    thread_local size_t current_queue_index = 0;
+
+    size_t DefaultWorkerCount() noexcept
+    {
+        unsigned int hardware_threads = std::thread::hardware_concurrency();
+        return ((hardware_threads > 1) ? (hardware_threads - 1) : 0);
+    }
+}
+
+WorkStealingPool::WorkerQueue::Array::Array(size_t capacity)
+    : capacity(capacity), slots(new std::atomic<Task*>[capacity])
+{
+}
+
+const size_t WorkStealingPool::waiting_flag;
+
+const size_t WorkStealingPool::WorkerQueue::initial_capacity;
+
+WorkStealingPool::WorkerQueue::WorkerQueue()
+{
+    m_arrays.emplace_back(new Array(initial_capacity));
+    m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+}
+
+void WorkStealingPool::WorkerQueue::push(Task* task)
+{
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    int64_t top = m_top.load(std::memory_order_acquire);
+    Array* array = m_array.load(std::memory_order_relaxed);
+    if ((bottom - top) >= static_cast<int64_t>(array->capacity))
+    {
+        array = grow(array, top, bottom);
+    }
+    array->slots[bottom & (array->capacity - 1)].store(task, std::memory_order_relaxed);
+    // Publishes the task to the thieves
+    m_bottom.store(bottom + 1, std::memory_order_release);
+}
+
+WorkStealingPool::Task* WorkStealingPool::WorkerQueue::pop() noexcept
+{
+    // The bottom is reserved before the top is read. The sequentially consistent operations make sure that either
+    // this thread sees the top moved by a thief or the thief sees the new bottom, so the two can't take the same task.
+    int64_t bottom = (m_bottom.load(std::memory_order_relaxed) - 1);
+    Array* array = m_array.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_seq_cst);
+    int64_t top = m_top.load(std::memory_order_seq_cst);
+    if (top > bottom)
+    {
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return nullptr;
+    }
+
+    Task* task = array->slots[bottom & (array->capacity - 1)].load(std::memory_order_relaxed);
+    if (top == bottom)
+    {
+        // This is the last task, race the thieves for it
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            task = nullptr;
+        }
+        m_bottom.store(bottom + 1, std::memory_order_release);
+    }
+    return task;
+}
+
+WorkStealingPool::Task* WorkStealingPool::WorkerQueue::steal() noexcept
+{
+    int64_t top = m_top.load(std::memory_order_seq_cst);
+    int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+    if (top >= bottom)
+    {
+        return nullptr;
+    }
+
+    Array* array = m_array.load(std::memory_order_acquire);
+    Task* task = array->slots[top & (array->capacity - 1)].load(std::memory_order_relaxed);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return nullptr;
+    }
+    return task;
+}
+
+WorkStealingPool::WorkerQueue::Array* WorkStealingPool::WorkerQueue::grow(Array* array, int64_t top,
+    int64_t bottom)
+{
+    m_arrays.reserve(m_arrays.size() + 1);
+    m_arrays.emplace_back(new Array(2 * array->capacity));
+    Array* new_array = m_arrays.back().get();
+    for (int64_t i = top; i < bottom; ++i)
+    {
+        new_array->slots[i & (new_array->capacity - 1)].store(
+            array->slots[i & (array->capacity - 1)].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    m_array.store(new_array, std::memory_order_release);
+    return new_array;
+}
+
+WorkStealingPool::WorkStealingPool()
+    : WorkStealingPool(DefaultWorkerCount())
+{
+}
+
+WorkStealingPool::WorkStealingPool(size_t worker_count)
+{
+    for (size_t i = 0; i < worker_count; ++i)
+    {
+        m_worker_queues.emplace_back(new WorkerQueue());
+    }
+    m_workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i)
+    {
+        m_workers.emplace_back(&WorkStealingPool::work, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(m_idle_mutex);
+        m_stopping = true;
+    }
+    m_idle_condition.notify_all();
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+size_t WorkStealingPool::workerCount() const noexcept
+{
+    return m_workers.size();
+}
+
+void WorkStealingPool::run(TaskGroup& group, std::function<void()> task)
+{
+    // The counts are incremented first so that they never go below zero when the task is taken right away
+    group.m_pending_count.fetch_add(1, std::memory_order_relaxed);
+    m_queued_count.fetch_add(1, std::memory_order_relaxed);
+    Task* new_task = nullptr;
+    try
+    {
+        new_task = new Task{ std::move(task), &group };
+        push(currentQueueIndex(), new_task);
+    }
+    catch (...)
+    {
+        delete new_task;
+        m_queued_count.fetch_sub(1, std::memory_order_relaxed);
+        group.m_pending_count.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+
+    // Taking the lock makes sure a worker that found no task is either already waiting and gets the notification or
+    // hasn't checked m_queued_count yet and will see the new task
+    {
+        std::lock_guard<std::mutex> lock(m_idle_mutex);
+    }
+    m_idle_condition.notify_one();
+}
+
+void WorkStealingPool::wait(TaskGroup& group)
+{
+    size_t queue_index = currentQueueIndex();
+    while ((group.m_pending_count.load(std::memory_order_acquire) & ~waiting_flag) != 0)
+    {
+        Task* task = takeTask(queue_index);
+        if (task)
+        {
+            execute(task);
+            continue;
+        }
+
+        // The remaining tasks of the group are running in other threads. The flag is set under the lock so the
+        // thread that finishes the last one either sees it and notifies m_idle_condition after this thread has
+        // started waiting or finishes before the predicate is checked.
+        std::unique_lock<std::mutex> lock(m_idle_mutex);
+        group.m_pending_count.fetch_or(waiting_flag, std::memory_order_relaxed);
+        m_idle_condition.wait(lock,
+            [this, &group]()
+            {
+                return (((group.m_pending_count.load(std::memory_order_acquire) & ~waiting_flag) == 0)
+                    || (m_queued_count.load(std::memory_order_acquire) != 0));
+            });
+    }
+    group.m_pending_count.store(0, std::memory_order_relaxed);
+
+    if (group.m_exception)
+    {
+        std::exception_ptr exception = group.m_exception;
+        group.m_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void WorkStealingPool::work(size_t queue_index) noexcept
+{
+    current_pool = this;
+    current_queue_index = queue_index;
+
+    while (true)
+    {
+        Task* task = takeTask(queue_index);
+        if (task)
+        {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_idle_mutex);
+        m_idle_condition.wait(lock,
+            [this]() { return (m_stopping || (m_queued_count.load(std::memory_order_acquire) != 0)); });
+        if (m_stopping)
+        {
+            return;
+        }
+    }
+}
+
+size_t WorkStealingPool::currentQueueIndex() const noexcept
+{
+    if (current_pool == this)
+    {
+        return current_queue_index;
+    }
+    else
+    {
+        return m_worker_queues.size();
+    }
+}
+
+void WorkStealingPool::push(size_t queue_index, Task* task)
+{
+    if (queue_index < m_worker_queues.size())
+    {
+        m_worker_queues[queue_index]->push(task);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_shared_queue.mutex);
+        m_shared_queue.tasks.push_back(task);
+    }
+}
+
+WorkStealingPool::Task* WorkStealingPool::takeTask(size_t queue_index) noexcept
+{
+    if (m_queued_count.load(std::memory_order_acquire) == 0)
+    {
+        return nullptr;
+    }
+
+    // The newest task of our own queue, then the oldest task of the other queues starting with the next one so that
+    // the thieves don't all go for the same queue
+    Task* task = takeTask(queue_index, true);
+    size_t queue_count = (m_worker_queues.size() + 1);
+    for (size_t i = 1; !task && (i < queue_count); ++i)
+    {
+        task = takeTask(((queue_index + i) % queue_count), false);
+    }
+    if (task)
+    {
+        m_queued_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+WorkStealingPool::Task* WorkStealingPool::takeTask(size_t queue_index, bool own_queue) noexcept
+{
+    if (queue_index < m_worker_queues.size())
+    {
+        WorkerQueue& queue = *m_worker_queues[queue_index];
+        return (own_queue ? queue.pop() : queue.steal());
+    }
+
+    std::lock_guard<std::mutex> lock(m_shared_queue.mutex);
+    if (m_shared_queue.tasks.empty())
+    {
+        return nullptr;
+    }
+    Task* task = nullptr;
+    if (own_queue)
+    {
+        task = m_shared_queue.tasks.back();
+        m_shared_queue.tasks.pop_back();
+    }
+    else
+    {
+        task = m_shared_queue.tasks.front();
+        m_shared_queue.tasks.pop_front();
+    }
+    return task;
+}
+
+void WorkStealingPool::execute(Task* task) noexcept
+{
+    TaskGroup& group = *task->group;
+    try
+    {
+        task->function();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(group.m_exception_mutex);
+        if (!group.m_exception)
+        {
+            group.m_exception = std::current_exception();
+        }
+    }
+    delete task;
+
+    if (group.m_pending_count.fetch_sub(1, std::memory_order_acq_rel) == (waiting_flag | 1))
+    {
+        // Same as in run, taking the lock makes sure the waiting thread is already waiting and gets the notification
+        {
+            std::lock_guard<std::mutex> lock(m_idle_mutex);
+        }
+        m_idle_condition.notify_all();
+    }
+}
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ArenaAllocatorTests.hpp"
+#include "Ishiko/DataStructures/ArenaAllocator.hpp"
+#include <cstdint>
+#include <cstring>
+
+using namespace Ishiko;
+
+ArenaAllocatorTests::ArenaAllocatorTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "ArenaAllocator tests", context)
+{
+    append<HeapAllocationErrorsTest>("allocate test 1", AllocateTest1);
+    append<HeapAllocationErrorsTest>("allocate test 2", AllocateTest2);
+    append<HeapAllocationErrorsTest>("allocate test 3", AllocateTest3);
+    append<HeapAllocationErrorsTest>("reserve test 1", ReserveTest1);
+    append<HeapAllocationErrorsTest>("release test 1", ReleaseTest1);
+}
+
+void ArenaAllocatorTests::AllocateTest1(Test& test)
+{
+    ArenaAllocator allocator;
+
+    void* memory1 = allocator.allocate(1);
+    void* memory2 = allocator.allocate(24);
+    std::memset(memory1, 0xFF, 1);
+    std::memset(memory2, 0xFF, 24);
+
+    ISHIKO_TEST_ABORT_IF(memory1 == nullptr);
+    ISHIKO_TEST_ABORT_IF(memory2 == nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(reinterpret_cast<uintptr_t>(memory1) % ArenaAllocator::alignment, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(reinterpret_cast<uintptr_t>(memory2) % ArenaAllocator::alignment, 0);
+    // Blocks are carved one after the other out of the same slab
+    ISHIKO_TEST_FAIL_IF(static_cast<char*>(memory2) != (static_cast<char*>(memory1) + ArenaAllocator::alignment));
+    ISHIKO_TEST_PASS();
+}
+
+void ArenaAllocatorTests::AllocateTest2(Test& test)
+{
+    ArenaAllocator allocator(1024);
+
+    void* memory = allocator.allocate(4096);
+    std::memset(memory, 0xFF, 4096);
+
+    ISHIKO_TEST_FAIL_IF(memory == nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void ArenaAllocatorTests::AllocateTest3(Test& test)
+{
+    ArenaAllocator allocator;
+
+    Error error;
+    void* memory = allocator.allocate(100, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF(memory == nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void ArenaAllocatorTests::ReserveTest1(Test& test)
+{
+    ArenaAllocator allocator(1024);
+
+    allocator.reserve(1000, 32);
+    char* first_block = static_cast<char*>(allocator.allocate(32));
+    char* last_block = nullptr;
+    for (size_t i = 1; i < 1000; ++i)
+    {
+        last_block = static_cast<char*>(allocator.allocate(32));
+    }
+
+    // All the blocks come from the slab allocated by reserve
+    ISHIKO_TEST_FAIL_IF(last_block != (first_block + (999 * 32)));
+    ISHIKO_TEST_PASS();
+}
+
+void ArenaAllocatorTests::ReleaseTest1(Test& test)
+{
+    ArenaAllocator allocator(1024);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        allocator.allocate(64);
+    }
+
+    allocator.release();
+    void* memory = allocator.allocate(64);
+
+    ISHIKO_TEST_FAIL_IF(memory == nullptr);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_ARENAALLOCATORTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_ARENAALLOCATORTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class ArenaAllocatorTests : public Ishiko::TestSequence
+{
+public:
+    ArenaAllocatorTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void AllocateTest1(Ishiko::Test& test);
+    static void AllocateTest2(Ishiko::Test& test);
+    static void AllocateTest3(Ishiko::Test& test);
+    static void ReserveTest1(Ishiko::Test& test);
+    static void ReleaseTest1(Ishiko::Test& test);
+};
+
+#endif
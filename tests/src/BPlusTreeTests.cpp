@@ -0,0 +1,655 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "BPlusTreeTests.hpp"
+#include "Ishiko/DataStructures/ArenaAllocator.hpp"
+#include "Ishiko/DataStructures/BPlusTree.hpp"
+#include "Ishiko/DataStructures/PoolAllocator.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    // Small nodes so that a few thousand values are enough to get a tree with several levels of inner nodes
+    typedef BPlusTree<int, std::less<int>, 64> SmallNodeBPlusTree;
+    typedef BPlusTree<int, std::greater<int>> DescendingBPlusTree;
+    typedef BPlusTree<int64_t, std::less<int64_t>, 64> Int64BPlusTree;
+    typedef BPlusTree<uint32_t, std::less<uint32_t>, 64> UInt32BPlusTree;
+    typedef BPlusTree<std::string, std::less<std::string>, 192> StringBPlusTree;
+
+    // Returns true if the leaves hold exactly the values of expected_values in order, every leaf but a lone root is
+    // at least half full and every value can be found
+    template<class Tree, class Set>
+    bool isValid(const Tree& tree, const Set& expected_values)
+    {
+        if (tree.size() != expected_values.size())
+        {
+            return false;
+        }
+        typename Set::const_iterator expected_it = expected_values.begin();
+        const typename Tree::LeafNode* leaf = tree.begin().leaf();
+        while (leaf)
+        {
+            if ((leaf->size() == 0) || ((tree.height() > 1) && (leaf->size() < (Tree::leaf_capacity / 2))))
+            {
+                return false;
+            }
+            for (size_t i = 0; i < leaf->size(); ++i)
+            {
+                if ((expected_it == expected_values.end()) || (leaf->data(i) != *expected_it))
+                {
+                    return false;
+                }
+                ++expected_it;
+            }
+            leaf = leaf->nextLeaf();
+        }
+        if (expected_it != expected_values.end())
+        {
+            return false;
+        }
+        for (const typename Set::value_type& value : expected_values)
+        {
+            typename Tree::ConstIterator it = tree.find(value);
+            if ((it == tree.end()) || (*it != value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Compares the key search with std::lower_bound and std::upper_bound for all the prefixes of keys, which must be
+    // sorted
+    template<class DataType>
+    bool checkKeySearch(const std::vector<DataType>& keys, const std::vector<DataType>& values)
+    {
+        typedef BPlusTreeKeySearch<DataType, std::less<DataType>> KeySearch;
+        std::less<DataType> compare;
+        for (size_t size = 0; size <= keys.size(); ++size)
+        {
+            for (const DataType& value : values)
+            {
+                size_t expected_lower_bound =
+                    (std::lower_bound(keys.begin(), keys.begin() + size, value) - keys.begin());
+                size_t expected_upper_bound =
+                    (std::upper_bound(keys.begin(), keys.begin() + size, value) - keys.begin());
+                if ((KeySearch::LowerBound(keys.data(), size, value, compare) != expected_lower_bound)
+                    || (KeySearch::UpperBound(keys.data(), size, value, compare) != expected_upper_bound))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // 40 sorted keys with runs of equal keys, spread over the whole range of DataType so that the comparisons of the
+    // unsigned types differ from the signed ones
+    template<class DataType>
+    std::vector<DataType> makeKeys()
+    {
+        std::vector<DataType> keys;
+        DataType step = ((std::numeric_limits<DataType>::max() / 30) - (std::numeric_limits<DataType>::min() / 30));
+        DataType key = std::numeric_limits<DataType>::min();
+        for (int i = 0; i < 40; ++i)
+        {
+            keys.push_back(key);
+            if ((i % 3) != 0)
+            {
+                key += step;
+            }
+        }
+        return keys;
+    }
+
+    template<class DataType>
+    std::vector<DataType> makeSearchedValues(const std::vector<DataType>& keys)
+    {
+        std::vector<DataType> values = keys;
+        for (const DataType& key : keys)
+        {
+            if (key != std::numeric_limits<DataType>::max())
+            {
+                values.push_back(key + 1);
+            }
+            if (key != std::numeric_limits<DataType>::min())
+            {
+                values.push_back(key - 1);
+            }
+        }
+        values.push_back(std::numeric_limits<DataType>::max());
+        return values;
+    }
+}
+
+BPlusTreeTests::BPlusTreeTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "BPlusTree tests", context)
+{
+    append<HeapAllocationErrorsTest>("BPlusTreeKeySearch test 1", KeySearchTest1);
+    append<HeapAllocationErrorsTest>("BPlusTreeKeySearch test 2", KeySearchTest2);
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("Constructor test 2", ConstructorTest2);
+    append<HeapAllocationErrorsTest>("Constructor test 3", ConstructorTest3);
+    append<HeapAllocationErrorsTest>("insert test 1", InsertTest1);
+    append<HeapAllocationErrorsTest>("insert test 2", InsertTest2);
+    append<HeapAllocationErrorsTest>("insert test 3", InsertTest3);
+    append<HeapAllocationErrorsTest>("insert test 4", InsertTest4);
+    append<HeapAllocationErrorsTest>("emplace test 1", EmplaceTest1);
+    append<HeapAllocationErrorsTest>("find test 1", FindTest1);
+    append<HeapAllocationErrorsTest>("find test 2", FindTest2);
+    append<HeapAllocationErrorsTest>("lowerBound test 1", LowerBoundTest1);
+    append<HeapAllocationErrorsTest>("upperBound test 1", UpperBoundTest1);
+    append<HeapAllocationErrorsTest>("scan test 1", ScanTest1);
+    append<HeapAllocationErrorsTest>("Iterator test 1", IteratorTest1);
+    append<HeapAllocationErrorsTest>("erase test 1", EraseTest1);
+    append<HeapAllocationErrorsTest>("erase test 2", EraseTest2);
+    append<HeapAllocationErrorsTest>("erase test 3", EraseTest3);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+    append<HeapAllocationErrorsTest>("clear test 2", ClearTest2);
+}
+
+// The integer keys are searched with the vector instructions when they are available
+void BPlusTreeTests::KeySearchTest1(Test& test)
+{
+    std::vector<int32_t> int32_keys = makeKeys<int32_t>();
+    std::vector<uint32_t> uint32_keys = makeKeys<uint32_t>();
+    std::vector<int64_t> int64_keys = makeKeys<int64_t>();
+    std::vector<uint64_t> uint64_keys = makeKeys<uint64_t>();
+
+    ISHIKO_TEST_FAIL_IF_NOT(checkKeySearch(int32_keys, makeSearchedValues(int32_keys)));
+    ISHIKO_TEST_FAIL_IF_NOT(checkKeySearch(uint32_keys, makeSearchedValues(uint32_keys)));
+    ISHIKO_TEST_FAIL_IF_NOT(checkKeySearch(int64_keys, makeSearchedValues(int64_keys)));
+    ISHIKO_TEST_FAIL_IF_NOT(checkKeySearch(uint64_keys, makeSearchedValues(uint64_keys)));
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::KeySearchTest2(Test& test)
+{
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    for (char c = 'a'; c <= 'z'; ++c)
+    {
+        keys.push_back(std::string(2, c));
+        keys.push_back(std::string(2, c));
+        values.push_back(std::string(1, c));
+        values.push_back(std::string(2, c));
+        values.push_back(std::string(3, c));
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(checkKeySearch(keys, values));
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::ConstructorTest1(Test& test)
+{
+    BPlusTree<int> tree;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.height(), 0);
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF(tree.begin() != tree.end());
+    ISHIKO_TEST_FAIL_IF(tree.contains(0));
+    ISHIKO_TEST_FAIL_IF(tree.lowerBound(0) != tree.end());
+    ISHIKO_TEST_FAIL_IF_NOT(BPlusTree<int>::leaf_capacity >= 32);
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::ConstructorTest2(Test& test)
+{
+    std::vector<int> values;
+    std::set<int> expected_values;
+    for (int i = 0; i < 10000; ++i)
+    {
+        values.push_back(i);
+        if ((i % 7) == 0)
+        {
+            values.push_back(i);
+        }
+        expected_values.insert(i);
+    }
+
+    SmallNodeBPlusTree tree(values.begin(), values.end());
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 10000);
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree, expected_values));
+
+    // The tree built in bulk can be modified like any other
+    for (int i = 0; i < 10000; i += 3)
+    {
+        tree.erase(i);
+        expected_values.erase(i);
+    }
+    for (int i = 10000; i < 11000; ++i)
+    {
+        tree.insert(i);
+        expected_values.insert(i);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree, expected_values));
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::ConstructorTest3(Test& test)
+{
+    std::vector<int> no_values;
+    BPlusTree<int> empty_tree(no_values.begin(), no_values.end());
+
+    ISHIKO_TEST_FAIL_IF_NOT(empty_tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF(empty_tree.begin() != empty_tree.end());
+
+    // Enough values for a full leaf and one more, the last leaf gets values back from the one before it
+    std::set<int> expected_values;
+    for (int i = 0; i <= static_cast<int>(SmallNodeBPlusTree::leaf_capacity); ++i)
+    {
+        expected_values.insert(i);
+    }
+    SmallNodeBPlusTree tree(expected_values.begin(), expected_values.end());
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.height(), 2);
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree, expected_values));
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::InsertTest1(Test& test)
+{
+    BPlusTree<int> tree;
+
+    bool inserted1 = tree.insert(5);
+    bool inserted2 = tree.insert(5);
+
+    ISHIKO_TEST_FAIL_IF_NOT(inserted1);
+    ISHIKO_TEST_FAIL_IF(inserted2);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.height(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(*tree.begin(), 5);
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::InsertTest2(Test& test)
+{
+    SmallNodeBPlusTree ascending_tree;
+    SmallNodeBPlusTree descending_tree;
+    SmallNodeBPlusTree random_tree;
+
+    std::set<int> expected_values;
+    std::vector<int> values;
+    for (int i = 0; i < 5000; ++i)
+    {
+        ascending_tree.insert(i);
+        descending_tree.insert(4999 - i);
+        values.push_back(i);
+        expected_values.insert(i);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(42));
+    for (int value : values)
+    {
+        random_tree.insert(value);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(ascending_tree, expected_values));
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(descending_tree, expected_values));
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(random_tree, expected_values));
+    ISHIKO_TEST_FAIL_IF(random_tree.height() < 5);
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::InsertTest3(Test& test)
+{
+    StringBPlusTree tree;
+    std::set<std::string> expected_values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string value = std::to_string((i * 7919) % 1000);
+        tree.insert(std::move(value));
+        expected_values.insert(std::to_string(i));
+    }
+
+    // A value that is already in the tree must not be moved from
+    std::string duplicate = "123";
+    bool inserted = tree.insert(std::move(duplicate));
+
+    ISHIKO_TEST_FAIL_IF(inserted);
+    ISHIKO_TEST_FAIL_IF_NEQ(duplicate, "123");
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree, expected_values));
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::InsertTest4(Test& test)
+{
+    SmallNodeBPlusTree tree;
+    std::set<int> expected_values;
+
+    Error error;
+    for (int i = 0; i < 1000; ++i)
+    {
+        int value = ((i * 37) % 1000);
+        tree.insert(value, error);
+        expected_values.insert(value);
+    }
+    bool inserted = tree.insert(5, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF(inserted);
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree, expected_values));
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::EmplaceTest1(Test& test)
+{
+    StringBPlusTree tree;
+
+    bool emplaced1 = tree.emplace(3, 'a');
+    bool emplaced2 = tree.emplace("aaa");
+    bool emplaced3 = tree.emplace(2, 'b');
+
+    ISHIKO_TEST_FAIL_IF_NOT(emplaced1);
+    ISHIKO_TEST_FAIL_IF(emplaced2);
+    ISHIKO_TEST_FAIL_IF_NOT(emplaced3);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NOT(tree.contains("bb"));
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::FindTest1(Test& test)
+{
+    SmallNodeBPlusTree tree;
+    for (int i = 0; i < 1000; i += 2)
+    {
+        tree.insert(i);
+    }
+
+    SmallNodeBPlusTree::ConstIterator it1 = tree.find(42);
+    SmallNodeBPlusTree::ConstIterator it2 = tree.find(43);
+
+    ISHIKO_TEST_ABORT_IF(it1 == tree.end());
+    ISHIKO_TEST_FAIL_IF_NEQ(*it1, 42);
+    ISHIKO_TEST_FAIL_IF(it2 != tree.end());
+    ISHIKO_TEST_FAIL_IF_NOT(tree.contains(0));
+    ISHIKO_TEST_FAIL_IF_NOT(tree.contains(998));
+    ISHIKO_TEST_FAIL_IF(tree.contains(-1));
+    ISHIKO_TEST_FAIL_IF(tree.contains(999));
+    ISHIKO_TEST_PASS();
+}
+
+// 64 bit and unsigned keys whose order differs from the order of their signed 32 bit halves
+void BPlusTreeTests::FindTest2(Test& test)
+{
+    Int64BPlusTree int64_tree;
+    UInt32BPlusTree uint32_tree;
+    std::set<int64_t> expected_int64_values;
+    std::set<uint32_t> expected_uint32_values;
+    std::mt19937_64 generator(7);
+    for (int i = 0; i < 2000; ++i)
+    {
+        uint64_t value = generator();
+        int64_tree.insert(static_cast<int64_t>(value));
+        expected_int64_values.insert(static_cast<int64_t>(value));
+        uint32_tree.insert(static_cast<uint32_t>(value));
+        expected_uint32_values.insert(static_cast<uint32_t>(value));
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(int64_tree, expected_int64_values));
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(uint32_tree, expected_uint32_values));
+    ISHIKO_TEST_FAIL_IF_NEQ(*int64_tree.lowerBound(std::numeric_limits<int64_t>::min()),
+        *expected_int64_values.begin());
+    ISHIKO_TEST_FAIL_IF_NEQ(*uint32_tree.lowerBound(0), *expected_uint32_values.begin());
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::LowerBoundTest1(Test& test)
+{
+    SmallNodeBPlusTree tree;
+    for (int i = 0; i < 1000; i += 2)
+    {
+        tree.insert(i);
+    }
+
+    bool all_correct = true;
+    for (int i = -1; i < 998; ++i)
+    {
+        SmallNodeBPlusTree::ConstIterator it = tree.lowerBound(i);
+        if ((it == tree.end()) || (*it != (((i + 1) / 2) * 2)))
+        {
+            all_correct = false;
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(all_correct);
+    ISHIKO_TEST_FAIL_IF(tree.lowerBound(999) != tree.end());
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::UpperBoundTest1(Test& test)
+{
+    SmallNodeBPlusTree tree;
+    for (int i = 0; i < 1000; i += 2)
+    {
+        tree.insert(i);
+    }
+
+    bool all_correct = true;
+    for (int i = -1; i < 997; ++i)
+    {
+        SmallNodeBPlusTree::ConstIterator it = tree.upperBound(i);
+        if ((it == tree.end()) || (*it != (((i + 2) / 2) * 2)))
+        {
+            all_correct = false;
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(all_correct);
+    ISHIKO_TEST_FAIL_IF(tree.upperBound(998) != tree.end());
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::ScanTest1(Test& test)
+{
+    SmallNodeBPlusTree tree;
+    for (int i = 0; i < 1000; ++i)
+    {
+        tree.insert(i);
+    }
+
+    std::vector<int> output;
+    size_t count1 = tree.scan(100, 200, [&output](int value) { output.push_back(value); return true; });
+    size_t count2 = tree.scan(500, 1000, [](int value) { return (value < 509); });
+    size_t count3 = tree.scan(2000, 3000, [](int) { return true; });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count1, 100);
+    ISHIKO_TEST_ABORT_IF_NEQ(output.size(), 100);
+    ISHIKO_TEST_FAIL_IF_NEQ(output.front(), 100);
+    ISHIKO_TEST_FAIL_IF_NEQ(output.back(), 199);
+    ISHIKO_TEST_FAIL_IF_NEQ(count2, 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(count3, 0);
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::IteratorTest1(Test& test)
+{
+    DescendingBPlusTree tree;
+    std::vector<int> values;
+    for (int i = 0; i < 500; ++i)
+    {
+        values.push_back(i);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(7));
+    for (int value : values)
+    {
+        tree.insert(value);
+    }
+
+    std::vector<int> visited(tree.begin(), tree.end());
+
+    ISHIKO_TEST_ABORT_IF_NEQ(visited.size(), 500);
+    for (size_t i = 0; i < visited.size(); ++i)
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(visited[i], static_cast<int>(499 - i));
+    }
+    ISHIKO_TEST_FAIL_IF_NEQ(*++tree.find(250), 249);
+    ISHIKO_TEST_FAIL_IF(++tree.find(0) != tree.end());
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::EraseTest1(Test& test)
+{
+    BPlusTree<int> tree;
+    tree.insert(1);
+    tree.insert(2);
+    tree.insert(3);
+
+    bool erased1 = tree.erase(2);
+    bool erased2 = tree.erase(2);
+
+    ISHIKO_TEST_FAIL_IF_NOT(erased1);
+    ISHIKO_TEST_FAIL_IF(erased2);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 2);
+    ISHIKO_TEST_FAIL_IF(tree.contains(2));
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::EraseTest2(Test& test)
+{
+    SmallNodeBPlusTree tree;
+    std::set<int> expected_values;
+    std::vector<int> values;
+    for (int i = 0; i < 3000; ++i)
+    {
+        values.push_back(i);
+    }
+    std::mt19937 generator(1234);
+    std::shuffle(values.begin(), values.end(), generator);
+    for (int value : values)
+    {
+        tree.insert(value);
+        expected_values.insert(value);
+    }
+
+    // Erase in a different random order, checking the tree regularly hits all the borrowing and merging cases on the
+    // way down to an empty tree
+    std::shuffle(values.begin(), values.end(), generator);
+    bool valid = true;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_NOT(tree.erase(values[i]));
+        expected_values.erase(values[i]);
+        if ((i % 50) == 0)
+        {
+            valid = (valid && isValid(tree, expected_values));
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(valid);
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.height(), 0);
+    ISHIKO_TEST_FAIL_IF(tree.begin() != tree.end());
+    ISHIKO_TEST_PASS();
+}
+
+// Random inserts and erases of strings, which aren't trivially copyable, against std::set
+void BPlusTreeTests::EraseTest3(Test& test)
+{
+    StringBPlusTree tree;
+    std::set<std::string> expected_values;
+    std::mt19937 generator(99);
+    std::uniform_int_distribution<int> distribution(0, 999);
+    bool same_results = true;
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string value = std::to_string(distribution(generator));
+        if ((i % 3) == 0)
+        {
+            same_results = (same_results && (tree.erase(value) == (expected_values.erase(value) == 1)));
+        }
+        else
+        {
+            same_results = (same_results && (tree.insert(value) == expected_values.insert(value).second));
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(same_results);
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree, expected_values));
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::StatisticsTest1(Test& test)
+{
+    std::vector<int> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(i);
+    }
+    SmallNodeBPlusTree tree(values.begin(), values.end());
+
+    ContainerStatistics statistics = tree.statistics();
+
+    // The bulk load fills every leaf but the last one or two
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_count, 1000);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.height, tree.height());
+    ISHIKO_TEST_FAIL_IF(statistics.spare_bytes > (SmallNodeBPlusTree::leaf_capacity * sizeof(int)));
+    ISHIKO_TEST_FAIL_IF(statistics.element_bytes < (1000 * sizeof(int)));
+    ISHIKO_TEST_FAIL_IF(statistics.has_allocation_statistics);
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::ClearTest1(Test& test)
+{
+    StringBPlusTree tree;
+    for (int i = 0; i < 10000; ++i)
+    {
+        tree.insert(std::to_string(i));
+    }
+
+    tree.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 0);
+    ISHIKO_TEST_FAIL_IF(tree.begin() != tree.end());
+
+    tree.insert("3");
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 1);
+    ISHIKO_TEST_PASS();
+}
+
+void BPlusTreeTests::ClearTest2(Test& test)
+{
+    BPlusTree<int, std::less<int>, 64, ArenaAllocator> arena_tree;
+    BPlusTree<int, std::less<int>, 64, PoolAllocator> pool_tree;
+    arena_tree.reserve(1000);
+    pool_tree.reserve(1000);
+    std::set<int> expected_values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        arena_tree.insert(i);
+        pool_tree.insert(i);
+        expected_values.insert(i);
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        arena_tree.erase(i);
+        pool_tree.erase(i);
+        expected_values.erase(i);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(arena_tree, expected_values));
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(pool_tree, expected_values));
+
+    arena_tree.clear();
+    pool_tree.clear();
+    arena_tree.insert(3);
+    pool_tree.insert(3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(arena_tree.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(pool_tree.size(), 1);
+    ISHIKO_TEST_PASS();
+}
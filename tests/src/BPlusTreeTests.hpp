@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_BPLUSTREETESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_BPLUSTREETESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class BPlusTreeTests : public Ishiko::TestSequence
+{
+public:
+    BPlusTreeTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void KeySearchTest1(Ishiko::Test& test);
+    static void KeySearchTest2(Ishiko::Test& test);
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void ConstructorTest2(Ishiko::Test& test);
+    static void ConstructorTest3(Ishiko::Test& test);
+    static void InsertTest1(Ishiko::Test& test);
+    static void InsertTest2(Ishiko::Test& test);
+    static void InsertTest3(Ishiko::Test& test);
+    static void InsertTest4(Ishiko::Test& test);
+    static void EmplaceTest1(Ishiko::Test& test);
+    static void FindTest1(Ishiko::Test& test);
+    static void FindTest2(Ishiko::Test& test);
+    static void LowerBoundTest1(Ishiko::Test& test);
+    static void UpperBoundTest1(Ishiko::Test& test);
+    static void ScanTest1(Ishiko::Test& test);
+    static void IteratorTest1(Ishiko::Test& test);
+    static void EraseTest1(Ishiko::Test& test);
+    static void EraseTest2(Ishiko::Test& test);
+    static void EraseTest3(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+    static void ClearTest2(Ishiko::Test& test);
+};
+
+#endif
@@ -2,11 +2,69 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "BinaryTreeTests.hpp"
+#include "Ishiko/DataStructures/ArenaAllocator.hpp"
 #include "Ishiko/DataStructures/BinaryTree.hpp"
+#include "Ishiko/DataStructures/CountingAllocator.hpp"
+#include <atomic>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace Ishiko;
 
+namespace
+{
+    // Builds a tree with 5 at the root, 3 and 8 as its children, 1 and 4 as the children of 3, 7 and 9 as the
+    // children of 8, 2 as the right child of 1 and 6 as the left child of 7. Returns the node holding 3.
+    BinaryTree<int>::Node* buildTree(BinaryTree<int>& tree)
+    {
+        tree.setRoot(5);
+        BinaryTree<int>::Node* node3 = tree.insertLeft(3, tree.root());
+        BinaryTree<int>::Node* node8 = tree.insertRight(8, tree.root());
+        BinaryTree<int>::Node* node1 = tree.insertLeft(1, node3);
+        tree.insertRight(4, node3);
+        tree.insertRight(2, node1);
+        BinaryTree<int>::Node* node7 = tree.insertLeft(7, node8);
+        tree.insertRight(9, node8);
+        tree.insertLeft(6, node7);
+        return node3;
+    }
+
+    // A tree deep enough to overflow the stack if it was walked recursively
+    void buildDegenerateTree(BinaryTree<int>& tree)
+    {
+        tree.setRoot(0);
+        BinaryTree<int>::Node* node = tree.root();
+        for (int i = 1; i < 1000000; ++i)
+        {
+            if ((i % 2) == 0)
+            {
+                node = tree.insertLeft(i, node);
+            }
+            else
+            {
+                node = tree.insertRight(i, node);
+            }
+        }
+    }
+
+    // A root with a chain of left children holding -1, -2, ... and a chain of right children holding 1, 2, ... Every
+    // level has one node at each end of the tree, which is the worst case of the level order traversal without a
+    // queue.
+    void buildForkTree(BinaryTree<int>& tree, int depth)
+    {
+        tree.setRoot(0);
+        BinaryTree<int>::Node* left_node = tree.root();
+        BinaryTree<int>::Node* right_node = tree.root();
+        for (int i = 1; i <= depth; ++i)
+        {
+            left_node = tree.insertLeft(-i, left_node);
+            right_node = tree.insertRight(i, right_node);
+        }
+    }
+}
+
 BinaryTreeTests::BinaryTreeTests(const TestNumber& number, const TestContext& context)
     : TestSequence(number, "BinaryTree tests", context)
 {
@@ -16,17 +74,47 @@ BinaryTreeTests::BinaryTreeTests(const TestNumber& number, const TestContext& co
     append<HeapAllocationErrorsTest>("setRoot test 2", SetRootTest2);
     append<HeapAllocationErrorsTest>("setRoot test 3", SetRootTest3);
     append<HeapAllocationErrorsTest>("setRoot test 4", SetRootTest4);
+    append<HeapAllocationErrorsTest>("setRoot test 5", SetRootTest5);
     append<HeapAllocationErrorsTest>("insertLeft test 1", InsertLeftTest1);
     append<HeapAllocationErrorsTest>("insertLeft test 2", InsertLeftTest2);
+    append<HeapAllocationErrorsTest>("emplaceLeft test 1", EmplaceLeftTest1);
     append<HeapAllocationErrorsTest>("insertRight test 1", InsertRightTest1);
     append<HeapAllocationErrorsTest>("insertRight test 2", InsertRightTest2);
+    append<HeapAllocationErrorsTest>("emplaceRight test 1", EmplaceRightTest1);
     append<HeapAllocationErrorsTest>("doInorderTraversal test 1", DoInorderTraversalTest1);
     append<HeapAllocationErrorsTest>("doInorderTraversal test 2", DoInorderTraversalTest2);
     append<HeapAllocationErrorsTest>("doInorderTraversal test 3", DoInorderTraversalTest3);
+    append<HeapAllocationErrorsTest>("doInorderTraversal test 4", DoInorderTraversalTest4);
+    append<HeapAllocationErrorsTest>("doInorderTraversal test 5", DoInorderTraversalTest5);
+    append<HeapAllocationErrorsTest>("doInorderTraversal test 6", DoInorderTraversalTest6);
+    append<HeapAllocationErrorsTest>("doPreorderTraversal test 1", DoPreorderTraversalTest1);
+    append<HeapAllocationErrorsTest>("doPreorderTraversal test 2", DoPreorderTraversalTest2);
+    append<HeapAllocationErrorsTest>("doPostorderTraversal test 1", DoPostorderTraversalTest1);
+    append<HeapAllocationErrorsTest>("doPostorderTraversal test 2", DoPostorderTraversalTest2);
+    append<HeapAllocationErrorsTest>("doLevelOrderTraversal test 1", DoLevelOrderTraversalTest1);
+    append<HeapAllocationErrorsTest>("doLevelOrderTraversal test 2", DoLevelOrderTraversalTest2);
+    append<HeapAllocationErrorsTest>("doLevelOrderTraversal test 3", DoLevelOrderTraversalTest3);
+    append<HeapAllocationErrorsTest>("doLevelOrderTraversal test 4", DoLevelOrderTraversalTest4);
+    append<HeapAllocationErrorsTest>("doLevelOrderTraversal test 5", DoLevelOrderTraversalTest5);
+    append<HeapAllocationErrorsTest>("Iterator test 1", IteratorTest1);
+    append<HeapAllocationErrorsTest>("Iterator test 2", IteratorTest2);
+    append<HeapAllocationErrorsTest>("Iterator test 3", IteratorTest3);
+    append<HeapAllocationErrorsTest>("parallelTraversal test 1", ParallelTraversalTest1);
+    append<HeapAllocationErrorsTest>("parallelTraversal test 2", ParallelTraversalTest2);
+    append<HeapAllocationErrorsTest>("parallelReduce test 1", ParallelReduceTest1);
+    append<HeapAllocationErrorsTest>("parallelReduce test 2", ParallelReduceTest2);
+    append<HeapAllocationErrorsTest>("parallelReduce test 3", ParallelReduceTest3);
+    append<HeapAllocationErrorsTest>("freeze test 1", FreezeTest1);
+    append<HeapAllocationErrorsTest>("freeze test 2", FreezeTest2);
     append<HeapAllocationErrorsTest>("rotateLeft test 1", RotateLeftTest1);
     append<HeapAllocationErrorsTest>("rotateLeft test 2", RotateLeftTest2);
     append<HeapAllocationErrorsTest>("rotateRight test 1", RotateRightTest1);
     append<HeapAllocationErrorsTest>("rotateRight test 2", RotateRightTest2);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+    append<HeapAllocationErrorsTest>("clear test 2", ClearTest2);
+    append<HeapAllocationErrorsTest>("clear test 3", ClearTest3);
+    append<HeapAllocationErrorsTest>("Destructor test 1", DestructorTest1);
 }
 
 void BinaryTreeTests::ConstructorTest1(Test& test)
@@ -137,6 +225,24 @@ void BinaryTreeTests::SetRootTest4(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void BinaryTreeTests::SetRootTest5(Test& test)
+{
+    Error error;
+
+    BinaryTree<std::unique_ptr<int>> tree;
+    std::unique_ptr<int> data(new int(5));
+    tree.setRoot(std::move(data), error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(data.get(), nullptr);
+
+    BinaryTree<std::unique_ptr<int>>::Node* root_node = tree.root();
+
+    ISHIKO_TEST_ABORT_IF_EQ(root_node->data().get(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(*root_node->data(), 5);
+    ISHIKO_TEST_PASS();
+}
+
 void BinaryTreeTests::InsertLeftTest1(Test& test)
 {
     BinaryTree<int> tree;
@@ -195,6 +301,21 @@ void BinaryTreeTests::InsertLeftTest2(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void BinaryTreeTests::EmplaceLeftTest1(Test& test)
+{
+    BinaryTree<std::string> tree;
+    tree.setRoot("root");
+
+    BinaryTree<std::string>::Node* root_node = tree.root();
+    BinaryTree<std::string>::Node* left_child_node = tree.emplaceLeft(root_node, 3, 'a');
+
+    ISHIKO_TEST_ABORT_IF_EQ(left_child_node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(root_node->leftChildNode(), left_child_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(left_child_node->parentNode(), root_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(left_child_node->data(), "aaa");
+    ISHIKO_TEST_PASS();
+}
+
 void BinaryTreeTests::InsertRightTest1(Test& test)
 {
     BinaryTree<int> tree;
@@ -253,6 +374,21 @@ void BinaryTreeTests::InsertRightTest2(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void BinaryTreeTests::EmplaceRightTest1(Test& test)
+{
+    BinaryTree<std::unique_ptr<int>> tree;
+    tree.setRoot(std::unique_ptr<int>(new int(5)));
+
+    BinaryTree<std::unique_ptr<int>>::Node* root_node = tree.root();
+    BinaryTree<std::unique_ptr<int>>::Node* right_child_node = tree.emplaceRight(root_node, new int(7));
+
+    ISHIKO_TEST_ABORT_IF_EQ(right_child_node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(root_node->rightChildNode(), right_child_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(right_child_node->parentNode(), root_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(*right_child_node->data(), 7);
+    ISHIKO_TEST_PASS();
+}
+
 void BinaryTreeTests::DoInorderTraversalTest1(Test& test)
 {
     BinaryTree<int> tree;
@@ -308,6 +444,352 @@ void BinaryTreeTests::DoInorderTraversalTest3(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void BinaryTreeTests::DoInorderTraversalTest4(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+
+    std::vector<int> output;
+    tree.doInorderTraversal([&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoInorderTraversalTest5(Test& test)
+{
+    BinaryTree<int> tree;
+    const BinaryTree<int>::Node* subtree_root = buildTree(tree);
+
+    std::vector<int> output;
+    tree.doInorderTraversal(subtree_root, [&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({1, 2, 3, 4}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoInorderTraversalTest6(Test& test)
+{
+    BinaryTree<int> tree;
+    buildDegenerateTree(tree);
+
+    size_t count = 0;
+    int first = -1;
+    int last = -1;
+    tree.doInorderTraversal(
+        [&count, &first, &last](int data)
+        {
+            if (count == 0)
+            {
+                first = data;
+            }
+            last = data;
+            ++count;
+        });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count, 1000000);
+    ISHIKO_TEST_FAIL_IF_NEQ(first, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(last, 1);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoPreorderTraversalTest1(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+
+    std::vector<int> output;
+    tree.doPreorderTraversal([&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({5, 3, 1, 2, 4, 8, 7, 6, 9}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoPreorderTraversalTest2(Test& test)
+{
+    BinaryTree<int> tree;
+    const BinaryTree<int>::Node* subtree_root = buildTree(tree);
+
+    std::vector<int> output;
+    tree.doPreorderTraversal(subtree_root, [&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({3, 1, 2, 4}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoPostorderTraversalTest1(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+
+    std::vector<int> output;
+    tree.doPostorderTraversal([&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({2, 1, 4, 3, 6, 7, 9, 8, 5}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoPostorderTraversalTest2(Test& test)
+{
+    BinaryTree<int> tree;
+    const BinaryTree<int>::Node* subtree_root = buildTree(tree);
+
+    std::vector<int> output;
+    tree.doPostorderTraversal(subtree_root, [&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({2, 1, 4, 3}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoLevelOrderTraversalTest1(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+
+    std::vector<int> output;
+    tree.doLevelOrderTraversal([&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({5, 3, 8, 1, 4, 7, 9, 2, 6}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoLevelOrderTraversalTest2(Test& test)
+{
+    BinaryTree<int> tree;
+    const BinaryTree<int>::Node* subtree_root = buildTree(tree);
+
+    std::vector<int> output;
+    tree.doLevelOrderTraversal(subtree_root, [&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({3, 1, 4, 2}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoLevelOrderTraversalTest3(Test& test)
+{
+    BinaryTree<int> tree;
+    buildDegenerateTree(tree);
+
+    size_t count = 0;
+    int first = -1;
+    int last = -1;
+    tree.doLevelOrderTraversal(
+        [&count, &first, &last](int data)
+        {
+            if (count == 0)
+            {
+                first = data;
+            }
+            last = data;
+            ++count;
+        });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count, 1000000);
+    ISHIKO_TEST_FAIL_IF_NEQ(first, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(last, 999999);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoLevelOrderTraversalTest4(Test& test)
+{
+    BinaryTree<int> tree;
+    buildForkTree(tree, 10000);
+
+    std::vector<int> output;
+    tree.doLevelOrderTraversal([&output](int data) { output.push_back(data); });
+
+    std::vector<int> expected_output(1, 0);
+    for (int i = 1; i <= 10000; ++i)
+    {
+        expected_output.push_back(-i);
+        expected_output.push_back(i);
+    }
+    ISHIKO_TEST_FAIL_IF_NEQ(output, expected_output);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DoLevelOrderTraversalTest5(Test& test)
+{
+    BinaryTree<int> tree;
+    const BinaryTree<int>::Node* subtree_root = buildTree(tree);
+
+    std::vector<const BinaryTree<int>::Node*> buffer;
+    std::vector<int> output;
+    tree.doLevelOrderTraversal(buffer, [&output](int data) { output.push_back(data); });
+    tree.doLevelOrderTraversal(subtree_root, buffer, [&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({5, 3, 8, 1, 4, 7, 9, 2, 6, 3, 1, 4, 2}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::IteratorTest1(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+
+    std::vector<int> output;
+    for (int data : tree)
+    {
+        output.push_back(data);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ISHIKO_TEST_FAIL_IF_NOT(BinaryTree<int>().begin() == BinaryTree<int>().end());
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::IteratorTest2(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+    const BinaryTree<int>& const_tree = tree;
+
+    std::vector<int> output;
+    BinaryTree<int>::ConstIterator it = const_tree.end();
+    while (it != const_tree.begin())
+    {
+        --it;
+        output.push_back(*it);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({9, 8, 7, 6, 5, 4, 3, 2, 1}));
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::IteratorTest3(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+
+    for (BinaryTree<int>::Iterator it = tree.begin(); it != tree.end(); ++it)
+    {
+        *it *= 10;
+    }
+    BinaryTree<int>::ConstIterator last_it = --tree.end();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*tree.begin(), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(*last_it, 90);
+    ISHIKO_TEST_FAIL_IF_NEQ(last_it.node()->parentNode()->data(), 80);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::ParallelTraversalTest1(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+    WorkStealingPool pool(4);
+
+    std::atomic<int> sum{0};
+    std::atomic<size_t> count{0};
+    tree.parallelTraversal(pool,
+        [&sum, &count](int data)
+        {
+            sum += data;
+            ++count;
+        },
+        1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(sum.load(), 45);
+    ISHIKO_TEST_FAIL_IF_NEQ(count.load(), 9);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::ParallelTraversalTest2(Test& test)
+{
+    BinaryTree<int> tree;
+    buildDegenerateTree(tree);
+    WorkStealingPool pool(4);
+
+    std::atomic<size_t> count{0};
+    tree.parallelTraversal(pool, [&count](int) { ++count; });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count.load(), 1000000);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::ParallelReduceTest1(Test& test)
+{
+    BinaryTree<int> tree;
+    WorkStealingPool pool(4);
+
+    int sum = tree.parallelReduce(pool, 0, [](int data) { return data; }, [](int x, int y) { return (x + y); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(sum, 0);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::ParallelReduceTest2(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+    WorkStealingPool pool(4);
+
+    // Concatenation isn't commutative so this checks the results are combined in inorder
+    std::string digits = tree.parallelReduce(pool, std::string(),
+        [](int data) { return std::to_string(data); },
+        [](const std::string& x, const std::string& y) { return (x + y); },
+        1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(digits, "123456789");
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::ParallelReduceTest3(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+    WorkStealingPool pool(4);
+
+    bool thrown = false;
+    try
+    {
+        tree.parallelReduce(pool, 0,
+            [](int data)
+            {
+                if (data == 2)
+                {
+                    throw std::runtime_error("transform failed");
+                }
+                return data;
+            },
+            [](int x, int y) { return (x + y); },
+            1);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(thrown);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::FreezeTest1(Test& test)
+{
+    BinaryTree<int> tree;
+
+    FrozenBinaryTree<int> frozen_tree = tree.freeze();
+
+    ISHIKO_TEST_FAIL_IF_NOT(frozen_tree.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::FreezeTest2(Test& test)
+{
+    BinaryTree<int> tree;
+    buildTree(tree);
+
+    FrozenBinaryTree<int> frozen_tree = tree.freeze();
+    // The copy doesn't depend on the tree
+    tree.clear();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(frozen_tree.size(), 9);
+    ISHIKO_TEST_FAIL_IF_NEQ(std::vector<int>(frozen_tree.begin(), frozen_tree.end()),
+        std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ISHIKO_TEST_FAIL_IF_NEQ(frozen_tree.find(6)->data(), 6);
+    ISHIKO_TEST_PASS();
+}
+
 void BinaryTreeTests::RotateLeftTest1(Test& test)
 {
     BinaryTree<int> tree;
@@ -405,3 +887,112 @@ void BinaryTreeTests::RotateRightTest2(Test& test)
 
     ISHIKO_TEST_PASS();
 }
+
+void BinaryTreeTests::StatisticsTest1(Test& test)
+{
+    typedef BinaryTree<int, DataTypeTraits<int>, CountingAllocator<>> CountingBinaryTree;
+    CountingBinaryTree tree;
+    tree.setRoot(5);
+    CountingBinaryTree::Node* root_node = tree.root();
+    CountingBinaryTree::Node* left_child_node = tree.insertLeft(3, root_node);
+    tree.insertRight(7, root_node);
+    tree.insertLeft(2, left_child_node);
+    tree.insertLeft(1, left_child_node);
+
+    ContainerStatistics statistics = tree.statistics();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_count, 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_bytes, 5 * sizeof(CountingBinaryTree::Node));
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.height, 4);
+    ISHIKO_TEST_FAIL_IF_NOT(statistics.has_allocation_statistics);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.allocations.allocation_count, 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.allocations.allocated_bytes, statistics.element_bytes);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::ClearTest1(Test& test)
+{
+    BinaryTree<int> tree;
+    tree.setRoot(5);
+    BinaryTree<int>::Node* left_child_node = tree.insertLeft(3, tree.root());
+    tree.insertRight(4, left_child_node);
+    tree.insertLeft(1, left_child_node);
+    tree.insertRight(7, tree.root());
+
+    tree.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+
+    Error error;
+    BinaryTree<int>::Node* node = tree.root(error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(node, nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::ClearTest2(Test& test)
+{
+    typedef BinaryTree<int, DataTypeTraits<int>, ArenaAllocator> ArenaBinaryTree;
+
+    ArenaBinaryTree tree;
+    tree.reserve(5);
+    tree.setRoot(5);
+    ArenaBinaryTree::Node* left_child_node = tree.insertLeft(3, tree.root());
+    tree.insertRight(4, left_child_node);
+    tree.insertLeft(1, left_child_node);
+    tree.insertRight(7, tree.root());
+
+    // The nodes are trivially destructible so the arena frees them all at once
+    tree.clear();
+    tree.setRoot(8);
+
+    ISHIKO_TEST_FAIL_IF(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root()->data(), 8);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root()->leftChildNode(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::ClearTest3(Test& test)
+{
+    std::shared_ptr<int> value = std::make_shared<int>(5);
+    BinaryTree<std::shared_ptr<int>> tree;
+    tree.setRoot(value);
+    BinaryTree<std::shared_ptr<int>>::Node* node = tree.root();
+    for (int i = 1; i < 100; ++i)
+    {
+        // Every node but the last one has a leaf on its left so that the left subtrees are handed over to the pool
+        tree.insertLeft(value, node);
+        node = tree.insertRight(value, node);
+    }
+    WorkStealingPool pool(2);
+
+    tree.clear(pool, 1);
+
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(value.use_count(), 1);
+    ISHIKO_TEST_PASS();
+}
+
+void BinaryTreeTests::DestructorTest1(Test& test)
+{
+    // A degenerate tree deep enough to overflow the stack if the nodes were deleted recursively
+    {
+        BinaryTree<int> tree;
+        tree.setRoot(0);
+        BinaryTree<int>::Node* node = tree.root();
+        for (int i = 1; i < 1000000; ++i)
+        {
+            if ((i % 2) == 0)
+            {
+                node = tree.insertLeft(i, node);
+            }
+            else
+            {
+                node = tree.insertRight(i, node);
+            }
+        }
+    }
+
+    ISHIKO_TEST_PASS();
+}
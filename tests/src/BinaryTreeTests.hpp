@@ -18,17 +18,47 @@ private:
     static void SetRootTest2(Ishiko::Test& test);
     static void SetRootTest3(Ishiko::Test& test);
     static void SetRootTest4(Ishiko::Test& test);
+    static void SetRootTest5(Ishiko::Test& test);
     static void InsertLeftTest1(Ishiko::Test& test);
     static void InsertLeftTest2(Ishiko::Test& test);
+    static void EmplaceLeftTest1(Ishiko::Test& test);
     static void InsertRightTest1(Ishiko::Test& test);
     static void InsertRightTest2(Ishiko::Test& test);
+    static void EmplaceRightTest1(Ishiko::Test& test);
     static void DoInorderTraversalTest1(Ishiko::Test& test);
     static void DoInorderTraversalTest2(Ishiko::Test& test);
     static void DoInorderTraversalTest3(Ishiko::Test& test);
+    static void DoInorderTraversalTest4(Ishiko::Test& test);
+    static void DoInorderTraversalTest5(Ishiko::Test& test);
+    static void DoInorderTraversalTest6(Ishiko::Test& test);
+    static void DoPreorderTraversalTest1(Ishiko::Test& test);
+    static void DoPreorderTraversalTest2(Ishiko::Test& test);
+    static void DoPostorderTraversalTest1(Ishiko::Test& test);
+    static void DoPostorderTraversalTest2(Ishiko::Test& test);
+    static void DoLevelOrderTraversalTest1(Ishiko::Test& test);
+    static void DoLevelOrderTraversalTest2(Ishiko::Test& test);
+    static void DoLevelOrderTraversalTest3(Ishiko::Test& test);
+    static void DoLevelOrderTraversalTest4(Ishiko::Test& test);
+    static void DoLevelOrderTraversalTest5(Ishiko::Test& test);
+    static void IteratorTest1(Ishiko::Test& test);
+    static void IteratorTest2(Ishiko::Test& test);
+    static void IteratorTest3(Ishiko::Test& test);
+    static void ParallelTraversalTest1(Ishiko::Test& test);
+    static void ParallelTraversalTest2(Ishiko::Test& test);
+    static void ParallelReduceTest1(Ishiko::Test& test);
+    static void ParallelReduceTest2(Ishiko::Test& test);
+    static void ParallelReduceTest3(Ishiko::Test& test);
+    static void FreezeTest1(Ishiko::Test& test);
+    static void FreezeTest2(Ishiko::Test& test);
     static void RotateLeftTest1(Ishiko::Test& test);
     static void RotateLeftTest2(Ishiko::Test& test);
     static void RotateRightTest1(Ishiko::Test& test);
     static void RotateRightTest2(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+    static void ClearTest2(Ishiko::Test& test);
+    static void ClearTest3(Ishiko::Test& test);
+    static void DestructorTest1(Ishiko::Test& test);
 };
 
 #endif
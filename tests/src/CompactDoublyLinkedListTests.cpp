@@ -0,0 +1,393 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "CompactDoublyLinkedListTests.hpp"
+#include "Ishiko/DataStructures/CompactDoublyLinkedList.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    typedef CompactDoublyLinkedList<uint32_t> List;
+    // 255 nodes at most since the index 255 is the null index
+    typedef CompactDoublyLinkedList<uint32_t, uint8_t> TinyList;
+
+    // The values of the list read from the head and, to check the previous links and the tail, from the tail
+    std::vector<uint32_t> forwardValues(const List& list)
+    {
+        std::vector<uint32_t> result;
+        for (uint32_t index = list.head(); index != List::null_index; index = list.nextIndex(index))
+        {
+            result.push_back(list.data(index));
+        }
+        return result;
+    }
+
+    std::vector<uint32_t> backwardValues(const List& list)
+    {
+        std::vector<uint32_t> result;
+        for (uint32_t index = list.tail(); index != List::null_index; index = list.previousIndex(index))
+        {
+            result.push_back(list.data(index));
+        }
+        return result;
+    }
+}
+
+CompactDoublyLinkedListTests::CompactDoublyLinkedListTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "CompactDoublyLinkedList tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("Copy constructor test 1", CopyConstructorTest1);
+    append<HeapAllocationErrorsTest>("Move constructor test 1", MoveConstructorTest1);
+    append<HeapAllocationErrorsTest>("operator= test 1", AssignmentOperatorTest1);
+    append<HeapAllocationErrorsTest>("pushBack test 1", PushBackTest1);
+    append<HeapAllocationErrorsTest>("pushBack test 2", PushBackTest2);
+    append<HeapAllocationErrorsTest>("pushBack test 3", PushBackTest3);
+    append<HeapAllocationErrorsTest>("pushFront test 1", PushFrontTest1);
+    append<HeapAllocationErrorsTest>("insertAfter test 1", InsertAfterTest1);
+    append<HeapAllocationErrorsTest>("insertBefore test 1", InsertBeforeTest1);
+    append<HeapAllocationErrorsTest>("popFront test 1", PopFrontTest1);
+    append<HeapAllocationErrorsTest>("popBack test 1", PopBackTest1);
+    append<HeapAllocationErrorsTest>("erase test 1", EraseTest1);
+    append<HeapAllocationErrorsTest>("traverse test 1", TraverseTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+    append<HeapAllocationErrorsTest>("reserve test 1", ReserveTest1);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+}
+
+void CompactDoublyLinkedListTests::ConstructorTest1(Test& test)
+{
+    List list;
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.capacity(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), List::null_index);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail(), List::null_index);
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::CopyConstructorTest1(Test& test)
+{
+    List list;
+    uint32_t index = list.pushBack(1);
+    list.pushBack(2);
+    list.pushBack(3);
+    list.erase(index);
+
+    List copy(list);
+
+    // The free node is part of the copy too
+    uint32_t copy_index = copy.pushFront(4);
+    copy.data(copy.tail()) = 5;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(copy_index, index);
+    ISHIKO_TEST_FAIL_IF_NEQ(copy.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(copy), std::vector<uint32_t>({4, 2, 5}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(copy), std::vector<uint32_t>({5, 2, 4}));
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({2, 3}));
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::MoveConstructorTest1(Test& test)
+{
+    List list;
+    list.pushBack(1);
+    list.pushBack(2);
+
+    List moved_list(std::move(list));
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.capacity(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(moved_list.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(moved_list), std::vector<uint32_t>({1, 2}));
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::AssignmentOperatorTest1(Test& test)
+{
+    List list;
+    list.pushBack(1);
+    list.pushBack(2);
+    List other_list;
+    other_list.pushBack(3);
+
+    other_list = list;
+    list.pushBack(4);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(other_list), std::vector<uint32_t>({1, 2}));
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({1, 2, 4}));
+
+    other_list = std::move(list);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(other_list), std::vector<uint32_t>({1, 2, 4}));
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::PushBackTest1(Test& test)
+{
+    List list;
+    uint32_t index1 = list.pushBack(1);
+    uint32_t index2 = list.pushBack(2);
+    uint32_t index3 = list.pushBack(3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), index1);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail(), index3);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.nextIndex(index1), index2);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.previousIndex(index1), List::null_index);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.nextIndex(index3), List::null_index);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({1, 2, 3}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<uint32_t>({3, 2, 1}));
+    ISHIKO_TEST_PASS();
+}
+
+// The indices stay valid when the slab grows
+void CompactDoublyLinkedListTests::PushBackTest2(Test& test)
+{
+    List list;
+    std::vector<uint32_t> indices;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        indices.push_back(list.pushBack(i));
+    }
+
+    bool indices_valid = true;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        if (list.data(indices[i]) != i)
+        {
+            indices_valid = false;
+        }
+    }
+
+    // Pushing a value of the list itself while the slab grows
+    while (list.size() != list.capacity())
+    {
+        list.pushBack(0);
+    }
+    uint32_t index = list.pushBack(list.data(list.head()));
+
+    ISHIKO_TEST_FAIL_IF_NOT(indices_valid);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.data(index), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::PushBackTest3(Test& test)
+{
+    TinyList list;
+
+    Error error;
+    for (uint32_t i = 0; i < 255; ++i)
+    {
+        list.pushBack(i, error);
+    }
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 255);
+
+    uint8_t index = list.pushBack(255, error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(index, TinyList::null_index);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 255);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.data(list.tail()), 254);
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::PushFrontTest1(Test& test)
+{
+    List list;
+    list.pushFront(3);
+    list.pushFront(2);
+    uint32_t index = list.pushFront(1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), index);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({1, 2, 3}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<uint32_t>({3, 2, 1}));
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::InsertAfterTest1(Test& test)
+{
+    List list;
+    uint32_t index1 = list.pushBack(1);
+    uint32_t index3 = list.pushBack(3);
+
+    list.insertAfter(2, index1);
+    list.insertAfter(4, index3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({1, 2, 3, 4}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<uint32_t>({4, 3, 2, 1}));
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::InsertBeforeTest1(Test& test)
+{
+    List list;
+    uint32_t index2 = list.pushBack(2);
+    uint32_t index4 = list.pushBack(4);
+
+    Error error;
+    list.insertBefore(1, index2, error);
+    list.insertBefore(3, index4, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({1, 2, 3, 4}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<uint32_t>({4, 3, 2, 1}));
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::PopFrontTest1(Test& test)
+{
+    List list;
+    list.pushBack(1);
+    list.pushBack(2);
+
+    list.popFront();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({2}));
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), list.tail());
+
+    list.popFront();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+
+    Error error;
+    list.popFront(error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::PopBackTest1(Test& test)
+{
+    List list;
+    list.pushBack(1);
+    list.pushBack(2);
+
+    list.popBack();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({1}));
+    ISHIKO_TEST_FAIL_IF_NEQ(list.nextIndex(list.tail()), List::null_index);
+
+    list.popBack();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), List::null_index);
+
+    Error error;
+    list.popBack(error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_PASS();
+}
+
+// The nodes of erased values are reused before the slab grows
+void CompactDoublyLinkedListTests::EraseTest1(Test& test)
+{
+    List list;
+    list.reserve(4);
+    list.pushBack(1);
+    uint32_t index2 = list.pushBack(2);
+    uint32_t index3 = list.pushBack(3);
+    list.pushBack(4);
+
+    list.erase(index2);
+    list.erase(index3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({1, 4}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<uint32_t>({4, 1}));
+
+    uint32_t index5 = list.pushBack(5);
+    uint32_t index6 = list.pushBack(6);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(index5, index3);
+    ISHIKO_TEST_FAIL_IF_NEQ(index6, index2);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.capacity(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({1, 4, 5, 6}));
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::TraverseTest1(Test& test)
+{
+    List list;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        list.pushFront(i);
+    }
+
+    std::vector<uint32_t> output;
+    list.traverse([&output](uint32_t value) { output.push_back(value); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output.size(), 100);
+    ISHIKO_TEST_FAIL_IF_NEQ(output.front(), 99);
+    ISHIKO_TEST_FAIL_IF_NEQ(output.back(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::ClearTest1(Test& test)
+{
+    List list;
+    list.pushBack(1);
+    list.pushBack(2);
+    size_t capacity = list.capacity();
+
+    list.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), List::null_index);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.capacity(), capacity);
+
+    list.pushBack(3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<uint32_t>({3}));
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::ReserveTest1(Test& test)
+{
+    List list;
+    list.reserve(100);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.capacity(), 100);
+
+    Error error;
+    list.reserve(200, error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.capacity(), 200);
+
+    TinyList tiny_list;
+    tiny_list.reserve(256, error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(tiny_list.capacity(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void CompactDoublyLinkedListTests::StatisticsTest1(Test& test)
+{
+    List list;
+    list.reserve(10);
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        list.pushBack(i);
+    }
+
+    ContainerStatistics statistics = list.statistics();
+
+    // 2 indices of 32 bits per value
+    ISHIKO_TEST_FAIL_IF_NEQ(sizeof(List::Node), 12);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_count, 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_bytes, 6 * sizeof(List::Node));
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.spare_bytes, 4 * sizeof(List::Node));
+    ISHIKO_TEST_PASS();
+}
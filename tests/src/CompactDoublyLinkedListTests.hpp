@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_COMPACTDOUBLYLINKEDLISTTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_COMPACTDOUBLYLINKEDLISTTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class CompactDoublyLinkedListTests : public Ishiko::TestSequence
+{
+public:
+    CompactDoublyLinkedListTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void CopyConstructorTest1(Ishiko::Test& test);
+    static void MoveConstructorTest1(Ishiko::Test& test);
+    static void AssignmentOperatorTest1(Ishiko::Test& test);
+    static void PushBackTest1(Ishiko::Test& test);
+    static void PushBackTest2(Ishiko::Test& test);
+    static void PushBackTest3(Ishiko::Test& test);
+    static void PushFrontTest1(Ishiko::Test& test);
+    static void InsertAfterTest1(Ishiko::Test& test);
+    static void InsertBeforeTest1(Ishiko::Test& test);
+    static void PopFrontTest1(Ishiko::Test& test);
+    static void PopBackTest1(Ishiko::Test& test);
+    static void EraseTest1(Ishiko::Test& test);
+    static void TraverseTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+    static void ReserveTest1(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ConcurrentQueueTests.hpp"
+#include "Ishiko/DataStructures/ConcurrentQueue.hpp"
+#include "Ishiko/DataStructures/EpochBasedReclamation.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Ishiko;
+
+ConcurrentQueueTests::ConcurrentQueueTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "ConcurrentQueue tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("push test 1", PushTest1);
+    append<HeapAllocationErrorsTest>("push test 2", PushTest2);
+    append<HeapAllocationErrorsTest>("push test 3", PushTest3);
+    append<HeapAllocationErrorsTest>("emplace test 1", EmplaceTest1);
+    append<HeapAllocationErrorsTest>("tryPop test 1", TryPopTest1);
+    append<HeapAllocationErrorsTest>("tryPop test 2", TryPopTest2);
+    append<HeapAllocationErrorsTest>("Destructor test 1", DestructorTest1);
+    append<HeapAllocationErrorsTest>("concurrent push and tryPop test 1", ConcurrentPushTryPopTest1);
+}
+
+void ConcurrentQueueTests::ConstructorTest1(Test& test)
+{
+    ConcurrentQueue<int> queue;
+
+    ISHIKO_TEST_FAIL_IF_NOT(queue.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentQueueTests::PushTest1(Test& test)
+{
+    ConcurrentQueue<int> queue;
+    queue.push(5);
+
+    ISHIKO_TEST_FAIL_IF(queue.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentQueueTests::PushTest2(Test& test)
+{
+    ConcurrentQueue<int> queue;
+    queue.push(5);
+    queue.push(3);
+    queue.push(8);
+
+    int value = 0;
+    ISHIKO_TEST_ABORT_IF_NOT(queue.tryPop(value));
+    ISHIKO_TEST_FAIL_IF_NEQ(value, 5);
+    ISHIKO_TEST_ABORT_IF_NOT(queue.tryPop(value));
+    ISHIKO_TEST_FAIL_IF_NEQ(value, 3);
+    ISHIKO_TEST_ABORT_IF_NOT(queue.tryPop(value));
+    ISHIKO_TEST_FAIL_IF_NEQ(value, 8);
+    ISHIKO_TEST_FAIL_IF_NOT(queue.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentQueueTests::PushTest3(Test& test)
+{
+    ConcurrentQueue<std::string> queue;
+    std::string moved_value = "def";
+    queue.push("abc");
+    queue.push(std::move(moved_value));
+
+    std::string value;
+    ISHIKO_TEST_ABORT_IF_NOT(queue.tryPop(value));
+    ISHIKO_TEST_FAIL_IF_NEQ(value, "abc");
+    ISHIKO_TEST_ABORT_IF_NOT(queue.tryPop(value));
+    ISHIKO_TEST_FAIL_IF_NEQ(value, "def");
+    ISHIKO_TEST_FAIL_IF_NOT(queue.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentQueueTests::EmplaceTest1(Test& test)
+{
+    ConcurrentQueue<std::string> queue;
+    queue.emplace(3, 'x');
+
+    std::string value;
+    ISHIKO_TEST_ABORT_IF_NOT(queue.tryPop(value));
+    ISHIKO_TEST_FAIL_IF_NEQ(value, "xxx");
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentQueueTests::TryPopTest1(Test& test)
+{
+    ConcurrentQueue<int> queue;
+
+    int value = 7;
+    bool popped = queue.tryPop(value);
+
+    ISHIKO_TEST_FAIL_IF(popped);
+    ISHIKO_TEST_FAIL_IF_NEQ(value, 7);
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentQueueTests::TryPopTest2(Test& test)
+{
+    // Pushing and popping many more elements than the free list can hold exercises both the recycling of nodes and
+    // the fallback to the heap
+    ConcurrentQueue<int> queue;
+    const int count = 3 * ConcurrentQueue<int>::max_free_nodes;
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            queue.push(i);
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            int value = -1;
+            ISHIKO_TEST_ABORT_IF_NOT(queue.tryPop(value));
+            ISHIKO_TEST_ABORT_IF_NEQ(value, i);
+        }
+        ISHIKO_TEST_ABORT_IF_NOT(queue.isEmpty());
+        EpochBasedReclamation::Synchronize();
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentQueueTests::DestructorTest1(Test& test)
+{
+    // The remaining elements must be destroyed by the destructor, the sanitizers report it if they aren't
+    {
+        ConcurrentQueue<std::string> queue;
+        queue.push("a string long enough to be allocated on the heap");
+        queue.push("another string long enough to be allocated on the heap");
+    }
+    EpochBasedReclamation::Synchronize();
+
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentQueueTests::ConcurrentPushTryPopTest1(Test& test)
+{
+    const int producer_count = 4;
+    const int consumer_count = 4;
+    const int values_per_producer = 20000;
+
+    // Each value encodes its producer and its position in that producer's sequence. Every value must be popped
+    // exactly once and each consumer must see the values of a given producer in the order they were pushed.
+    ConcurrentQueue<int> queue;
+    std::vector<std::vector<int>> popped_values(consumer_count);
+    std::atomic<int> remaining_values(producer_count * values_per_producer);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producer_count; ++p)
+    {
+        threads.emplace_back(
+            [&queue, p]()
+            {
+                for (int i = 0; i < values_per_producer; ++i)
+                {
+                    queue.push((i * producer_count) + p);
+                }
+            });
+    }
+    for (int c = 0; c < consumer_count; ++c)
+    {
+        threads.emplace_back(
+            [&queue, &popped_values, &remaining_values, c]()
+            {
+                while (remaining_values.load() > 0)
+                {
+                    int value;
+                    if (queue.tryPop(value))
+                    {
+                        popped_values[c].push_back(value);
+                        --remaining_values;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<int> pop_counts(producer_count * values_per_producer, 0);
+    for (int c = 0; c < consumer_count; ++c)
+    {
+        std::vector<int> last_positions(producer_count, -1);
+        for (int value : popped_values[c])
+        {
+            ++pop_counts[value];
+            int producer = (value % producer_count);
+            int position = (value / producer_count);
+            ISHIKO_TEST_ABORT_IF_NOT(position > last_positions[producer]);
+            last_positions[producer] = position;
+        }
+    }
+    for (int count : pop_counts)
+    {
+        ISHIKO_TEST_ABORT_IF_NEQ(count, 1);
+    }
+    ISHIKO_TEST_FAIL_IF_NOT(queue.isEmpty());
+
+    EpochBasedReclamation::Synchronize();
+
+    ISHIKO_TEST_PASS();
+}
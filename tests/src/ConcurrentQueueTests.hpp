@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_CONCURRENTQUEUETESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_CONCURRENTQUEUETESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class ConcurrentQueueTests : public Ishiko::TestSequence
+{
+public:
+    ConcurrentQueueTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void PushTest1(Ishiko::Test& test);
+    static void PushTest2(Ishiko::Test& test);
+    static void PushTest3(Ishiko::Test& test);
+    static void EmplaceTest1(Ishiko::Test& test);
+    static void TryPopTest1(Ishiko::Test& test);
+    static void TryPopTest2(Ishiko::Test& test);
+    static void DestructorTest1(Ishiko::Test& test);
+    static void ConcurrentPushTryPopTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ConcurrentSkipListTests.hpp"
+#include "Ishiko/DataStructures/ConcurrentSkipList.hpp"
+#include "Ishiko/DataStructures/EpochBasedReclamation.hpp"
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // The generator is called concurrently so each thread gets its own engine
+    size_t numLevels()
+    {
+        thread_local std::mt19937 gen(std::random_device{}());
+        std::uniform_real_distribution<> dis(0.0, 1.0);
+
+        size_t numLevels = 1;
+        while ((numLevels < 20) && (dis(gen) < 0.5))
+        {
+            ++numLevels;
+        }
+        return numLevels;
+    }
+}
+
+using namespace Ishiko;
+
+ConcurrentSkipListTests::ConcurrentSkipListTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "ConcurrentSkipList tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("insert test 1", InsertTest1);
+    append<HeapAllocationErrorsTest>("insert test 2", InsertTest2);
+    append<HeapAllocationErrorsTest>("insert test 3", InsertTest3);
+    append<HeapAllocationErrorsTest>("erase test 1", EraseTest1);
+    append<HeapAllocationErrorsTest>("erase test 2", EraseTest2);
+    append<HeapAllocationErrorsTest>("find test 1", FindTest1);
+    append<HeapAllocationErrorsTest>("concurrent insert test 1", ConcurrentInsertTest1);
+    append<HeapAllocationErrorsTest>("concurrent insert and erase test 1", ConcurrentInsertEraseTest1);
+}
+
+void ConcurrentSkipListTests::ConstructorTest1(Test& test)
+{
+    ConcurrentSkipList<int> list(numLevels);
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF(list.contains(0));
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentSkipListTests::InsertTest1(Test& test)
+{
+    ConcurrentSkipList<int> list(numLevels);
+    bool inserted = list.insert(5);
+
+    ISHIKO_TEST_FAIL_IF_NOT(inserted);
+    ISHIKO_TEST_FAIL_IF(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NOT(list.contains(5));
+    ISHIKO_TEST_FAIL_IF(list.contains(4));
+    ISHIKO_TEST_FAIL_IF(list.contains(6));
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentSkipListTests::InsertTest2(Test& test)
+{
+    ConcurrentSkipList<int> list(numLevels);
+    list.insert(5);
+    bool inserted = list.insert(5);
+
+    ISHIKO_TEST_FAIL_IF(inserted);
+    ISHIKO_TEST_FAIL_IF_NOT(list.contains(5));
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentSkipListTests::InsertTest3(Test& test)
+{
+    ConcurrentSkipList<std::string> list(numLevels);
+    for (int i = 999; i >= 0; --i)
+    {
+        list.insert(std::to_string(i));
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_NOT(list.contains(std::to_string(i)));
+    }
+    ISHIKO_TEST_FAIL_IF(list.contains("1000"));
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentSkipListTests::EraseTest1(Test& test)
+{
+    ConcurrentSkipList<int> list(numLevels);
+    list.insert(5);
+    bool erased = list.erase(5);
+
+    ISHIKO_TEST_FAIL_IF_NOT(erased);
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF(list.contains(5));
+
+    EpochBasedReclamation::Synchronize();
+
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentSkipListTests::EraseTest2(Test& test)
+{
+    ConcurrentSkipList<int> list(numLevels);
+    for (int i = 0; i < 1000; ++i)
+    {
+        list.insert(i);
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        ISHIKO_TEST_ABORT_IF_NOT(list.erase(i));
+    }
+
+    ISHIKO_TEST_FAIL_IF(list.erase(0));
+    ISHIKO_TEST_FAIL_IF(list.erase(1000));
+    for (int i = 0; i < 1000; ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_NEQ(list.contains(i), ((i % 2) == 1));
+    }
+
+    EpochBasedReclamation::Synchronize();
+
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentSkipListTests::FindTest1(Test& test)
+{
+    ConcurrentSkipList<std::string> list(numLevels);
+    list.insert("abc");
+    list.insert("def");
+
+    std::string result;
+    bool found = list.find("def", [&result](const std::string& data) { result = data; });
+
+    ISHIKO_TEST_FAIL_IF_NOT(found);
+    ISHIKO_TEST_FAIL_IF_NEQ(result, "def");
+    ISHIKO_TEST_FAIL_IF(list.find("ghi", [&result](const std::string& data) { result = data; }));
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentSkipListTests::ConcurrentInsertTest1(Test& test)
+{
+    const int thread_count = 4;
+    const int values_per_thread = 10000;
+
+    ConcurrentSkipList<int> list(numLevels);
+    std::atomic<int> failed_inserts(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        // The threads insert interleaved values so that they contend on the same neighbourhoods
+        threads.emplace_back(
+            [&list, &failed_inserts, t]()
+            {
+                for (int i = 0; i < values_per_thread; ++i)
+                {
+                    if (!list.insert((i * thread_count) + t))
+                    {
+                        ++failed_inserts;
+                    }
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(failed_inserts.load(), 0);
+    for (int i = 0; i < (thread_count * values_per_thread); ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_NOT(list.contains(i));
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentSkipListTests::ConcurrentInsertEraseTest1(Test& test)
+{
+    const int thread_count = 4;
+    const int key_count = 256;
+    const int iterations = 20000;
+
+    // Every thread inserts and erases keys from the same small range so that erases race with inserts and with
+    // each other. Each thread keeps track of its net contribution per key which must add up to the final content.
+    ConcurrentSkipList<int> list(numLevels);
+    std::vector<std::vector<int>> balances(thread_count, std::vector<int>(key_count, 0));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back(
+            [&list, &balances, t]()
+            {
+                std::mt19937 gen(t);
+                std::uniform_int_distribution<int> keys(0, key_count - 1);
+                for (int i = 0; i < iterations; ++i)
+                {
+                    int key = keys(gen);
+                    if (gen() % 2)
+                    {
+                        if (list.insert(key))
+                        {
+                            ++balances[t][key];
+                        }
+                    }
+                    else if (list.erase(key))
+                    {
+                        --balances[t][key];
+                    }
+                }
+            });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int key = 0; key < key_count; ++key)
+    {
+        int balance = 0;
+        for (int t = 0; t < thread_count; ++t)
+        {
+            balance += balances[t][key];
+        }
+        ISHIKO_TEST_ABORT_IF_NEQ(list.contains(key), (balance == 1));
+        ISHIKO_TEST_ABORT_IF((balance != 0) && (balance != 1));
+    }
+
+    EpochBasedReclamation::Synchronize();
+
+    ISHIKO_TEST_PASS();
+}
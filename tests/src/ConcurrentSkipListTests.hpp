@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_CONCURRENTSKIPLISTTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_CONCURRENTSKIPLISTTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class ConcurrentSkipListTests : public Ishiko::TestSequence
+{
+public:
+    ConcurrentSkipListTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void InsertTest1(Ishiko::Test& test);
+    static void InsertTest2(Ishiko::Test& test);
+    static void InsertTest3(Ishiko::Test& test);
+    static void EraseTest1(Ishiko::Test& test);
+    static void EraseTest2(Ishiko::Test& test);
+    static void FindTest1(Ishiko::Test& test);
+    static void ConcurrentInsertTest1(Ishiko::Test& test);
+    static void ConcurrentInsertEraseTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ConcurrentStackTests.hpp"
+#include "Ishiko/DataStructures/ConcurrentStack.hpp"
+#include <thread>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    class Item : public ConcurrentStackHook<Item>
+    {
+    public:
+        explicit Item(int value) : m_value(value)
+        {
+        }
+
+        int m_value;
+    };
+
+    // Every thread repeatedly pops an item, modifies it and pushes it back. At the end each item must be in the
+    // stack exactly once and have been modified by exactly the number of successful pops.
+    template<typename Stack>
+    bool RunRecycling(Stack& stack, std::vector<Item>& items, int thread_count, int iterations)
+    {
+        for (Item& item : items)
+        {
+            stack.push(&item);
+        }
+
+        std::vector<int> pop_counts(thread_count, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back(
+                [&stack, &pop_counts, iterations, t]()
+                {
+                    for (int i = 0; i < iterations; ++i)
+                    {
+                        Item* item = stack.pop();
+                        if (item)
+                        {
+                            ++item->m_value;
+                            ++pop_counts[t];
+                            stack.push(item);
+                        }
+                    }
+                });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::vector<int> seen(items.size(), 0);
+        int expected_total = 0;
+        for (int count : pop_counts)
+        {
+            expected_total += count;
+        }
+        int total = 0;
+        for (Item* item = stack.popAll(); item; item = Stack::NextNode(item))
+        {
+            ++seen[item - items.data()];
+            total += item->m_value;
+        }
+        for (int count : seen)
+        {
+            if (count != 1)
+            {
+                return false;
+            }
+        }
+        return (total == expected_total);
+    }
+}
+
+ConcurrentStackTests::ConcurrentStackTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "ConcurrentStack tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("push test 1", PushTest1);
+    append<HeapAllocationErrorsTest>("pop test 1", PopTest1);
+    append<HeapAllocationErrorsTest>("pop test 2", PopTest2);
+    append<HeapAllocationErrorsTest>("pushChain test 1", PushChainTest1);
+    append<HeapAllocationErrorsTest>("popAll test 1", PopAllTest1);
+    append<HeapAllocationErrorsTest>("popAll test 2", PopAllTest2);
+    append<HeapAllocationErrorsTest>("elimination test 1", EliminationTest1);
+    append<HeapAllocationErrorsTest>("concurrent push and pop test 1", ConcurrentPushPopTest1);
+    append<HeapAllocationErrorsTest>("concurrent push and pop test 2", ConcurrentPushPopTest2);
+}
+
+void ConcurrentStackTests::ConstructorTest1(Test& test)
+{
+    ConcurrentStack<Item> stack;
+
+    ISHIKO_TEST_FAIL_IF_NOT(stack.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentStackTests::PushTest1(Test& test)
+{
+    Item item(5);
+    ConcurrentStack<Item> stack;
+    stack.push(&item);
+
+    ISHIKO_TEST_FAIL_IF(stack.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentStackTests::PopTest1(Test& test)
+{
+    Item item(5);
+    ConcurrentStack<Item> stack;
+    stack.push(&item);
+
+    Item* popped_item = stack.pop();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(popped_item, &item);
+    ISHIKO_TEST_FAIL_IF_NOT(stack.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentStackTests::PopTest2(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+    Item item3(3);
+    ConcurrentStack<Item> stack;
+    stack.push(&item1);
+    stack.push(&item2);
+    stack.push(&item3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item2);
+    stack.push(&item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentStackTests::PushChainTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+    Item item3(3);
+    Item item4(4);
+    ConcurrentStack<Item> stack;
+    stack.push(&item1);
+    ConcurrentStack<Item>::SetNextNode(&item4, &item3);
+    ConcurrentStack<Item>::SetNextNode(&item3, &item2);
+    stack.pushChain(&item4, &item2);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item4);
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item1);
+    ISHIKO_TEST_FAIL_IF_NOT(stack.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentStackTests::PopAllTest1(Test& test)
+{
+    ConcurrentStack<Item> stack;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.popAll(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentStackTests::PopAllTest2(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+    Item item3(3);
+    ConcurrentStack<Item> stack;
+    stack.push(&item1);
+    stack.push(&item2);
+    stack.push(&item3);
+
+    std::vector<int> values;
+    for (Item* item = stack.popAll(); item; item = ConcurrentStack<Item>::NextNode(item))
+    {
+        values.push_back(item->m_value);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(stack.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(values, (std::vector<int>{ 3, 2, 1 }));
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentStackTests::EliminationTest1(Test& test)
+{
+    // Without contention a stack with an elimination array behaves like any other stack
+    Item item1(1);
+    Item item2(2);
+    ConcurrentStack<Item, void, 4> stack;
+    stack.push(&item1);
+    stack.push(&item2);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(stack.pop(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentStackTests::ConcurrentPushPopTest1(Test& test)
+{
+    // Fewer items than threads so that the same items are popped and pushed again all the time, which is what
+    // triggers the ABA problem if the stack isn't protected against it
+    std::vector<Item> items(3, Item(0));
+    ConcurrentStack<Item> stack;
+
+    bool consistent = RunRecycling(stack, items, 4, 50000);
+
+    ISHIKO_TEST_FAIL_IF_NOT(consistent);
+    ISHIKO_TEST_PASS();
+}
+
+void ConcurrentStackTests::ConcurrentPushPopTest2(Test& test)
+{
+    std::vector<Item> items(3, Item(0));
+    ConcurrentStack<Item, void, 2> stack;
+
+    bool consistent = RunRecycling(stack, items, 4, 50000);
+
+    ISHIKO_TEST_FAIL_IF_NOT(consistent);
+    ISHIKO_TEST_PASS();
+}
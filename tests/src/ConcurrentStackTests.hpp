@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_CONCURRENTSTACKTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_CONCURRENTSTACKTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class ConcurrentStackTests : public Ishiko::TestSequence
+{
+public:
+    ConcurrentStackTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void PushTest1(Ishiko::Test& test);
+    static void PopTest1(Ishiko::Test& test);
+    static void PopTest2(Ishiko::Test& test);
+    static void PushChainTest1(Ishiko::Test& test);
+    static void PopAllTest1(Ishiko::Test& test);
+    static void PopAllTest2(Ishiko::Test& test);
+    static void EliminationTest1(Ishiko::Test& test);
+    static void ConcurrentPushPopTest1(Ishiko::Test& test);
+    static void ConcurrentPushPopTest2(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "ContainerStatisticsTests.hpp"
+#include "Ishiko/DataStructures/ContainerStatistics.hpp"
+#include <string>
+
+using namespace Ishiko;
+
+ContainerStatisticsTests::ContainerStatisticsTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "ContainerStatistics tests", context)
+{
+    append<HeapAllocationErrorsTest>("toString test 1", ToStringTest1);
+    append<HeapAllocationErrorsTest>("toString test 2", ToStringTest2);
+    append<HeapAllocationErrorsTest>("toJSON test 1", ToJSONTest1);
+    append<HeapAllocationErrorsTest>("toJSON test 2", ToJSONTest2);
+}
+
+void ContainerStatisticsTests::ToStringTest1(Test& test)
+{
+    ContainerStatistics statistics;
+
+    std::string text = statistics.toString();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(text,
+        "elements: 0, element bytes: 0, spare bytes: 0, height: 0, level histogram: []");
+    ISHIKO_TEST_PASS();
+}
+
+void ContainerStatisticsTests::ToStringTest2(Test& test)
+{
+    ContainerStatistics statistics;
+    statistics.element_count = 3;
+    statistics.element_bytes = 96;
+    statistics.spare_bytes = 24;
+    statistics.height = 2;
+    statistics.level_histogram.push_back(2);
+    statistics.level_histogram.push_back(1);
+    statistics.has_allocation_statistics = true;
+    statistics.allocations.allocation_count = 4;
+    statistics.allocations.deallocation_count = 1;
+    statistics.allocations.allocated_bytes = 120;
+    statistics.allocations.peak_allocated_bytes = 144;
+
+    std::string text = statistics.toString();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(text,
+        "elements: 3, element bytes: 96, spare bytes: 24, height: 2, level histogram: [2, 1], allocations: 4, "
+        "deallocations: 1, allocated bytes: 120, peak allocated bytes: 144");
+    ISHIKO_TEST_PASS();
+}
+
+void ContainerStatisticsTests::ToJSONTest1(Test& test)
+{
+    ContainerStatistics statistics;
+
+    std::string json = statistics.toJSON();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(json,
+        "{\"element_count\": 0, \"element_bytes\": 0, \"spare_bytes\": 0, \"height\": 0, \"level_histogram\": [], "
+        "\"allocations\": null}");
+    ISHIKO_TEST_PASS();
+}
+
+void ContainerStatisticsTests::ToJSONTest2(Test& test)
+{
+    ContainerStatistics statistics;
+    statistics.element_count = 3;
+    statistics.element_bytes = 96;
+    statistics.spare_bytes = 24;
+    statistics.height = 2;
+    statistics.level_histogram.push_back(2);
+    statistics.level_histogram.push_back(1);
+    statistics.has_allocation_statistics = true;
+    statistics.allocations.allocation_count = 4;
+    statistics.allocations.deallocation_count = 1;
+    statistics.allocations.allocated_bytes = 120;
+    statistics.allocations.peak_allocated_bytes = 144;
+
+    std::string json = statistics.toJSON();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(json,
+        "{\"element_count\": 3, \"element_bytes\": 96, \"spare_bytes\": 24, \"height\": 2, "
+        "\"level_histogram\": [2, 1], \"allocations\": {\"allocation_count\": 4, \"deallocation_count\": 1, "
+        "\"allocated_bytes\": 120, \"peak_allocated_bytes\": 144}}");
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_CONTAINERSTATISTICSTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_CONTAINERSTATISTICSTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class ContainerStatisticsTests : public Ishiko::TestSequence
+{
+public:
+    ContainerStatisticsTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ToStringTest1(Ishiko::Test& test);
+    static void ToStringTest2(Ishiko::Test& test);
+    static void ToJSONTest1(Ishiko::Test& test);
+    static void ToJSONTest2(Ishiko::Test& test);
+};
+
+#endif
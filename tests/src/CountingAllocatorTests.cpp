@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "CountingAllocatorTests.hpp"
+#include "Ishiko/DataStructures/ArenaAllocator.hpp"
+#include "Ishiko/DataStructures/CountingAllocator.hpp"
+#include <cstring>
+
+using namespace Ishiko;
+
+CountingAllocatorTests::CountingAllocatorTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "CountingAllocator tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("allocate test 1", AllocateTest1);
+    append<HeapAllocationErrorsTest>("deallocate test 1", DeallocateTest1);
+    append<HeapAllocationErrorsTest>("release test 1", ReleaseTest1);
+}
+
+void CountingAllocatorTests::ConstructorTest1(Test& test)
+{
+    CountingAllocator<> allocator;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().allocation_count, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().deallocation_count, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().allocated_bytes, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().peak_allocated_bytes, 0);
+    ISHIKO_TEST_PASS();
+}
+
+void CountingAllocatorTests::AllocateTest1(Test& test)
+{
+    CountingAllocator<> allocator;
+
+    void* memory1 = allocator.allocate(24);
+    void* memory2 = allocator.allocate(40);
+    std::memset(memory1, 0xFF, 24);
+    std::memset(memory2, 0xFF, 40);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().allocation_count, 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().deallocation_count, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().allocated_bytes, 64);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().peak_allocated_bytes, 64);
+
+    allocator.deallocate(memory2, 40);
+    allocator.deallocate(memory1, 24);
+
+    ISHIKO_TEST_PASS();
+}
+
+void CountingAllocatorTests::DeallocateTest1(Test& test)
+{
+    CountingAllocator<> allocator;
+    void* memory1 = allocator.allocate(24);
+    void* memory2 = allocator.allocate(40);
+
+    allocator.deallocate(memory2, 40);
+    void* memory3 = allocator.allocate(8);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().allocation_count, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().deallocation_count, 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().allocated_bytes, 32);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().peak_allocated_bytes, 64);
+
+    allocator.deallocate(memory3, 8);
+    allocator.deallocate(memory1, 24);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().deallocation_count, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().allocated_bytes, 0);
+    ISHIKO_TEST_PASS();
+}
+
+void CountingAllocatorTests::ReleaseTest1(Test& test)
+{
+    CountingAllocator<ArenaAllocator> allocator;
+    allocator.allocate(24);
+    allocator.allocate(40);
+
+    allocator.release();
+
+    ISHIKO_TEST_FAIL_IF_NOT(CountingAllocator<ArenaAllocator>::supports_release);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().allocation_count, 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().deallocation_count, 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().allocated_bytes, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(allocator.statistics().peak_allocated_bytes, 64);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_COUNTINGALLOCATORTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_COUNTINGALLOCATORTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class CountingAllocatorTests : public Ishiko::TestSequence
+{
+public:
+    CountingAllocatorTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void AllocateTest1(Ishiko::Test& test);
+    static void DeallocateTest1(Ishiko::Test& test);
+    static void ReleaseTest1(Ishiko::Test& test);
+};
+
+#endif
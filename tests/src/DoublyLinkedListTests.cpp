@@ -3,9 +3,44 @@
 
 #include "DoublyLinkedListTests.hpp"
 #include "Ishiko/DataStructures/DoublyLinkedList.hpp"
+#include "Ishiko/DataStructures/PoolAllocator.hpp"
+#include "Ishiko/DataStructures/WorkStealingPool.hpp"
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace Ishiko;
 
+namespace
+{
+    // The values of the list read from the head and, to check the previous links and the tail, from the tail
+    std::vector<int> forwardValues(DoublyLinkedList<int>& list)
+    {
+        std::vector<int> result;
+        if (!list.isEmpty())
+        {
+            for (DoublyLinkedList<int>::Node* node = list.head(); node; node = node->nextNode())
+            {
+                result.push_back(node->data());
+            }
+        }
+        return result;
+    }
+
+    std::vector<int> backwardValues(DoublyLinkedList<int>& list)
+    {
+        std::vector<int> result;
+        if (!list.isEmpty())
+        {
+            for (DoublyLinkedList<int>::Node* node = list.tail(); node; node = node->previousNode())
+            {
+                result.push_back(node->data());
+            }
+        }
+        return result;
+    }
+}
+
 DoublyLinkedListTests::DoublyLinkedListTests(const TestNumber& number, const TestContext& context)
     : TestSequence(number, "DoublyLinkedList tests", context)
 {
@@ -13,11 +48,30 @@ DoublyLinkedListTests::DoublyLinkedListTests(const TestNumber& number, const Tes
     append<HeapAllocationErrorsTest>("setHead test 1", SetHeadTest1);
     append<HeapAllocationErrorsTest>("setHead test 2", SetHeadTest2);
     append<HeapAllocationErrorsTest>("insertAfter test 1", InsertAfterTest1);
+    append<HeapAllocationErrorsTest>("insertAfter test 2", InsertAfterTest2);
+    append<HeapAllocationErrorsTest>("emplaceAfter test 1", EmplaceAfterTest1);
     append<HeapAllocationErrorsTest>("insertBefore test 1", InsertBeforeTest1);
     append<HeapAllocationErrorsTest>("insertBefore test 2", InsertBeforeTest2);
+    append<HeapAllocationErrorsTest>("emplaceBefore test 1", EmplaceBeforeTest1);
+    append<HeapAllocationErrorsTest>("pushFront test 1", PushFrontTest1);
+    append<HeapAllocationErrorsTest>("pushBack test 1", PushBackTest1);
+    append<HeapAllocationErrorsTest>("pushBack test 2", PushBackTest2);
+    append<HeapAllocationErrorsTest>("emplaceBack test 1", EmplaceBackTest1);
+    append<HeapAllocationErrorsTest>("popFront test 1", PopFrontTest1);
+    append<HeapAllocationErrorsTest>("popBack test 1", PopBackTest1);
+    append<HeapAllocationErrorsTest>("popBack test 2", PopBackTest2);
+    append<HeapAllocationErrorsTest>("erase test 1", EraseTest1);
+    append<HeapAllocationErrorsTest>("splice test 1", SpliceTest1);
+    append<HeapAllocationErrorsTest>("splice test 2", SpliceTest2);
+    append<HeapAllocationErrorsTest>("splice test 3", SpliceTest3);
     append<HeapAllocationErrorsTest>("traverse test 1", TraverseTest1);
     append<HeapAllocationErrorsTest>("traverse test 2", TraverseTest2);
     append<HeapAllocationErrorsTest>("traverse test 3", TraverseTest3);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+    append<HeapAllocationErrorsTest>("clear test 2", ClearTest2);
+    append<HeapAllocationErrorsTest>("clear test 3", ClearTest3);
+    append<HeapAllocationErrorsTest>("Destructor test 1", DestructorTest1);
 }
 
 void DoublyLinkedListTests::ConstructorTest1(Test& test)
@@ -94,6 +148,38 @@ void DoublyLinkedListTests::InsertAfterTest1(Test& test)
     ISHIKO_TEST_FAIL_IF_NEQ(next_node->data(), 3);
     ISHIKO_TEST_PASS();
 }
+
+void DoublyLinkedListTests::InsertAfterTest2(Test& test)
+{
+    DoublyLinkedList<std::unique_ptr<int>> list;
+    list.setHead(std::unique_ptr<int>(new int(5)));
+
+    DoublyLinkedList<std::unique_ptr<int>>::Node* head_node = list.head();
+    std::unique_ptr<int> data(new int(3));
+    DoublyLinkedList<std::unique_ptr<int>>::Node* next_node = list.insertAfter(std::move(data), head_node);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(data.get(), nullptr);
+    ISHIKO_TEST_ABORT_IF_EQ(next_node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(head_node->nextNode(), next_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(next_node->previousNode(), head_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(*next_node->data(), 3);
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::EmplaceAfterTest1(Test& test)
+{
+    DoublyLinkedList<std::string> list;
+    list.setHead("head");
+
+    DoublyLinkedList<std::string>::Node* head_node = list.head();
+    DoublyLinkedList<std::string>::Node* next_node = list.emplaceAfter(head_node, 3, 'a');
+
+    ISHIKO_TEST_ABORT_IF_EQ(next_node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(head_node->nextNode(), next_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(next_node->previousNode(), head_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(next_node->data(), "aaa");
+    ISHIKO_TEST_PASS();
+}
 void DoublyLinkedListTests::InsertBeforeTest1(Test& test)
 {
     DoublyLinkedList<int> list;
@@ -158,6 +244,266 @@ void DoublyLinkedListTests::InsertBeforeTest2(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void DoublyLinkedListTests::EmplaceBeforeTest1(Test& test)
+{
+    DoublyLinkedList<std::string> list;
+    list.setHead("head");
+
+    DoublyLinkedList<std::string>::Node* old_head_node = list.head();
+    DoublyLinkedList<std::string>::Node* new_node = list.emplaceBefore(old_head_node, 3, 'a');
+
+    ISHIKO_TEST_ABORT_IF_EQ(new_node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), new_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(new_node->nextNode(), old_head_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(old_head_node->previousNode(), new_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(new_node->data(), "aaa");
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::PushFrontTest1(Test& test)
+{
+    DoublyLinkedList<int> list;
+    list.pushFront(3);
+    list.pushFront(2);
+    DoublyLinkedList<int>::Node* node = list.pushFront(1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), node);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail()->data(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<int>({1, 2, 3}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<int>({3, 2, 1}));
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::PushBackTest1(Test& test)
+{
+    DoublyLinkedList<int> list;
+    DoublyLinkedList<int>::Node* node = list.pushBack(1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), node);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail(), node);
+
+    list.pushBack(2);
+    node = list.pushBack(3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head()->data(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail(), node);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<int>({1, 2, 3}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<int>({3, 2, 1}));
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::PushBackTest2(Test& test)
+{
+    DoublyLinkedList<std::string> list;
+
+    Error error;
+    list.pushBack("first value, long enough to be allocated on the heap", error);
+    std::string value = "second value, long enough to be allocated on the heap";
+    DoublyLinkedList<std::string>::Node* node = list.pushBack(std::move(value), error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail(), node);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head()->data(), "first value, long enough to be allocated on the heap");
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail()->data(), "second value, long enough to be allocated on the heap");
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::EmplaceBackTest1(Test& test)
+{
+    DoublyLinkedList<std::string> list;
+    list.emplaceBack(3, 'b');
+    list.emplaceFront(2, 'a');
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head()->data(), "aa");
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail()->data(), "bbb");
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::PopFrontTest1(Test& test)
+{
+    DoublyLinkedList<int> list;
+    list.pushBack(1);
+    list.pushBack(2);
+    list.pushBack(3);
+
+    list.popFront();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<int>({2, 3}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<int>({3, 2}));
+
+    list.popFront();
+    list.popFront();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 0);
+
+    Error error;
+    list.popFront(error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::PopBackTest1(Test& test)
+{
+    DoublyLinkedList<int> list;
+    list.pushBack(1);
+    list.pushBack(2);
+    list.pushBack(3);
+
+    list.popBack();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail()->data(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail()->nextNode(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<int>({1, 2}));
+
+    list.popBack();
+    list.popBack();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+
+    // The list must still be usable once emptied from the back
+    list.pushBack(4);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), list.tail());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head()->data(), 4);
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::PopBackTest2(Test& test)
+{
+    DoublyLinkedList<int> list;
+
+    Error error;
+    list.popBack(error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+
+    Error tail_error;
+    DoublyLinkedList<int>::Node* node = list.tail(tail_error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(tail_error);
+    ISHIKO_TEST_FAIL_IF_NEQ(node, nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::EraseTest1(Test& test)
+{
+    DoublyLinkedList<int> list;
+    DoublyLinkedList<int>::Node* node1 = list.pushBack(1);
+    DoublyLinkedList<int>::Node* node2 = list.pushBack(2);
+    list.pushBack(3);
+    DoublyLinkedList<int>::Node* node4 = list.pushBack(4);
+
+    list.erase(node2);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<int>({1, 3, 4}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<int>({4, 3, 1}));
+
+    list.erase(node4);
+    list.erase(node1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), list.tail());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head()->data(), 3);
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::SpliceTest1(Test& test)
+{
+    DoublyLinkedList<int> list;
+    list.pushBack(1);
+    DoublyLinkedList<int>::Node* node4 = list.pushBack(4);
+    DoublyLinkedList<int> other_list;
+    other_list.pushBack(2);
+    other_list.pushBack(3);
+    DoublyLinkedList<int> last_list;
+    last_list.pushBack(5);
+
+    list.splice(node4, other_list);
+    list.splice(nullptr, last_list);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<int>({1, 2, 3, 4, 5}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<int>({5, 4, 3, 2, 1}));
+    ISHIKO_TEST_FAIL_IF_NOT(other_list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(other_list.size(), 0);
+    ISHIKO_TEST_FAIL_IF_NOT(last_list.isEmpty());
+
+    // Splicing an empty list is a no-op
+    list.splice(list.head(), other_list);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 5);
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::SpliceTest2(Test& test)
+{
+    DoublyLinkedList<int> list;
+    DoublyLinkedList<int> other_list;
+    other_list.pushBack(1);
+    DoublyLinkedList<int>::Node* node = other_list.pushBack(2);
+    other_list.pushBack(3);
+
+    list.splice(nullptr, other_list, node);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), node);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.tail(), node);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->previousNode(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->nextNode(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(other_list.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(other_list), std::vector<int>({1, 3}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(other_list), std::vector<int>({3, 1}));
+
+    // Moving the tail of the other list to the front of this one
+    list.splice(list.head(), other_list, other_list.tail());
+
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<int>({3, 2}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<int>({2, 3}));
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(other_list), std::vector<int>({1}));
+    ISHIKO_TEST_FAIL_IF_NEQ(other_list.head(), other_list.tail());
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::SpliceTest3(Test& test)
+{
+    DoublyLinkedList<int> list;
+    list.pushBack(1);
+    DoublyLinkedList<int>::Node* node5 = list.pushBack(5);
+    DoublyLinkedList<int> other_list;
+    other_list.pushBack(10);
+    DoublyLinkedList<int>::Node* first_node = other_list.pushBack(2);
+    other_list.pushBack(3);
+    DoublyLinkedList<int>::Node* last_node = other_list.pushBack(4);
+    other_list.pushBack(11);
+
+    list.splice(node5, other_list, first_node, last_node, 3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<int>({1, 2, 3, 4, 5}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<int>({5, 4, 3, 2, 1}));
+    ISHIKO_TEST_FAIL_IF_NEQ(other_list.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(other_list), std::vector<int>({10, 11}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(other_list), std::vector<int>({11, 10}));
+
+    // Moving the whole of the other list as a range, from the head to the tail
+    list.splice(nullptr, other_list, other_list.head(), other_list.tail(), other_list.size());
+
+    ISHIKO_TEST_FAIL_IF_NEQ(forwardValues(list), std::vector<int>({1, 2, 3, 4, 5, 10, 11}));
+    ISHIKO_TEST_FAIL_IF_NEQ(backwardValues(list), std::vector<int>({11, 10, 5, 4, 3, 2, 1}));
+    ISHIKO_TEST_FAIL_IF_NOT(other_list.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
 void DoublyLinkedListTests::TraverseTest1(Test& test)
 {
     DoublyLinkedList<int> list;
@@ -212,3 +558,89 @@ void DoublyLinkedListTests::TraverseTest3(Test& test)
     ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({5, 7, 9}));
     ISHIKO_TEST_PASS();
 }
+
+void DoublyLinkedListTests::StatisticsTest1(Test& test)
+{
+    DoublyLinkedList<int> list;
+    list.setHead(0);
+    DoublyLinkedList<int>::Node* node = list.head();
+    for (int i = 1; i < 10; ++i)
+    {
+        node = list.insertAfter(i, node);
+    }
+
+    ContainerStatistics statistics = list.statistics();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_count, 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_bytes, 10 * sizeof(DoublyLinkedList<int>::Node));
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.height, 0);
+    ISHIKO_TEST_FAIL_IF(statistics.has_allocation_statistics);
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::ClearTest1(Test& test)
+{
+    DoublyLinkedList<int> list;
+    list.setHead(5);
+    list.insertAfter(9, list.head());
+    list.insertAfter(7, list.head());
+
+    list.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::ClearTest2(Test& test)
+{
+    DoublyLinkedList<std::string, DataTypeTraits<std::string>, PoolAllocator> list;
+    list.setHead("first value, long enough to be allocated on the heap");
+    list.insertAfter("second value, long enough to be allocated on the heap", list.head());
+    list.insertBefore("third value, long enough to be allocated on the heap", list.head());
+
+    list.clear();
+    list.setHead("fourth value, long enough to be allocated on the heap");
+
+    ISHIKO_TEST_FAIL_IF(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head()->data(), "fourth value, long enough to be allocated on the heap");
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head()->nextNode(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::ClearTest3(Test& test)
+{
+    std::shared_ptr<int> value = std::make_shared<int>(5);
+    DoublyLinkedList<std::shared_ptr<int>, DataTypeTraits<std::shared_ptr<int>>, PoolAllocator> list;
+    list.reserve(100);
+    list.setHead(value);
+    for (int i = 1; i < 100; ++i)
+    {
+        list.insertAfter(value, list.head());
+    }
+    WorkStealingPool pool(2);
+
+    // The pool frees the nodes all at once once their data has been destroyed
+    list.clear(pool, 8);
+    list.setHead(value);
+
+    ISHIKO_TEST_FAIL_IF(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head()->nextNode(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(value.use_count(), 2);
+    ISHIKO_TEST_PASS();
+}
+
+void DoublyLinkedListTests::DestructorTest1(Test& test)
+{
+    // Long enough to overflow the stack if the nodes were deleted recursively
+    {
+        DoublyLinkedList<int> list;
+        list.setHead(0);
+        DoublyLinkedList<int>::Node* last_node = list.head();
+        for (int i = 1; i < 1000000; ++i)
+        {
+            last_node = list.insertAfter(i, last_node);
+        }
+    }
+
+    ISHIKO_TEST_PASS();
+}
@@ -16,11 +16,30 @@ private:
     static void SetHeadTest1(Ishiko::Test& test);
     static void SetHeadTest2(Ishiko::Test& test);
     static void InsertAfterTest1(Ishiko::Test& test);
+    static void InsertAfterTest2(Ishiko::Test& test);
+    static void EmplaceAfterTest1(Ishiko::Test& test);
     static void InsertBeforeTest1(Ishiko::Test& test);
     static void InsertBeforeTest2(Ishiko::Test& test);
+    static void EmplaceBeforeTest1(Ishiko::Test& test);
+    static void PushFrontTest1(Ishiko::Test& test);
+    static void PushBackTest1(Ishiko::Test& test);
+    static void PushBackTest2(Ishiko::Test& test);
+    static void EmplaceBackTest1(Ishiko::Test& test);
+    static void PopFrontTest1(Ishiko::Test& test);
+    static void PopBackTest1(Ishiko::Test& test);
+    static void PopBackTest2(Ishiko::Test& test);
+    static void EraseTest1(Ishiko::Test& test);
+    static void SpliceTest1(Ishiko::Test& test);
+    static void SpliceTest2(Ishiko::Test& test);
+    static void SpliceTest3(Ishiko::Test& test);
     static void TraverseTest1(Ishiko::Test& test);
     static void TraverseTest2(Ishiko::Test& test);
     static void TraverseTest3(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+    static void ClearTest2(Ishiko::Test& test);
+    static void ClearTest3(Ishiko::Test& test);
+    static void DestructorTest1(Ishiko::Test& test);
 };
 
 #endif
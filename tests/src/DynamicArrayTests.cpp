@@ -0,0 +1,320 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "DynamicArrayTests.hpp"
+#include "Ishiko/DataStructures/DynamicArray.hpp"
+#include <memory>
+#include <string>
+
+using namespace Ishiko;
+
+DynamicArrayTests::DynamicArrayTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "DynamicArray tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("pushBack test 1", PushBackTest1);
+    append<HeapAllocationErrorsTest>("pushBack test 2", PushBackTest2);
+    append<HeapAllocationErrorsTest>("pushBack test 3", PushBackTest3);
+    append<HeapAllocationErrorsTest>("pushBack test 4", PushBackTest4);
+    append<HeapAllocationErrorsTest>("pushBack test 5", PushBackTest5);
+    append<HeapAllocationErrorsTest>("pushBack test 6", PushBackTest6);
+    append<HeapAllocationErrorsTest>("emplaceBack test 1", EmplaceBackTest1);
+    append<HeapAllocationErrorsTest>("emplaceBack test 2", EmplaceBackTest2);
+    append<HeapAllocationErrorsTest>("reserve test 1", ReserveTest1);
+    append<HeapAllocationErrorsTest>("reserve test 2", ReserveTest2);
+    append<HeapAllocationErrorsTest>("popBack test 1", PopBackTest1);
+    append<HeapAllocationErrorsTest>("erase test 1", EraseTest1);
+    append<HeapAllocationErrorsTest>("erase test 2", EraseTest2);
+    append<HeapAllocationErrorsTest>("shrinkToFit test 1", ShrinkToFitTest1);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+}
+
+void DynamicArrayTests::ConstructorTest1(Test& test)
+{
+    DynamicArray<int> array;
+
+    ISHIKO_TEST_FAIL_IF_NOT(array.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(array.size(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(array.capacity(), 4);
+    ISHIKO_TEST_FAIL_IF(array.begin() != array.end());
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::PushBackTest1(Test& test)
+{
+    DynamicArray<int> array;
+
+    array.pushBack(1);
+    array.pushBack(2);
+    array.pushBack(3);
+
+    // The values fit in the inline storage
+    const void* data = array.data();
+    ISHIKO_TEST_FAIL_IF((data < static_cast<const void*>(&array)) || (data >= static_cast<const void*>(&array + 1)));
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[0], 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[1], 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[2], 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(array.back(), 3);
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::PushBackTest2(Test& test)
+{
+    DynamicArray<int> array;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        array.pushBack(i);
+    }
+
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 1000);
+    ISHIKO_TEST_FAIL_IF(array.capacity() < 1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(array[i], i);
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::PushBackTest3(Test& test)
+{
+    DynamicArray<std::string> array;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        array.pushBack(std::string(40, static_cast<char>('0' + (i % 10))));
+    }
+
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 100);
+    for (int i = 0; i < 100; ++i)
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(array[i], std::string(40, static_cast<char>('0' + (i % 10))));
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::PushBackTest4(Test& test)
+{
+    DynamicArray<std::string> array;
+    array.pushBack("first value, long enough to be allocated on the heap");
+
+    // Every second push needs to grow the array which moves the value being copied
+    for (int i = 0; i < 20; ++i)
+    {
+        array.pushBack(array[0]);
+    }
+
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 21);
+    for (const std::string& value : array)
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(value, "first value, long enough to be allocated on the heap");
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::PushBackTest5(Test& test)
+{
+    DynamicArray<int, 2> array;
+
+    Error error;
+    for (int i = 0; i < 10; ++i)
+    {
+        array.pushBack(i, error);
+    }
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[0], 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[9], 9);
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::PushBackTest6(Test& test)
+{
+    DynamicArray<std::unique_ptr<int>, 2> array;
+
+    Error error;
+    for (int i = 0; i < 10; ++i)
+    {
+        std::unique_ptr<int> value(new int(i));
+        if (i % 2)
+        {
+            array.pushBack(std::move(value));
+        }
+        else
+        {
+            array.pushBack(std::move(value), error);
+        }
+
+        ISHIKO_TEST_FAIL_IF_NEQ(value.get(), nullptr);
+    }
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(*array[0], 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(*array[9], 9);
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::EmplaceBackTest1(Test& test)
+{
+    DynamicArray<std::string, 2> array;
+    for (size_t i = 1; i <= 10; ++i)
+    {
+        array.emplaceBack(i, 'a');
+    }
+
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[0], "a");
+    ISHIKO_TEST_FAIL_IF_NEQ(array[9], "aaaaaaaaaa");
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::EmplaceBackTest2(Test& test)
+{
+    DynamicArray<std::string, 2> array;
+    array.emplaceBack("a");
+    array.emplaceBack("b");
+
+    // The array is full so this grows it while the argument refers to one of its values
+    array.emplaceBack(array[0]);
+
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[2], "a");
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::ReserveTest1(Test& test)
+{
+    DynamicArray<int> array;
+    array.pushBack(1);
+
+    array.reserve(100);
+    const int* data = array.data();
+    for (int i = 2; i <= 100; ++i)
+    {
+        array.pushBack(i);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(array.capacity(), 100);
+    ISHIKO_TEST_FAIL_IF(array.data() != data);
+    ISHIKO_TEST_FAIL_IF_NEQ(array.size(), 100);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[0], 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[99], 100);
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::ReserveTest2(Test& test)
+{
+    DynamicArray<int> array;
+
+    Error error;
+    array.reserve(static_cast<size_t>(-1), error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(array.capacity(), 4);
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::PopBackTest1(Test& test)
+{
+    DynamicArray<std::string> array;
+    array.pushBack("a");
+    array.pushBack("b");
+
+    array.popBack();
+
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(array.back(), "a");
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::EraseTest1(Test& test)
+{
+    DynamicArray<int> array;
+    for (int i = 0; i < 10; ++i)
+    {
+        array.pushBack(i);
+    }
+
+    array.erase(0);
+    array.erase(2, 5);
+
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[0], 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[1], 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[2], 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[5], 9);
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::EraseTest2(Test& test)
+{
+    DynamicArray<std::string> array;
+    for (int i = 0; i < 10; ++i)
+    {
+        array.pushBack(std::to_string(i));
+    }
+
+    array.erase(9);
+    array.erase(1, 4);
+
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[0], "0");
+    ISHIKO_TEST_FAIL_IF_NEQ(array[1], "4");
+    ISHIKO_TEST_FAIL_IF_NEQ(array[5], "8");
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::ShrinkToFitTest1(Test& test)
+{
+    DynamicArray<std::string> array;
+    for (int i = 0; i < 100; ++i)
+    {
+        array.pushBack(std::to_string(i));
+    }
+    array.erase(2, 100);
+
+    array.shrinkToFit();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(array.capacity(), 4);
+    ISHIKO_TEST_ABORT_IF_NEQ(array.size(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(array[0], "0");
+    ISHIKO_TEST_FAIL_IF_NEQ(array[1], "1");
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::StatisticsTest1(Test& test)
+{
+    DynamicArray<int> array;
+    array.reserve(10);
+    array.pushBack(1);
+    array.pushBack(2);
+    array.pushBack(3);
+
+    ContainerStatistics statistics = array.statistics();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_count, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_bytes, 3 * sizeof(int));
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.spare_bytes, (array.capacity() - 3) * sizeof(int));
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.height, 0);
+    ISHIKO_TEST_FAIL_IF(statistics.has_allocation_statistics);
+    ISHIKO_TEST_PASS();
+}
+
+void DynamicArrayTests::ClearTest1(Test& test)
+{
+    DynamicArray<std::string> array;
+    for (int i = 0; i < 100; ++i)
+    {
+        array.pushBack(std::to_string(i));
+    }
+
+    array.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(array.isEmpty());
+    ISHIKO_TEST_FAIL_IF(array.capacity() < 100);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_DYNAMICARRAYTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_DYNAMICARRAYTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class DynamicArrayTests : public Ishiko::TestSequence
+{
+public:
+    DynamicArrayTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void PushBackTest1(Ishiko::Test& test);
+    static void PushBackTest2(Ishiko::Test& test);
+    static void PushBackTest3(Ishiko::Test& test);
+    static void PushBackTest4(Ishiko::Test& test);
+    static void PushBackTest5(Ishiko::Test& test);
+    static void PushBackTest6(Ishiko::Test& test);
+    static void EmplaceBackTest1(Ishiko::Test& test);
+    static void EmplaceBackTest2(Ishiko::Test& test);
+    static void ReserveTest1(Ishiko::Test& test);
+    static void ReserveTest2(Ishiko::Test& test);
+    static void PopBackTest1(Ishiko::Test& test);
+    static void EraseTest1(Ishiko::Test& test);
+    static void EraseTest2(Ishiko::Test& test);
+    static void ShrinkToFitTest1(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+};
+
+#endif
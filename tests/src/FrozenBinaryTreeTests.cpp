@@ -0,0 +1,280 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "FrozenBinaryTreeTests.hpp"
+#include "Ishiko/DataStructures/BinaryTree.hpp"
+#include "Ishiko/DataStructures/FrozenBinaryTree.hpp"
+#include <functional>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    typedef FrozenBinaryTree<int, std::greater<int>> DescendingFrozenBinaryTree;
+
+    // A binary search tree holding 1 to 9, see BinaryTreeTests
+    void buildTree(BinaryTree<int>& tree)
+    {
+        tree.setRoot(5);
+        BinaryTree<int>::Node* node3 = tree.insertLeft(3, tree.root());
+        BinaryTree<int>::Node* node8 = tree.insertRight(8, tree.root());
+        BinaryTree<int>::Node* node1 = tree.insertLeft(1, node3);
+        tree.insertRight(4, node3);
+        tree.insertRight(2, node1);
+        BinaryTree<int>::Node* node7 = tree.insertLeft(7, node8);
+        tree.insertRight(9, node8);
+        tree.insertLeft(6, node7);
+    }
+
+    // Fills the subtree rooted at node with the values from first to last - 1 so that the tree is a complete binary
+    // search tree
+    void buildCompleteTree(BinaryTree<int>& tree, BinaryTree<int>::Node* node, int first, int last)
+    {
+        int middle = first + ((last - first) / 2);
+        if (first < middle)
+        {
+            buildCompleteTree(tree, tree.insertLeft(first + ((middle - first) / 2), node), first, middle);
+        }
+        if ((middle + 1) < last)
+        {
+            buildCompleteTree(tree, tree.insertRight((middle + 1) + ((last - middle - 1) / 2), node), middle + 1,
+                last);
+        }
+    }
+
+    size_t depth(const FrozenBinaryTree<int>::Node* node)
+    {
+        size_t result = 0;
+        while (node->parentNode())
+        {
+            node = node->parentNode();
+            ++result;
+        }
+        return result;
+    }
+}
+
+FrozenBinaryTreeTests::FrozenBinaryTreeTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "FrozenBinaryTree tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("Constructor test 2", ConstructorTest2);
+    append<HeapAllocationErrorsTest>("Constructor test 3", ConstructorTest3);
+    append<HeapAllocationErrorsTest>("Constructor test 4", ConstructorTest4);
+    append<HeapAllocationErrorsTest>("find test 1", FindTest1);
+    append<HeapAllocationErrorsTest>("find test 2", FindTest2);
+    append<HeapAllocationErrorsTest>("lowerBound test 1", LowerBoundTest1);
+    append<HeapAllocationErrorsTest>("upperBound test 1", UpperBoundTest1);
+    append<HeapAllocationErrorsTest>("Iterator test 1", IteratorTest1);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+}
+
+void FrozenBinaryTreeTests::ConstructorTest1(Test& test)
+{
+    FrozenBinaryTree<int> tree;
+
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root(), nullptr);
+    ISHIKO_TEST_FAIL_IF(tree.begin() != tree.end());
+    ISHIKO_TEST_FAIL_IF(tree.contains(1));
+    ISHIKO_TEST_PASS();
+}
+
+void FrozenBinaryTreeTests::ConstructorTest2(Test& test)
+{
+    BinaryTree<int> source_tree;
+    buildTree(source_tree);
+
+    FrozenBinaryTree<int> tree(source_tree.root());
+
+    std::vector<int> output;
+    tree.doInorderTraversal([&output](int data) { output.push_back(data); });
+
+    ISHIKO_TEST_FAIL_IF(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 9);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root()->data(), 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root()->parentNode(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root()->leftChildNode()->data(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root()->rightChildNode()->data(), 8);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root()->leftChildNode()->leftChildNode()->rightChildNode()->data(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ISHIKO_TEST_PASS();
+}
+
+// The nodes of a complete tree of height 10 are laid out as the top 5 levels followed by the 32 subtrees of height
+// 5 below them, so a lookup only touches 2 blocks of 31 nodes
+void FrozenBinaryTreeTests::ConstructorTest3(Test& test)
+{
+    BinaryTree<int> source_tree;
+    source_tree.setRoot(511);
+    buildCompleteTree(source_tree, source_tree.root(), 0, 1023);
+
+    FrozenBinaryTree<int> tree(source_tree.root());
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 1023);
+    bool top_levels_first = true;
+    bool bottom_subtrees_contiguous = true;
+    const FrozenBinaryTree<int>::Node* first_node = tree.root();
+    for (size_t i = 0; i < tree.size(); ++i)
+    {
+        const FrozenBinaryTree<int>::Node* node = (first_node + i);
+        size_t node_depth = depth(node);
+        if ((node_depth < 5) != (i < 31))
+        {
+            top_levels_first = false;
+        }
+        if (node_depth == 5)
+        {
+            // The root of a bottom subtree is followed by the 30 other nodes of the subtree
+            for (size_t j = 1; j < 31; ++j)
+            {
+                const FrozenBinaryTree<int>::Node* descendant_node = (node + j);
+                while (descendant_node && (descendant_node != node))
+                {
+                    descendant_node = descendant_node->parentNode();
+                }
+                if (!descendant_node)
+                {
+                    bottom_subtrees_contiguous = false;
+                }
+            }
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(top_levels_first);
+    ISHIKO_TEST_FAIL_IF_NOT(bottom_subtrees_contiguous);
+    ISHIKO_TEST_PASS();
+}
+
+// A tree deep enough to overflow the stack if it was copied recursively
+void FrozenBinaryTreeTests::ConstructorTest4(Test& test)
+{
+    BinaryTree<int> source_tree;
+    source_tree.setRoot(0);
+    BinaryTree<int>::Node* node = source_tree.root();
+    for (int i = 1; i < 1000000; ++i)
+    {
+        node = source_tree.insertRight(i, node);
+    }
+
+    FrozenBinaryTree<int> tree = source_tree.freeze();
+
+    int expected_value = 0;
+    bool in_order = true;
+    tree.doInorderTraversal(
+        [&expected_value, &in_order](int data)
+        {
+            if (data != expected_value)
+            {
+                in_order = false;
+            }
+            ++expected_value;
+        });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 1000000);
+    ISHIKO_TEST_FAIL_IF_NOT(in_order);
+    ISHIKO_TEST_FAIL_IF_NEQ(expected_value, 1000000);
+    ISHIKO_TEST_FAIL_IF_NOT(tree.contains(999999));
+    ISHIKO_TEST_PASS();
+}
+
+void FrozenBinaryTreeTests::FindTest1(Test& test)
+{
+    BinaryTree<int> source_tree;
+    source_tree.setRoot(511);
+    buildCompleteTree(source_tree, source_tree.root(), 0, 1023);
+    FrozenBinaryTree<int> tree = source_tree.freeze();
+
+    bool all_found = true;
+    for (int i = 0; i < 1023; ++i)
+    {
+        const FrozenBinaryTree<int>::Node* node = tree.find(i);
+        if (!node || (node->data() != i))
+        {
+            all_found = false;
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(all_found);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.find(-1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.find(1023), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void FrozenBinaryTreeTests::FindTest2(Test& test)
+{
+    BinaryTree<int> source_tree;
+    source_tree.setRoot(5);
+    source_tree.insertLeft(8, source_tree.root());
+    source_tree.insertRight(3, source_tree.root());
+
+    DescendingFrozenBinaryTree tree = source_tree.freeze(std::greater<int>());
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.find(8)->data(), 8);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.find(3)->data(), 3);
+    ISHIKO_TEST_FAIL_IF_NOT(tree.contains(5));
+    ISHIKO_TEST_FAIL_IF(tree.contains(4));
+    ISHIKO_TEST_PASS();
+}
+
+void FrozenBinaryTreeTests::LowerBoundTest1(Test& test)
+{
+    BinaryTree<int> source_tree;
+    buildTree(source_tree);
+    FrozenBinaryTree<int> tree = source_tree.freeze();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.lowerBound(0)->data(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.lowerBound(4)->data(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.lowerBound(9)->data(), 9);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.lowerBound(10), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void FrozenBinaryTreeTests::UpperBoundTest1(Test& test)
+{
+    BinaryTree<int> source_tree;
+    buildTree(source_tree);
+    FrozenBinaryTree<int> tree = source_tree.freeze();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.upperBound(0)->data(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.upperBound(5)->data(), 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.upperBound(9), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void FrozenBinaryTreeTests::IteratorTest1(Test& test)
+{
+    BinaryTree<int> source_tree;
+    buildTree(source_tree);
+    FrozenBinaryTree<int> tree = source_tree.freeze();
+
+    std::vector<int> output(tree.begin(), tree.end());
+    std::vector<int> reverse_output;
+    FrozenBinaryTree<int>::ConstIterator it = tree.end();
+    while (it != tree.begin())
+    {
+        --it;
+        reverse_output.push_back(*it);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ISHIKO_TEST_FAIL_IF_NEQ(reverse_output, std::vector<int>({9, 8, 7, 6, 5, 4, 3, 2, 1}));
+    ISHIKO_TEST_PASS();
+}
+
+void FrozenBinaryTreeTests::StatisticsTest1(Test& test)
+{
+    BinaryTree<int> source_tree;
+    buildTree(source_tree);
+    FrozenBinaryTree<int> tree = source_tree.freeze();
+
+    ContainerStatistics statistics = tree.statistics();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_count, 9);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_bytes, 9 * sizeof(FrozenBinaryTree<int>::Node));
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.spare_bytes, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.height, 4);
+    ISHIKO_TEST_PASS();
+}
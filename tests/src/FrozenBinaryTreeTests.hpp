@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_FROZENBINARYTREETESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_FROZENBINARYTREETESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class FrozenBinaryTreeTests : public Ishiko::TestSequence
+{
+public:
+    FrozenBinaryTreeTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void ConstructorTest2(Ishiko::Test& test);
+    static void ConstructorTest3(Ishiko::Test& test);
+    static void ConstructorTest4(Ishiko::Test& test);
+    static void FindTest1(Ishiko::Test& test);
+    static void FindTest2(Ishiko::Test& test);
+    static void LowerBoundTest1(Ishiko::Test& test);
+    static void UpperBoundTest1(Ishiko::Test& test);
+    static void IteratorTest1(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+};
+
+#endif
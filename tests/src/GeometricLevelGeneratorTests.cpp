@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "GeometricLevelGeneratorTests.hpp"
+#include "Ishiko/DataStructures/GeometricLevelGenerator.hpp"
+
+using namespace Ishiko;
+
+GeometricLevelGeneratorTests::GeometricLevelGeneratorTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "GeometricLevelGenerator tests", context)
+{
+    append<HeapAllocationErrorsTest>("operator() test 1", CallOperatorTest1);
+    append<HeapAllocationErrorsTest>("operator() test 2", CallOperatorTest2);
+    append<HeapAllocationErrorsTest>("operator() test 3", CallOperatorTest3);
+}
+
+void GeometricLevelGeneratorTests::CallOperatorTest1(Test& test)
+{
+    // With p = 1/2 about half the nodes have more than 1 level and a quarter more than 2
+    GeometricLevelGenerator<> generator;
+
+    size_t counts[4] = { 0, 0, 0, 0 };
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        size_t levels = generator();
+
+        ISHIKO_TEST_ABORT_IF((levels < 1) || (levels > 32));
+
+        for (size_t j = 0; (j < 4) && (j < levels); ++j)
+        {
+            ++counts[j];
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(counts[0], 100000);
+    ISHIKO_TEST_FAIL_IF((counts[1] < 48000) || (counts[1] > 52000));
+    ISHIKO_TEST_FAIL_IF((counts[2] < 23000) || (counts[2] > 27000));
+    ISHIKO_TEST_FAIL_IF((counts[3] < 11000) || (counts[3] > 14000));
+    ISHIKO_TEST_PASS();
+}
+
+void GeometricLevelGeneratorTests::CallOperatorTest2(Test& test)
+{
+    // With p = 1/4 about a quarter of the nodes have more than 1 level
+    GeometricLevelGenerator<2> generator;
+
+    size_t count = 0;
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        if (generator() > 1)
+        {
+            ++count;
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF((count < 23000) || (count > 27000));
+    ISHIKO_TEST_PASS();
+}
+
+void GeometricLevelGeneratorTests::CallOperatorTest3(Test& test)
+{
+    GeometricLevelGenerator<> generator(3);
+
+    size_t max_levels = 0;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        size_t levels = generator();
+        if (levels > max_levels)
+        {
+            max_levels = levels;
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(max_levels, 3);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_GEOMETRICLEVELGENERATORTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_GEOMETRICLEVELGENERATORTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class GeometricLevelGeneratorTests : public Ishiko::TestSequence
+{
+public:
+    GeometricLevelGeneratorTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void CallOperatorTest1(Ishiko::Test& test);
+    static void CallOperatorTest2(Ishiko::Test& test);
+    static void CallOperatorTest3(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,256 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "IntrusiveBinaryTreeTests.hpp"
+#include "Ishiko/DataStructures/IntrusiveBinaryTree.hpp"
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    class Item : public BinaryTreeHook<Item>
+    {
+    public:
+        explicit Item(int value) : m_value(value)
+        {
+        }
+
+        int m_value;
+    };
+
+    typedef IntrusiveBinaryTree<Item> ItemTree;
+}
+
+IntrusiveBinaryTreeTests::IntrusiveBinaryTreeTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "IntrusiveBinaryTree tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("setRoot test 1", SetRootTest1);
+    append<HeapAllocationErrorsTest>("insertLeft test 1", InsertLeftTest1);
+    append<HeapAllocationErrorsTest>("insertRight test 1", InsertRightTest1);
+    append<HeapAllocationErrorsTest>("doInorderTraversal test 1", DoInorderTraversalTest1);
+    append<HeapAllocationErrorsTest>("doPreorderTraversal test 1", DoPreorderTraversalTest1);
+    append<HeapAllocationErrorsTest>("doPostorderTraversal test 1", DoPostorderTraversalTest1);
+    append<HeapAllocationErrorsTest>("doLevelOrderTraversal test 1", DoLevelOrderTraversalTest1);
+    append<HeapAllocationErrorsTest>("rotateLeft test 1", RotateLeftTest1);
+    append<HeapAllocationErrorsTest>("rotateRight test 1", RotateRightTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+}
+
+void IntrusiveBinaryTreeTests::ConstructorTest1(Test& test)
+{
+    ItemTree tree;
+
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::SetRootTest1(Test& test)
+{
+    Item item(5);
+
+    ItemTree tree;
+    tree.setRoot(&item);
+
+    ISHIKO_TEST_FAIL_IF(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root(), &item);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::ParentNode(&item), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::LeftChildNode(&item), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::RightChildNode(&item), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::InsertLeftTest1(Test& test)
+{
+    Item item1(5);
+    Item item2(3);
+
+    ItemTree tree;
+    tree.setRoot(&item1);
+    tree.insertLeft(&item2, &item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::LeftChildNode(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::RightChildNode(&item1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::ParentNode(&item2), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::LeftChildNode(&item2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::RightChildNode(&item2), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::InsertRightTest1(Test& test)
+{
+    Item item1(5);
+    Item item2(7);
+
+    ItemTree tree;
+    tree.setRoot(&item1);
+    tree.insertRight(&item2, &item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::LeftChildNode(&item1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::RightChildNode(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::ParentNode(&item2), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::LeftChildNode(&item2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::RightChildNode(&item2), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::DoInorderTraversalTest1(Test& test)
+{
+    Item item1(5);
+    Item item2(3);
+    Item item3(7);
+    Item item4(4);
+
+    ItemTree tree;
+    tree.setRoot(&item1);
+    tree.insertLeft(&item2, &item1);
+    tree.insertRight(&item3, &item1);
+    tree.insertRight(&item4, &item2);
+
+    std::vector<int> values;
+    tree.doInorderTraversal([&values](const Item& item) { values.push_back(item.m_value); });
+
+    ISHIKO_TEST_ABORT_IF_NEQ(values.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[0], 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[1], 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[2], 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[3], 7);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::DoPreorderTraversalTest1(Test& test)
+{
+    Item item1(5);
+    Item item2(3);
+    Item item3(7);
+    Item item4(4);
+
+    ItemTree tree;
+    tree.setRoot(&item1);
+    tree.insertLeft(&item2, &item1);
+    tree.insertRight(&item3, &item1);
+    tree.insertRight(&item4, &item2);
+
+    std::vector<int> values;
+    tree.doPreorderTraversal([&values](const Item& item) { values.push_back(item.m_value); });
+
+    ISHIKO_TEST_ABORT_IF_NEQ(values.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[0], 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[1], 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[2], 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[3], 7);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::DoPostorderTraversalTest1(Test& test)
+{
+    Item item1(5);
+    Item item2(3);
+    Item item3(7);
+    Item item4(4);
+
+    ItemTree tree;
+    tree.setRoot(&item1);
+    tree.insertLeft(&item2, &item1);
+    tree.insertRight(&item3, &item1);
+    tree.insertRight(&item4, &item2);
+
+    std::vector<int> values;
+    tree.doPostorderTraversal([&values](const Item& item) { values.push_back(item.m_value); });
+
+    ISHIKO_TEST_ABORT_IF_NEQ(values.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[0], 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[1], 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[2], 7);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[3], 5);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::DoLevelOrderTraversalTest1(Test& test)
+{
+    Item item1(5);
+    Item item2(3);
+    Item item3(7);
+    Item item4(4);
+
+    ItemTree tree;
+    tree.setRoot(&item1);
+    tree.insertLeft(&item2, &item1);
+    tree.insertRight(&item3, &item1);
+    tree.insertRight(&item4, &item2);
+
+    std::vector<int> values;
+    tree.doLevelOrderTraversal([&values](const Item& item) { values.push_back(item.m_value); });
+
+    ISHIKO_TEST_ABORT_IF_NEQ(values.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[0], 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[1], 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[2], 7);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[3], 4);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::RotateLeftTest1(Test& test)
+{
+    Item item1(5);
+    Item item2(7);
+
+    ItemTree tree;
+    tree.setRoot(&item1);
+    tree.insertRight(&item2, &item1);
+
+    tree.rotateLeft(&item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root(), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::ParentNode(&item2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::LeftChildNode(&item2), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::RightChildNode(&item2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::ParentNode(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::LeftChildNode(&item1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::RightChildNode(&item1), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::RotateRightTest1(Test& test)
+{
+    Item item1(5);
+    Item item2(3);
+
+    ItemTree tree;
+    tree.setRoot(&item1);
+    tree.insertLeft(&item2, &item1);
+
+    tree.rotateRight(&item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root(), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::ParentNode(&item2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::LeftChildNode(&item2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::RightChildNode(&item2), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::ParentNode(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::LeftChildNode(&item1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::RightChildNode(&item1), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveBinaryTreeTests::ClearTest1(Test& test)
+{
+    Item item1(5);
+    Item item2(3);
+
+    ItemTree tree;
+    tree.setRoot(&item1);
+    tree.insertLeft(&item2, &item1);
+    tree.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+
+    tree.setRoot(&item2);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.root(), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemTree::ParentNode(&item2), nullptr);
+    ISHIKO_TEST_PASS();
+}
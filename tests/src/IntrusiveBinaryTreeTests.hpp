@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_INTRUSIVEBINARYTREETESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_INTRUSIVEBINARYTREETESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class IntrusiveBinaryTreeTests : public Ishiko::TestSequence
+{
+public:
+    IntrusiveBinaryTreeTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void SetRootTest1(Ishiko::Test& test);
+    static void InsertLeftTest1(Ishiko::Test& test);
+    static void InsertRightTest1(Ishiko::Test& test);
+    static void DoInorderTraversalTest1(Ishiko::Test& test);
+    static void DoPreorderTraversalTest1(Ishiko::Test& test);
+    static void DoPostorderTraversalTest1(Ishiko::Test& test);
+    static void DoLevelOrderTraversalTest1(Ishiko::Test& test);
+    static void RotateLeftTest1(Ishiko::Test& test);
+    static void RotateRightTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "IntrusiveDoublyLinkedListTests.hpp"
+#include "Ishiko/DataStructures/IntrusiveDoublyLinkedList.hpp"
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    class Item : public DoublyLinkedListHook<Item>
+    {
+    public:
+        explicit Item(int value) : m_value(value)
+        {
+        }
+
+        int m_value;
+    };
+
+    typedef IntrusiveDoublyLinkedList<Item> ItemList;
+}
+
+IntrusiveDoublyLinkedListTests::IntrusiveDoublyLinkedListTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "IntrusiveDoublyLinkedList tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("pushFront test 1", PushFrontTest1);
+    append<HeapAllocationErrorsTest>("insertAfter test 1", InsertAfterTest1);
+    append<HeapAllocationErrorsTest>("insertBefore test 1", InsertBeforeTest1);
+    append<HeapAllocationErrorsTest>("erase test 1", EraseTest1);
+    append<HeapAllocationErrorsTest>("traverse test 1", TraverseTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+}
+
+void IntrusiveDoublyLinkedListTests::ConstructorTest1(Test& test)
+{
+    ItemList list;
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveDoublyLinkedListTests::PushFrontTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+
+    ItemList list;
+    list.pushFront(&item1);
+    list.pushFront(&item2);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::PreviousNode(&item2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::NextNode(&item2), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::PreviousNode(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::NextNode(&item1), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveDoublyLinkedListTests::InsertAfterTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+    Item item3(3);
+
+    ItemList list;
+    list.pushFront(&item1);
+    list.insertAfter(&item3, &item1);
+    list.insertAfter(&item2, &item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::NextNode(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::NextNode(&item2), &item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::NextNode(&item3), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::PreviousNode(&item3), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::PreviousNode(&item2), &item1);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveDoublyLinkedListTests::InsertBeforeTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+    Item item3(3);
+
+    ItemList list;
+    list.pushFront(&item3);
+    list.insertBefore(&item1, &item3);
+    list.insertBefore(&item2, &item3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::PreviousNode(&item1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::NextNode(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::NextNode(&item2), &item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::PreviousNode(&item3), &item2);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveDoublyLinkedListTests::EraseTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+    Item item3(3);
+
+    ItemList list;
+    list.pushFront(&item3);
+    list.pushFront(&item2);
+    list.pushFront(&item1);
+
+    list.erase(&item2);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::NextNode(&item1), &item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::PreviousNode(&item3), &item1);
+
+    list.erase(&item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::PreviousNode(&item3), nullptr);
+
+    list.erase(&item3);
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveDoublyLinkedListTests::TraverseTest1(Test& test)
+{
+    std::vector<Item> items;
+    for (int i = 0; i < 10; ++i)
+    {
+        items.emplace_back(i);
+    }
+
+    ItemList list;
+    for (Item& item : items)
+    {
+        list.pushFront(&item);
+    }
+
+    std::vector<int> values;
+    list.traverse([&values](const Item& item) { values.push_back(item.m_value); });
+
+    ISHIKO_TEST_ABORT_IF_NEQ(values.size(), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[0], 9);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[9], 0);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveDoublyLinkedListTests::ClearTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+
+    ItemList list;
+    list.pushFront(&item1);
+    list.pushFront(&item2);
+    list.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+
+    list.pushFront(&item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::PreviousNode(&item1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(ItemList::NextNode(&item1), nullptr);
+    ISHIKO_TEST_PASS();
+}
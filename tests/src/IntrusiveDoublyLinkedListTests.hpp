@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_INTRUSIVEDOUBLYLINKEDLISTTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_INTRUSIVEDOUBLYLINKEDLISTTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class IntrusiveDoublyLinkedListTests : public Ishiko::TestSequence
+{
+public:
+    IntrusiveDoublyLinkedListTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void PushFrontTest1(Ishiko::Test& test);
+    static void InsertAfterTest1(Ishiko::Test& test);
+    static void InsertBeforeTest1(Ishiko::Test& test);
+    static void EraseTest1(Ishiko::Test& test);
+    static void TraverseTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+};
+
+#endif
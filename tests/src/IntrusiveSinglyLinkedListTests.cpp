@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "IntrusiveSinglyLinkedListTests.hpp"
+#include "Ishiko/DataStructures/IntrusiveSinglyLinkedList.hpp"
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    class Item : public SinglyLinkedListHook<Item>
+    {
+    public:
+        explicit Item(int value) : m_value(value)
+        {
+        }
+
+        int m_value;
+    };
+
+    class ByPriority;
+    class ByAge;
+
+    // An item that can be in two lists at the same time
+    class Task : public SinglyLinkedListHook<Task, ByPriority>, public SinglyLinkedListHook<Task, ByAge>
+    {
+    public:
+        explicit Task(int id) : m_id(id)
+        {
+        }
+
+        int m_id;
+    };
+}
+
+IntrusiveSinglyLinkedListTests::IntrusiveSinglyLinkedListTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "IntrusiveSinglyLinkedList tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("pushFront test 1", PushFrontTest1);
+    append<HeapAllocationErrorsTest>("insert test 1", InsertTest1);
+    append<HeapAllocationErrorsTest>("popFront test 1", PopFrontTest1);
+    append<HeapAllocationErrorsTest>("eraseAfter test 1", EraseAfterTest1);
+    append<HeapAllocationErrorsTest>("traverse test 1", TraverseTest1);
+    append<HeapAllocationErrorsTest>("Hook test 1", HookTest1);
+    append<HeapAllocationErrorsTest>("Hook test 2", HookTest2);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+}
+
+void IntrusiveSinglyLinkedListTests::ConstructorTest1(Test& test)
+{
+    IntrusiveSinglyLinkedList<Item> list;
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveSinglyLinkedListTests::PushFrontTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+
+    IntrusiveSinglyLinkedList<Item> list;
+    list.pushFront(&item1);
+    list.pushFront(&item2);
+
+    ISHIKO_TEST_FAIL_IF(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(IntrusiveSinglyLinkedList<Item>::NextNode(&item2), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(IntrusiveSinglyLinkedList<Item>::NextNode(&item1), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveSinglyLinkedListTests::InsertTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+    Item item3(3);
+
+    IntrusiveSinglyLinkedList<Item> list;
+    list.pushFront(&item1);
+    list.insert(&item3, &item1);
+    list.insert(&item2, &item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(IntrusiveSinglyLinkedList<Item>::NextNode(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(IntrusiveSinglyLinkedList<Item>::NextNode(&item2), &item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(IntrusiveSinglyLinkedList<Item>::NextNode(&item3), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveSinglyLinkedListTests::PopFrontTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+
+    IntrusiveSinglyLinkedList<Item> list;
+    list.pushFront(&item1);
+    list.pushFront(&item2);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.popFront(), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.popFront(), &item1);
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.popFront(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveSinglyLinkedListTests::EraseAfterTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+    Item item3(3);
+
+    IntrusiveSinglyLinkedList<Item> list;
+    list.pushFront(&item3);
+    list.pushFront(&item2);
+    list.pushFront(&item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.eraseAfter(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(IntrusiveSinglyLinkedList<Item>::NextNode(&item1), &item3);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.eraseAfter(&item3), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveSinglyLinkedListTests::TraverseTest1(Test& test)
+{
+    std::vector<Item> items;
+    for (int i = 0; i < 10; ++i)
+    {
+        items.emplace_back(i);
+    }
+
+    IntrusiveSinglyLinkedList<Item> list;
+    for (Item& item : items)
+    {
+        list.pushFront(&item);
+    }
+
+    std::vector<int> values;
+    list.traverse([&values](const Item& item) { values.push_back(item.m_value); });
+
+    ISHIKO_TEST_ABORT_IF_NEQ(values.size(), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[0], 9);
+    ISHIKO_TEST_FAIL_IF_NEQ(values[9], 0);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveSinglyLinkedListTests::HookTest1(Test& test)
+{
+    Task task1(1);
+    Task task2(2);
+
+    typedef IntrusiveSinglyLinkedList<Task, ByPriority> PriorityList;
+    typedef IntrusiveSinglyLinkedList<Task, ByAge> AgeList;
+
+    PriorityList by_priority;
+    AgeList by_age;
+    by_priority.pushFront(&task1);
+    by_priority.pushFront(&task2);
+    by_age.pushFront(&task2);
+    by_age.pushFront(&task1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(by_priority.head(), &task2);
+    ISHIKO_TEST_FAIL_IF_NEQ(PriorityList::NextNode(&task2), &task1);
+    ISHIKO_TEST_FAIL_IF_NEQ(by_age.head(), &task1);
+    ISHIKO_TEST_FAIL_IF_NEQ(AgeList::NextNode(&task1), &task2);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveSinglyLinkedListTests::HookTest2(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+
+    IntrusiveSinglyLinkedList<Item> list;
+    list.pushFront(&item2);
+    list.pushFront(&item1);
+
+    // Assigning to an object that is in a list doesn't change its links
+    item1 = Item(3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(IntrusiveSinglyLinkedList<Item>::NextNode(&item1), &item2);
+    ISHIKO_TEST_FAIL_IF_NEQ(item1.m_value, 3);
+    ISHIKO_TEST_PASS();
+}
+
+void IntrusiveSinglyLinkedListTests::ClearTest1(Test& test)
+{
+    Item item1(1);
+    Item item2(2);
+
+    IntrusiveSinglyLinkedList<Item> list;
+    list.pushFront(&item1);
+    list.pushFront(&item2);
+    list.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+
+    list.pushFront(&item1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), &item1);
+    ISHIKO_TEST_FAIL_IF_NEQ(IntrusiveSinglyLinkedList<Item>::NextNode(&item1), nullptr);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_INTRUSIVESINGLYLINKEDLISTTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_INTRUSIVESINGLYLINKEDLISTTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class IntrusiveSinglyLinkedListTests : public Ishiko::TestSequence
+{
+public:
+    IntrusiveSinglyLinkedListTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void PushFrontTest1(Ishiko::Test& test);
+    static void InsertTest1(Ishiko::Test& test);
+    static void PopFrontTest1(Ishiko::Test& test);
+    static void EraseAfterTest1(Ishiko::Test& test);
+    static void TraverseTest1(Ishiko::Test& test);
+    static void HookTest1(Ishiko::Test& test);
+    static void HookTest2(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,326 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "OrderedSetImageTests.hpp"
+#include "Ishiko/DataStructures/BinaryTree.hpp"
+#include "Ishiko/DataStructures/OrderedSetImage.hpp"
+#include "Ishiko/DataStructures/SkipList.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    // Small nodes so that a few hundred values are enough to get a tree with several levels. A leaf holds 12 ints
+    // and an internal node 3 children.
+    typedef OrderedSetImageWriter<int, std::less<int>, 64> SmallWriter;
+    typedef OrderedSetImage<int, std::less<int>, 64> SmallImage;
+
+    // An image as it would be in memory after being mapped from a file, in particular suitably aligned
+    class ImageBuffer
+    {
+    public:
+        explicit ImageBuffer(const std::string& bytes)
+            : m_words((bytes.size() + 7) / 8), m_size(bytes.size())
+        {
+            memcpy(m_words.data(), bytes.data(), bytes.size());
+        }
+
+        const void* data() const noexcept
+        {
+            return m_words.data();
+        }
+
+        size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+    private:
+        std::vector<uint64_t> m_words;
+        size_t m_size;
+    };
+
+    template<typename Writer>
+    std::string WriteImage(const std::vector<int>& values)
+    {
+        std::ostringstream output;
+        Writer writer(output);
+        writer.add(values.begin(), values.end());
+        writer.finish();
+        return output.str();
+    }
+
+    std::vector<int> OddValues(int count)
+    {
+        std::vector<int> values;
+        for (int i = 0; i < count; ++i)
+        {
+            values.push_back((2 * i) + 1);
+        }
+        return values;
+    }
+}
+
+OrderedSetImageTests::OrderedSetImageTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "OrderedSetImage tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("Constructor test 2", ConstructorTest2);
+    append<HeapAllocationErrorsTest>("Constructor test 3", ConstructorTest3);
+    append<HeapAllocationErrorsTest>("Constructor test 4", ConstructorTest4);
+    append<HeapAllocationErrorsTest>("Constructor test 5", ConstructorTest5);
+    append<HeapAllocationErrorsTest>("OrderedSetImageWriter test 1", WriterTest1);
+    append<HeapAllocationErrorsTest>("OrderedSetImageWriter test 2", WriterTest2);
+    append<HeapAllocationErrorsTest>("OrderedSetImageWriter test 3", WriterTest3);
+    append<HeapAllocationErrorsTest>("OrderedSetImageWriter test 4", WriterTest4);
+    append<HeapAllocationErrorsTest>("find test 1", FindTest1);
+    append<HeapAllocationErrorsTest>("lowerBound test 1", LowerBoundTest1);
+    append<HeapAllocationErrorsTest>("lowerBound test 2", LowerBoundTest2);
+    append<HeapAllocationErrorsTest>("SkipList test 1", SkipListTest1);
+    append<HeapAllocationErrorsTest>("BinaryTree test 1", BinaryTreeTest1);
+}
+
+void OrderedSetImageTests::ConstructorTest1(Test& test)
+{
+    OrderedSetImage<int> image;
+
+    ISHIKO_TEST_FAIL_IF_NOT(image.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(image.size(), 0);
+    ISHIKO_TEST_FAIL_IF(image.begin() != image.end());
+    ISHIKO_TEST_FAIL_IF(image.contains(0));
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::ConstructorTest2(Test& test)
+{
+    ImageBuffer buffer(WriteImage<OrderedSetImageWriter<int>>({ 1, 2, 3 }));
+
+    Error error;
+    OrderedSetImage<int> image(buffer.data(), buffer.size(), error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(image.size(), 3);
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::ConstructorTest3(Test& test)
+{
+    std::string bytes = WriteImage<OrderedSetImageWriter<int>>({ 1, 2, 3 });
+    bytes[0] = 'X';
+    ImageBuffer buffer(bytes);
+
+    Error error;
+    OrderedSetImage<int> image(buffer.data(), buffer.size(), error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(error.code(), static_cast<int>(DataStructuresErrorCategory::Value::invalid_image));
+    ISHIKO_TEST_FAIL_IF_NOT(image.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::ConstructorTest4(Test& test)
+{
+    // An image written with a different data type is rejected
+    ImageBuffer buffer(WriteImage<OrderedSetImageWriter<int>>({ 1, 2, 3 }));
+
+    Error error;
+    OrderedSetImage<double> image(buffer.data(), buffer.size(), error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::ConstructorTest5(Test& test)
+{
+    // A truncated image is rejected, by the throwing constructor here
+    std::string bytes = WriteImage<OrderedSetImageWriter<int>>({ 1, 2, 3 });
+    ImageBuffer buffer(bytes.substr(0, bytes.size() - 8));
+
+    bool thrown = false;
+    try
+    {
+        OrderedSetImage<int> image(buffer.data(), buffer.size());
+    }
+    catch (const Exception& e)
+    {
+        thrown = (e.value() == static_cast<int>(DataStructuresErrorCategory::Value::invalid_image));
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(thrown);
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::WriterTest1(Test& test)
+{
+    ImageBuffer buffer(WriteImage<OrderedSetImageWriter<int>>({}));
+
+    OrderedSetImage<int> image(buffer.data(), buffer.size());
+
+    ISHIKO_TEST_FAIL_IF_NOT(image.isEmpty());
+    ISHIKO_TEST_FAIL_IF(image.begin() != image.end());
+    ISHIKO_TEST_FAIL_IF(image.contains(1));
+    ISHIKO_TEST_FAIL_IF_NEQ(image.statistics().height, 0);
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::WriterTest2(Test& test)
+{
+    // The header, a single leaf and the trailer
+    std::string bytes = WriteImage<OrderedSetImageWriter<int>>({ 5, 8, 13 });
+    ImageBuffer buffer(bytes);
+
+    OrderedSetImage<int> image(buffer.data(), buffer.size());
+
+    std::vector<int> values(image.begin(), image.end());
+    ISHIKO_TEST_FAIL_IF_NEQ(bytes.size(), (2 * 4096) + sizeof(OrderedSetImageLayout<int, 4096>::Trailer));
+    ISHIKO_TEST_FAIL_IF_NEQ(values, (std::vector<int>{ 5, 8, 13 }));
+    ISHIKO_TEST_FAIL_IF_NEQ(image.statistics().height, 1);
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::WriterTest3(Test& test)
+{
+    // Enough values for a tree with 6 levels, including a last leaf and last internal nodes that are not full
+    std::vector<int> values = OddValues(1000);
+    ImageBuffer buffer(WriteImage<SmallWriter>(values));
+
+    SmallImage image(buffer.data(), buffer.size());
+
+    std::vector<int> image_values;
+    image.traverse([&image_values](int value) { image_values.push_back(value); });
+    ISHIKO_TEST_FAIL_IF_NEQ(image.size(), 1000);
+    ISHIKO_TEST_FAIL_IF_NEQ(image_values, values);
+    ISHIKO_TEST_FAIL_IF_NEQ(image.statistics().height, 6);
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::WriterTest4(Test& test)
+{
+    std::ostringstream output;
+    SmallWriter writer(output);
+    writer.add(3);
+
+    bool thrown = false;
+    try
+    {
+        writer.add(3);
+    }
+    catch (const Exception& e)
+    {
+        thrown = true;
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(thrown);
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::FindTest1(Test& test)
+{
+    // Every size up to a few full levels so that the boundaries between nodes end up everywhere
+    for (int count = 1; count < 200; ++count)
+    {
+        std::vector<int> values = OddValues(count);
+        ImageBuffer buffer(WriteImage<SmallWriter>(values));
+        SmallImage image(buffer.data(), buffer.size());
+
+        for (int value = 0; value <= (2 * count); ++value)
+        {
+            const int* found = image.find(value);
+            if (value % 2)
+            {
+                ISHIKO_TEST_ABORT_IF_NOT(found && (*found == value));
+            }
+            else
+            {
+                ISHIKO_TEST_ABORT_IF(found);
+            }
+        }
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::LowerBoundTest1(Test& test)
+{
+    std::vector<int> values = OddValues(500);
+    ImageBuffer buffer(WriteImage<SmallWriter>(values));
+    SmallImage image(buffer.data(), buffer.size());
+
+    for (int value = -1; value < 1000; ++value)
+    {
+        SmallImage::ConstIterator it = image.lowerBound(value);
+        ISHIKO_TEST_ABORT_IF(it == image.end());
+        ISHIKO_TEST_ABORT_IF_NEQ(*it, ((value < 1) ? 1 : (value | 1)));
+    }
+    ISHIKO_TEST_FAIL_IF(image.lowerBound(1000) != image.end());
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::LowerBoundTest2(Test& test)
+{
+    // Values greater than the last value of a leaf but less than the first value of the next leaf
+    std::vector<int> values = OddValues(500);
+    ImageBuffer buffer(WriteImage<SmallWriter>(values));
+    SmallImage image(buffer.data(), buffer.size());
+
+    std::vector<int> remaining_values;
+    for (SmallImage::ConstIterator it = image.lowerBound(24); it != image.end(); ++it)
+    {
+        remaining_values.push_back(*it);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(remaining_values, std::vector<int>(values.begin() + 12, values.end()));
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::SkipListTest1(Test& test)
+{
+    SkipList<int> list;
+    for (int i = 0; i < 5000; ++i)
+    {
+        list.insert((i * 7919) % 5000);
+    }
+
+    std::ostringstream output;
+    OrderedSetImageWriter<int> writer(output);
+    writer.add(list.begin(), list.end());
+    writer.finish();
+    ImageBuffer buffer(output.str());
+
+    OrderedSetImage<int> image(buffer.data(), buffer.size());
+
+    ISHIKO_TEST_FAIL_IF_NEQ(image.size(), 5000);
+    for (int i = 0; i < 5000; ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_NOT(image.contains(i));
+    }
+    ISHIKO_TEST_FAIL_IF(image.contains(5000));
+    ISHIKO_TEST_PASS();
+}
+
+void OrderedSetImageTests::BinaryTreeTest1(Test& test)
+{
+    BinaryTree<int> tree;
+    tree.setRoot(20);
+    BinaryTree<int>::Node* left_node = tree.insertLeft(10, tree.root());
+    tree.insertRight(30, tree.root());
+    tree.insertLeft(5, left_node);
+    tree.insertRight(15, left_node);
+
+    std::ostringstream output;
+    OrderedSetImageWriter<int> writer(output);
+    tree.doInorderTraversal([&writer](int value) { writer.add(value); });
+    writer.finish();
+    ImageBuffer buffer(output.str());
+
+    OrderedSetImage<int> image(buffer.data(), buffer.size());
+
+    std::vector<int> values(image.begin(), image.end());
+    ISHIKO_TEST_FAIL_IF_NEQ(values, (std::vector<int>{ 5, 10, 15, 20, 30 }));
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_ORDEREDSETIMAGETESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_ORDEREDSETIMAGETESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class OrderedSetImageTests : public Ishiko::TestSequence
+{
+public:
+    OrderedSetImageTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void ConstructorTest2(Ishiko::Test& test);
+    static void ConstructorTest3(Ishiko::Test& test);
+    static void ConstructorTest4(Ishiko::Test& test);
+    static void ConstructorTest5(Ishiko::Test& test);
+    static void WriterTest1(Ishiko::Test& test);
+    static void WriterTest2(Ishiko::Test& test);
+    static void WriterTest3(Ishiko::Test& test);
+    static void WriterTest4(Ishiko::Test& test);
+    static void FindTest1(Ishiko::Test& test);
+    static void LowerBoundTest1(Ishiko::Test& test);
+    static void LowerBoundTest2(Ishiko::Test& test);
+    static void SkipListTest1(Ishiko::Test& test);
+    static void BinaryTreeTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PoolAllocatorTests.hpp"
+#include "Ishiko/DataStructures/PoolAllocator.hpp"
+#include <cstdint>
+#include <cstring>
+
+using namespace Ishiko;
+
+PoolAllocatorTests::PoolAllocatorTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "PoolAllocator tests", context)
+{
+    append<HeapAllocationErrorsTest>("allocate test 1", AllocateTest1);
+    append<HeapAllocationErrorsTest>("allocate test 2", AllocateTest2);
+    append<HeapAllocationErrorsTest>("deallocate test 1", DeallocateTest1);
+    append<HeapAllocationErrorsTest>("deallocate test 2", DeallocateTest2);
+    append<HeapAllocationErrorsTest>("release test 1", ReleaseTest1);
+}
+
+void PoolAllocatorTests::AllocateTest1(Test& test)
+{
+    PoolAllocator allocator;
+
+    void* memory1 = allocator.allocate(24);
+    void* memory2 = allocator.allocate(24);
+    std::memset(memory1, 0xFF, 24);
+    std::memset(memory2, 0xFF, 24);
+
+    ISHIKO_TEST_ABORT_IF(memory1 == nullptr);
+    ISHIKO_TEST_ABORT_IF(memory2 == nullptr);
+    ISHIKO_TEST_FAIL_IF(memory1 == memory2);
+    ISHIKO_TEST_FAIL_IF_NEQ(reinterpret_cast<uintptr_t>(memory1) % ArenaAllocator::alignment, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(reinterpret_cast<uintptr_t>(memory2) % ArenaAllocator::alignment, 0);
+    ISHIKO_TEST_PASS();
+}
+
+void PoolAllocatorTests::AllocateTest2(Test& test)
+{
+    PoolAllocator allocator;
+
+    Error error;
+    void* memory = allocator.allocate(PoolAllocator::max_block_size + 1, error);
+    std::memset(memory, 0xFF, PoolAllocator::max_block_size + 1);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF(memory == nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(reinterpret_cast<uintptr_t>(memory) % ArenaAllocator::alignment, 0);
+    ISHIKO_TEST_PASS();
+}
+
+void PoolAllocatorTests::DeallocateTest1(Test& test)
+{
+    PoolAllocator allocator;
+    void* memory1 = allocator.allocate(40);
+
+    allocator.deallocate(memory1, 40);
+    // Same size class as 40 so the freed block is reused
+    void* memory2 = allocator.allocate(48);
+    void* memory3 = allocator.allocate(40);
+
+    ISHIKO_TEST_FAIL_IF(memory2 != memory1);
+    ISHIKO_TEST_FAIL_IF(memory3 == memory1);
+    ISHIKO_TEST_PASS();
+}
+
+void PoolAllocatorTests::DeallocateTest2(Test& test)
+{
+    PoolAllocator allocator;
+    void* memory1 = allocator.allocate(1000);
+    void* memory2 = allocator.allocate(2000);
+    void* memory3 = allocator.allocate(3000);
+
+    allocator.deallocate(memory2, 2000);
+    allocator.deallocate(memory1, 1000);
+    allocator.deallocate(memory3, 3000);
+
+    ISHIKO_TEST_PASS();
+}
+
+void PoolAllocatorTests::ReleaseTest1(Test& test)
+{
+    PoolAllocator allocator(1024);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        allocator.allocate(64);
+        allocator.allocate(1024);
+    }
+
+    allocator.release();
+    void* memory = allocator.allocate(64);
+
+    ISHIKO_TEST_FAIL_IF(memory == nullptr);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_POOLALLOCATORTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_POOLALLOCATORTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class PoolAllocatorTests : public Ishiko::TestSequence
+{
+public:
+    PoolAllocatorTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void AllocateTest1(Ishiko::Test& test);
+    static void AllocateTest2(Ishiko::Test& test);
+    static void DeallocateTest1(Ishiko::Test& test);
+    static void DeallocateTest2(Ishiko::Test& test);
+    static void ReleaseTest1(Ishiko::Test& test);
+};
+
+#endif
@@ -2,14 +2,84 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "RedBlackTreeTests.hpp"
+#include "Ishiko/DataStructures/ArenaAllocator.hpp"
+#include "Ishiko/DataStructures/PoolAllocator.hpp"
 #include "Ishiko/DataStructures/RedBlackTree.hpp"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
 
 using namespace Ishiko;
 
+namespace
+{
+    // Returns the black height of the subtree rooted at node, or 0 if the subtree breaks one of the red-black or
+    // binary search tree properties
+    template<class Compare, class Node>
+    size_t checkSubtree(const Node* node, const Node* parent_node, size_t& count)
+    {
+        if (!node)
+        {
+            return 1;
+        }
+        if (node->parentNode() != parent_node)
+        {
+            return 0;
+        }
+        if (node->isRed() && parent_node && parent_node->isRed())
+        {
+            return 0;
+        }
+        Compare compare;
+        if ((node->leftChildNode() && !compare(node->leftChildNode()->value(), node->value()))
+            || (node->rightChildNode() && !compare(node->value(), node->rightChildNode()->value())))
+        {
+            return 0;
+        }
+        ++count;
+        size_t left_height = checkSubtree<Compare>(node->leftChildNode(), node, count);
+        size_t right_height = checkSubtree<Compare>(node->rightChildNode(), node, count);
+        if ((left_height == 0) || (left_height != right_height))
+        {
+            return 0;
+        }
+        return (left_height + (node->isBlack() ? 1 : 0));
+    }
+
+    template<class Compare, class Allocator>
+    bool isValid(const RedBlackTree<int, Compare, Allocator>& tree)
+    {
+        if (tree.root() && tree.root()->isRed())
+        {
+            return false;
+        }
+        size_t count = 0;
+        const typename RedBlackTree<int, Compare, Allocator>::Node* no_parent = nullptr;
+        return ((checkSubtree<Compare>(tree.root(), no_parent, count) != 0) && (count == tree.size()));
+    }
+}
+
 RedBlackTreeTests::RedBlackTreeTests(const TestNumber& number, const TestContext& context)
     : TestSequence(number, "RedBlackTree tests", context)
 {
     append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("insert test 1", InsertTest1);
+    append<HeapAllocationErrorsTest>("insert test 2", InsertTest2);
+    append<HeapAllocationErrorsTest>("insert test 3", InsertTest3);
+    append<HeapAllocationErrorsTest>("insert test 4", InsertTest4);
+    append<HeapAllocationErrorsTest>("emplace test 1", EmplaceTest1);
+    append<HeapAllocationErrorsTest>("find test 1", FindTest1);
+    append<HeapAllocationErrorsTest>("lowerBound test 1", LowerBoundTest1);
+    append<HeapAllocationErrorsTest>("upperBound test 1", UpperBoundTest1);
+    append<HeapAllocationErrorsTest>("Iterator test 1", IteratorTest1);
+    append<HeapAllocationErrorsTest>("erase test 1", EraseTest1);
+    append<HeapAllocationErrorsTest>("erase test 2", EraseTest2);
+    append<HeapAllocationErrorsTest>("erase test 3", EraseTest3);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+    append<HeapAllocationErrorsTest>("clear test 2", ClearTest2);
 }
 
 void RedBlackTreeTests::ConstructorTest1(Test& test)
@@ -17,5 +87,342 @@ void RedBlackTreeTests::ConstructorTest1(Test& test)
     RedBlackTree<int> tree;
 
     ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 0);
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF(tree.root() != nullptr);
+    ISHIKO_TEST_FAIL_IF(tree.begin() != tree.end());
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::InsertTest1(Test& test)
+{
+    RedBlackTree<int> tree;
+
+    RedBlackTree<int>::Node* node = tree.insert(5);
+
+    ISHIKO_TEST_ABORT_IF(node == nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->value(), 5);
+    ISHIKO_TEST_FAIL_IF_NOT(node->isBlack());
+    ISHIKO_TEST_FAIL_IF(tree.root() != node);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 1);
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::InsertTest2(Test& test)
+{
+    RedBlackTree<int> tree;
+
+    RedBlackTree<int>::Node* node1 = tree.insert(5);
+    RedBlackTree<int>::Node* node2 = tree.insert(5);
+
+    ISHIKO_TEST_FAIL_IF(node1 != node2);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 1);
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::InsertTest3(Test& test)
+{
+    RedBlackTree<int> ascending_tree;
+    RedBlackTree<int> descending_tree;
+    RedBlackTree<int> random_tree;
+
+    std::vector<int> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        ascending_tree.insert(i);
+        descending_tree.insert(1000 - i);
+        values.push_back(i);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(42));
+    for (int value : values)
+    {
+        random_tree.insert(value);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(ascending_tree.size(), 1000);
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(ascending_tree));
+    ISHIKO_TEST_FAIL_IF_NEQ(descending_tree.size(), 1000);
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(descending_tree));
+    ISHIKO_TEST_FAIL_IF_NEQ(random_tree.size(), 1000);
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(random_tree));
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::InsertTest4(Test& test)
+{
+    RedBlackTree<std::string> tree;
+    std::string value = "aaa";
+    const RedBlackTree<std::string>::Node* node = tree.insert(std::move(value));
+
+    ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->value(), "aaa");
+
+    // A value that is already in the tree must not be moved from
+    std::string duplicate = "aaa";
+    const RedBlackTree<std::string>::Node* existing_node = tree.insert(std::move(duplicate));
+
+    ISHIKO_TEST_FAIL_IF_NEQ(existing_node, node);
+    ISHIKO_TEST_FAIL_IF_NEQ(duplicate, "aaa");
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 1);
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::EmplaceTest1(Test& test)
+{
+    RedBlackTree<int> tree;
+
+    std::vector<int> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(i);
+        values.push_back(i);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(42));
+    for (int value : values)
+    {
+        RedBlackTree<int>::Node* node = tree.emplace(value);
+
+        ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
+        ISHIKO_TEST_FAIL_IF_NEQ(node->value(), value);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 1000);
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree));
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::FindTest1(Test& test)
+{
+    RedBlackTree<int> tree;
+    for (int i = 0; i < 100; i += 2)
+    {
+        tree.insert(i);
+    }
+
+    const RedBlackTree<int>::Node* node1 = tree.find(42);
+    const RedBlackTree<int>::Node* node2 = tree.find(43);
+
+    ISHIKO_TEST_ABORT_IF(node1 == nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node1->value(), 42);
+    ISHIKO_TEST_FAIL_IF(node2 != nullptr);
+    ISHIKO_TEST_FAIL_IF_NOT(tree.contains(0));
+    ISHIKO_TEST_FAIL_IF_NOT(tree.contains(98));
+    ISHIKO_TEST_FAIL_IF(tree.contains(-1));
+    ISHIKO_TEST_FAIL_IF(tree.contains(99));
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::LowerBoundTest1(Test& test)
+{
+    RedBlackTree<int> tree;
+    for (int i = 0; i < 100; i += 2)
+    {
+        tree.insert(i);
+    }
+
+    const RedBlackTree<int>::Node* node1 = tree.lowerBound(42);
+    const RedBlackTree<int>::Node* node2 = tree.lowerBound(43);
+    const RedBlackTree<int>::Node* node3 = tree.lowerBound(-5);
+    const RedBlackTree<int>::Node* node4 = tree.lowerBound(99);
+
+    ISHIKO_TEST_ABORT_IF(node1 == nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node1->value(), 42);
+    ISHIKO_TEST_ABORT_IF(node2 == nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node2->value(), 44);
+    ISHIKO_TEST_ABORT_IF(node3 == nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node3->value(), 0);
+    ISHIKO_TEST_FAIL_IF(node4 != nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::UpperBoundTest1(Test& test)
+{
+    RedBlackTree<int> tree;
+    for (int i = 0; i < 100; i += 2)
+    {
+        tree.insert(i);
+    }
+
+    const RedBlackTree<int>::Node* node1 = tree.upperBound(42);
+    const RedBlackTree<int>::Node* node2 = tree.upperBound(43);
+    const RedBlackTree<int>::Node* node3 = tree.upperBound(98);
+
+    ISHIKO_TEST_ABORT_IF(node1 == nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node1->value(), 44);
+    ISHIKO_TEST_ABORT_IF(node2 == nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node2->value(), 44);
+    ISHIKO_TEST_FAIL_IF(node3 != nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::IteratorTest1(Test& test)
+{
+    RedBlackTree<int, std::greater<int>> tree;
+    std::vector<int> values;
+    for (int i = 0; i < 500; ++i)
+    {
+        values.push_back(i);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(7));
+    for (int value : values)
+    {
+        tree.insert(value);
+    }
+
+    std::vector<int> visited(tree.begin(), tree.end());
+
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree));
+    ISHIKO_TEST_ABORT_IF_NEQ(visited.size(), 500);
+    for (size_t i = 0; i < visited.size(); ++i)
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(visited[i], static_cast<int>(499 - i));
+    }
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.find(250)->nextNode()->value(), 249);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.find(250)->previousNode()->value(), 251);
+    ISHIKO_TEST_FAIL_IF(tree.find(0)->nextNode() != nullptr);
+    ISHIKO_TEST_FAIL_IF(tree.find(499)->previousNode() != nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::EraseTest1(Test& test)
+{
+    RedBlackTree<int> tree;
+    tree.insert(1);
+    tree.insert(2);
+    tree.insert(3);
+
+    bool erased1 = tree.erase(2);
+    bool erased2 = tree.erase(2);
+
+    ISHIKO_TEST_FAIL_IF_NOT(erased1);
+    ISHIKO_TEST_FAIL_IF(erased2);
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 2);
+    ISHIKO_TEST_FAIL_IF(tree.contains(2));
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree));
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::EraseTest2(Test& test)
+{
+    RedBlackTree<int> tree;
+    std::vector<int> values;
+    for (int i = 0; i < 2000; ++i)
+    {
+        values.push_back(i);
+    }
+    std::mt19937 generator(1234);
+    std::shuffle(values.begin(), values.end(), generator);
+    for (int value : values)
+    {
+        tree.insert(value);
+    }
+
+    // Erase in a different random order, checking the tree after every erase hits all the rebalancing cases
+    std::shuffle(values.begin(), values.end(), generator);
+    bool valid = true;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_NOT(tree.erase(values[i]));
+        valid = (valid && isValid(tree));
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(valid);
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 0);
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::EraseTest3(Test& test)
+{
+    RedBlackTree<int> tree;
+    for (int i = 0; i < 100; ++i)
+    {
+        tree.insert(i);
+    }
+
+    // Erasing through the nodes while iterating over them removes the even values
+    RedBlackTree<int>::Node* node = tree.find(0);
+    while (node)
+    {
+        RedBlackTree<int>::Node* next_node = node->nextNode();
+        if ((node->value() % 2) == 0)
+        {
+            tree.erase(node);
+        }
+        node = next_node;
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 50);
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(tree));
+    ISHIKO_TEST_FAIL_IF(tree.contains(50));
+    ISHIKO_TEST_FAIL_IF_NOT(tree.contains(51));
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::StatisticsTest1(Test& test)
+{
+    RedBlackTree<int> tree;
+    for (int i = 0; i < 100; ++i)
+    {
+        tree.insert(i);
+    }
+
+    ContainerStatistics statistics = tree.statistics();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_count, 100);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_bytes, 100 * sizeof(RedBlackTree<int>::Node));
+    // A red-black tree with n nodes is at most 2 * log2(n + 1) high and a binary tree at least log2(n + 1)
+    ISHIKO_TEST_FAIL_IF(statistics.height < 7);
+    ISHIKO_TEST_FAIL_IF(statistics.height > 13);
+    ISHIKO_TEST_FAIL_IF(statistics.has_allocation_statistics);
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::ClearTest1(Test& test)
+{
+    RedBlackTree<int> tree;
+    for (int i = 0; i < 100000; ++i)
+    {
+        tree.insert(i);
+    }
+
+    tree.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(tree.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 0);
+    ISHIKO_TEST_FAIL_IF(tree.begin() != tree.end());
+
+    tree.insert(3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(tree.size(), 1);
+    ISHIKO_TEST_PASS();
+}
+
+void RedBlackTreeTests::ClearTest2(Test& test)
+{
+    RedBlackTree<int, std::less<int>, ArenaAllocator> arena_tree;
+    RedBlackTree<int, std::less<int>, PoolAllocator> pool_tree;
+    arena_tree.reserve(1000);
+    pool_tree.reserve(1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        arena_tree.insert(i);
+        pool_tree.insert(i);
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        arena_tree.erase(i);
+        pool_tree.erase(i);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(arena_tree));
+    ISHIKO_TEST_FAIL_IF_NOT(isValid(pool_tree));
+
+    arena_tree.clear();
+    pool_tree.clear();
+    arena_tree.insert(3);
+    pool_tree.insert(3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(arena_tree.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(pool_tree.size(), 1);
     ISHIKO_TEST_PASS();
 }
@@ -13,6 +13,21 @@ public:
 
 private:
     static void ConstructorTest1(Ishiko::Test& test);
+    static void InsertTest1(Ishiko::Test& test);
+    static void InsertTest2(Ishiko::Test& test);
+    static void InsertTest3(Ishiko::Test& test);
+    static void InsertTest4(Ishiko::Test& test);
+    static void EmplaceTest1(Ishiko::Test& test);
+    static void FindTest1(Ishiko::Test& test);
+    static void LowerBoundTest1(Ishiko::Test& test);
+    static void UpperBoundTest1(Ishiko::Test& test);
+    static void IteratorTest1(Ishiko::Test& test);
+    static void EraseTest1(Ishiko::Test& test);
+    static void EraseTest2(Ishiko::Test& test);
+    static void EraseTest3(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+    static void ClearTest2(Ishiko::Test& test);
 };
 
 #endif
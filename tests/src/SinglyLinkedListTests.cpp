@@ -2,20 +2,52 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "SinglyLinkedListTests.hpp"
+#include "Ishiko/DataStructures/CountingAllocator.hpp"
+#include "Ishiko/DataStructures/PoolAllocator.hpp"
 #include "Ishiko/DataStructures/SinglyLinkedList.hpp"
+#include "Ishiko/DataStructures/WorkStealingPool.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
 
 using namespace Ishiko;
 
+namespace
+{
+    // Copying is nothrow but moving always throws
+    class ThrowingMoveValue
+    {
+    public:
+        ThrowingMoveValue() noexcept = default;
+        ThrowingMoveValue(const ThrowingMoveValue&) noexcept = default;
+        ThrowingMoveValue(ThrowingMoveValue&&)
+        {
+            throw std::runtime_error("move failed");
+        }
+        ThrowingMoveValue& operator=(const ThrowingMoveValue&) noexcept = default;
+        ThrowingMoveValue& operator=(ThrowingMoveValue&&) noexcept = default;
+    };
+}
+
 SinglyLinkedListTests::SinglyLinkedListTests(const TestNumber& number, const TestContext& context)
     : TestSequence(number, "SinglyLinkedList tests", context)
 {
     append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
     append<HeapAllocationErrorsTest>("setHead test 1", SetHeadTest1);
     append<HeapAllocationErrorsTest>("setHead test 2", SetHeadTest2);
+    append<HeapAllocationErrorsTest>("setHead test 3", SetHeadTest3);
+    append<HeapAllocationErrorsTest>("setHead test 4", SetHeadTest4);
     append<HeapAllocationErrorsTest>("insert test 1", InsertTest1);
+    append<HeapAllocationErrorsTest>("insert test 2", InsertTest2);
+    append<HeapAllocationErrorsTest>("emplace test 1", EmplaceTest1);
     append<HeapAllocationErrorsTest>("traverse test 1", TraverseTest1);
     append<HeapAllocationErrorsTest>("traverse test 2", TraverseTest2);
     append<HeapAllocationErrorsTest>("traverse test 3", TraverseTest3);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+    append<HeapAllocationErrorsTest>("clear test 2", ClearTest2);
+    append<HeapAllocationErrorsTest>("reserve test 1", ReserveTest1);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+    append<HeapAllocationErrorsTest>("Destructor test 1", DestructorTest1);
 }
 
 void SinglyLinkedListTests::ConstructorTest1(Test& test)
@@ -64,6 +96,44 @@ void SinglyLinkedListTests::SetHeadTest2(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void SinglyLinkedListTests::SetHeadTest3(Test& test)
+{
+    Error error;
+
+    SinglyLinkedList<std::unique_ptr<int>> list;
+    std::unique_ptr<int> data(new int(5));
+    list.setHead(std::move(data), error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(data.get(), nullptr);
+
+    SinglyLinkedList<std::unique_ptr<int>>::Node* node = list.head();
+
+    ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
+    ISHIKO_TEST_ABORT_IF_EQ(node->data().get(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(*node->data(), 5);
+
+    std::unique_ptr<int> new_data(new int(3));
+    list.setHead(std::move(new_data));
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), node);
+    ISHIKO_TEST_ABORT_IF_EQ(node->data().get(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(*node->data(), 3);
+    ISHIKO_TEST_PASS();
+}
+
+void SinglyLinkedListTests::SetHeadTest4(Test& test)
+{
+    Error error;
+
+    SinglyLinkedList<ThrowingMoveValue> list;
+    list.setHead(ThrowingMoveValue(), error);
+
+    ISHIKO_TEST_FAIL_IF_NOT(error);
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
 void SinglyLinkedListTests::InsertTest1(Test& test)
 {
     SinglyLinkedList<int> list;
@@ -82,6 +152,42 @@ void SinglyLinkedListTests::InsertTest1(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void SinglyLinkedListTests::InsertTest2(Test& test)
+{
+    SinglyLinkedList<std::unique_ptr<int>> list;
+    list.setHead(std::unique_ptr<int>(new int(5)));
+
+    SinglyLinkedList<std::unique_ptr<int>>::Node* head_node = list.head();
+
+    ISHIKO_TEST_ABORT_IF_EQ(head_node, nullptr);
+
+    std::unique_ptr<int> data(new int(3));
+    SinglyLinkedList<std::unique_ptr<int>>::Node* next_node = list.insert(std::move(data), head_node);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(data.get(), nullptr);
+    ISHIKO_TEST_ABORT_IF_EQ(next_node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(head_node->nextNode(), next_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(*next_node->data(), 3);
+    ISHIKO_TEST_PASS();
+}
+
+void SinglyLinkedListTests::EmplaceTest1(Test& test)
+{
+    SinglyLinkedList<std::string> list;
+    list.setHead("head");
+
+    SinglyLinkedList<std::string>::Node* head_node = list.head();
+
+    ISHIKO_TEST_ABORT_IF_EQ(head_node, nullptr);
+
+    SinglyLinkedList<std::string>::Node* next_node = list.emplace(head_node, 3, 'a');
+
+    ISHIKO_TEST_ABORT_IF_EQ(next_node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(head_node->nextNode(), next_node);
+    ISHIKO_TEST_FAIL_IF_NEQ(next_node->data(), "aaa");
+    ISHIKO_TEST_PASS();
+}
+
 void SinglyLinkedListTests::TraverseTest1(Test& test)
 {
     SinglyLinkedList<int> list;
@@ -136,3 +242,97 @@ void SinglyLinkedListTests::TraverseTest3(Test& test)
     ISHIKO_TEST_FAIL_IF_NEQ(output, std::vector<int>({5, 7, 9}));
     ISHIKO_TEST_PASS();
 }
+
+void SinglyLinkedListTests::ClearTest1(Test& test)
+{
+    SinglyLinkedList<int> list;
+    list.setHead(5);
+    list.insert(9, list.head());
+    list.insert(7, list.head());
+
+    list.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void SinglyLinkedListTests::ClearTest2(Test& test)
+{
+    std::shared_ptr<int> value = std::make_shared<int>(5);
+    SinglyLinkedList<std::shared_ptr<int>> list;
+    list.setHead(value);
+    SinglyLinkedList<std::shared_ptr<int>>::Node* last_node = list.head();
+    for (int i = 1; i < 100; ++i)
+    {
+        last_node = list.insert(value, last_node);
+    }
+    WorkStealingPool pool(2);
+
+    list.clear(pool, 8);
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(value.use_count(), 1);
+    ISHIKO_TEST_PASS();
+}
+
+void SinglyLinkedListTests::ReserveTest1(Test& test)
+{
+    SinglyLinkedList<int, DataTypeTraits<int>, PoolAllocator> list;
+    list.reserve(100);
+
+    list.setHead(0);
+    SinglyLinkedList<int, DataTypeTraits<int>, PoolAllocator>::Node* node = list.head();
+    for (int i = 1; i < 100; ++i)
+    {
+        node = list.insert(i, node);
+    }
+
+    int sum = 0;
+    list.traverse([&sum](int value) { sum += value; });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(sum, 4950);
+    ISHIKO_TEST_PASS();
+}
+
+void SinglyLinkedListTests::StatisticsTest1(Test& test)
+{
+    typedef SinglyLinkedList<int, DataTypeTraits<int>, CountingAllocator<>> CountingSinglyLinkedList;
+    CountingSinglyLinkedList list;
+    list.setHead(0);
+    CountingSinglyLinkedList::Node* node = list.head();
+    for (int i = 1; i < 10; ++i)
+    {
+        node = list.insert(i, node);
+    }
+
+    ContainerStatistics statistics = list.statistics();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_count, 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_bytes, 10 * sizeof(CountingSinglyLinkedList::Node));
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.spare_bytes, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.height, 0);
+    ISHIKO_TEST_FAIL_IF_NOT(statistics.level_histogram.empty());
+    ISHIKO_TEST_FAIL_IF_NOT(statistics.has_allocation_statistics);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.allocations.allocation_count, 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.allocations.deallocation_count, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.allocations.allocated_bytes, statistics.element_bytes);
+    ISHIKO_TEST_PASS();
+}
+
+void SinglyLinkedListTests::DestructorTest1(Test& test)
+{
+    // Long enough to overflow the stack if the nodes were deleted recursively
+    {
+        SinglyLinkedList<int> list;
+        list.setHead(0);
+        SinglyLinkedList<int>::Node* last_node = list.head();
+        for (int i = 1; i < 1000000; ++i)
+        {
+            last_node = list.insert(i, last_node);
+        }
+    }
+
+    ISHIKO_TEST_PASS();
+}
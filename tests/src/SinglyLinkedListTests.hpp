@@ -15,10 +15,19 @@ private:
     static void ConstructorTest1(Ishiko::Test& test);
     static void SetHeadTest1(Ishiko::Test& test);
     static void SetHeadTest2(Ishiko::Test& test);
+    static void SetHeadTest3(Ishiko::Test& test);
+    static void SetHeadTest4(Ishiko::Test& test);
     static void InsertTest1(Ishiko::Test& test);
+    static void InsertTest2(Ishiko::Test& test);
+    static void EmplaceTest1(Ishiko::Test& test);
     static void TraverseTest1(Ishiko::Test& test);
     static void TraverseTest2(Ishiko::Test& test);
     static void TraverseTest3(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+    static void ClearTest2(Ishiko::Test& test);
+    static void ReserveTest1(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+    static void DestructorTest1(Ishiko::Test& test);
 };
 
 #endif
@@ -2,39 +2,46 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include "SkipListTests.hpp"
+#include "Ishiko/DataStructures/CountingAllocator.hpp"
+#include "Ishiko/DataStructures/PoolAllocator.hpp"
 #include "Ishiko/DataStructures/SkipList.hpp"
-#include <random>
+#include "Ishiko/DataStructures/WorkStealingPool.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
 
 namespace
 {
-    size_t numLevels()
-    {
-        std::random_device rd;  // Will be used to obtain a seed for the random number engine
-        std::mt19937 gen(rd()); // Standard mersenne_twister_engine seeded with rd()
-        std::uniform_real_distribution<> dis(0.0, 1.0);
-
-        size_t numLevels = 1;
-        while ((numLevels < 20) && (dis(gen) < 0.5))
-        {
-            ++numLevels;
-        }
-        return numLevels;
-    }
-
     static size_t currentDummyLevel = 0;
     size_t dummyNumLevels()
     {
         static size_t levels[] = {2, 1, 4, 2};
         return levels[currentDummyLevel++];
     }
-}
 
-using namespace Ishiko;
+    size_t oneLevel()
+    {
+        return 1;
+    }
+
+    // The tests that check the exact layout of the list draw the node heights from a fixed sequence
+    typedef SkipList<int, std::less<int>, size_t (*)()> FixedLevelsSkipList;
+}
 
 SkipListTests::SkipListTests(const TestNumber& number, const TestContext& context)
     : TestSequence(number, "SkipList tests", context)
 {
     append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("Constructor test 2", ConstructorTest2);
+    append<HeapAllocationErrorsTest>("Constructor test 3", ConstructorTest3);
+    append<HeapAllocationErrorsTest>("Constructor test 4", ConstructorTest4);
+    append<HeapAllocationErrorsTest>("Constructor test 5", ConstructorTest5);
+    append<HeapAllocationErrorsTest>("Constructor test 6", ConstructorTest6);
     append<HeapAllocationErrorsTest>("insert test 1", InsertTest1);
     append<HeapAllocationErrorsTest>("insert test 2", InsertTest2);
     append<HeapAllocationErrorsTest>("insert test 3", InsertTest3);
@@ -42,11 +49,33 @@ SkipListTests::SkipListTests(const TestNumber& number, const TestContext& contex
     append<HeapAllocationErrorsTest>("insert test 5", InsertTest5);
     append<HeapAllocationErrorsTest>("insert test 6", InsertTest6);
     append<HeapAllocationErrorsTest>("insert test 7", InsertTest7);
+    append<HeapAllocationErrorsTest>("insert test 8", InsertTest8);
+    append<HeapAllocationErrorsTest>("insert test 9", InsertTest9);
+    append<HeapAllocationErrorsTest>("emplace test 1", EmplaceTest1);
+    append<HeapAllocationErrorsTest>("find test 1", FindTest1);
+    append<HeapAllocationErrorsTest>("contains test 1", ContainsTest1);
+    append<HeapAllocationErrorsTest>("lowerBound test 1", LowerBoundTest1);
+    append<HeapAllocationErrorsTest>("lowerBound test 2", LowerBoundTest2);
+    append<HeapAllocationErrorsTest>("upperBound test 1", UpperBoundTest1);
+    append<HeapAllocationErrorsTest>("scan test 1", ScanTest1);
+    append<HeapAllocationErrorsTest>("scan test 2", ScanTest2);
+    append<HeapAllocationErrorsTest>("iterator test 1", IteratorTest1);
+    append<HeapAllocationErrorsTest>("erase test 1", EraseTest1);
+    append<HeapAllocationErrorsTest>("erase test 2", EraseTest2);
+    append<HeapAllocationErrorsTest>("erase test 3", EraseTest3);
+    append<HeapAllocationErrorsTest>("erase test 4", EraseTest4);
+    append<HeapAllocationErrorsTest>("erase test 5", EraseTest5);
+    append<HeapAllocationErrorsTest>("shrinkToFit test 1", ShrinkToFitTest1);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+    append<HeapAllocationErrorsTest>("clear test 2", ClearTest2);
+    append<HeapAllocationErrorsTest>("clear test 3", ClearTest3);
+    append<HeapAllocationErrorsTest>("Destructor test 1", DestructorTest1);
 }
 
 void SkipListTests::ConstructorTest1(Test& test)
 {
-    SkipList<int> list(numLevels);
+    SkipList<int> list;
 
     ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
 
@@ -57,49 +86,168 @@ void SkipListTests::ConstructorTest1(Test& test)
     ISHIKO_TEST_PASS();
 }
 
+void SkipListTests::ConstructorTest2(Test& test)
+{
+    std::vector<int> values;
+    SkipList<int> list(values.begin(), values.end());
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ConstructorTest3(Test& test)
+{
+    std::vector<int> values = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    SkipList<int> list(values.begin(), values.end(), SkipList<int>::BulkLoadHeights::deterministic);
+
+    size_t expected_levels[] = { 1, 2, 1, 3, 1, 2, 1, 4 };
+    SkipList<int>::Node* node = list.head();
+    for (size_t i = 0; i < 8; ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
+        ISHIKO_TEST_FAIL_IF_NEQ(node->data(), values[i]);
+        ISHIKO_TEST_FAIL_IF_NEQ(node->levels(), expected_levels[i]);
+        node = node->nextNode();
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(node, nullptr);
+
+    node = list.head()->nextNode();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(node->nextNode(1)->data(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->nextNode(1)->nextNode(2)->data(), 8);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->nextNode(1)->nextNode(2)->nextNode(3), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ConstructorTest4(Test& test)
+{
+    std::vector<std::string> values;
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(std::to_string(i));
+        values.push_back(std::to_string(i));
+    }
+    std::sort(values.begin(), values.end());
+
+    SkipList<std::string> list(values.begin(), values.end());
+
+    size_t count = 0;
+    SkipList<std::string>::Node* node = list.head();
+    while (node)
+    {
+        for (size_t level = 0; level < node->levels(); ++level)
+        {
+            SkipList<std::string>::Node* next_node = node->nextNode(level);
+            if (next_node)
+            {
+                ISHIKO_TEST_FAIL_IF_NOT(node->data() < next_node->data());
+            }
+        }
+        node = node->nextNode();
+        ++count;
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count, 1000);
+
+    list.insert("1000");
+    list.erase("500");
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.contains("1000"));
+    ISHIKO_TEST_FAIL_IF(list.contains("500"));
+    ISHIKO_TEST_FAIL_IF_NOT(list.contains("999"));
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ConstructorTest5(Test& test)
+{
+    SkipList<int, std::greater<int>> list;
+    for (int i = 0; i < 10; ++i)
+    {
+        list.insert(i);
+    }
+
+    ISHIKO_TEST_ABORT_IF_EQ(list.head(), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head()->data(), 9);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.lowerBound(20)->data(), 9);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.upperBound(5)->data(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.erase(7, 3), 4);
+    ISHIKO_TEST_FAIL_IF(list.contains(5));
+    ISHIKO_TEST_FAIL_IF_NOT(list.contains(3));
+
+    int expected_value = 9;
+    for (SkipList<int, std::greater<int>>::Node* node = list.head(); node; node = node->nextNode())
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(node->data(), expected_value);
+        expected_value = ((expected_value == 8) ? 3 : (expected_value - 1));
+    }
+    ISHIKO_TEST_FAIL_IF_NEQ(expected_value, -1);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ConstructorTest6(Test& test)
+{
+    std::istringstream input("1 2 2 3 5 8");
+    std::istream_iterator<int> first(input);
+    std::istream_iterator<int> last;
+    SkipList<int> list(first, last, SkipList<int>::BulkLoadHeights::deterministic);
+
+    int expected_values[] = { 1, 2, 3, 5, 8 };
+    SkipList<int>::Node* node = list.head();
+    for (size_t i = 0; i < 5; ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
+        ISHIKO_TEST_FAIL_IF_NEQ(node->data(), expected_values[i]);
+        node = node->nextNode();
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(node, nullptr);
+    ISHIKO_TEST_PASS();
+}
+
 void SkipListTests::InsertTest1(Test& test)
 {
     currentDummyLevel = 0;
-    SkipList<int> list(dummyNumLevels);
+    FixedLevelsSkipList list(dummyNumLevels);
     list.insert(5);
 
     ISHIKO_TEST_FAIL_IF(list.isEmpty());
 
-    SkipList<int>::Node* node = list.head();
+    FixedLevelsSkipList::Node* node = list.head();
 
     ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node->nextNode(), nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node->data(), 5);
-    ISHIKO_TEST_FAIL_IF_NEQ(node->m_next_nodes.size(), 1);
-    ISHIKO_TEST_FAIL_IF_NEQ(node->m_next_nodes[0], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->levels(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->nextNode(0), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->nextNode(1), nullptr);
     ISHIKO_TEST_PASS();
 }
 
 void SkipListTests::InsertTest2(Test& test)
 {
     currentDummyLevel = 0;
-    SkipList<int> list(dummyNumLevels);
+    FixedLevelsSkipList list(dummyNumLevels);
     list.insert(5);
-    SkipList<int>::Node* node_r_2 = list.insert(7);
+    FixedLevelsSkipList::Node* node_r_2 = list.insert(7);
 
     ISHIKO_TEST_FAIL_IF(list.isEmpty());
 
-    SkipList<int>::Node* node_1 = list.head();
+    FixedLevelsSkipList::Node* node_1 = list.head();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_1, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_1->data(), 5);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[0], node_r_2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[1], node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->levels(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(0), node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(1), nullptr);
 
-    SkipList<int>::Node* node_2 = node_1->nextNode();
+    FixedLevelsSkipList::Node* node_2 = node_1->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_2, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_2->data(), 7);
     ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(), nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes[0], nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes[1], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->levels(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(0), nullptr);
 
     ISHIKO_TEST_PASS();
 }
@@ -107,36 +255,38 @@ void SkipListTests::InsertTest2(Test& test)
 void SkipListTests::InsertTest3(Test& test)
 {
     currentDummyLevel = 0;
-    SkipList<int> list(dummyNumLevels);
+    FixedLevelsSkipList list(dummyNumLevels);
     list.insert(5);
-    SkipList<int>::Node* node_r_2 = list.insert(7);
-    SkipList<int>::Node* node_r_3 = list.insert(9);
+    FixedLevelsSkipList::Node* node_r_2 = list.insert(7);
+    FixedLevelsSkipList::Node* node_r_3 = list.insert(9);
 
     ISHIKO_TEST_FAIL_IF(list.isEmpty());
 
-    SkipList<int>::Node* node_1 = list.head();
+    FixedLevelsSkipList::Node* node_1 = list.head();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_1, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_1->data(), 5);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[0], node_r_2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[1], node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->levels(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(0), node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(1), node_r_3);
 
-    SkipList<int>::Node* node_2 = node_1->nextNode();
+    FixedLevelsSkipList::Node* node_2 = node_1->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_2, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_2->data(), 7);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes[0], node_r_3);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes[1], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->levels(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(0), node_r_3);
 
-    SkipList<int>::Node* node_3 = node_2->nextNode();
+    FixedLevelsSkipList::Node* node_3 = node_2->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_3, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_3->data(), 9);
     ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(), nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes.size(), 1);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes[0], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->levels(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(0), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(3), nullptr);
 
     ISHIKO_TEST_PASS();
 }
@@ -144,36 +294,38 @@ void SkipListTests::InsertTest3(Test& test)
 void SkipListTests::InsertTest4(Test& test)
 {
     currentDummyLevel = 0;
-    SkipList<int> list(dummyNumLevels);
+    FixedLevelsSkipList list(dummyNumLevels);
     list.insert(5);
-    SkipList<int>::Node* node_r_2 = list.insert(9);
-    SkipList<int>::Node* node_r_3 = list.insert(7);
+    FixedLevelsSkipList::Node* node_r_2 = list.insert(9);
+    FixedLevelsSkipList::Node* node_r_3 = list.insert(7);
 
     ISHIKO_TEST_FAIL_IF(list.isEmpty());
 
-    SkipList<int>::Node* node_1 = list.head();
+    FixedLevelsSkipList::Node* node_1 = list.head();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_1, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_1->data(), 5);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[0], node_r_3);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[1], node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->levels(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(0), node_r_3);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(1), node_r_3);
 
-    SkipList<int>::Node* node_2 = node_1->nextNode();
+    FixedLevelsSkipList::Node* node_2 = node_1->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_2, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_2->data(), 7);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes.size(), 1);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes[0], node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->levels(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(0), node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(3), nullptr);
 
-    SkipList<int>::Node* node_3 = node_2->nextNode();
+    FixedLevelsSkipList::Node* node_3 = node_2->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_3, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_3->data(), 9);
     ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(), nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes[0], nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes[1], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->levels(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(0), nullptr);
 
     ISHIKO_TEST_PASS();
 }
@@ -181,37 +333,41 @@ void SkipListTests::InsertTest4(Test& test)
 void SkipListTests::InsertTest5(Test& test)
 {
     currentDummyLevel = 0;
-    SkipList<int> list(dummyNumLevels);
+    FixedLevelsSkipList list(dummyNumLevels);
     list.insert(5);
-    SkipList<int>::Node* node_r_2 = list.insert(9);
-    SkipList<int>::Node* node_r_3 = list.insert(7);
-    SkipList<int>::Node* node_r_4 = list.insert(9);
+    FixedLevelsSkipList::Node* node_r_2 = list.insert(9);
+    FixedLevelsSkipList::Node* node_r_3 = list.insert(7);
+    FixedLevelsSkipList::Node* node_r_4 = list.insert(9);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(node_r_4, node_r_2);
 
     ISHIKO_TEST_FAIL_IF(list.isEmpty());
 
-    SkipList<int>::Node* node_1 = list.head();
+    FixedLevelsSkipList::Node* node_1 = list.head();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_1, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_1->data(), 5);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[0], node_r_3);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[1], node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->levels(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(0), node_r_3);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(1), node_r_3);
 
-    SkipList<int>::Node* node_2 = node_1->nextNode();
+    FixedLevelsSkipList::Node* node_2 = node_1->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_2, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_2->data(), 7);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes.size(), 1);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes[0], node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->levels(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(0), node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(1), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(3), nullptr);
 
-    SkipList<int>::Node* node_3 = node_2->nextNode();
+    FixedLevelsSkipList::Node* node_3 = node_2->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_3, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_3->data(), 9);
     ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(), nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes[0], nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes[1], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->levels(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(0), nullptr);
 
     ISHIKO_TEST_PASS();
 }
@@ -219,36 +375,39 @@ void SkipListTests::InsertTest5(Test& test)
 void SkipListTests::InsertTest6(Test& test)
 {
     currentDummyLevel = 0;
-    SkipList<int> list(dummyNumLevels);
-    SkipList<int>::Node* node_r_1 = list.insert(5);
-    SkipList<int>::Node* node_r_2 = list.insert(7);
-    SkipList<int>::Node* node_r_3 = list.insert(3);
+    FixedLevelsSkipList list(dummyNumLevels);
+    FixedLevelsSkipList::Node* node_r_1 = list.insert(5);
+    FixedLevelsSkipList::Node* node_r_2 = list.insert(7);
+    FixedLevelsSkipList::Node* node_r_3 = list.insert(3);
 
     ISHIKO_TEST_FAIL_IF(list.isEmpty());
 
-    SkipList<int>::Node* node_1 = list.head();
+    FixedLevelsSkipList::Node* node_1 = list.head();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_1, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1, node_r_3);
     ISHIKO_TEST_FAIL_IF_NEQ(node_1->data(), 3);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[0], node_r_1);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[1], node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->levels(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(0), node_r_1);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(1), node_r_1);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(2), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(3), nullptr);
 
-    SkipList<int>::Node* node_2 = node_1->nextNode();
+    FixedLevelsSkipList::Node* node_2 = node_1->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_2, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_2->data(), 5);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes.size(), 1);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes[0], node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->levels(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(0), node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(1), nullptr);
 
-    SkipList<int>::Node* node_3 = node_2->nextNode();
+    FixedLevelsSkipList::Node* node_3 = node_2->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_3, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_3->data(), 7);
     ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(), nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes[0], nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_3->m_next_nodes[1], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->levels(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_3->nextNode(0), nullptr);
 
     ISHIKO_TEST_PASS();
 }
@@ -256,27 +415,524 @@ void SkipListTests::InsertTest6(Test& test)
 void SkipListTests::InsertTest7(Test& test)
 {
     currentDummyLevel = 0;
-    SkipList<int> list(dummyNumLevels);
-    SkipList<int>::Node* node_r_1 = list.insert(5);
-    SkipList<int>::Node* node_r_2 = list.insert(3);
+    FixedLevelsSkipList list(dummyNumLevels);
+    FixedLevelsSkipList::Node* node_r_1 = list.insert(5);
+    FixedLevelsSkipList::Node* node_r_2 = list.insert(3);
 
     ISHIKO_TEST_FAIL_IF(list.isEmpty());
 
-    SkipList<int>::Node* node_1 = list.head();
+    FixedLevelsSkipList::Node* node_1 = list.head();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_1, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1, node_r_2);
     ISHIKO_TEST_FAIL_IF_NEQ(node_1->data(), 3);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[0], node_r_1);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_1->m_next_nodes[1], node_r_1);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->levels(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_1->nextNode(0), node_r_1);
 
-    SkipList<int>::Node* node_2 = node_1->nextNode();
+    FixedLevelsSkipList::Node* node_2 = node_1->nextNode();
 
     ISHIKO_TEST_ABORT_IF_EQ(node_2, nullptr);
     ISHIKO_TEST_FAIL_IF_NEQ(node_2->data(), 5);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes.size(), 2);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes[0], nullptr);
-    ISHIKO_TEST_FAIL_IF_NEQ(node_2->m_next_nodes[1], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->levels(), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(0), nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node_2->nextNode(1), nullptr);
+
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::InsertTest8(Test& test)
+{
+    SkipList<std::string> list;
+    for (int i = 0; i < 1000; ++i)
+    {
+        list.insert(std::to_string((i * 7919) % 1000));
+    }
+
+    size_t count = 0;
+    SkipList<std::string>::Node* node = list.head();
+    while (node)
+    {
+        for (size_t level = 0; level < node->levels(); ++level)
+        {
+            SkipList<std::string>::Node* next_node = node->nextNode(level);
+            if (next_node)
+            {
+                ISHIKO_TEST_FAIL_IF_NOT(node->data() < next_node->data());
+                ISHIKO_TEST_FAIL_IF(next_node->levels() <= level);
+            }
+        }
+        ++count;
+        node = node->nextNode();
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count, 1000);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::InsertTest9(Test& test)
+{
+    SkipList<std::string> list;
+    std::string data = "aaa";
+    SkipList<std::string>::Node* node = list.insert(std::move(data));
+
+    ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->data(), "aaa");
+
+    // An element that is already in the list must not be moved from
+    std::string duplicate = "aaa";
+    SkipList<std::string>::Node* existing_node = list.insert(std::move(duplicate));
+
+    ISHIKO_TEST_FAIL_IF_NEQ(existing_node, node);
+    ISHIKO_TEST_FAIL_IF_NEQ(duplicate, "aaa");
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::EmplaceTest1(Test& test)
+{
+    SkipList<std::string> list;
+    list.insert("b");
+    list.insert("d");
+
+    SkipList<std::string>::Node* node = list.emplace(3, 'c');
+
+    ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->data(), "ccc");
+
+    SkipList<std::string>::Node* existing_node = list.emplace(3, 'c');
+
+    ISHIKO_TEST_FAIL_IF_NEQ(existing_node, node);
+
+    std::vector<std::string> elements(list.begin(), list.end());
+
+    ISHIKO_TEST_ABORT_IF_NEQ(elements.size(), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(elements[0], "b");
+    ISHIKO_TEST_FAIL_IF_NEQ(elements[1], "ccc");
+    ISHIKO_TEST_FAIL_IF_NEQ(elements[2], "d");
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::FindTest1(Test& test)
+{
+    currentDummyLevel = 0;
+    FixedLevelsSkipList list(dummyNumLevels);
+    FixedLevelsSkipList::Node* node_r_1 = list.insert(5);
+    FixedLevelsSkipList::Node* node_r_2 = list.insert(7);
+    FixedLevelsSkipList::Node* node_r_3 = list.insert(9);
+
+    FixedLevelsSkipList::SearchPath path_1 = list.find(8);
+
+    ISHIKO_TEST_ABORT_IF_NEQ(path_1.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_1[0], node_r_2);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_1[1], node_r_1);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_1[2], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_1[3], nullptr);
+
+    FixedLevelsSkipList::SearchPath path_2 = list.find(9);
+
+    ISHIKO_TEST_ABORT_IF_NEQ(path_2.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_2[0], node_r_3);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_2[1], node_r_3);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_2[2], node_r_3);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_2[3], node_r_3);
+
+    FixedLevelsSkipList::SearchPath path_3 = list.find(1);
+
+    ISHIKO_TEST_ABORT_IF_NEQ(path_3.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_3[0], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_3[1], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_3[2], nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(path_3[3], nullptr);
+
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ContainsTest1(Test& test)
+{
+    SkipList<int> list;
+
+    ISHIKO_TEST_FAIL_IF(list.contains(5));
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        list.insert(i);
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ISHIKO_TEST_FAIL_IF_NEQ(list.contains(i), ((i % 2) == 0));
+    }
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::LowerBoundTest1(Test& test)
+{
+    SkipList<int> list;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.lowerBound(5), nullptr);
+
+    list.insert(3);
+    SkipList<int>::Node* node_5 = list.insert(5);
+    SkipList<int>::Node* node_7 = list.insert(7);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.lowerBound(1), list.head());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.lowerBound(4), node_5);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.lowerBound(5), node_5);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.lowerBound(7), node_7);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.lowerBound(8), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::LowerBoundTest2(Test& test)
+{
+    SkipList<int> list;
+    for (int i = 0; i < 10000; i += 2)
+    {
+        list.insert(i);
+    }
+
+    // Sequential lookups each starting from the result of the previous one
+    SkipList<int>::Node* finger = list.lowerBound(0);
+    for (int i = 1; i < 10001; i += 3)
+    {
+        SkipList<int>::Node* node = list.lowerBound(i, finger);
+
+        ISHIKO_TEST_ABORT_IF_NEQ(node, list.lowerBound(i));
+
+        if (node)
+        {
+            finger = node;
+        }
+    }
+
+    // Data before the finger falls back to a search from the head
+    SkipList<int>::Node* node = list.lowerBound(5, list.lowerBound(5000));
+
+    ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->data(), 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.lowerBound(5, nullptr), node);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::UpperBoundTest1(Test& test)
+{
+    SkipList<int> list;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.upperBound(5), nullptr);
+
+    list.insert(3);
+    SkipList<int>::Node* node_5 = list.insert(5);
+    SkipList<int>::Node* node_7 = list.insert(7);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.upperBound(1), list.head());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.upperBound(3), node_5);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.upperBound(5), node_7);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.upperBound(6), node_7);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.upperBound(7), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ScanTest1(Test& test)
+{
+    SkipList<int> list;
+    for (int i = 0; i < 10; ++i)
+    {
+        list.insert(i);
+    }
+
+    std::vector<int> values;
+    size_t count = list.scan(3, 7, [&values](int value) { values.push_back(value); return true; });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count, 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(values, std::vector<int>({ 3, 4, 5, 6 }));
+    ISHIKO_TEST_FAIL_IF_NEQ(list.scan(7, 7, [](int) { return true; }), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.scan(20, 30, [](int) { return true; }), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.scan(-5, 30, [](int) { return true; }), 10);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ScanTest2(Test& test)
+{
+    SkipList<int> list;
+    for (int i = 0; i < 10; ++i)
+    {
+        list.insert(i);
+    }
+
+    std::vector<int> values;
+    size_t count = list.scan(2, 9,
+        [&values](int value)
+        {
+            values.push_back(value);
+            return (value < 4);
+        });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(values, std::vector<int>({ 2, 3, 4 }));
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::IteratorTest1(Test& test)
+{
+    SkipList<int> list;
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.begin() == list.end());
+
+    list.insert(5);
+    list.insert(3);
+    list.insert(8);
+
+    std::vector<int> values;
+    for (int value : list)
+    {
+        values.push_back(value);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(values, std::vector<int>({ 3, 5, 8 }));
+    ISHIKO_TEST_FAIL_IF_NEQ(std::distance(list.begin(), list.end()), 3);
+
+    SkipList<int>::ConstIterator it = list.begin();
+    SkipList<int>::ConstIterator previous = it++;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*previous, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(*it, 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(it.node(), list.lowerBound(4));
+    ISHIKO_TEST_FAIL_IF_NOT(std::find(list.begin(), list.end(), 8) != list.end());
+    ISHIKO_TEST_FAIL_IF_NOT(std::find(list.begin(), list.end(), 4) == list.end());
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::EraseTest1(Test& test)
+{
+    currentDummyLevel = 0;
+    FixedLevelsSkipList list(dummyNumLevels);
+    list.insert(5);
+    bool erased = list.erase(5);
+
+    ISHIKO_TEST_FAIL_IF_NOT(erased);
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), nullptr);
+    ISHIKO_TEST_FAIL_IF(list.contains(5));
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::EraseTest2(Test& test)
+{
+    currentDummyLevel = 0;
+    FixedLevelsSkipList list(dummyNumLevels);
+
+    ISHIKO_TEST_FAIL_IF(list.erase(5));
+
+    list.insert(5);
+    list.insert(3);
+
+    ISHIKO_TEST_FAIL_IF(list.erase(4));
+    ISHIKO_TEST_FAIL_IF(list.erase(6));
+    ISHIKO_TEST_FAIL_IF_NOT(list.erase(3));
+
+    FixedLevelsSkipList::Node* node = list.head();
+
+    ISHIKO_TEST_ABORT_IF_EQ(node, nullptr);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->data(), 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(node->nextNode(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::EraseTest3(Test& test)
+{
+    SkipList<std::string> list;
+    for (int i = 0; i < 1000; ++i)
+    {
+        list.insert(std::to_string(i));
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        ISHIKO_TEST_ABORT_IF_NOT(list.erase(std::to_string(i)));
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_NEQ(list.contains(std::to_string(i)), ((i % 2) == 1));
+    }
+
+    size_t count = 0;
+    SkipList<std::string>::Node* node = list.head();
+    while (node)
+    {
+        for (size_t level = 0; level < node->levels(); ++level)
+        {
+            SkipList<std::string>::Node* next_node = node->nextNode(level);
+            if (next_node)
+            {
+                ISHIKO_TEST_FAIL_IF_NOT(node->data() < next_node->data());
+            }
+        }
+        node = node->nextNode();
+        ++count;
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count, 500);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::EraseTest4(Test& test)
+{
+    SkipList<int> list;
+    for (int i = 0; i < 100; ++i)
+    {
+        list.insert(i);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.erase(10, 20), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.erase(15, 25), 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.erase(50, 50), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.erase(60, 50), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.erase(90, 1000), 10);
+    for (int i = 0; i < 100; ++i)
+    {
+        ISHIKO_TEST_ABORT_IF_NEQ(list.contains(i), ((i < 10) || ((i >= 25) && (i < 90))));
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.erase(-10, 1000), 75);
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::EraseTest5(Test& test)
+{
+    FixedLevelsSkipList list(oneLevel);
+    FixedLevelsSkipList::Node* node1 = list.insert(5);
+    list.erase(5);
+    FixedLevelsSkipList::Node* node2 = list.insert(7);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(node1, node2);
+    ISHIKO_TEST_FAIL_IF_NEQ(node2->data(), 7);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), node2);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ShrinkToFitTest1(Test& test)
+{
+    SkipList<std::string> list;
+    for (int i = 0; i < 100; ++i)
+    {
+        list.insert(std::to_string(i));
+    }
+    list.erase("0", "5");
+    list.shrinkToFit();
+    list.insert("1");
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.contains("1"));
+    ISHIKO_TEST_FAIL_IF(list.contains("2"));
+    ISHIKO_TEST_FAIL_IF_NOT(list.contains("5"));
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::StatisticsTest1(Test& test)
+{
+    currentDummyLevel = 0;
+    typedef SkipList<int, std::less<int>, size_t (*)(), CountingAllocator<>> CountingSkipList;
+    CountingSkipList list(dummyNumLevels);
+    list.insert(5);
+    list.insert(7);
+    list.insert(3);
+    list.insert(9);
+
+    ContainerStatistics statistics1 = list.statistics();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics1.element_count, 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics1.spare_bytes, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics1.height, 4);
+    ISHIKO_TEST_ABORT_IF_NEQ(statistics1.level_histogram.size(), 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics1.level_histogram[0], 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics1.level_histogram[1], 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics1.level_histogram[2], 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics1.level_histogram[3], 1);
+    ISHIKO_TEST_FAIL_IF_NOT(statistics1.has_allocation_statistics);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics1.allocations.allocation_count, 4);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics1.allocations.allocated_bytes, statistics1.element_bytes);
+
+    // The erased node is kept for reuse
+    list.erase(9);
+    ContainerStatistics statistics2 = list.statistics();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics2.element_count, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics2.height, 4);
+    ISHIKO_TEST_FAIL_IF_EQ(statistics2.spare_bytes, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics2.element_bytes + statistics2.spare_bytes, statistics1.element_bytes);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics2.allocations.deallocation_count, 0);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ClearTest1(Test& test)
+{
+    currentDummyLevel = 0;
+    FixedLevelsSkipList list(dummyNumLevels);
+    list.insert(5);
+    list.insert(7);
+    list.insert(3);
+
+    list.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), nullptr);
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ClearTest2(Test& test)
+{
+    typedef SkipList<std::string, std::less<std::string>, GeometricLevelGenerator<>, PoolAllocator> PoolSkipList;
+
+    PoolSkipList list;
+    list.reserve(100);
+    for (int i = 0; i < 100; ++i)
+    {
+        list.insert(std::to_string(i));
+    }
+    list.erase("0", "5");
+    for (int i = 100; i < 150; ++i)
+    {
+        list.insert(std::to_string(i));
+    }
+
+    list.clear();
+    list.insert("1");
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.contains("1"));
+    ISHIKO_TEST_FAIL_IF(list.contains("5"));
+    ISHIKO_TEST_FAIL_IF(list.contains("120"));
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::ClearTest3(Test& test)
+{
+    SkipList<std::string> list;
+    for (int i = 0; i < 100; ++i)
+    {
+        list.insert(std::string("value, long enough to be allocated on the heap ") + std::to_string(i));
+    }
+    WorkStealingPool pool(2);
+
+    list.clear(pool, 8);
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.head(), nullptr);
+
+    list.insert("1");
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.contains("1"));
+    ISHIKO_TEST_PASS();
+}
+
+void SkipListTests::DestructorTest1(Test& test)
+{
+    // Long enough to overflow the stack if the nodes were deleted recursively
+    {
+        FixedLevelsSkipList list(oneLevel);
+        for (int i = 1000000; i > 0; --i)
+        {
+            list.insert(i);
+        }
+    }
 
     ISHIKO_TEST_PASS();
 }
@@ -13,6 +13,11 @@ public:
 
 private:
     static void ConstructorTest1(Ishiko::Test& test);
+    static void ConstructorTest2(Ishiko::Test& test);
+    static void ConstructorTest3(Ishiko::Test& test);
+    static void ConstructorTest4(Ishiko::Test& test);
+    static void ConstructorTest5(Ishiko::Test& test);
+    static void ConstructorTest6(Ishiko::Test& test);
     static void InsertTest1(Ishiko::Test& test);
     static void InsertTest2(Ishiko::Test& test);
     static void InsertTest3(Ishiko::Test& test);
@@ -20,6 +25,28 @@ private:
     static void InsertTest5(Ishiko::Test& test);
     static void InsertTest6(Ishiko::Test& test);
     static void InsertTest7(Ishiko::Test& test);
+    static void InsertTest8(Ishiko::Test& test);
+    static void InsertTest9(Ishiko::Test& test);
+    static void EmplaceTest1(Ishiko::Test& test);
+    static void FindTest1(Ishiko::Test& test);
+    static void ContainsTest1(Ishiko::Test& test);
+    static void LowerBoundTest1(Ishiko::Test& test);
+    static void LowerBoundTest2(Ishiko::Test& test);
+    static void UpperBoundTest1(Ishiko::Test& test);
+    static void ScanTest1(Ishiko::Test& test);
+    static void ScanTest2(Ishiko::Test& test);
+    static void IteratorTest1(Ishiko::Test& test);
+    static void EraseTest1(Ishiko::Test& test);
+    static void EraseTest2(Ishiko::Test& test);
+    static void EraseTest3(Ishiko::Test& test);
+    static void EraseTest4(Ishiko::Test& test);
+    static void EraseTest5(Ishiko::Test& test);
+    static void ShrinkToFitTest1(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+    static void ClearTest2(Ishiko::Test& test);
+    static void ClearTest3(Ishiko::Test& test);
+    static void DestructorTest1(Ishiko::Test& test);
 };
 
 #endif
@@ -0,0 +1,418 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "UnrolledSinglyLinkedListTests.hpp"
+#include "Ishiko/DataStructures/PoolAllocator.hpp"
+#include "Ishiko/DataStructures/UnrolledSinglyLinkedList.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Ishiko;
+
+namespace
+{
+    // Chunks of 4 ints so that a few values are enough to split and merge chunks
+    typedef UnrolledSinglyLinkedList<int, 32> SmallChunkList;
+    typedef UnrolledSinglyLinkedList<std::string, 256, DataTypeTraits<std::string>, PoolAllocator> StringPoolList;
+
+    std::vector<int> values(SmallChunkList& list)
+    {
+        return std::vector<int>(list.begin(), list.end());
+    }
+
+    SmallChunkList::Iterator appendValues(SmallChunkList& list, int first, int last)
+    {
+        SmallChunkList::Iterator it = list.begin();
+        if (list.isEmpty())
+        {
+            list.setHead(first++);
+            it = list.begin();
+        }
+        else
+        {
+            for (size_t i = 1; i < list.size(); ++i)
+            {
+                ++it;
+            }
+        }
+        for (int i = first; i < last; ++i)
+        {
+            it = list.insert(i, it);
+        }
+        return it;
+    }
+
+    size_t chunkCount(const SmallChunkList& list)
+    {
+        ContainerStatistics statistics = list.statistics();
+        return ((statistics.element_bytes + statistics.spare_bytes) / sizeof(SmallChunkList::Chunk));
+    }
+}
+
+UnrolledSinglyLinkedListTests::UnrolledSinglyLinkedListTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "UnrolledSinglyLinkedList tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("setHead test 1", SetHeadTest1);
+    append<HeapAllocationErrorsTest>("setHead test 2", SetHeadTest2);
+    append<HeapAllocationErrorsTest>("insert test 1", InsertTest1);
+    append<HeapAllocationErrorsTest>("insert test 2", InsertTest2);
+    append<HeapAllocationErrorsTest>("emplace test 1", EmplaceTest1);
+    append<HeapAllocationErrorsTest>("erase test 1", EraseTest1);
+    append<HeapAllocationErrorsTest>("erase test 2", EraseTest2);
+    append<HeapAllocationErrorsTest>("erase test 3", EraseTest3);
+    append<HeapAllocationErrorsTest>("erase test 4", EraseTest4);
+    append<HeapAllocationErrorsTest>("Iterator test 1", IteratorTest1);
+    append<HeapAllocationErrorsTest>("traverse test 1", TraverseTest1);
+    append<HeapAllocationErrorsTest>("clear test 1", ClearTest1);
+    append<HeapAllocationErrorsTest>("clear test 2", ClearTest2);
+    append<HeapAllocationErrorsTest>("statistics test 1", StatisticsTest1);
+}
+
+void UnrolledSinglyLinkedListTests::ConstructorTest1(Test& test)
+{
+    UnrolledSinglyLinkedList<int> list;
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 0);
+    ISHIKO_TEST_FAIL_IF(list.begin() != list.end());
+    ISHIKO_TEST_FAIL_IF(list.head() != list.end());
+    ISHIKO_TEST_PASS();
+}
+
+void UnrolledSinglyLinkedListTests::SetHeadTest1(Test& test)
+{
+    UnrolledSinglyLinkedList<int> list;
+    list.setHead(5);
+
+    ISHIKO_TEST_FAIL_IF(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(*list.head(), 5);
+
+    // Setting the head of a list that isn't empty replaces the first value
+    list.setHead(7);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(*list.head(), 7);
+    ISHIKO_TEST_PASS();
+}
+
+void UnrolledSinglyLinkedListTests::SetHeadTest2(Test& test)
+{
+    UnrolledSinglyLinkedList<std::string> list;
+
+    Error error;
+    list.setHead("first value, long enough to be allocated on the heap", error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(*list.head(), "first value, long enough to be allocated on the heap");
+
+    std::string value = "second value, long enough to be allocated on the heap";
+    list.setHead(std::move(value), error);
+
+    ISHIKO_TEST_FAIL_IF(error);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(*list.head(), "second value, long enough to be allocated on the heap");
+    ISHIKO_TEST_PASS();
+}
+
+// Appending fills the chunks completely
+void UnrolledSinglyLinkedListTests::InsertTest1(Test& test)
+{
+    SmallChunkList list;
+    SmallChunkList::Iterator it = appendValues(list, 0, 10);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*it, 9);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(values(list), std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    ISHIKO_TEST_FAIL_IF_NEQ(chunkCount(list), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.statistics().spare_bytes, 2 * sizeof(int));
+    ISHIKO_TEST_PASS();
+}
+
+// Inserting into a full chunk splits it
+void UnrolledSinglyLinkedListTests::InsertTest2(Test& test)
+{
+    SmallChunkList list;
+    appendValues(list, 0, 8);
+
+    SmallChunkList::Iterator it = list.begin();
+    ++it;
+    it = list.insert(10, it);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*it, 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(*(++it), 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(chunkCount(list), 3);
+
+    // The value after the last value of a full chunk goes at the start of the next chunk if it isn't full
+    it = list.begin();
+    for (int i = 0; i < 4; ++i)
+    {
+        ++it;
+    }
+    it = list.insert(11, it);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*it, 11);
+    ISHIKO_TEST_FAIL_IF_NEQ(chunkCount(list), 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 10);
+    ISHIKO_TEST_FAIL_IF_NEQ(values(list), std::vector<int>({0, 1, 10, 2, 3, 11, 4, 5, 6, 7}));
+    ISHIKO_TEST_PASS();
+}
+
+void UnrolledSinglyLinkedListTests::EmplaceTest1(Test& test)
+{
+    UnrolledSinglyLinkedList<std::string, 128> list;
+    list.setHead("a");
+    UnrolledSinglyLinkedList<std::string, 128>::Iterator it = list.begin();
+    for (size_t i = 1; i < 20; ++i)
+    {
+        it = list.emplace(it, i, 'b');
+    }
+    list.emplace(list.begin(), 3, 'c');
+
+    std::vector<std::string> output;
+    list.traverse([&output](const std::string& value) { output.push_back(value); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 21);
+    ISHIKO_TEST_FAIL_IF_NEQ(output.size(), 21);
+    ISHIKO_TEST_FAIL_IF_NEQ(output[0], "a");
+    ISHIKO_TEST_FAIL_IF_NEQ(output[1], "ccc");
+    ISHIKO_TEST_FAIL_IF_NEQ(output[2], "b");
+    ISHIKO_TEST_FAIL_IF_NEQ(output[20], std::string(19, 'b'));
+    ISHIKO_TEST_PASS();
+}
+
+// A chunk that falls below half full takes a value from the next chunk, or is merged with it
+void UnrolledSinglyLinkedListTests::EraseTest1(Test& test)
+{
+    SmallChunkList list;
+    appendValues(list, 0, 10);
+
+    SmallChunkList::Iterator it = list.begin();
+    it = list.erase(it);
+    it = list.erase(it);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*it, 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(values(list), std::vector<int>({2, 3, 4, 5, 6, 7, 8, 9}));
+    ISHIKO_TEST_FAIL_IF_NEQ(chunkCount(list), 3);
+
+    it = list.erase(it);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*it, 3);
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 7);
+    ISHIKO_TEST_FAIL_IF_NEQ(values(list), std::vector<int>({3, 4, 5, 6, 7, 8, 9}));
+    ISHIKO_TEST_FAIL_IF_NEQ(chunkCount(list), 3);
+
+    it = list.erase(it);
+    it = list.erase(it);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*it, 5);
+    ISHIKO_TEST_FAIL_IF_NEQ(values(list), std::vector<int>({5, 6, 7, 8, 9}));
+    ISHIKO_TEST_FAIL_IF_NEQ(chunkCount(list), 2);
+    ISHIKO_TEST_PASS();
+}
+
+void UnrolledSinglyLinkedListTests::EraseTest2(Test& test)
+{
+    SmallChunkList list;
+    appendValues(list, 0, 10);
+
+    // Erasing the last values
+    SmallChunkList::Iterator it = list.begin();
+    for (int i = 0; i < 8; ++i)
+    {
+        ++it;
+    }
+    it = list.erase(it);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*it, 9);
+
+    it = list.erase(it);
+
+    ISHIKO_TEST_FAIL_IF(it != list.end());
+    ISHIKO_TEST_FAIL_IF_NEQ(chunkCount(list), 2);
+
+    // Erasing everything
+    it = list.begin();
+    while (it != list.end())
+    {
+        it = list.erase(it);
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(chunkCount(list), 0);
+
+    list.setHead(1);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(values(list), std::vector<int>({1}));
+    ISHIKO_TEST_PASS();
+}
+
+// Random inserts and erases compared with a std::vector
+void UnrolledSinglyLinkedListTests::EraseTest3(Test& test)
+{
+    SmallChunkList list;
+    std::vector<int> expected_values;
+    list.setHead(0);
+    expected_values.push_back(0);
+
+    bool dense = true;
+    uint32_t random = 12345;
+    for (int i = 1; i < 2000; ++i)
+    {
+        random = ((random * 1103515245u) + 12345u);
+        size_t index = ((random >> 8) % list.size());
+        SmallChunkList::Iterator it = list.begin();
+        for (size_t j = 0; j < index; ++j)
+        {
+            ++it;
+        }
+        if (((random >> 4) % 5) < 3)
+        {
+            list.insert(i, it);
+            expected_values.insert(expected_values.begin() + index + 1, i);
+        }
+        else if (list.size() > 1)
+        {
+            list.erase(it);
+            expected_values.erase(expected_values.begin() + index);
+        }
+
+        // All the chunks but the last are at least half full
+        if (chunkCount(list) > ((list.size() / 2) + 1))
+        {
+            dense = false;
+        }
+    }
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), expected_values.size());
+    ISHIKO_TEST_FAIL_IF_NEQ(values(list), expected_values);
+    ISHIKO_TEST_FAIL_IF_NOT(dense);
+    ISHIKO_TEST_PASS();
+}
+
+// The strings are moved one at a time when chunks are split and merged
+void UnrolledSinglyLinkedListTests::EraseTest4(Test& test)
+{
+    UnrolledSinglyLinkedList<std::string, 128> list;
+    list.setHead(std::string(40, 'a'));
+    UnrolledSinglyLinkedList<std::string, 128>::Iterator it = list.begin();
+    for (size_t i = 1; i < 30; ++i)
+    {
+        it = list.insert(std::string(40 + i, 'a'), it);
+    }
+
+    // Erases every other string
+    it = list.begin();
+    while (it != list.end())
+    {
+        it = list.erase(it);
+        if (it != list.end())
+        {
+            ++it;
+        }
+    }
+
+    std::vector<size_t> sizes;
+    list.traverse([&sizes](const std::string& value) { sizes.push_back(value.size()); });
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 15);
+    ISHIKO_TEST_FAIL_IF_NEQ(sizes.size(), 15);
+    ISHIKO_TEST_FAIL_IF_NEQ(sizes.front(), 41);
+    ISHIKO_TEST_FAIL_IF_NEQ(sizes.back(), 69);
+    ISHIKO_TEST_PASS();
+}
+
+void UnrolledSinglyLinkedListTests::IteratorTest1(Test& test)
+{
+    SmallChunkList list;
+    appendValues(list, 0, 10);
+
+    for (int& value : list)
+    {
+        value *= 2;
+    }
+
+    SmallChunkList::Iterator it = list.begin();
+    SmallChunkList::Iterator previous_it = it++;
+
+    ISHIKO_TEST_FAIL_IF_NEQ(*previous_it, 0);
+    ISHIKO_TEST_FAIL_IF_NEQ(*it, 2);
+    ISHIKO_TEST_FAIL_IF_NEQ(values(list), std::vector<int>({0, 2, 4, 6, 8, 10, 12, 14, 16, 18}));
+    ISHIKO_TEST_PASS();
+}
+
+void UnrolledSinglyLinkedListTests::TraverseTest1(Test& test)
+{
+    UnrolledSinglyLinkedList<int> list;
+    list.setHead(0);
+    UnrolledSinglyLinkedList<int>::Iterator it = list.begin();
+    for (int i = 1; i < 1000; ++i)
+    {
+        it = list.insert(i, it);
+    }
+
+    int expected_value = 0;
+    bool in_order = true;
+    list.traverse(
+        [&expected_value, &in_order](int data)
+        {
+            if (data != expected_value)
+            {
+                in_order = false;
+            }
+            ++expected_value;
+        });
+
+    ISHIKO_TEST_FAIL_IF_NOT(in_order);
+    ISHIKO_TEST_FAIL_IF_NEQ(expected_value, 1000);
+    ISHIKO_TEST_PASS();
+}
+
+void UnrolledSinglyLinkedListTests::ClearTest1(Test& test)
+{
+    SmallChunkList list;
+    appendValues(list, 0, 10);
+
+    list.clear();
+
+    ISHIKO_TEST_FAIL_IF_NOT(list.isEmpty());
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 0);
+    ISHIKO_TEST_FAIL_IF(list.begin() != list.end());
+    ISHIKO_TEST_PASS();
+}
+
+void UnrolledSinglyLinkedListTests::ClearTest2(Test& test)
+{
+    StringPoolList list;
+    list.setHead("first value, long enough to be allocated on the heap");
+    StringPoolList::Iterator it = list.begin();
+    for (size_t i = 0; i < 20; ++i)
+    {
+        it = list.insert("other value, long enough to be allocated on the heap", it);
+    }
+
+    list.clear();
+    list.setHead("last value, long enough to be allocated on the heap");
+
+    ISHIKO_TEST_FAIL_IF_NEQ(list.size(), 1);
+    ISHIKO_TEST_FAIL_IF_NEQ(*list.head(), "last value, long enough to be allocated on the heap");
+    ISHIKO_TEST_PASS();
+}
+
+void UnrolledSinglyLinkedListTests::StatisticsTest1(Test& test)
+{
+    SmallChunkList list;
+    appendValues(list, 0, 6);
+
+    ContainerStatistics statistics = list.statistics();
+
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_count, 6);
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.element_bytes, (2 * sizeof(SmallChunkList::Chunk)) - (2 * sizeof(int)));
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.spare_bytes, 2 * sizeof(int));
+    ISHIKO_TEST_FAIL_IF_NEQ(statistics.height, 0);
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_UNROLLEDSINGLYLINKEDLISTTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_UNROLLEDSINGLYLINKEDLISTTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class UnrolledSinglyLinkedListTests : public Ishiko::TestSequence
+{
+public:
+    UnrolledSinglyLinkedListTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void SetHeadTest1(Ishiko::Test& test);
+    static void SetHeadTest2(Ishiko::Test& test);
+    static void InsertTest1(Ishiko::Test& test);
+    static void InsertTest2(Ishiko::Test& test);
+    static void EmplaceTest1(Ishiko::Test& test);
+    static void EraseTest1(Ishiko::Test& test);
+    static void EraseTest2(Ishiko::Test& test);
+    static void EraseTest3(Ishiko::Test& test);
+    static void EraseTest4(Ishiko::Test& test);
+    static void IteratorTest1(Ishiko::Test& test);
+    static void TraverseTest1(Ishiko::Test& test);
+    static void ClearTest1(Ishiko::Test& test);
+    static void ClearTest2(Ishiko::Test& test);
+    static void StatisticsTest1(Ishiko::Test& test);
+};
+
+#endif
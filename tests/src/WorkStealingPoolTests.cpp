@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#include "WorkStealingPoolTests.hpp"
+#include "Ishiko/DataStructures/WorkStealingPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace Ishiko;
+
+WorkStealingPoolTests::WorkStealingPoolTests(const TestNumber& number, const TestContext& context)
+    : TestSequence(number, "WorkStealingPool tests", context)
+{
+    append<HeapAllocationErrorsTest>("Constructor test 1", ConstructorTest1);
+    append<HeapAllocationErrorsTest>("Constructor test 2", ConstructorTest2);
+    append<HeapAllocationErrorsTest>("run test 1", RunTest1);
+    append<HeapAllocationErrorsTest>("run test 2", RunTest2);
+    append<HeapAllocationErrorsTest>("run test 3", RunTest3);
+    append<HeapAllocationErrorsTest>("run test 4", RunTest4);
+    append<HeapAllocationErrorsTest>("wait test 1", WaitTest1);
+    append<HeapAllocationErrorsTest>("wait test 2", WaitTest2);
+}
+
+void WorkStealingPoolTests::ConstructorTest1(Test& test)
+{
+    WorkStealingPool pool(3);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(pool.workerCount(), 3);
+    ISHIKO_TEST_PASS();
+}
+
+void WorkStealingPoolTests::ConstructorTest2(Test& test)
+{
+    WorkStealingPool pool;
+
+    ISHIKO_TEST_FAIL_IF(pool.workerCount() >= std::max(std::thread::hardware_concurrency(), 1u));
+    ISHIKO_TEST_PASS();
+}
+
+void WorkStealingPoolTests::RunTest1(Test& test)
+{
+    // Without workers the tasks run in the thread that waits for them
+    WorkStealingPool pool(0);
+    WorkStealingPool::TaskGroup group;
+    std::thread::id main_thread_id = std::this_thread::get_id();
+    size_t count = 0;
+    bool same_thread = true;
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        pool.run(group,
+            [&count, &same_thread, main_thread_id]()
+            {
+                ++count;
+                same_thread = (same_thread && (std::this_thread::get_id() == main_thread_id));
+            });
+    }
+    pool.wait(group);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count, 10);
+    ISHIKO_TEST_FAIL_IF_NOT(same_thread);
+    ISHIKO_TEST_PASS();
+}
+
+void WorkStealingPoolTests::RunTest2(Test& test)
+{
+    WorkStealingPool pool(4);
+    WorkStealingPool::TaskGroup group;
+    std::atomic<size_t> count{0};
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        pool.run(group, [&count]() { ++count; });
+    }
+    pool.wait(group);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count.load(), 1000);
+    ISHIKO_TEST_PASS();
+}
+
+void WorkStealingPoolTests::RunTest3(Test& test)
+{
+    // Tasks that fork tasks and wait for them
+    WorkStealingPool pool(4);
+    WorkStealingPool::TaskGroup group;
+    std::atomic<size_t> count{0};
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        pool.run(group,
+            [&pool, &count]()
+            {
+                WorkStealingPool::TaskGroup nested_group;
+                for (size_t j = 0; j < 10; ++j)
+                {
+                    pool.run(nested_group, [&count]() { ++count; });
+                }
+                pool.wait(nested_group);
+            });
+    }
+    pool.wait(group);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count.load(), 100);
+    ISHIKO_TEST_PASS();
+}
+
+void WorkStealingPoolTests::RunTest4(Test& test)
+{
+    // A worker queues more tasks than its queue initially holds while the other workers steal them
+    WorkStealingPool pool(4);
+    WorkStealingPool::TaskGroup group;
+    std::atomic<size_t> count{0};
+
+    pool.run(group,
+        [&pool, &count]()
+        {
+            WorkStealingPool::TaskGroup nested_group;
+            for (size_t i = 0; i < 10000; ++i)
+            {
+                pool.run(nested_group, [&count]() { ++count; });
+            }
+            pool.wait(nested_group);
+        });
+    pool.wait(group);
+
+    ISHIKO_TEST_FAIL_IF_NEQ(count.load(), 10000);
+    ISHIKO_TEST_PASS();
+}
+
+void WorkStealingPoolTests::WaitTest1(Test& test)
+{
+    WorkStealingPool pool(2);
+    WorkStealingPool::TaskGroup group;
+    std::atomic<size_t> count{0};
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        pool.run(group,
+            [&count, i]()
+            {
+                if (i == 5)
+                {
+                    throw std::runtime_error("task failed");
+                }
+                ++count;
+            });
+    }
+
+    bool thrown = false;
+    try
+    {
+        pool.wait(group);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    ISHIKO_TEST_FAIL_IF_NOT(thrown);
+    ISHIKO_TEST_FAIL_IF_NEQ(count.load(), 9);
+    ISHIKO_TEST_PASS();
+}
+
+void WorkStealingPoolTests::WaitTest2(Test& test)
+{
+    // The waiting thread has nothing to run while the task runs in a worker so it blocks until the task is done
+    WorkStealingPool pool(1);
+    WorkStealingPool::TaskGroup group;
+    std::atomic<bool> started{false};
+    std::atomic<bool> done{false};
+
+    pool.run(group,
+        [&started, &done]()
+        {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            done = true;
+        });
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+    pool.wait(group);
+
+    ISHIKO_TEST_FAIL_IF_NOT(done.load());
+    ISHIKO_TEST_PASS();
+}
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
+// SPDX-License-Identifier: BSL-1.0
+
+#ifndef GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_WORKSTEALINGPOOLTESTS_HPP
+#define GUARD_ISHIKO_CPP_DATASTRUCTURES_TESTS_WORKSTEALINGPOOLTESTS_HPP
+
+#include <Ishiko/TestFramework/Core.hpp>
+
+class WorkStealingPoolTests : public Ishiko::TestSequence
+{
+public:
+    WorkStealingPoolTests(const Ishiko::TestNumber& number, const Ishiko::TestContext& context);
+
+private:
+    static void ConstructorTest1(Ishiko::Test& test);
+    static void ConstructorTest2(Ishiko::Test& test);
+    static void RunTest1(Ishiko::Test& test);
+    static void RunTest2(Ishiko::Test& test);
+    static void RunTest3(Ishiko::Test& test);
+    static void RunTest4(Ishiko::Test& test);
+    static void WaitTest1(Ishiko::Test& test);
+    static void WaitTest2(Ishiko::Test& test);
+};
+
+#endif
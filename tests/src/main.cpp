@@ -1,11 +1,29 @@
 // SPDX-FileCopyrightText: 2005-2024 Xavier Leclercq
 // SPDX-License-Identifier: BSL-1.0
 
+#include "ArenaAllocatorTests.hpp"
+#include "BPlusTreeTests.hpp"
 #include "BinaryTreeTests.hpp"
+#include "CompactDoublyLinkedListTests.hpp"
+#include "ConcurrentQueueTests.hpp"
+#include "ConcurrentSkipListTests.hpp"
+#include "ConcurrentStackTests.hpp"
+#include "ContainerStatisticsTests.hpp"
+#include "CountingAllocatorTests.hpp"
 #include "DoublyLinkedListTests.hpp"
+#include "DynamicArrayTests.hpp"
+#include "FrozenBinaryTreeTests.hpp"
+#include "GeometricLevelGeneratorTests.hpp"
+#include "IntrusiveBinaryTreeTests.hpp"
+#include "IntrusiveDoublyLinkedListTests.hpp"
+#include "IntrusiveSinglyLinkedListTests.hpp"
+#include "OrderedSetImageTests.hpp"
+#include "PoolAllocatorTests.hpp"
 #include "RedBlackTreeTests.hpp"
 #include "SinglyLinkedListTests.hpp"
 #include "SkipListTests.hpp"
+#include "UnrolledSinglyLinkedListTests.hpp"
+#include "WorkStealingPoolTests.hpp"
 #include "Ishiko/DataStructures/linkoptions.hpp"
 #include <Ishiko/TestFramework/Core.hpp>
 #include <exception>
@@ -23,11 +41,29 @@ int main(int argc, char* argv[])
         TestHarness the_test_harness("Ishiko/C++ DataStructures Library Tests", configuration);
 
         TestSequence& the_tests = the_test_harness.tests();
+        the_tests.append<ArenaAllocatorTests>();
+        the_tests.append<PoolAllocatorTests>();
+        the_tests.append<CountingAllocatorTests>();
+        the_tests.append<WorkStealingPoolTests>();
+        the_tests.append<ContainerStatisticsTests>();
         the_tests.append<SinglyLinkedListTests>();
+        the_tests.append<IntrusiveSinglyLinkedListTests>();
+        the_tests.append<UnrolledSinglyLinkedListTests>();
         the_tests.append<DoublyLinkedListTests>();
+        the_tests.append<IntrusiveDoublyLinkedListTests>();
+        the_tests.append<CompactDoublyLinkedListTests>();
+        the_tests.append<ConcurrentQueueTests>();
+        the_tests.append<ConcurrentStackTests>();
+        the_tests.append<DynamicArrayTests>();
+        the_tests.append<GeometricLevelGeneratorTests>();
         the_tests.append<SkipListTests>();
+        the_tests.append<ConcurrentSkipListTests>();
         the_tests.append<BinaryTreeTests>();
+        the_tests.append<FrozenBinaryTreeTests>();
+        the_tests.append<IntrusiveBinaryTreeTests>();
         the_tests.append<RedBlackTreeTests>();
+        the_tests.append<BPlusTreeTests>();
+        the_tests.append<OrderedSetImageTests>();
 
         return the_test_harness.run();
     }